@@ -0,0 +1,61 @@
+// *****************************************************************************
+    // include project headers
+    #include "CPUEngines.hpp"
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AVAILABLE CPU ENGINES
+// =============================================================================
+
+
+int32_t ReferenceEngine::RunCycles( V32CPU& CPU, int32_t MaxCycles )
+{
+    CPU.ChunkCycles = MaxCycles;
+    CPU.RemainingCycles = MaxCycles;
+    
+    // the cycle is counted before the instruction runs,
+    // and HLT or WAIT will take away all remaining ones
+    while( CPU.RemainingCycles > 0 )
+    {
+        CPU.RemainingCycles--;
+        CPU.RunNextCycle();
+    }
+    
+    return CPU.FinishChunk();
+}
+
+// -----------------------------------------------------------------------------
+
+int32_t ChunkedEngine::RunCycles( V32CPU& CPU, int32_t MaxCycles )
+{
+    return CPU.RunCycles( MaxCycles );
+}
+
+
+// =============================================================================
+//      SELECTION OF ENGINES BY NAME
+// =============================================================================
+
+
+vector< string > GetEngineNames()
+{
+    return { "reference", "chunked" };
+}
+
+// -----------------------------------------------------------------------------
+
+unique_ptr< V32CPUEngine > CreateEngine( const string& Name )
+{
+    if( Name == "reference" )
+      return unique_ptr< V32CPUEngine >( new ReferenceEngine );
+    
+    if( Name == "chunked" )
+      return unique_ptr< V32CPUEngine >( new ChunkedEngine );
+    
+    return nullptr;
+}
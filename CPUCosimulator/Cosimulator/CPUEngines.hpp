@@ -0,0 +1,60 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef CPUENGINES_HPP
+    #define CPUENGINES_HPP
+    
+    // include console logic headers
+    #include "ConsoleLogic/V32CPU.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <memory>           // [ C++ STL ] Smart pointers
+// *****************************************************************************
+
+
+// =============================================================================
+//      AVAILABLE CPU ENGINES
+// =============================================================================
+
+
+// The reference engine runs one instruction at a time
+// with RunNextCycle, keeping the cycle count around
+// each one. It is the simplest possible implementation
+// of the engine contract, and all others must match it.
+class ReferenceEngine: public V32::V32CPUEngine
+{
+    public:
+        
+        virtual int32_t RunCycles( V32::V32CPU& CPU, int32_t MaxCycles );
+};
+
+// -----------------------------------------------------------------------------
+
+// The chunked engine is the one used by the emulators
+// (the CPU's own RunCycles), so it is the one checked
+// by default. New engines should be added here too.
+class ChunkedEngine: public V32::V32CPUEngine
+{
+    public:
+        
+        virtual int32_t RunCycles( V32::V32CPU& CPU, int32_t MaxCycles );
+};
+
+
+// =============================================================================
+//      SELECTION OF ENGINES BY NAME
+// =============================================================================
+
+
+// engines that can be chosen from the command line
+std::vector< std::string > GetEngineNames();
+
+// returns null if there is no engine with that name
+std::unique_ptr< V32::V32CPUEngine > CreateEngine( const std::string& Name );
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
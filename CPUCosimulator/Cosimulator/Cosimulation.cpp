@@ -0,0 +1,268 @@
+// *****************************************************************************
+    // include project headers
+    #include "Cosimulation.hpp"
+    #include "CPUEngines.hpp"
+    
+    // include infrastructure headers
+    #include "DevToolsInfrastructure/StringFunctions.hpp"
+    #include "DevToolsInfrastructure/EnumStringConversions.hpp"
+    
+    // include C/C++ headers
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      COSIMULATION: INSTANCE HANDLING
+// =============================================================================
+
+
+Cosimulation::Cosimulation( unique_ptr< V32CPUEngine > TestedEngine, int32_t StepCycles, uint32_t InputSeed )
+:   Reference( unique_ptr< V32CPUEngine >( new ReferenceEngine ), StepCycles ),
+    Tested( move( TestedEngine ), StepCycles ),
+    InputGenerator( InputSeed )
+{
+    for( bool& Pressed: PressedControls )
+      Pressed = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void Cosimulation::Start( shared_ptr< const ROMContents > Bios, shared_ptr< const ROMContents > Cartridge )
+{
+    for( V32Console* Console: { &Reference.Console, &Tested.Console } )
+    {
+        Console->LoadBios( Bios );
+        
+        if( Cartridge )
+          Console->LoadCartridge( Cartridge );
+        
+        // these would otherwise be taken from the host
+        Console->SetCurrentDate( 2000, 0 );
+        Console->SetCurrentTime( 0, 0, 0 );
+        Console->SetGamepadConnection( 0, true );
+        Console->SetPower( true );
+    }
+}
+
+
+// =============================================================================
+//      COSIMULATION: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+// each control has a small chance to change on every
+// frame, so that programs see all kinds of input
+void Cosimulation::ApplyInput()
+{
+    for( int i = 0; i < 11; i++ )
+    {
+        if( (InputGenerator() % 32) != 0 )
+          continue;
+        
+        PressedControls[ i ] = !PressedControls[ i ];
+        Reference.Console.SetGamepadControl( 0, (GamepadControls)i, PressedControls[ i ] );
+        Tested.Console.SetGamepadControl( 0, (GamepadControls)i, PressedControls[ i ] );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// returns the reason they differ, or empty if equal
+string Cosimulation::CompareSteps( unsigned StepIndex )
+{
+    const StepRecord& R = Reference.Trace.Steps[ StepIndex ];
+    const StepRecord& T = Tested.Trace.Steps[ StepIndex ];
+    
+    if( R.Cycles != T.Cycles )
+      return "cycles run are different";
+    
+    if( R.RaisedError != T.RaisedError )
+      return "only one engine raised a hardware error";
+    
+    if( R.InstructionPointer.AsBinary != T.InstructionPointer.AsBinary )
+      return "instruction pointer is different";
+    
+    for( int i = 0; i < 16; i++ )
+      if( R.Registers[ i ].AsBinary != T.Registers[ i ].AsBinary )
+        return "register " + RegisterToString( (CPURegisters)i ) + " is different";
+    
+    if( R.Halted != T.Halted || R.Waiting != T.Waiting )
+      return "CPU halt or wait state is different";
+    
+    if( R.NumberOfWrites != T.NumberOfWrites )
+      return "number of memory and port writes is different";
+    
+    for( unsigned i = 0; i < R.NumberOfWrites; i++ )
+    {
+        const RecordedWrite& RW = Reference.Trace.Writes[ R.FirstWrite + i ];
+        const RecordedWrite& TW = Tested.Trace.Writes[ T.FirstWrite + i ];
+        
+        if( RW.IsPort != TW.IsPort || RW.Address != TW.Address || RW.Value.AsBinary != TW.Value.AsBinary )
+          return "memory or port writes are different";
+    }
+    
+    return "";
+}
+
+// -----------------------------------------------------------------------------
+
+string Cosimulation::DescribeStep( const StepRecord& Step )
+{
+    string Description = Hex( Step.StartAddress, 8 ) + ": ";
+    string LastInstruction = Disassembler.DisassembleInstruction( Step.LastInstruction, Step.LastImmediate );
+    
+    // for single instructions, their address is known
+    if( Step.Cycles == 1 )
+      Description += LastInstruction;
+    else
+      Description += to_string( Step.Cycles ) + " cycles, last was " + LastInstruction;
+    
+    if( Step.RaisedError )
+      Description += " (hardware error)";
+    
+    return Description;
+}
+
+// -----------------------------------------------------------------------------
+
+void Cosimulation::ReportDivergence( ostream& Report, int Frame, unsigned StepIndex, const string& Reason )
+{
+    const vector< StepRecord >& RSteps = Reference.Trace.Steps;
+    const vector< StepRecord >& TSteps = Tested.Trace.Steps;
+    
+    // find the cycle where the step started
+    int32_t FrameCycle = 0;
+    
+    for( unsigned i = 0; i < StepIndex; i++ )
+      FrameCycle += RSteps[ i ].Cycles;
+    
+    Report << "DIVERGENCE in frame " << Frame << ", step " << StepIndex;
+    Report << " (starting at cycle " << FrameCycle << " of the frame)" << endl;
+    Report << "Reason: " << Reason << endl;
+    
+    // show what led to this point
+    unsigned FirstShown = (StepIndex > 8? StepIndex - 8 : 0);
+    
+    if( FirstShown < StepIndex )
+    {
+        Report << endl << "Previous steps (same in both engines):" << endl;
+        
+        for( unsigned i = FirstShown; i < StepIndex; i++ )
+          Report << "  " << DescribeStep( RSteps[ i ] ) << endl;
+    }
+    
+    // one of the engines may have run fewer steps
+    bool HasReferenceStep = (StepIndex < RSteps.size());
+    bool HasTestedStep = (StepIndex < TSteps.size());
+    
+    Report << endl << "Diverging step:" << endl;
+    Report << "  reference: " << (HasReferenceStep? DescribeStep( RSteps[ StepIndex ] ) : "(frame ended)") << endl;
+    Report << "  tested:    " << (HasTestedStep? DescribeStep( TSteps[ StepIndex ] ) : "(frame ended)") << endl;
+    
+    if( !HasReferenceStep || !HasTestedStep )
+      return;
+    
+    const StepRecord& R = RSteps[ StepIndex ];
+    const StepRecord& T = TSteps[ StepIndex ];
+    
+    // compare CPU state, marking differences
+    Report << endl << "CPU state after the step:     reference    tested" << endl;
+    
+    for( int i = 0; i < 17; i++ )
+    {
+        string Name = (i < 16? RegisterToString( (CPURegisters)i ) : string("IP"));
+        V32Word RValue = (i < 16? R.Registers[ i ] : R.InstructionPointer);
+        V32Word TValue = (i < 16? T.Registers[ i ] : T.InstructionPointer);
+        
+        Report << "  " << Name << string( 28 - Name.size(), ' ' );
+        Report << Hex( RValue.AsBinary, 8 ) << "   " << Hex( TValue.AsBinary, 8 );
+        Report << (RValue.AsBinary != TValue.AsBinary? "   <--" : "") << endl;
+    }
+    
+    Report << "  Halted / Waiting            " << R.Halted << " / " << R.Waiting;
+    Report << "        " << T.Halted << " / " << T.Waiting << endl;
+    
+    // list writes from each engine
+    for( int Engine = 0; Engine < 2; Engine++ )
+    {
+        const StepRecord& Step = (Engine == 0? R : T);
+        const vector< RecordedWrite >& Writes = (Engine == 0? Reference.Trace.Writes : Tested.Trace.Writes);
+        
+        Report << endl << (Engine == 0? "Reference" : "Tested") << " writes in the step:";
+        Report << (Step.NumberOfWrites == 0? " none" : "") << endl;
+        
+        for( unsigned i = 0; i < Step.NumberOfWrites; i++ )
+        {
+            const RecordedWrite& Write = Writes[ Step.FirstWrite + i ];
+            Report << "  " << (Write.IsPort? "port    " : "address ") << Hex( Write.Address, 8 );
+            Report << " <- " << Hex( Write.Value.AsBinary, 8 ) << endl;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// writes are already compared in each step, but this
+// also catches engines that write memory directly
+bool Cosimulation::CompareRAM( ostream& Report, int Frame )
+{
+    const vector< V32Word >& R = Reference.Console.RAM.Memory;
+    const vector< V32Word >& T = Tested.Console.RAM.Memory;
+    
+    auto Mismatch = mismatch( R.begin(), R.end(), T.begin(),
+      []( const V32Word& a, const V32Word& b ){ return a.AsBinary == b.AsBinary; } );
+    
+    if( Mismatch.first == R.end() )
+      return true;
+    
+    int32_t Address = Constants::RAMFirstAddress + (Mismatch.first - R.begin());
+    Report << "DIVERGENCE in RAM contents after frame " << Frame << endl;
+    Report << "First different address is " << Hex( Address, 8 );
+    Report << ": reference has " << Hex( Mismatch.first->AsBinary, 8 );
+    Report << ", tested has " << Hex( Mismatch.second->AsBinary, 8 ) << endl;
+    return false;
+}
+
+
+// =============================================================================
+//      COSIMULATION: EXECUTION
+// =============================================================================
+
+
+bool Cosimulation::RunFrame( int Frame, ostream& Report )
+{
+    ApplyInput();
+    
+    // run the frame on each console
+    Reference.RunNextFrame();
+    Tested.RunNextFrame();
+    
+    // find the first step that differs
+    const vector< StepRecord >& RSteps = Reference.Trace.Steps;
+    const vector< StepRecord >& TSteps = Tested.Trace.Steps;
+    unsigned ComparedSteps = min( RSteps.size(), TSteps.size() );
+    
+    for( unsigned i = 0; i < ComparedSteps; i++ )
+    {
+        string Reason = CompareSteps( i );
+        
+        if( !Reason.empty() )
+        {
+            ReportDivergence( Report, Frame, i, Reason );
+            return false;
+        }
+    }
+    
+    if( RSteps.size() != TSteps.size() )
+    {
+        ReportDivergence( Report, Frame, ComparedSteps, "number of steps in the frame is different" );
+        return false;
+    }
+    
+    return CompareRAM( Report, Frame );
+}
@@ -0,0 +1,69 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef COSIMULATION_HPP
+    #define COSIMULATION_HPP
+    
+    // include project headers
+    #include "ExecutionTrace.hpp"
+    
+    // include disassembler headers
+    #include "Disassembler/VirconDisassembler.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <ostream>          // [ C++ STL ] Output streams
+    #include <random>           // [ C++ STL ] Random numbers
+// *****************************************************************************
+
+
+// =============================================================================
+//      LOCKSTEP EXECUTION OF TWO CPU ENGINES
+// =============================================================================
+
+
+// Two consoles run the same BIOS and cartridge with the
+// same input: one on the reference engine, and the other
+// on the engine being tested. After each frame their
+// traces are compared step by step, and then their RAM.
+// Both consoles are deterministic, so the first step that
+// differs is exactly where the tested engine diverged.
+class Cosimulation
+{
+    public:
+        
+        TracedConsole Reference;
+        TracedConsole Tested;
+        
+    private:
+        
+        // simulated input (the same for both)
+        std::mt19937 InputGenerator;
+        bool PressedControls[ 11 ];
+        
+        // used to show the instructions run
+        VirconDisassembler Disassembler;
+        
+        // internal auxiliary methods
+        void ApplyInput();
+        std::string CompareSteps( unsigned StepIndex );
+        std::string DescribeStep( const StepRecord& Step );
+        void ReportDivergence( std::ostream& Report, int Frame, unsigned StepIndex, const std::string& Reason );
+        bool CompareRAM( std::ostream& Report, int Frame );
+        
+    public:
+        
+        // instance handling
+        Cosimulation( std::unique_ptr< V32::V32CPUEngine > TestedEngine, int32_t StepCycles, uint32_t InputSeed );
+        
+        // both consoles are powered on with the same contents
+        void Start( std::shared_ptr< const V32::ROMContents > Bios, std::shared_ptr< const V32::ROMContents > Cartridge );
+        
+        // returns false and reports when engines diverge
+        bool RunFrame( int Frame, std::ostream& Report );
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -0,0 +1,115 @@
+// *****************************************************************************
+    // include console logic headers
+    #include "ConsoleLogic/V32ROMContents.hpp"
+    
+    // include project headers
+    #include "Cosimulation.hpp"
+    #include "CPUEngines.hpp"
+    
+    // include C/C++ headers
+    #include <iostream>         // [ C++ STL ] I/O Streams
+    #include <string>           // [ C++ STL ] Strings
+    #include <stdexcept>        // [ C++ STL ] Exceptions
+    #include <cstdlib>          // [ ANSI C ] Standard library
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// This program checks a CPU engine against the reference
+// one, running both in lockstep with no video, audio or
+// real input. Steps of 1 cycle compare the CPU after every
+// instruction; larger steps are faster, but they only
+// locate a divergence within a block of instructions.
+
+// the log is only used while loading
+static void LogLine( void* UserData, const string& Message )
+{
+    cout << Message << endl;
+}
+
+// -----------------------------------------------------------------------------
+
+static void PrintUsage()
+{
+    cout << "USAGE: Vircon32Cosimulator <bios file> [cartridge file] [frames] [step cycles] [engine] [input seed]" << endl;
+    cout << "Defaults are 600 frames, steps of 1 cycle, the chunked engine and input seed 1" << endl;
+    cout << "Available engines:";
+    
+    for( const string& Name: GetEngineNames() )
+      cout << " " << Name;
+    
+    cout << endl;
+}
+
+
+// =============================================================================
+//      MAIN FUNCTION
+// =============================================================================
+
+
+int main( int NumberOfArguments, char* Arguments[] )
+{
+    if( NumberOfArguments < 2 )
+    {
+        PrintUsage();
+        return 1;
+    }
+    
+    // an empty cartridge argument runs just the BIOS
+    string BiosPath = Arguments[ 1 ];
+    string CartridgePath = (NumberOfArguments > 2? Arguments[ 2 ] : "");
+    int NumberOfFrames = (NumberOfArguments > 3? atoi( Arguments[ 3 ] ) : 600);
+    int32_t StepCycles = (NumberOfArguments > 4? atoi( Arguments[ 4 ] ) : 1);
+    string EngineName = (NumberOfArguments > 5? Arguments[ 5 ] : "chunked");
+    uint32_t InputSeed = (NumberOfArguments > 6? strtoul( Arguments[ 6 ], nullptr, 10 ) : 1);
+    
+    unique_ptr< V32CPUEngine > TestedEngine = CreateEngine( EngineName );
+    
+    if( !TestedEngine || StepCycles < 1 )
+    {
+        PrintUsage();
+        return 1;
+    }
+    
+    // the default callbacks throw errors as exceptions
+    ConsoleCallbacks LoaderCallbacks;
+    SetDefaultCallbacks( LoaderCallbacks );
+    LoaderCallbacks.LogLine = LogLine;
+    
+    try
+    {
+        // both consoles share the same contents
+        shared_ptr< const ROMContents > Bios = LoadBiosContents( BiosPath, LoaderCallbacks );
+        shared_ptr< const ROMContents > Cartridge;
+        
+        if( !CartridgePath.empty() )
+          Cartridge = LoadCartridgeContents( CartridgePath, LoaderCallbacks );
+        
+        Cosimulation Simulation( move( TestedEngine ), StepCycles, InputSeed );
+        Simulation.Start( Bios, Cartridge );
+        
+        cout << "Comparing engine \"" << EngineName << "\" with the reference engine, ";
+        cout << "in steps of " << StepCycles << " cycles" << endl;
+        
+        for( int Frame = 0; Frame < NumberOfFrames; Frame++ )
+          if( !Simulation.RunFrame( Frame, cout ) )
+            return 1;
+        
+        cout << "No divergence found in " << NumberOfFrames << " frames" << endl;
+        return 0;
+    }
+    
+    catch( const exception& e )
+    {
+        cout << "ERROR: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,164 @@
+// *****************************************************************************
+    // include project headers
+    #include "ExecutionTrace.hpp"
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      EXECUTION TRACE
+// =============================================================================
+
+
+void ExecutionTrace::Clear()
+{
+    Steps.clear();
+    Writes.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void ExecutionTrace::AddWrite( int32_t Address, V32Word Value, bool IsPort )
+{
+    Writes.push_back( { Address, Value, IsPort } );
+}
+
+// -----------------------------------------------------------------------------
+
+void ExecutionTrace::AddStep( V32CPU& CPU, int32_t StartAddress, int32_t Cycles, bool RaisedError )
+{
+    StepRecord Step;
+    Step.StartAddress = StartAddress;
+    Step.Cycles = Cycles;
+    Step.RaisedError = RaisedError;
+    Step.LastInstruction = CPU.Instruction;
+    Step.LastImmediate = CPU.ImmediateValue;
+    
+    // named registers are separate members
+    for( int i = 0; i < 11; i++ )
+      Step.Registers[ i ] = CPU.Registers[ i ];
+    
+    Step.Registers[ 11 ] = CPU.CountRegister;
+    Step.Registers[ 12 ] = CPU.SourceRegister;
+    Step.Registers[ 13 ] = CPU.DestinationRegister;
+    Step.Registers[ 14 ] = CPU.BasePointer;
+    Step.Registers[ 15 ] = CPU.StackPointer;
+    
+    Step.InstructionPointer = CPU.InstructionPointer;
+    Step.Halted = CPU.Halted;
+    Step.Waiting = CPU.Waiting;
+    
+    // this step made all writes after the previous one
+    Step.FirstWrite = 0;
+    
+    if( !Steps.empty() )
+      Step.FirstWrite = Steps.back().FirstWrite + Steps.back().NumberOfWrites;
+    
+    Step.NumberOfWrites = Writes.size() - Step.FirstWrite;
+    Steps.push_back( Step );
+}
+
+
+// =============================================================================
+//      RECORDING OF CPU ACTIVITY
+// =============================================================================
+
+
+bool RecordingMemory::ReadAddress( int32_t LocalAddress, V32Word& Result )
+{
+    return Device->ReadAddress( LocalAddress, Result );
+}
+
+// -----------------------------------------------------------------------------
+
+bool RecordingMemory::WriteAddress( int32_t LocalAddress, V32Word Value )
+{
+    // failed writes are recorded too, since
+    // they have effects (a hardware error)
+    Trace->AddWrite( FirstAddress | LocalAddress, Value, false );
+    return Device->WriteAddress( LocalAddress, Value );
+}
+
+// -----------------------------------------------------------------------------
+
+bool RecordingPorts::ReadPort( int32_t LocalPort, V32Word& Result )
+{
+    return Device->ReadPort( LocalPort, Result );
+}
+
+// -----------------------------------------------------------------------------
+
+bool RecordingPorts::WritePort( int32_t LocalPort, V32Word Value )
+{
+    Trace->AddWrite( FirstPort | LocalPort, Value, true );
+    return Device->WritePort( LocalPort, Value );
+}
+
+// -----------------------------------------------------------------------------
+
+int32_t TracingEngine::RunCycles( V32CPU& CPU, int32_t MaxCycles )
+{
+    int32_t StartAddress = CPU.InstructionPointer.AsInteger;
+    int32_t Cycles;
+    
+    // hardware errors must still reach the console
+    try
+    {
+        Cycles = TracedEngine->RunCycles( CPU, MaxCycles );
+    }
+    
+    catch( const CPUException& )
+    {
+        Trace->AddStep( CPU, StartAddress, CPU.GetElapsedCycles(), true );
+        throw;
+    }
+    
+    Trace->AddStep( CPU, StartAddress, Cycles, false );
+    return Cycles;
+}
+
+
+// =============================================================================
+//      CONSOLE WITH TRACED EXECUTION
+// =============================================================================
+
+
+TracedConsole::TracedConsole( unique_ptr< V32CPUEngine > CPUEngine, int32_t StepCycles )
+{
+    Engine = move( CPUEngine );
+    Tracer.TracedEngine = Engine.get();
+    Tracer.Trace = &Trace;
+    
+    // place recorders between buses and devices, using
+    // the same address decoding as the buses themselves
+    for( int i = 0; i < Constants::MemoryBusSlaves; i++ )
+    {
+        MemoryRecorders[ i ].Device = Console.MemoryBus.Slaves[ i ];
+        MemoryRecorders[ i ].FirstAddress = i << 28;
+        MemoryRecorders[ i ].Trace = &Trace;
+        Console.MemoryBus.Slaves[ i ] = &MemoryRecorders[ i ];
+    }
+    
+    for( int i = 0; i < Constants::ControlBusSlaves; i++ )
+    {
+        PortRecorders[ i ].Device = Console.ControlBus.Slaves[ i ];
+        PortRecorders[ i ].FirstPort = i << 8;
+        PortRecorders[ i ].Trace = &Trace;
+        Console.ControlBus.Slaves[ i ] = &PortRecorders[ i ];
+    }
+    
+    // run the CPU in steps of the requested size
+    Console.CPUEngine = &Tracer;
+    Console.MaxChunkCycles = StepCycles;
+}
+
+// -----------------------------------------------------------------------------
+
+void TracedConsole::RunNextFrame()
+{
+    Trace.Clear();
+    Console.RunNextFrame();
+}
@@ -0,0 +1,164 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef EXECUTIONTRACE_HPP
+    #define EXECUTIONTRACE_HPP
+    
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include C/C++ headers
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <memory>           // [ C++ STL ] Smart pointers
+// *****************************************************************************
+
+
+// =============================================================================
+//      DEFINITIONS FOR EXECUTION TRACES
+// =============================================================================
+
+
+// a write made by the CPU to memory or to a port,
+// with its global address or port number
+typedef struct
+{
+    int32_t Address;
+    V32::V32Word Value;
+    bool IsPort;
+}
+RecordedWrite;
+
+// -----------------------------------------------------------------------------
+
+// CPU state after each step (each chunk run by the
+// engine), along with the writes made during the step
+typedef struct
+{
+    // what was run in the step
+    int32_t StartAddress;
+    int32_t Cycles;
+    bool RaisedError;
+    
+    // last instruction in the step
+    V32::CPUInstruction LastInstruction;
+    V32::V32Word LastImmediate;
+    
+    // CPU state at the end
+    V32::V32Word Registers[ 16 ];
+    V32::V32Word InstructionPointer;
+    int32_t Halted;
+    int32_t Waiting;
+    
+    // range in the list of writes
+    uint32_t FirstWrite;
+    uint32_t NumberOfWrites;
+}
+StepRecord;
+
+// -----------------------------------------------------------------------------
+
+class ExecutionTrace
+{
+    public:
+        
+        std::vector< StepRecord > Steps;
+        std::vector< RecordedWrite > Writes;
+        
+    public:
+        
+        void Clear();
+        void AddWrite( int32_t Address, V32::V32Word Value, bool IsPort );
+        void AddStep( V32::V32CPU& CPU, int32_t StartAddress, int32_t Cycles, bool RaisedError );
+};
+
+
+// =============================================================================
+//      RECORDING OF CPU ACTIVITY
+// =============================================================================
+
+
+// these are placed between the buses and their devices,
+// so they see every write the CPU makes through them
+class RecordingMemory: public V32::VirconMemoryInterface
+{
+    public:
+        
+        V32::VirconMemoryInterface* Device;
+        int32_t FirstAddress;
+        ExecutionTrace* Trace;
+        
+    public:
+        
+        virtual bool ReadAddress( int32_t LocalAddress, V32::V32Word& Result );
+        virtual bool WriteAddress( int32_t LocalAddress, V32::V32Word Value );
+};
+
+// -----------------------------------------------------------------------------
+
+class RecordingPorts: public V32::VirconControlInterface
+{
+    public:
+        
+        V32::VirconControlInterface* Device;
+        int32_t FirstPort;
+        ExecutionTrace* Trace;
+        
+    public:
+        
+        virtual bool ReadPort( int32_t LocalPort, V32::V32Word& Result );
+        virtual bool WritePort( int32_t LocalPort, V32::V32Word Value );
+};
+
+// -----------------------------------------------------------------------------
+
+// runs another engine, and adds a step to
+// the trace for each chunk that it runs
+class TracingEngine: public V32::V32CPUEngine
+{
+    public:
+        
+        V32::V32CPUEngine* TracedEngine;
+        ExecutionTrace* Trace;
+        
+    public:
+        
+        virtual int32_t RunCycles( V32::V32CPU& CPU, int32_t MaxCycles );
+};
+
+
+// =============================================================================
+//      CONSOLE WITH TRACED EXECUTION
+// =============================================================================
+
+
+// A console whose CPU runs on the given engine, and
+// where all CPU activity is recorded in a trace. Note
+// that writes are only seen when the engine accesses
+// memory through the bus, like the CPU itself does.
+class TracedConsole
+{
+    public:
+        
+        V32::V32Console Console;
+        ExecutionTrace Trace;
+        
+    private:
+        
+        std::unique_ptr< V32::V32CPUEngine > Engine;
+        TracingEngine Tracer;
+        RecordingMemory MemoryRecorders[ V32::Constants::MemoryBusSlaves ];
+        RecordingPorts PortRecorders[ V32::Constants::ControlBusSlaves ];
+        
+    public:
+        
+        // each step will run up to the given cycles
+        TracedConsole( std::unique_ptr< V32::V32CPUEngine > CPUEngine, int32_t StepCycles );
+        
+        // the trace only holds the latest frame
+        void RunNextFrame();
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
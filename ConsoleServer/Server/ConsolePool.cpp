@@ -0,0 +1,179 @@
+// *****************************************************************************
+    // include project headers
+    #include "ConsolePool.hpp"
+    
+    // include C/C++ headers
+    #include <exception>        // [ C++ STL ] Exceptions
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      CONSOLE POOL: INSTANCE HANDLING
+// =============================================================================
+
+
+ConsolePool::ConsolePool( unsigned NumberOfThreads )
+{
+    if( NumberOfThreads < 1 )
+      NumberOfThreads = 1;
+    
+    TickNumber = 0;
+    MustExit = false;
+    PendingConsoles = 0;
+    
+    // create all queues before any worker starts,
+    // since every worker can steal from all of them
+    for( unsigned i = 0; i < NumberOfThreads; i++ )
+      Queues.emplace_back( new WorkerQueue );
+    
+    for( unsigned i = 0; i < NumberOfThreads; i++ )
+      Workers.emplace_back( &ConsolePool::WorkerFunction, this, i );
+}
+
+// -----------------------------------------------------------------------------
+
+ConsolePool::~ConsolePool()
+{
+    {
+        lock_guard< mutex > Lock( TickMutex );
+        MustExit = true;
+    }
+    
+    TickStarted.notify_all();
+    
+    for( thread& Worker: Workers )
+      Worker.join();
+}
+
+
+// =============================================================================
+//      CONSOLE POOL: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+bool ConsolePool::TakeConsole( unsigned WorkerIndex, V32Console*& Console )
+{
+    // first try our own queue, from the back
+    {
+        WorkerQueue& Own = *Queues[ WorkerIndex ];
+        lock_guard< mutex > Lock( Own.Mutex );
+        
+        if( !Own.Consoles.empty() )
+        {
+            Console = Own.Consoles.back();
+            Own.Consoles.pop_back();
+            return true;
+        }
+    }
+    
+    // otherwise steal from other queues, from the front
+    for( unsigned i = 1; i < Queues.size(); i++ )
+    {
+        WorkerQueue& Victim = *Queues[ (WorkerIndex + i) % Queues.size() ];
+        lock_guard< mutex > Lock( Victim.Mutex );
+        
+        if( !Victim.Consoles.empty() )
+        {
+            Console = Victim.Consoles.front();
+            Victim.Consoles.pop_front();
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+void ConsolePool::RunConsole( V32Console* Console )
+{
+    try
+    {
+        Console->RunNextFrame();
+    }
+    
+    catch( const exception& e )
+    {
+        lock_guard< mutex > Lock( ErrorMutex );
+        Errors.push_back( { Console, e.what() } );
+    }
+    
+    // the last console to finish ends the tick
+    if( --PendingConsoles == 0 )
+    {
+        lock_guard< mutex > Lock( TickMutex );
+        TickFinished.notify_all();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ConsolePool::WorkerFunction( unsigned WorkerIndex )
+{
+    uint64_t LastTick = 0;
+    
+    while( true )
+    {
+        // wait for a new tick to start
+        {
+            unique_lock< mutex > Lock( TickMutex );
+            TickStarted.wait( Lock, [&]{ return MustExit || TickNumber != LastTick; } );
+            
+            if( MustExit )
+              return;
+            
+            LastTick = TickNumber;
+        }
+        
+        // run consoles until there are none left
+        V32Console* Console;
+        
+        while( TakeConsole( WorkerIndex, Console ) )
+          RunConsole( Console );
+    }
+}
+
+
+// =============================================================================
+//      CONSOLE POOL: PUBLIC METHODS
+// =============================================================================
+
+
+vector< ConsoleError > ConsolePool::RunFrame( const vector< V32Console* >& Consoles )
+{
+    Errors.clear();
+    
+    if( Consoles.empty() )
+      return Errors;
+    
+    // count consoles before any of them is queued
+    PendingConsoles = (int)Consoles.size();
+    
+    // spread consoles evenly across all queues
+    for( unsigned i = 0; i < Consoles.size(); i++ )
+    {
+        WorkerQueue& Queue = *Queues[ i % Queues.size() ];
+        lock_guard< mutex > Lock( Queue.Mutex );
+        Queue.Consoles.push_back( Consoles[ i ] );
+    }
+    
+    // start the tick and wait for it to finish
+    unique_lock< mutex > Lock( TickMutex );
+    TickNumber++;
+    TickStarted.notify_all();
+    TickFinished.wait( Lock, [&]{ return PendingConsoles == 0; } );
+    
+    // no worker can be accessing errors now
+    return Errors;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned ConsolePool::GetNumberOfThreads()
+{
+    return Workers.size();
+}
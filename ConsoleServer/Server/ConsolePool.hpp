@@ -0,0 +1,101 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef CONSOLEPOOL_HPP
+    #define CONSOLEPOOL_HPP
+    
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include C/C++ headers
+    #include <string>               // [ C++ STL ] Strings
+    #include <vector>               // [ C++ STL ] Vectors
+    #include <deque>                // [ C++ STL ] Double-ended queues
+    #include <memory>               // [ C++ STL ] Smart pointers
+    #include <atomic>               // [ C++ STL ] Atomic variables
+    #include <thread>               // [ C++ STL ] Threads
+    #include <mutex>                // [ C++ STL ] Mutexes
+    #include <condition_variable>   // [ C++ STL ] Condition variables
+// *****************************************************************************
+
+
+// =============================================================================
+//      DEFINITIONS FOR THE POOL
+// =============================================================================
+
+
+// consoles that failed during a frame are
+// reported along with the error message
+typedef struct
+{
+    V32::V32Console* Console;
+    std::string Message;
+}
+ConsoleError;
+
+// -----------------------------------------------------------------------------
+
+// each worker owns a queue of consoles to run
+typedef struct
+{
+    std::mutex Mutex;
+    std::deque< V32::V32Console* > Consoles;
+}
+WorkerQueue;
+
+
+// =============================================================================
+//      WORK-STEALING THREAD POOL
+// =============================================================================
+
+
+// Each tick runs one frame on every given console.
+// Consoles are spread across the worker queues, and
+// each worker takes consoles from the back of its own
+// queue; when it is empty, it steals from the front of
+// other queues. This keeps all threads busy even when
+// some consoles take much longer than others to run a
+// frame (for instance, while loading or when halted).
+class ConsolePool
+{
+    private:
+        
+        // workers and their queues
+        std::vector< std::unique_ptr< WorkerQueue > > Queues;
+        std::vector< std::thread > Workers;
+        
+        // synchronization between ticks
+        std::mutex TickMutex;
+        std::condition_variable TickStarted;
+        std::condition_variable TickFinished;
+        uint64_t TickNumber;
+        bool MustExit;
+        std::atomic< int > PendingConsoles;
+        
+        // errors during current tick
+        std::mutex ErrorMutex;
+        std::vector< ConsoleError > Errors;
+        
+        // internal auxiliary methods
+        bool TakeConsole( unsigned WorkerIndex, V32::V32Console*& Console );
+        void RunConsole( V32::V32Console* Console );
+        void WorkerFunction( unsigned WorkerIndex );
+        
+    public:
+        
+        // instance handling
+        ConsolePool( unsigned NumberOfThreads );
+       ~ConsolePool();
+        
+        // runs a frame on all consoles, and
+        // returns only after all have finished
+        std::vector< ConsoleError > RunFrame( const std::vector< V32::V32Console* >& Consoles );
+        
+        // queries
+        unsigned GetNumberOfThreads();
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
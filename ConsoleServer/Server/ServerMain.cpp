@@ -0,0 +1,197 @@
+// *****************************************************************************
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include project headers
+    #include "ConsolePool.hpp"
+    
+    // include C/C++ headers
+    #include <iostream>         // [ C++ STL ] I/O Streams
+    #include <fstream>          // [ C++ STL ] File Streams
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <memory>           // [ C++ STL ] Smart pointers
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    #include <chrono>           // [ C++ STL ] Time measurement
+    #include <thread>           // [ C++ STL ] Threads
+    #include <stdexcept>        // [ C++ STL ] Exceptions
+    #include <cstdlib>          // [ ANSI C ] Standard library
+    #include <cstdint>          // [ ANSI C ] Standard integers
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// This program runs many consoles with the same BIOS and
+// cartridge, as done in arcade and kiosk backends. ROM
+// contents are loaded only once and then shared by all
+// consoles, so each one only needs memory for its own
+// state: RAM, registers, GPU and SPU state. Consoles have
+// no video, audio or input, and run a frame per tick.
+
+// the log is used while loading, with no user data,
+// and then by each console, with its number as user
+// data; consoles run in parallel so lines are written
+// with a single call to avoid mixing them
+static void LogLine( void* UserData, const string& Message )
+{
+    if( !UserData )
+    {
+        cout << Message << endl;
+        return;
+    }
+    
+    string Line = "[Console " + to_string( (intptr_t)UserData ) + "] " + Message + "\n";
+    cout << Line << flush;
+}
+
+// -----------------------------------------------------------------------------
+
+// resident memory of this process in KB, or
+// 0 if it cannot be measured in this system
+static unsigned long GetResidentMemoryKB()
+{
+    #if defined( __linux__ )
+      ifstream StatusFile( "/proc/self/status" );
+      string Line;
+      
+      while( getline( StatusFile, Line ) )
+        if( Line.compare( 0, 6, "VmRSS:" ) == 0 )
+          return strtoul( Line.c_str() + 6, nullptr, 10 );
+    #endif
+    
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+static unsigned long GetContentsSizeKB( const ROMContents& Contents )
+{
+    unsigned long Bytes = Contents.ProgramROM.size() * sizeof( V32Word );
+    Bytes += Contents.Samples.size() * sizeof( SPUSample );
+    
+    for( const ROMTexture& Texture: Contents.Textures )
+      Bytes += Texture.Pixels.size() * sizeof( GPUColor );
+    
+    return Bytes / 1024;
+}
+
+// -----------------------------------------------------------------------------
+
+static double SecondsSince( chrono::steady_clock::time_point Start )
+{
+    chrono::duration< double > Elapsed = chrono::steady_clock::now() - Start;
+    return Elapsed.count();
+}
+
+
+// =============================================================================
+//      MAIN FUNCTION
+// =============================================================================
+
+
+int main( int NumberOfArguments, char* Arguments[] )
+{
+    if( NumberOfArguments < 3 )
+    {
+        cout << "USAGE: Vircon32Server <bios file> <cartridge file> [consoles] [frames] [threads]" << endl;
+        cout << "By default it runs 16 consoles for 600 frames, with one thread per CPU core" << endl;
+        return 1;
+    }
+    
+    string BiosPath = Arguments[ 1 ];
+    string CartridgePath = Arguments[ 2 ];
+    int NumberOfConsoles = (NumberOfArguments > 3? atoi( Arguments[ 3 ] ) : 16);
+    int NumberOfFrames = (NumberOfArguments > 4? atoi( Arguments[ 4 ] ) : 600);
+    unsigned NumberOfThreads = (NumberOfArguments > 5? atoi( Arguments[ 5 ] ) : thread::hardware_concurrency());
+    
+    if( NumberOfConsoles < 1 || NumberOfFrames < 0 )
+    {
+        cout << "Invalid number of consoles or frames" << endl;
+        return 1;
+    }
+    
+    // the default callbacks throw errors as exceptions
+    ConsoleCallbacks LoaderCallbacks;
+    SetDefaultCallbacks( LoaderCallbacks );
+    LoaderCallbacks.LogLine = LogLine;
+    
+    try
+    {
+        // load the shared contents only once
+        unsigned long MemoryBeforeLoad = GetResidentMemoryKB();
+        shared_ptr< const ROMContents > Bios = LoadBiosContents( BiosPath, LoaderCallbacks );
+        shared_ptr< const ROMContents > Cartridge = LoadCartridgeContents( CartridgePath, LoaderCallbacks );
+        unsigned long MemoryAfterLoad = GetResidentMemoryKB();
+        
+        cout << "Shared ROM contents: " << GetContentsSizeKB( *Bios ) + GetContentsSizeKB( *Cartridge ) << " KB" << endl;
+        
+        // create all consoles and connect them to the
+        // contents (this does not copy any of them)
+        vector< unique_ptr< V32Console > > Consoles;
+        vector< V32Console* > RunningConsoles;
+        
+        for( int i = 0; i < NumberOfConsoles; i++ )
+        {
+            Consoles.emplace_back( new V32Console );
+            Consoles.back()->Callbacks.UserData = (void*)(intptr_t)(i + 1);
+            Consoles.back()->Callbacks.LogLine = LogLine;
+            Consoles.back()->LoadBios( Bios );
+            Consoles.back()->LoadCartridge( Cartridge );
+            Consoles.back()->SetPower( true );
+            RunningConsoles.push_back( Consoles.back().get() );
+        }
+        
+        // run all frames
+        ConsolePool Pool( NumberOfThreads );
+        cout << "Running " << NumberOfConsoles << " consoles on " << Pool.GetNumberOfThreads() << " threads" << endl;
+        
+        auto RunStart = chrono::steady_clock::now();
+        unsigned long ConsoleFrames = 0;
+        
+        for( int Frame = 0; Frame < NumberOfFrames && !RunningConsoles.empty(); Frame++ )
+        {
+            ConsoleFrames += RunningConsoles.size();
+            vector< ConsoleError > Errors = Pool.RunFrame( RunningConsoles );
+            
+            // failed consoles stop running, but the rest go on
+            for( ConsoleError& Error: Errors )
+            {
+                cout << "Console stopped at frame " << Frame << ": " << Error.Message << endl;
+                RunningConsoles.erase( find( RunningConsoles.begin(), RunningConsoles.end(), Error.Console ) );
+            }
+        }
+        
+        double RunTime = SecondsSince( RunStart );
+        
+        // memory is measured after running, since RAM
+        // and GPU pages are only committed when used
+        unsigned long MemoryAfterRun = GetResidentMemoryKB();
+        
+        cout << "Ran " << ConsoleFrames << " console frames in " << RunTime << " s ("
+             << ConsoleFrames / RunTime << " frames/s, "
+             << ConsoleFrames / RunTime / NumberOfConsoles << " fps per console)" << endl;
+        
+        if( MemoryAfterRun > 0 )
+        {
+            cout << "Memory for shared contents: " << (MemoryAfterLoad - MemoryBeforeLoad) / 1024 << " MB" << endl;
+            cout << "Memory per console: " << (MemoryAfterRun - MemoryAfterLoad) / 1024 / NumberOfConsoles << " MB" << endl;
+        }
+        
+        // fail if any console stopped
+        return (RunningConsoles.size() == Consoles.size())? 0 : 1;
+    }
+    
+    catch( const exception& e )
+    {
+        cout << "ERROR: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -10,24 +10,47 @@
 namespace V32
 {
     // =============================================================================
-    //      CALLBACKS FOR EXTERNAL FUNCTIONS
+    //      DEFAULT CALLBACKS FOR EXTERNAL FUNCTIONS
     // =============================================================================
     
     
-    namespace Callbacks
+    namespace DefaultCallbacks
     {
-        // callbacks to the video library
-        void( *ClearScreen )( V32::GPUColor ) = nullptr;
-        void( *DrawQuad )( V32::GPUQuad& ) = nullptr;
-        void( *SetMultiplyColor )( V32::GPUColor ) = nullptr;
-        void( *SetBlendingMode )( int ) = nullptr;
-        void( *SelectTexture )( int ) = nullptr;
-        void( *LoadTexture )( int, void* ) = nullptr;
-        void( *UnloadCartridgeTextures )() = nullptr;
-        void( *UnloadBiosTexture )() = nullptr;
+        // video functions have no effect
+        void ClearScreen( void* UserData, V32::GPUColor ClearColor ) {}
+        void DrawQuad( void* UserData, V32::GPUQuad& DrawnQuad ) {}
+        void SetMultiplyColor( void* UserData, V32::GPUColor NewMultiplyColor ) {}
+        void SetBlendingMode( void* UserData, int NewBlendingMode ) {}
+        void SelectTexture( void* UserData, int GPUTextureID ) {}
+        void LoadTexture( void* UserData, int GPUTextureID, void* Pixels ) {}
+        void UnloadCartridgeTextures( void* UserData ) {}
+        void UnloadBiosTexture( void* UserData ) {}
         
-        // callbacks to the log library
-        void( *LogLine )( const string& ) = nullptr;
-        void( *ThrowException )( const string& ) = nullptr;
+        // log lines are discarded
+        void LogLine( void* UserData, const string& Message ) {}
+        
+        // errors must always stop execution
+        void ThrowException( void* UserData, const string& Message )
+        {
+            throw runtime_error( Message );
+        }
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SetDefaultCallbacks( ConsoleCallbacks& Callbacks )
+    {
+        Callbacks.UserData = nullptr;
+        Callbacks.ClearScreen = DefaultCallbacks::ClearScreen;
+        Callbacks.DrawQuad = DefaultCallbacks::DrawQuad;
+        Callbacks.SetMultiplyColor = DefaultCallbacks::SetMultiplyColor;
+        Callbacks.SetBlendingMode = DefaultCallbacks::SetBlendingMode;
+        Callbacks.SelectTexture = DefaultCallbacks::SelectTexture;
+        Callbacks.LoadTexture = DefaultCallbacks::LoadTexture;
+        Callbacks.UnloadCartridgeTextures = DefaultCallbacks::UnloadCartridgeTextures;
+        Callbacks.UnloadBiosTexture = DefaultCallbacks::UnloadBiosTexture;
+        Callbacks.LogLine = DefaultCallbacks::LogLine;
+        Callbacks.ThrowException = DefaultCallbacks::ThrowException;
+        Callbacks.TraceEvent = nullptr;
     }
 }
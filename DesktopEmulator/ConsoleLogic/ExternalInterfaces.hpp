@@ -76,24 +76,45 @@ namespace V32
     // =============================================================================
     
     
-    // note that providing all these callbacks is required:
+    // each console has its own set of callbacks, so that
+    // several consoles can coexist in the same program;
     // the console will invoke them without any checks
-    namespace Callbacks
+    typedef struct
     {
+        // frontend data for this console: it is not used by
+        // the console, only passed as the first argument to
+        // every callback so each frontend can find its state
+        void* UserData;
+        
         // callbacks to the video library
-        extern void( *ClearScreen )( V32::GPUColor );
-        extern void( *DrawQuad )( V32::GPUQuad& );
-        extern void( *SetMultiplyColor )( V32::GPUColor );
-        extern void( *SetBlendingMode )( int );
-        extern void( *SelectTexture )( int );
-        extern void( *LoadTexture )( int, void* );
-        extern void( *UnloadCartridgeTextures )();
-        extern void( *UnloadBiosTexture )();
+        void( *ClearScreen )( void*, V32::GPUColor );
+        void( *DrawQuad )( void*, V32::GPUQuad& );
+        void( *SetMultiplyColor )( void*, V32::GPUColor );
+        void( *SetBlendingMode )( void*, int );
+        void( *SelectTexture )( void*, int );
+        void( *LoadTexture )( void*, int, void* );
+        void( *UnloadCartridgeTextures )( void* );
+        void( *UnloadBiosTexture )( void* );
         
         // callbacks to the log library
-        extern void( *LogLine )( const std::string& );
-        extern void( *ThrowException )( const std::string& );
+        void( *LogLine )( void*, const std::string& );
+        void( *ThrowException )( void*, const std::string& );
+        
+        // optional callback for event tracing: unlike the
+        // rest it can be null, and then events are skipped;
+        // names are static strings, and phases follow the
+        // Chrome trace format ('B' begin, 'E' end, 'i' instant)
+        void( *TraceEvent )( void*, const char*, char, int32_t );
     }
+    ConsoleCallbacks;
+    
+    // -----------------------------------------------------------------------------
+    
+    // consoles start with these defaults: video and log
+    // do nothing and exceptions are thrown as runtime
+    // errors, so a console can run without any frontend;
+    // user data is cleared, since no frontend is attached
+    void SetDefaultCallbacks( ConsoleCallbacks& Callbacks );
     
     
     // =============================================================================
@@ -61,6 +61,7 @@ namespace V32
     V32ControlBus::V32ControlBus()
     {
         Master = nullptr;
+        PortWrites = 0;
         
         for( int i = 0; i < Constants::ControlBusSlaves; i++ )
           Slaves[ i ] = nullptr;
@@ -89,6 +90,7 @@ namespace V32
         // separate device ID and local address
         int32_t DeviceID = (GlobalPort >> 8) & 7;
         int32_t LocalPort = GlobalPort & 0xFF;
+        PortWrites++;
         
         // attempt to write on port
         bool Success = Slaves[ DeviceID ]->WritePort( LocalPort, Value );
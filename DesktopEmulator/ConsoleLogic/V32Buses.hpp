@@ -79,6 +79,10 @@ namespace V32
             // connected slaves
             VirconControlInterface* Slaves[ Constants::ControlBusSlaves ];
             
+            // port writes in current frame
+            // (for performance monitoring only)
+            uint32_t PortWrites;
+            
         public:
             
             // instance handling
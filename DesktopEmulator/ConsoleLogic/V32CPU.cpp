@@ -121,6 +121,11 @@ namespace V32
     {
         MemoryBus = nullptr;
         ControlBus = nullptr;
+        Callbacks = nullptr;
+        
+        // not running any chunk
+        ChunkCycles = 0;
+        RemainingCycles = 0;
     }
     
     // -----------------------------------------------------------------------------
@@ -141,6 +146,10 @@ namespace V32
         Halted = false;
         Waiting = false;
         
+        // discard any unfinished chunk
+        ChunkCycles = 0;
+        RemainingCycles = 0;
+        
         // clear instruction registers
         memset( &Instruction, 0, sizeof(V32Word) );
         ImmediateValue.AsBinary = 0;
@@ -176,6 +185,58 @@ namespace V32
     
     // -----------------------------------------------------------------------------
     
+    // runs up to the given number of cycles, and returns
+    // how many were actually run: this is fewer only when
+    // an instruction ended the chunk (a hardware error
+    // will instead leave the chunk for FinishChunk)
+    int32_t V32CPU::RunCycles( int32_t MaxCycles )
+    {
+        ChunkCycles = MaxCycles;
+        RemainingCycles = MaxCycles;
+        
+        // each instruction takes 1 cycle, and it
+        // is counted before it starts running
+        while( RemainingCycles > 0 )
+        {
+            RemainingCycles--;
+            RunNextCycle();
+        }
+        
+        return FinishChunk();
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // cycles run so far in the current chunk, including
+    // the instruction being run (0 outside of chunks)
+    int32_t V32CPU::GetElapsedCycles()
+    {
+        return ChunkCycles - RemainingCycles;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    int32_t V32CPU::FinishChunk()
+    {
+        int32_t ElapsedCycles = GetElapsedCycles();
+        ChunkCycles = 0;
+        RemainingCycles = 0;
+        
+        return ElapsedCycles;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // makes the current instruction the last one in the
+    // chunk, while keeping the count of elapsed cycles
+    void V32CPU::EndChunk()
+    {
+        ChunkCycles -= RemainingCycles;
+        RemainingCycles = 0;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
     void V32CPU::RaiseHardwareError( CPUErrorCodes Code )
     {
         // use registers to pass values
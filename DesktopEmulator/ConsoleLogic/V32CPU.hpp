@@ -8,6 +8,7 @@
     
     // include console logic headers
     #include "V32Buses.hpp"
+    #include "ExternalInterfaces.hpp"
 // *****************************************************************************
 
 
@@ -40,11 +41,20 @@ namespace V32
             int32_t Halted;
             int32_t Waiting;
             
+        public:
+            
+            // cycle budget for the chunk being run: the
+            // loop only checks the remaining cycles, and
+            // instructions that stop the CPU end the chunk
+            int32_t ChunkCycles;
+            int32_t RemainingCycles;
+            
         public:
             
             // connections with the host Vircon system
             V32MemoryBus* MemoryBus;
             V32ControlBus* ControlBus;
+            ConsoleCallbacks* Callbacks;
             
         public:
             
@@ -56,11 +66,38 @@ namespace V32
             void ChangeFrame();
             void RunNextCycle();
             
+            // execution in chunks of cycles
+            int32_t RunCycles( int32_t MaxCycles );
+            int32_t GetElapsedCycles();
+            int32_t FinishChunk();
+            void EndChunk();
+            
             // error handler
             void RaiseHardwareError( CPUErrorCodes Code );
     };
     
     
+    // =============================================================================
+    //      CPU EXECUTION ENGINES
+    // =============================================================================
+    
+    
+    // Consoles run their CPU with RunCycles, unless they are
+    // given another engine (a faster one, or a wrapper that
+    // checks execution). Engines must work exactly like
+    // RunCycles: keep ChunkCycles and RemainingCycles up to
+    // date while running, so that the timer and EndChunk
+    // work, and leave the chunk open for FinishChunk when
+    // an instruction raises a hardware error
+    class V32CPUEngine
+    {
+        public:
+            
+            virtual ~V32CPUEngine() {}
+            virtual int32_t RunCycles( V32CPU& CPU, int32_t MaxCycles ) = 0;
+    };
+    
+    
     // =============================================================================
     //      SPECIFIC INSTRUCTION PROCESSORS
     // =============================================================================
@@ -63,7 +63,8 @@ namespace V32
     void ProcessHLT( V32CPU& CPU, CPUInstruction Instruction )
     {
         CPU.Halted = true;
-        Callbacks::LogLine( "CPU halted" );
+        CPU.EndChunk();
+        CPU.Callbacks->LogLine( CPU.Callbacks->UserData, "CPU halted" );
     }
     
     // -----------------------------------------------------------------------------
@@ -71,6 +72,10 @@ namespace V32
     void ProcessWAIT( V32CPU& CPU, CPUInstruction Instruction )
     {
         CPU.Waiting = true;
+        CPU.EndChunk();
+        
+        if( CPU.Callbacks->TraceEvent )
+          CPU.Callbacks->TraceEvent( CPU.Callbacks->UserData, "WAIT", 'i', 0 );
     }
     
     // -----------------------------------------------------------------------------
@@ -10,11 +10,20 @@
     
     // include C/C++ headers
     #include <cstring>          // [ ANSI C ] Strings
+    #include <chrono>           // [ C++ STL ] Time measurement
+    
+    #include <cstdio>           // [ ANSI C ] Standard I/O
+    #include <fstream>          // [ C++ STL ] File streams
     
     // these are only needed to treat UTF-16 file paths
     #if defined(__WIN32__)
       #include <locale>         // [ C++ STL ] Locales
       #include <codecvt>        // [ C++ STL ] Encoding conversions
+      
+      // needed to replace files in a single step
+      #define WIN32_LEAN_AND_MEAN
+      #define NOMINMAX
+      #include <windows.h>      // [ WINDOWS ] Main header
     #endif
     
     // declare used namespaces
@@ -24,8 +33,24 @@
 
 namespace V32
 {
-    // buffer used to transmit textures from loaded ROM files to the video library
-    static GPUColor LoadedTexture[ Constants::GPUTextureSize ][ Constants::GPUTextureSize ];
+    // =============================================================================
+    //      AUXILIARY FUNCTIONS FOR ROM CONTENTS
+    // =============================================================================
+    
+    
+    // the video library always receives textures at full
+    // size; the buffer is given by the caller so that it
+    // can be reused and each console can use its own one
+    static void SendTextureToVideo( ConsoleCallbacks& Callbacks, int GPUTextureID, const ROMTexture& Texture, vector< GPUColor >& Buffer )
+    {
+        Buffer.assign( Constants::GPUTextureSize * Constants::GPUTextureSize, GPUColor{ 0, 0, 0, 0 } );
+        
+        // expand the texture line by line
+        for( unsigned y = 0; y < Texture.Height; y++ )
+          memcpy( &Buffer[ y * Constants::GPUTextureSize ], &Texture.Pixels[ y * Texture.Width ], Texture.Width * 4 );
+        
+        Callbacks.LoadTexture( Callbacks.UserData, GPUTextureID, &Buffer[ 0 ] );
+    }
     
     
     // =============================================================================
@@ -59,15 +84,30 @@ namespace V32
         ControlBus.Slaves[ 6 ] = &MemoryCardController;
         ControlBus.Slaves[ 7 ] = &NullController;
         
+        // the timer counts cycles run by the CPU
+        Timer.CPU = &CPU;
+        
         // connect main RAM
         RAM.Connect( Constants::RAMSize );
         
+        // connect components to external functions
+        SetDefaultCallbacks( Callbacks );
+        CPU.Callbacks = &Callbacks;
+        GPU.Callbacks = &Callbacks;
+        SPU.Callbacks = &Callbacks;
+        
         // set initial state
         PowerIsOn = false;
         
+        // by default the CPU runs itself, as
+        // many cycles as possible each time
+        CPUEngine = nullptr;
+        MaxChunkCycles = 0;
+        
         // initial loads are 0
         LastCPULoads[ 0 ] = LastCPULoads[ 1 ] = 0;
         LastGPULoads[ 0 ] = LastGPULoads[ 1 ] = 0;
+        memset( &LastFrameCounters, 0, sizeof(LastFrameCounters) );
         
         // do NOT reset until power on
     }
@@ -98,15 +138,19 @@ namespace V32
         // to take care of initializations
         if( On )
         {
-            Callbacks::LogLine( "Console power ON" );
+            Callbacks.LogLine( Callbacks.UserData, "Console power ON" );
             Reset();
         }
         
         // at power off, stop all sound
         else
         {
-            Callbacks::LogLine( "Console power OFF" );
+            Callbacks.LogLine( Callbacks.UserData, "Console power OFF" );
             SPU.StopAllChannels();
+            
+            // do not leave a delayed save pending
+            if( MemoryCardController.PendingSave )
+              SaveMemoryCard();
         }
     }
     
@@ -114,7 +158,7 @@ namespace V32
     
     void V32Console::Reset()
     {
-        Callbacks::LogLine( "Console reset" );
+        Callbacks.LogLine( Callbacks.UserData, "Console reset" );
         
         // first: transmit the message to all components that need it
         Timer.Reset();
@@ -130,6 +174,25 @@ namespace V32
         // loads become 0 on a reset
         LastCPULoads[ 0 ] = LastCPULoads[ 1 ] = 0;
         LastGPULoads[ 0 ] = LastGPULoads[ 1 ] = 0;
+        memset( &LastFrameCounters, 0, sizeof(LastFrameCounters) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // only the frame end is scheduled for now: waiting and
+    // halting are found by the CPU itself, which ends its
+    // chunk; future events (like timed interrupts) would
+    // shorten the chunk to end exactly where they happen
+    int32_t V32Console::GetCyclesToNextEvent()
+    {
+        int32_t Cycles = Constants::CyclesPerFrame - Timer.CycleCounter;
+        
+        // chunks may also be limited from outside
+        // (for instance, to check execution often)
+        if( MaxChunkCycles > 0 )
+          Cycles = min( Cycles, MaxChunkCycles );
+        
+        return Cycles;
     }
     
     // -----------------------------------------------------------------------------
@@ -140,35 +203,65 @@ namespace V32
         if( !PowerIsOn )
           return;
         
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "Console frame", 'B', 0 );
+        
         // STEP 1: Begin a new frame by sending
         // a frame change message to components
         Timer.ChangeFrame();
         CPU.ChangeFrame();
         GPU.ChangeFrame();
-        SPU.ChangeFrame();
         GamepadController.ChangeFrame();
+        ControlBus.PortWrites = 0;
+        
+        // sound generation is timed separately,
+        // since it is independent from the CPU
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "SPU mix", 'B', 0 );
+        
+        auto SPUStart = chrono::steady_clock::now();
+        SPU.ChangeFrame();
+        chrono::duration< double > SPUMixTime = chrono::steady_clock::now() - SPUStart;
+        
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "SPU mix", 'E', 0 );
         
         // STEP 2: Run a frame's worth of cycles
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "CPU run", 'B', 0 );
+        
         try
         {
-            for( int i = 0; i < Constants::CyclesPerFrame; i++ )
+            // the CPU runs in chunks, each one up to the next
+            // scheduled event; the timer is then updated with
+            // the cycles actually run. Port accesses already take
+            // effect as soon as they run, so only the timer
+            // needs this to stay exact within the frame
+            while( Timer.CycleCounter < Constants::CyclesPerFrame )
             {
-                // end loop early when CPU is set to wait
+                // end frame early when CPU is set to wait
                 if( CPU.Waiting || CPU.Halted )
                   break;
                 
-                // only these components need to
-                // be notified of each CPU cycle
-                Timer.RunNextCycle();
-                CPU.RunNextCycle();
+                int32_t ChunkSize = GetCyclesToNextEvent();
+                
+                if( CPUEngine )
+                  Timer.AdvanceCycles( CPUEngine->RunCycles( CPU, ChunkSize ) );
+                else
+                  Timer.AdvanceCycles( CPU.RunCycles( ChunkSize ) );
             }
         }
         catch( CPUException& CPUex )
         {
-            // do nothing: the only purpose of these exceptions
-            // is to stop the loop without checking in every step
+            // hardware errors stop the frame: the CPU will
+            // continue in the BIOS handler on the next frame;
+            // the failed instruction still counts as run
+            Timer.AdvanceCycles( CPU.FinishChunk() );
         }
         
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "CPU run", 'E', Timer.CycleCounter );
+        
         // after runnning the frame, update load info
         LastCPULoads[ 1 ] = LastCPULoads[ 0 ];
         LastCPULoads[ 0 ] = 100.0 * Timer.CycleCounter / Constants::CyclesPerFrame;
@@ -177,9 +270,29 @@ namespace V32
         LastGPULoads[ 1 ] = LastGPULoads[ 0 ];
         LastGPULoads[ 0 ] = 100.0 * GPUUsedPixels / Constants::GPUPixelCapacityPerFrame;
         
-        // STEP 3: save memory card to file when modified
+        // also keep detailed activity counts
+        LastFrameCounters.CPUCycles        = Timer.CycleCounter;
+        LastFrameCounters.PortWrites       = ControlBus.PortWrites;
+        LastFrameCounters.ClearCommands    = GPU.ClearCommands;
+        LastFrameCounters.DrawCommands     = GPU.DrawCommands;
+        LastFrameCounters.TextureSwitches  = GPU.TextureSwitches;
+        LastFrameCounters.RejectedCommands = GPU.RejectedCommands;
+        LastFrameCounters.RejectedPixels   = GPU.RejectedPixels;
+        LastFrameCounters.SPUMixTime       = SPUMixTime.count();
+        
+        // STEP 3: save memory card to file when modified; the
+        // save is delayed so that games writing on every frame
+        // do not cause a disk write on every frame
         if( MemoryCardController.PendingSave )
-          SaveMemoryCard();
+        {
+            MemoryCardController.PendingFrames++;
+            
+            if( MemoryCardController.PendingFrames >= MEM_SaveDelayFrames )
+              SaveMemoryCard();
+        }
+        
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "Console frame", 'E', 0 );
     }
     
     
@@ -220,6 +333,14 @@ namespace V32
         return max( LastGPULoads[ 0 ], LastGPULoads[ 1 ] );
     }
     
+    // -----------------------------------------------------------------------------
+    
+    // unlike loads, these are given only for the last frame
+    void V32Console::GetFrameCounters( ConsoleFrameCounters& Counters )
+    {
+        Counters = LastFrameCounters;
+    }
+    
     
     // =============================================================================
     //      V32 CONSOLE: BIOS MANAGEMENT
@@ -228,193 +349,39 @@ namespace V32
     
     void V32Console::LoadBios( const std::string& FilePath )
     {
-        Callbacks::LogLine( "Loading bios" );
-        Callbacks::LogLine( "File path: \"" + FilePath + "\"" );
+        Callbacks.LogLine( Callbacks.UserData, "Loading bios" );
+        Callbacks.LogLine( Callbacks.UserData, "File path: \"" + FilePath + "\"" );
         
+        // this console will be the only one using them
+        LoadBios( LoadBiosContents( FilePath, Callbacks ) );
+        Callbacks.LogLine( Callbacks.UserData, "Finished loading BIOS" );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // contents are not copied, so any number of
+    // consoles can be connected to the same ones
+    void V32Console::LoadBios( shared_ptr< const ROMContents > Contents )
+    {
         // unload any previous bios
         UnloadBios();
+        BiosContents = Contents;
         
-        // open bios file
-        ifstream InputFile;
-        
-        // on windows convert path from UTF-8 to UTF-16
-        #if defined(__WIN32__)
-          wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
-          wstring FilePathUTF16 = converter.from_bytes(FilePath);
-          InputFile.open( FilePathUTF16.c_str(), ios_base::binary | ios_base::ate );
-        #else
-          InputFile.open( FilePath, ios_base::binary | ios_base::ate );
-        #endif
-        
-        if( InputFile.fail() )
-          Callbacks::ThrowException( "Cannot open BIOS file" );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 1: Load global information
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // get size and ensure it is a multiple of 4
-        // (otherwise file contents are wrong)
-        unsigned FileBytes = InputFile.tellg();
-        
-        if( (FileBytes % 4) != 0 )
-          Callbacks::ThrowException( "Incorrect V32 file format (file size must be a multiple of 4)" );
-        
-        // ensure that we can at least load the file header
-        if( FileBytes < sizeof(ROMFileFormat::Header) )
-          Callbacks::ThrowException( "Incorrect V32 file format (file is too small)" );
-        
-        // now we can safely read the global header
-        InputFile.seekg( 0, ios_base::beg );
-        ROMFileFormat::Header ROMHeader;
-        InputFile.read( (char*)(&ROMHeader), sizeof(ROMFileFormat::Header) );
-        
-        // check if the ROM is actually a cartridge
-        if( CheckSignature( ROMHeader.Signature, ROMFileFormat::CartridgeSignature ) )
-          Callbacks::ThrowException( "Input V32 ROM cannot be loaded as a BIOS (is it a cartridge instead)" );
-        
-        // now check the actual BIOS signature
-        if( !CheckSignature( ROMHeader.Signature, ROMFileFormat::BiosSignature ) )
-          Callbacks::ThrowException( "Incorrect V32 file format (file does not have a valid signature)" );
-        
-        // check current Vircon version
-        if( ROMHeader.VirconVersion  > (unsigned)Constants::VirconVersion
-        ||  ROMHeader.VirconRevision > (unsigned)Constants::VirconRevision )
-          Callbacks::ThrowException( "This BIOS was made for a more recent version of Vircon32. Please use an updated emulator" );
-        
-        // report the title
-        ROMHeader.Title[ 63 ] = 0;
-        Callbacks::LogLine( string("BIOS title: \"") + ROMHeader.Title + "\"" );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 2: Check the declared rom contents
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // ensure that there is exactly 1 texture
-        if( ROMHeader.NumberOfTextures != 1 )
-          Callbacks::ThrowException( "A BIOS video rom should have exactly 1 texture" );
-        
-        // ensure that there is exactly 1 sound
-        if( ROMHeader.NumberOfSounds != 1 )
-          Callbacks::ThrowException( "A BIOS audio rom should have exactly 1 sound" );
-        
-        // check for correct program rom location
-        if( ROMHeader.ProgramROMLocation.StartOffset != sizeof(ROMFileFormat::Header) )
-          Callbacks::ThrowException( "Incorrect V32 file format (program ROM is not located after file header)" );
-        
-        // check for correct video rom location
-        uint32_t SizeAfterProgramROM = ROMHeader.ProgramROMLocation.StartOffset + ROMHeader.ProgramROMLocation.Length;
-        
-        if( ROMHeader.VideoROMLocation.StartOffset != SizeAfterProgramROM )
-          Callbacks::ThrowException( "Incorrect V32 file format (video ROM is not located after program ROM)" );
-        
-        // check for correct audio rom location
-        uint32_t SizeAfterVideoROM = ROMHeader.VideoROMLocation.StartOffset + ROMHeader.VideoROMLocation.Length;
-        
-        if( ROMHeader.AudioROMLocation.StartOffset != SizeAfterVideoROM )
-          Callbacks::ThrowException( "Incorrect V32 file format (audio ROM is not located after video ROM)" );
-        
-        // check for correct file size
-        uint32_t SizeAfterAudioROM = ROMHeader.AudioROMLocation.StartOffset + ROMHeader.AudioROMLocation.Length;
-        
-        if( FileBytes != SizeAfterAudioROM )
-          Callbacks::ThrowException( "Incorrect V32 file format (file size does not match indicated ROM contents)" );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 3: Load program rom
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // load a binary file header
-        BinaryFileFormat::Header BinaryHeader;
-        InputFile.read( (char*)(&BinaryHeader), sizeof(BinaryFileFormat::Header) );
-        
-        // check signature for embedded binary
-        if( !CheckSignature( BinaryHeader.Signature, BinaryFileFormat::Signature ) )
-          Callbacks::ThrowException( "BIOS binary does not have a valid signature" );
-        
-        // checking program rom size limitations
-        if( !IsBetween( BinaryHeader.NumberOfWords, 1, Constants::MaximumBiosProgramROM ) )
-          Callbacks::ThrowException( "BIOS binary does not have a correct size (from 1 word up to 1M words)" );
-        
-        // load the binary contents
-        vector< V32Word > LoadedBinary;
-        LoadedBinary.resize( BinaryHeader.NumberOfWords );
-        InputFile.read( (char*)(&LoadedBinary[ 0 ]), BinaryHeader.NumberOfWords * 4 );
-        BiosProgramROM.Connect( &LoadedBinary[ 0 ], BinaryHeader.NumberOfWords );
-        
-        // discard the temporary buffer
-        LoadedBinary.clear();
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 4: Load video rom
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // load a texture file signature
-        TextureFileFormat::Header TextureHeader;
-        InputFile.read( (char*)(&TextureHeader), sizeof(TextureFileFormat::Header) );
-        
-        // check signature for embedded texture
-        if( !CheckSignature( TextureHeader.Signature, TextureFileFormat::Signature ) )
-          Callbacks::ThrowException( "BIOS texture does not have a valid signature" );
-        
-        // report texture size
-        Callbacks::LogLine( "BIOS texture is " + to_string( TextureHeader.TextureWidth )
-           + "x" + to_string( TextureHeader.TextureHeight ) );
-        
-        // check texture size limitations
-        if( !IsBetween( TextureHeader.TextureWidth , 1, Constants::GPUTextureSize )
-        ||  !IsBetween( TextureHeader.TextureHeight, 1, Constants::GPUTextureSize ) )
-          Callbacks::ThrowException( "BIOS texture does not have correct dimensions (from 1x1 up to 1024x1024 pixels)" );
-        
-        // clear all texture pixels
-        memset( LoadedTexture, 0, sizeof(LoadedTexture) );
-        
-        // load the texture pixels line by line,
-        // in order to expand it to full size
-        for( unsigned y = 0; y < TextureHeader.TextureHeight; y++ )
-          InputFile.read( (char*)(LoadedTexture[ y ]), TextureHeader.TextureWidth * 4 );
+        // connect program ROM
+        BiosProgramROM.Connect( &Contents->ProgramROM[ 0 ], Contents->ProgramROM.size() );
         
         // send bios texture to the video library
-        Callbacks::LoadTexture( -1, LoadedTexture );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 5: Load audio rom
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // load a sound file signature
-        SoundFileFormat::Header SoundHeader;
-        InputFile.read( (char*)(&SoundHeader), sizeof(SoundFileFormat::Header) );
-        
-        // check signature for embedded sound
-        if( !CheckSignature( SoundHeader.Signature, SoundFileFormat::Signature ) )
-          Callbacks::ThrowException( "BIOS sound does not have a valid signature" );
-        
-        // report sound length
-        Callbacks::LogLine( "BIOS sound is " + to_string( SoundHeader.SoundSamples ) + " samples" );
-        
-        // check sound length limitations
-        if( !IsBetween( SoundHeader.SoundSamples, 1, Constants::SPUMaximumBiosSamples ) )
-          Callbacks::ThrowException( "BIOS sound does not have a correct length (from 1 up to 1M samples)" );
-        
-        // load the sound samples
-        vector< SPUSample > LoadedSound;
-        LoadedSound.resize( SoundHeader.SoundSamples );
-        InputFile.read( (char*)(&LoadedSound[ 0 ]), SoundHeader.SoundSamples * 4 );
-        SPU.LoadSound( SPU.BiosSound, &LoadedSound[ 0 ], SoundHeader.SoundSamples );
+        vector< GPUColor > TextureBuffer;
+        SendTextureToVideo( Callbacks, -1, Contents->Textures[ 0 ], TextureBuffer );
         
-        // discard the temporary buffer
-        LoadedSound.clear();
+        // the bios sound refers to the loaded samples
+        SPU.LoadSound( SPU.BiosSound, &Contents->Samples[ 0 ], Contents->SoundLengths[ 0 ] );
         
-        // only when loading was successful:
         // copy BIOS metadata
-        BiosFileName = GetPathFileName( FilePath );
-        BiosTitle = ROMHeader.Title;
-        BiosVersion = ROMHeader.ROMVersion;
-        BiosRevision = ROMHeader.ROMRevision;
-        
-        // close the file and report success
-        InputFile.close();
-        Callbacks::LogLine( "Finished loading BIOS" );
+        BiosFileName = Contents->FileName;
+        BiosTitle = Contents->Title;
+        BiosVersion = Contents->Version;
+        BiosRevision = Contents->Revision;
     }
     
     // -----------------------------------------------------------------------------
@@ -423,7 +390,7 @@ namespace V32
     {
         // do nothing if a bios is not loaded
         if( !HasBios() ) return;
-        Callbacks::LogLine( "Unloading bios" );
+        Callbacks.LogLine( Callbacks.UserData, "Unloading bios" );
         
         // release bios program ROM
         BiosProgramROM.Disconnect();
@@ -433,10 +400,14 @@ namespace V32
         BiosRevision = 0;
         
         // release the bios texture
-        Callbacks::UnloadBiosTexture();
+        Callbacks.UnloadBiosTexture( Callbacks.UserData );
         
         // tell SPU to release the bios sounds
         SPU.UnloadSound( SPU.BiosSound );
+        
+        // contents are released when no
+        // other console is still using them
+        BiosContents.reset();
     }
     
     // -----------------------------------------------------------------------------
@@ -454,240 +425,59 @@ namespace V32
     
     void V32Console::LoadCartridge( const std::string& FilePath )
     {
-        Callbacks::LogLine( "Loading cartridge" );
-        Callbacks::LogLine( "File path: \"" + FilePath + "\"" );
+        Callbacks.LogLine( Callbacks.UserData, "Loading cartridge" );
+        Callbacks.LogLine( Callbacks.UserData, "File path: \"" + FilePath + "\"" );
+        
+        // this console will be the only one using them
+        LoadCartridge( LoadCartridgeContents( FilePath, Callbacks ) );
+        Callbacks.LogLine( Callbacks.UserData, "Finished loading cartridge" );
+    }
+    
+    // -----------------------------------------------------------------------------
     
+    // contents are not copied, so any number of
+    // consoles can be connected to the same ones
+    void V32Console::LoadCartridge( shared_ptr< const ROMContents > Contents )
+    {
         // unload any previous cartridge
         UnloadCartridge();
+        CartridgeContents = Contents;
         
-        // open cartridge file
-        ifstream InputFile;
-        
-        // on windows convert path from UTF-8 to UTF-16
-        #if defined(__WIN32__)
-          wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
-          wstring FilePathUTF16 = converter.from_bytes(FilePath);
-          InputFile.open( FilePathUTF16.c_str(), ios_base::binary | ios_base::ate );
-        #else
-          InputFile.open( FilePath, ios_base::binary | ios_base::ate );
-        #endif
-        
-        if( InputFile.fail() )
-          Callbacks::ThrowException( "Cannot open cartridge file" );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 1: Load global information
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // get size and ensure it is a multiple of 4
-        // (otherwise file contents are wrong)
-        unsigned FileBytes = InputFile.tellg();
-        
-        if( (FileBytes % 4) != 0 )
-          Callbacks::ThrowException( "Incorrect V32 file format (file size must be a multiple of 4)" );
-        
-        // ensure that we can at least load the file header
-        if( FileBytes < sizeof(ROMFileFormat::Header) )
-          Callbacks::ThrowException( "Incorrect V32 file format (file is too small)" );
-        
-        // now we can safely read the global header
-        InputFile.seekg( 0, ios_base::beg );
-        ROMFileFormat::Header ROMHeader;
-        InputFile.read( (char*)(&ROMHeader), sizeof(ROMFileFormat::Header) );
-        
-        // check if the ROM is actually a BIOS
-        if( CheckSignature( ROMHeader.Signature, ROMFileFormat::BiosSignature ) )
-          Callbacks::ThrowException( "Input V32 ROM cannot be loaded as a cartridge (is it a BIOS instead)" );
-        
-        // now check the actual cartridge signature
-        if( !CheckSignature( ROMHeader.Signature, ROMFileFormat::CartridgeSignature ) )
-          Callbacks::ThrowException( "Incorrect V32 file format (file does not have a valid signature)" );
-        
-        // check current Vircon version
-        if( ROMHeader.VirconVersion  > (unsigned)Constants::VirconVersion
-        ||  ROMHeader.VirconRevision > (unsigned)Constants::VirconRevision )
-          Callbacks::ThrowException( "This cartridge was made for a more recent version of Vircon32. Please use an updated emulator" );
-        
-        // report the title
-        ROMHeader.Title[ 63 ] = 0;
-        Callbacks::LogLine( string("Cartridge title: \"") + ROMHeader.Title + "\"" );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 2: Check the declared rom contents
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        // check that there are not too many textures
-        Callbacks::LogLine( "Video ROM contains " + to_string( ROMHeader.NumberOfTextures ) + " textures" );
-        
-        if( ROMHeader.NumberOfTextures > (uint32_t)Constants::GPUMaximumCartridgeTextures )
-          Callbacks::ThrowException( "Video ROM contains too many textures (Vircon GPU only allows up to 256)" );
-        
-        // check that there are not too many sounds
-        Callbacks::LogLine( "Audio ROM contains " + to_string( ROMHeader.NumberOfSounds ) + " sounds" );
-        
-        if( ROMHeader.NumberOfSounds > (uint32_t)Constants::SPUMaximumCartridgeSounds )
-          Callbacks::ThrowException( "Audio ROM contains too many sounds (Vircon SPU only allows up to 1024)" );
-        
-        // check for correct program rom location
-        if( ROMHeader.ProgramROMLocation.StartOffset != sizeof(ROMFileFormat::Header) )
-          Callbacks::ThrowException( "Incorrect V32 file format (program ROM is not located after file header)" );
-        
-        // check for correct video rom location
-        uint32_t SizeAfterProgramROM = ROMHeader.ProgramROMLocation.StartOffset + ROMHeader.ProgramROMLocation.Length;
-        
-        if( ROMHeader.VideoROMLocation.StartOffset != SizeAfterProgramROM )
-          Callbacks::ThrowException( "Incorrect V32 file format (video ROM is not located after program ROM)" );
-        
-        // check for correct audio rom location
-        uint32_t SizeAfterVideoROM = ROMHeader.VideoROMLocation.StartOffset + ROMHeader.VideoROMLocation.Length;
-        
-        if( ROMHeader.AudioROMLocation.StartOffset != SizeAfterVideoROM )
-          Callbacks::ThrowException( "Incorrect V32 file format (audio ROM is not located after video ROM)" );
-        
-        // check for correct file size
-        uint32_t SizeAfterAudioROM = ROMHeader.AudioROMLocation.StartOffset + ROMHeader.AudioROMLocation.Length;
-        
-        if( FileBytes != SizeAfterAudioROM )
-          Callbacks::ThrowException( "Incorrect V32 file format (file size does not match indicated ROM contents)" );
+        // connect program ROM
+        CartridgeController.Connect( &Contents->ProgramROM[ 0 ], Contents->ProgramROM.size() );
         
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 3: Load program rom
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // send all textures to the video library,
+        // and then update GPU with the inserted textures
+        unsigned NumberOfTextures = Contents->Textures.size();
+        vector< GPUColor > TextureBuffer;
         
-        Callbacks::LogLine( "Loading cartridge program ROM" );
+        for( unsigned i = 0; i < NumberOfTextures; i++ )
+          SendTextureToVideo( Callbacks, i, Contents->Textures[ i ], TextureBuffer );
         
-        // load a binary file signature
-        BinaryFileFormat::Header BinaryHeader;
-        InputFile.read( (char*)(&BinaryHeader), sizeof(BinaryFileFormat::Header) );
+        GPU.InsertCartridgeTextures( NumberOfTextures );
         
-        // check signature for embedded binary
-        if( !CheckSignature( BinaryHeader.Signature, BinaryFileFormat::Signature ) )
-          Callbacks::ThrowException( "Cartridge binary does not have a valid signature" );
+        // create SPU sounds referring to the loaded samples,
+        // which are placed consecutively for all sounds
+        unsigned NumberOfSounds = Contents->SoundLengths.size();
+        uint32_t FirstSample = 0;
         
-        Callbacks::LogLine( "-> Program ROM is " + to_string( BinaryHeader.NumberOfWords ) + " words" );
-        
-        // check program rom size limitations
-        if( !IsBetween( BinaryHeader.NumberOfWords, 1, Constants::MaximumCartridgeProgramROM ) )
-          Callbacks::ThrowException( "Cartridge program ROM does not have a correct size (from 1 word up to 128M words)" );
-        
-        // load the binary contents
-        vector< V32Word > LoadedBinary;
-        LoadedBinary.resize( BinaryHeader.NumberOfWords );
-        InputFile.read( (char*)(&LoadedBinary[ 0 ]), BinaryHeader.NumberOfWords * 4 );
-        CartridgeController.Connect( &LoadedBinary[ 0 ], BinaryHeader.NumberOfWords );
-        
-        // discard the temporary buffer
-        LoadedBinary.clear();
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 4: Load video rom
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        Callbacks::LogLine( "Loading cartridge video ROM" );
-        
-        // load all textures in sequence
-        for( unsigned i = 0; i < ROMHeader.NumberOfTextures; i++ )
-        {
-            // load a texture file signature
-            TextureFileFormat::Header TextureHeader;
-            InputFile.read( (char*)(&TextureHeader), sizeof(TextureFileFormat::Header) );
-            
-            // check signature for embedded texture
-            if( !CheckSignature( TextureHeader.Signature, TextureFileFormat::Signature ) )
-              Callbacks::ThrowException( "Cartridge texture does not have a valid signature" );
-            
-            // report texture size
-            Callbacks::LogLine( "-> Texture " + to_string( i ) + ": " + to_string( TextureHeader.TextureWidth )
-               + " x " + to_string( TextureHeader.TextureHeight ) + " pixels" );
-            
-            // check texture size limitations
-            if( !IsBetween( TextureHeader.TextureWidth , 1, Constants::GPUTextureSize )
-            ||  !IsBetween( TextureHeader.TextureHeight, 1, Constants::GPUTextureSize ) )
-              Callbacks::ThrowException( "Cartridge texture does not have correct dimensions (1x1 up to 1024x1024 pixels)" );
-            
-            // clear all texture pixels
-            memset( LoadedTexture, 0, sizeof(LoadedTexture) );
-            
-            // load the texture pixels line by line,
-            // in order to expand it to full size
-            for( unsigned y = 0; y < TextureHeader.TextureHeight; y++ )
-              InputFile.read( (char*)(LoadedTexture[ y ]), TextureHeader.TextureWidth * 4 );
-            
-            // send this texture to the video library
-            Callbacks::LoadTexture( i, LoadedTexture );
-        }
-        
-        // now update GPU with the inserted textures
-        GPU.InsertCartridgeTextures( ROMHeader.NumberOfTextures );
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 5: Load audio rom
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        
-        Callbacks::LogLine( "Loading cartridge audio ROM" );
-        
-        // keep count of the total sound samples
-        uint32_t TotalSPUSamples = 0;
-        
-        // load all sounds in sequence
-        for( unsigned i = 0; i < ROMHeader.NumberOfSounds; i++ )
+        for( unsigned i = 0; i < NumberOfSounds; i++ )
         {
-            // load a sound file signature
-            SoundFileFormat::Header SoundHeader;
-            InputFile.read( (char*)(&SoundHeader), sizeof(SoundFileFormat::Header) );
-            
-            // check signature for embedded sound
-            if( !CheckSignature( SoundHeader.Signature, SoundFileFormat::Signature ) )
-              Callbacks::ThrowException( "Cartridge sound does not have a valid signature" );
-            
-            // report sound length
-            Callbacks::LogLine( "-> Sound " + to_string( i ) + ": " + to_string( SoundHeader.SoundSamples )
-               + " samples (" + to_string( SoundHeader.SoundSamples/44100.0f ) + " seconds)" );
-            
-            // check length limitations for this sound
-            if( !IsBetween( SoundHeader.SoundSamples, 1, Constants::SPUMaximumCartridgeSamples ) )
-              Callbacks::ThrowException( "Cartridge sound does not have correct length (1 up to 256M samples)" );
-            
-            // check length limitations for the whole SPU
-            TotalSPUSamples += SoundHeader.SoundSamples;
-            
-            if( TotalSPUSamples > (uint32_t)Constants::SPUMaximumCartridgeSamples )
-              Callbacks::ThrowException( "Cartridge sounds contain too many total samples (Vircon SPU only allows up to 256M total samples)" );
-            
-            // load the sound samples
-            vector< SPUSample > LoadedSound;
-            LoadedSound.resize( SoundHeader.SoundSamples );
-            InputFile.read( (char*)(&LoadedSound[ 0 ]), SoundHeader.SoundSamples * 4 );
-            
-            // create a new SPU sound and load data into it
-            SPU.LoadSound( SPU.CartridgeSounds[ i ], &LoadedSound[ 0 ], SoundHeader.SoundSamples );
-            
-            // discard the temporary buffer
-            LoadedSound.clear();
+            SPU.LoadSound( SPU.CartridgeSounds[ i ], &Contents->Samples[ FirstSample ], Contents->SoundLengths[ i ] );
+            FirstSample += Contents->SoundLengths[ i ];
         }
         
-        SPU.LoadedCartridgeSounds = ROMHeader.NumberOfSounds;
-        
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STEP 5: General Vircon setup
-        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        SPU.LoadedCartridgeSounds = NumberOfSounds;
         
-        // only when loading was successful:
         // copy cartridge contents information
-        CartridgeController.NumberOfTextures = ROMHeader.NumberOfTextures;
-        CartridgeController.NumberOfSounds = ROMHeader.NumberOfSounds;
+        CartridgeController.NumberOfTextures = NumberOfTextures;
+        CartridgeController.NumberOfSounds = NumberOfSounds;
         
         // copy cartridge metadata
-        CartridgeController.CartridgeTitle = ROMHeader.Title;
-        CartridgeController.CartridgeVersion = ROMHeader.ROMVersion;
-        CartridgeController.CartridgeRevision = ROMHeader.ROMRevision;
-        
-        // finally, close input file
-        InputFile.close();
-        
-        // save the file name
-        CartridgeController.CartridgeFileName = GetPathFileName( FilePath );
-        Callbacks::LogLine( "Finished loading cartridge" );
+        CartridgeController.CartridgeFileName = Contents->FileName;
+        CartridgeController.CartridgeTitle = Contents->Title;
+        CartridgeController.CartridgeVersion = Contents->Version;
+        CartridgeController.CartridgeRevision = Contents->Revision;
     }
     
     // -----------------------------------------------------------------------------
@@ -696,7 +486,7 @@ namespace V32
     {
         // do nothing if a cartridge is not loaded
         if( !HasCartridge() ) return;
-        Callbacks::LogLine( "Unloading cartridge" );
+        Callbacks.LogLine( Callbacks.UserData, "Unloading cartridge" );
         
         // release cartridge program ROM
         CartridgeController.Disconnect();
@@ -715,6 +505,10 @@ namespace V32
           SPU.UnloadSound( SPU.CartridgeSounds[ i ] );
         
         SPU.LoadedCartridgeSounds = 0;
+        
+        // contents are released when no
+        // other console is still using them
+        CartridgeContents.reset();
     }
     
     // -----------------------------------------------------------------------------
@@ -739,6 +533,42 @@ namespace V32
     }
     
     
+    // =============================================================================
+    //      AUXILIARY FUNCTIONS FOR MEMORY CARD FILES
+    // =============================================================================
+    
+    
+    // replaces a file with another one in a single step, so
+    // that the destination always has either its previous
+    // contents or the new ones (but never part of each)
+    static bool ReplaceCardFile( const string& SourcePath, const string& DestinationPath )
+    {
+        // on windows convert paths from UTF-8 to UTF-16
+        #if defined(__WIN32__)
+          wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
+          wstring SourcePathUTF16 = converter.from_bytes( SourcePath );
+          wstring DestinationPathUTF16 = converter.from_bytes( DestinationPath );
+          return MoveFileExW( SourcePathUTF16.c_str(), DestinationPathUTF16.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+        #else
+          return (rename( SourcePath.c_str(), DestinationPath.c_str() ) == 0);
+        #endif
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void RemoveCardFile( const string& FilePath )
+    {
+        // on windows convert path from UTF-8 to UTF-16
+        #if defined(__WIN32__)
+          wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
+          wstring FilePathUTF16 = converter.from_bytes( FilePath );
+          DeleteFileW( FilePathUTF16.c_str() );
+        #else
+          remove( FilePath.c_str() );
+        #endif
+    }
+    
+    
     // =============================================================================
     //      V32 CONSOLE: MEMORY CARD MANAGEMENT
     // =============================================================================
@@ -746,8 +576,8 @@ namespace V32
     
     void V32Console::CreateMemoryCard( const std::string& FilePath )
     {
-        Callbacks::LogLine( "Creating memory card" );
-        Callbacks::LogLine( "File path: \"" + FilePath + "\"" );
+        Callbacks.LogLine( Callbacks.UserData, "Creating memory card" );
+        Callbacks.LogLine( Callbacks.UserData, "File path: \"" + FilePath + "\"" );
         
         // open the file
         ofstream OutputFile;
@@ -762,7 +592,7 @@ namespace V32
         #endif
         
         if( OutputFile.fail() )
-          Callbacks::ThrowException( "Cannot create memory card file" );
+          Callbacks.ThrowException( Callbacks.UserData, "Cannot create memory card file" );
         
         // save the signature
         WriteSignature( OutputFile, MemoryCardFileFormat::Signature );
@@ -774,33 +604,33 @@ namespace V32
         
         // close the file
         OutputFile.close();
-        Callbacks::LogLine( "Finished creating memory card" );
+        Callbacks.LogLine( Callbacks.UserData, "Finished creating memory card" );
     }
     
     // -----------------------------------------------------------------------------
     
     void V32Console::LoadMemoryCard( const std::string& FilePath )
     {
-        Callbacks::LogLine( "Loading memory card" );
-        Callbacks::LogLine( "File path: \"" + FilePath + "\"" );
+        Callbacks.LogLine( Callbacks.UserData, "Loading memory card" );
+        Callbacks.LogLine( Callbacks.UserData, "File path: \"" + FilePath + "\"" );
     
         // unload any previous card
         UnloadMemoryCard();
         
-        // open the file for random access
-        fstream& InputFile = MemoryCardController.LinkedFile;
+        // open the file
+        ifstream InputFile;
         
         // on windows convert path from UTF-8 to UTF-16
         #if defined(__WIN32__)
           wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
           wstring FilePathUTF16 = converter.from_bytes(FilePath);
-          InputFile.open( FilePathUTF16.c_str(), ios_base::in | ios_base::out | ios::binary | ios::ate );
+          InputFile.open( FilePathUTF16.c_str(), ios::binary | ios::ate );
         #else
-          InputFile.open( FilePath, ios_base::in | ios_base::out | ios::binary | ios::ate );
+          InputFile.open( FilePath, ios::binary | ios::ate );
         #endif
         
         if( InputFile.fail() )
-          Callbacks::ThrowException( "Cannot open memory card file" );
+          Callbacks.ThrowException( Callbacks.UserData, "Cannot open memory card file" );
         
         // check file size coherency
         int NumberOfBytes = InputFile.tellg();
@@ -809,7 +639,7 @@ namespace V32
         if( NumberOfBytes != ExpectedBytes )
         {
             InputFile.close();
-            Callbacks::ThrowException( "Invalid memory card: File does not match the size of a Vircon memory card" );
+            Callbacks.ThrowException( Callbacks.UserData, "Invalid memory card: File does not match the size of a Vircon memory card" );
         }
         
         // read and check signature
@@ -818,21 +648,23 @@ namespace V32
         InputFile.read( FileSignature, 8 );
         
         if( !CheckSignature( FileSignature, MemoryCardFileFormat::Signature ) )
-          Callbacks::ThrowException( "Memory card file does not have a valid signature" );
+          Callbacks.ThrowException( Callbacks.UserData, "Memory card file does not have a valid signature" );
         
         // connect the memory
         MemoryCardController.Connect( Constants::MemoryCardSize );
         
         // now load the whole memory card contents
         InputFile.read( (char*)(&MemoryCardController.Memory[ 0 ]), Constants::MemoryCardSize * 4 );
+        InputFile.close();
+        MemoryCardController.MarkAsSaved();
         
-        // do NOT close the file! leave it open until
-        // card is unloaded or emulation is stopped,
-        // so that it can be saved if card is modified
+        // keep the path, so that the card
+        // can be saved when it is modified
+        MemoryCardController.CardFilePath = FilePath;
         
         // save the file name
         MemoryCardController.CardFileName = GetPathFileName( FilePath );
-        Callbacks::LogLine( "Finished loading memory card" );
+        Callbacks.LogLine( Callbacks.UserData, "Finished loading memory card" );
     }
     
     // -----------------------------------------------------------------------------
@@ -841,7 +673,7 @@ namespace V32
     {
         // do nothing if a card is not loaded
         if( !HasMemoryCard() ) return;
-        Callbacks::LogLine( "Unloading memory card" );
+        Callbacks.LogLine( Callbacks.UserData, "Unloading memory card" );
         
         // save the card if it was modified
         if( MemoryCardController.PendingSave )
@@ -849,32 +681,68 @@ namespace V32
         
         // remove the card memory
         MemoryCardController.Disconnect();
-        
-        // close the open file
-        MemoryCardController.LinkedFile.close();
-        Callbacks::LogLine( "Finished unloading memory card" );
+        MemoryCardController.CardFilePath.clear();
+        Callbacks.LogLine( Callbacks.UserData, "Finished unloading memory card" );
     }
     
     // -----------------------------------------------------------------------------
     
+    // the whole card is written to a temporary file that then
+    // replaces the card file: if the emulator crashes or the
+    // disk fills up while saving, the card file still has all
+    // of its previous contents (saves are delayed, so this is
+    // done at most once per second)
     void V32Console::SaveMemoryCard()
     {
         // do nothing if a card is not loaded
         if( !HasMemoryCard() ) return;
         
-        // check the file
-        fstream& OutputFile = MemoryCardController.LinkedFile;
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "Memory card save", 'B', 0 );
         
-        if( !OutputFile.is_open() || OutputFile.fail() )
-          Callbacks::ThrowException( "Cannot save memory card file" );
+        // open the temporary file
+        string CardFilePath = MemoryCardController.CardFilePath;
+        string TemporaryFilePath = CardFilePath + ".tmp";
+        ofstream OutputFile;
         
-        // save the signature
-        OutputFile.seekp( ios_base::beg );
+        // on windows convert path from UTF-8 to UTF-16
+        #if defined(__WIN32__)
+          wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
+          wstring FilePathUTF16 = converter.from_bytes(TemporaryFilePath);
+          OutputFile.open( FilePathUTF16.c_str(), ios_base::binary | ios::trunc );
+        #else
+          OutputFile.open( TemporaryFilePath, ios_base::binary | ios::trunc );
+        #endif
+        
+        if( OutputFile.fail() )
+          Callbacks.ThrowException( Callbacks.UserData, "Cannot save memory card file" );
+        
+        // write the signature and all card contents
         WriteSignature( OutputFile, MemoryCardFileFormat::Signature );
+        OutputFile.write( (char*)(&MemoryCardController.Memory[ 0 ]), MemoryCardController.MemorySize * 4 );
+        OutputFile.flush();
+        
+        bool WriteFailed = OutputFile.fail();
+        OutputFile.close();
+        
+        // the card file is only replaced after
+        // the temporary one has been fully written
+        if( WriteFailed || OutputFile.fail() )
+        {
+            RemoveCardFile( TemporaryFilePath );
+            Callbacks.ThrowException( Callbacks.UserData, "Cannot save memory card file" );
+        }
+        
+        if( !ReplaceCardFile( TemporaryFilePath, CardFilePath ) )
+        {
+            RemoveCardFile( TemporaryFilePath );
+            Callbacks.ThrowException( Callbacks.UserData, "Cannot replace memory card file" );
+        }
+        
+        MemoryCardController.MarkAsSaved();
         
-        // now save all contents
-        OutputFile.write( (char*)(&MemoryCardController.Memory[ 0 ]), Constants::MemoryCardSize * 4 );
-        MemoryCardController.PendingSave = false;
+        if( Callbacks.TraceEvent )
+          Callbacks.TraceEvent( Callbacks.UserData, "Memory card save", 'E', 0 );
     }
     
     // -----------------------------------------------------------------------------
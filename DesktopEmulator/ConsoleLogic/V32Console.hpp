@@ -14,14 +14,39 @@
     #include "V32CartridgeController.hpp"
     #include "V32MemoryCardController.hpp"
     #include "V32NullController.hpp"
+    #include "V32Savestates.hpp"
+    #include "V32ROMContents.hpp"
     
     // include C/C++ headers
     #include <string>         // [ C++ STL ] Strings
+    #include <memory>         // [ C++ STL ] Smart pointers
 // *****************************************************************************
 
 
 namespace V32
 {
+    // =============================================================================
+    //      CONSOLE ACTIVITY COUNTERS
+    // =============================================================================
+    
+    
+    // activity during the last frame, as needed for
+    // performance monitoring; GPU counts only include
+    // commands, so quads actually drawn are DrawCommands
+    typedef struct
+    {
+        int32_t  CPUCycles;
+        uint32_t PortWrites;
+        uint32_t ClearCommands;
+        uint32_t DrawCommands;
+        uint32_t TextureSwitches;
+        uint32_t RejectedCommands;
+        uint32_t RejectedPixels;
+        double   SPUMixTime;        // in seconds
+    }
+    ConsoleFrameCounters;
+    
+    
     // =============================================================================
     //      CONSOLE CLASS
     // =============================================================================
@@ -35,6 +60,10 @@ namespace V32
             V32MemoryBus  MemoryBus;
             V32ControlBus ControlBus;
             
+            // connections to the program running this
+            // console (set them before loading any media)
+            ConsoleCallbacks Callbacks;
+            
             // hardwired motherboard components
             V32Timer Timer;
             V32RNG RNG;
@@ -50,9 +79,20 @@ namespace V32
             V32RAM RAM;
             V32ROM BiosProgramROM;
             
+            // contents of the connected ROMs; they
+            // may be shared with other consoles
+            std::shared_ptr< const ROMContents > BiosContents;
+            std::shared_ptr< const ROMContents > CartridgeContents;
+            
             // internal state
             bool PowerIsOn;
             
+            // CPU execution: an alternative engine (when null
+            // the CPU runs itself) and a limit for the cycles
+            // in each chunk (0 for no limit other than events)
+            V32CPUEngine* CPUEngine;
+            int32_t MaxChunkCycles;
+            
             // additional data about the connected bios
             std::string BiosFileName;
             std::string BiosTitle;
@@ -63,6 +103,9 @@ namespace V32
             float LastCPULoads[ 2 ];
             float LastGPULoads[ 2 ];
             
+            // detailed activity for last frame
+            ConsoleFrameCounters LastFrameCounters;
+            
         public:
             
             // instance handling
@@ -83,16 +126,19 @@ namespace V32
             bool IsCPUHalted();
             float GetCPULoad();
             float GetGPULoad();
+            void GetFrameCounters( ConsoleFrameCounters& Counters );
             
             // bios management
             // (bios cannot be unloaded, but some implementations may need it)
             void LoadBios( const std::string& FilePath );
+            void LoadBios( std::shared_ptr< const ROMContents > Contents );
             void UnloadBios();
             bool HasBios();
             
             // cartridge management
             // (only accessible when power is off)
             void LoadCartridge( const std::string& FilePath );
+            void LoadCartridge( std::shared_ptr< const ROMContents > Contents );
             void UnloadCartridge();
             bool HasCartridge();
             std::string GetCartridgeFileName();
@@ -118,6 +164,19 @@ namespace V32
             
             // sound output management
             void GetFrameSoundOutput( SPUOutputBuffer& OutputBuffer );
+            
+            // state management (only for a powered on console,
+            // and buffers need to have at least GetStateSize bytes)
+            unsigned GetStateSize();
+            void SaveState( ConsoleState* State );
+            void LoadState( const ConsoleState* State );
+            
+            // - - - - - - - - - - - - - - - - - - - - - - - -
+            //   INTERNAL FUNCTIONS
+            // - - - - - - - - - - - - - - - - - - - - - - - -
+            
+            // execution scheduling
+            int32_t GetCyclesToNextEvent();
     };
 }
 
@@ -9,6 +9,7 @@
     
     // include C/C++ headers
     #include <cmath>            // [ ANSI C ] Mathematics
+    #include <cstring>          // [ ANSI C ] Strings
     
     // declare used namespaces
     using namespace std;
@@ -60,12 +61,21 @@ namespace V32
         // no entities were pointed yet
         PointedTexture = nullptr;
         PointedRegion = nullptr;
+        Callbacks = nullptr;
         
-        // size the array
-        CartridgeTextures.resize( Constants::GPUMaximumCartridgeTextures );
+        // all regions start as cleared
+        RegionsGeneration = 0;
+        TextureGenerations.resize( Constants::GPUMaximumCartridgeTextures, 0 );
         
         // no cartridge loaded yet
         LoadedCartridgeTextures = 0;
+        
+        // no activity yet
+        ClearCommands = 0;
+        DrawCommands = 0;
+        TextureSwitches = 0;
+        RejectedCommands = 0;
+        RejectedPixels = 0;
     }
     
     // -----------------------------------------------------------------------------
@@ -85,9 +95,14 @@ namespace V32
     void V32GPU::InsertCartridgeTextures( uint32_t NumberOfCartridgeTextures )
     {
         if( NumberOfCartridgeTextures > Constants::GPUMaximumCartridgeTextures )
-          Callbacks::ThrowException( "Attempting to insert too many cartridge textures" );
+          Callbacks->ThrowException( Callbacks->UserData, "Attempting to insert too many cartridge textures" );
         
         LoadedCartridgeTextures = NumberOfCartridgeTextures;
+        
+        // regions are only allocated for textures in the
+        // cartridge, and they start as already cleared
+        CartridgeTextures.assign( NumberOfCartridgeTextures, GPUTexture() );
+        TextureGenerations.assign( Constants::GPUMaximumCartridgeTextures, RegionsGeneration );
     }
     
     // -----------------------------------------------------------------------------
@@ -95,7 +110,10 @@ namespace V32
     void V32GPU::RemoveCartridgeTextures()
     {
         LoadedCartridgeTextures = 0;
-        Callbacks::UnloadCartridgeTextures();
+        Callbacks->UnloadCartridgeTextures( Callbacks->UserData );
+        
+        // release the memory for their regions
+        vector< GPUTexture >().swap( CartridgeTextures );
     }
     
     
@@ -154,6 +172,13 @@ namespace V32
     {
         // restore the drawing capacity for next frame
         RemainingPixels = Constants::GPUPixelCapacityPerFrame;
+        
+        // start counting activity for the new frame
+        ClearCommands = 0;
+        DrawCommands = 0;
+        TextureSwitches = 0;
+        RejectedCommands = 0;
+        RejectedPixels = 0;
     }
     
     // -----------------------------------------------------------------------------
@@ -179,40 +204,70 @@ namespace V32
         SelectedRegion = 0;
         
         // notify video library of parameter changes
-        Callbacks::SelectTexture( SelectedTexture );
-        Callbacks::SetMultiplyColor( MultiplyColor );
-        Callbacks::SetBlendingMode( ActiveBlending );
+        Callbacks->SelectTexture( Callbacks->UserData, SelectedTexture );
+        Callbacks->SetMultiplyColor( Callbacks->UserData, MultiplyColor );
+        Callbacks->SetBlendingMode( Callbacks->UserData, ActiveBlending );
         
         // reset pointed entities
         PointedTexture = &BiosTexture;
         PointedRegion = &BiosTexture.Regions[ 0 ];
         
         // reset all regions for every textures
-        // (but keep all existent textures reloaded!)
-        for( int i = 0; i < Constants::GPUMaximumCartridgeTextures; i++ )
-        for( int j = 0; j < Constants::GPURegionsPerTexture; j++ )
+        // (but keep all existent textures reloaded!);
+        // cartridge textures will be cleared when used
+        RegionsGeneration++;
+        
+        // in the very unlikely case of a wrap-around,
+        // old generations could be taken as current
+        if( RegionsGeneration == 0 )
         {
-            CartridgeTextures[ i ].Regions[ j ].MinX     = 0;
-            CartridgeTextures[ i ].Regions[ j ].MinX     = 0;
-            CartridgeTextures[ i ].Regions[ j ].MaxX     = 0;
-            CartridgeTextures[ i ].Regions[ j ].MaxY     = 0;
-            CartridgeTextures[ i ].Regions[ j ].HotspotX = 0;
-            CartridgeTextures[ i ].Regions[ j ].HotspotY = 0;
+            for( GPUTexture& Texture: CartridgeTextures )
+              memset( Texture.Regions, 0, sizeof(Texture.Regions) );
+            
+            TextureGenerations.assign( Constants::GPUMaximumCartridgeTextures, 0 );
         }
         
-        // same for BIOS texture
-        for( int j = 0; j < Constants::GPURegionsPerTexture; j++ )
+        // the BIOS texture is always cleared now
+        memset( BiosTexture.Regions, 0, sizeof(BiosTexture.Regions) );
+        
+        // initial screen clear to black
+        Callbacks->ClearScreen( Callbacks->UserData, ClearColor );
+    }
+    
+    
+    // =============================================================================
+    //      V32 GPU: HANDLING TEXTURE REGIONS
+    // =============================================================================
+    
+    
+    // texture ID -1 is the BIOS texture; regions of
+    // cartridge textures should not be accessed in
+    // any other way, since they could be outdated
+    GPUTexture* V32GPU::GetTextureForUse( int32_t TextureID )
+    {
+        if( TextureID < 0 )
+          return &BiosTexture;
+        
+        GPUTexture* Texture = &CartridgeTextures[ TextureID ];
+        
+        // clear regions not used since the last reset
+        if( TextureGenerations[ TextureID ] != RegionsGeneration )
         {
-            BiosTexture.Regions[ j ].MinX     = 0;
-            BiosTexture.Regions[ j ].MinX     = 0;
-            BiosTexture.Regions[ j ].MaxX     = 0;
-            BiosTexture.Regions[ j ].MaxY     = 0;
-            BiosTexture.Regions[ j ].HotspotX = 0;
-            BiosTexture.Regions[ j ].HotspotY = 0;
+            memset( Texture->Regions, 0, sizeof(Texture->Regions) );
+            TextureGenerations[ TextureID ] = RegionsGeneration;
         }
         
-        // initial screen clear to black
-        Callbacks::ClearScreen( ClearColor );
+        return Texture;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // needed before accessing all regions
+    // directly, such as for savestates
+    void V32GPU::ClearOutdatedRegions()
+    {
+        for( unsigned i = 0; i < LoadedCartridgeTextures; i++ )
+          GetTextureForUse( i );
     }
     
     
@@ -221,27 +276,50 @@ namespace V32
     // =============================================================================
     
     
-    void V32GPU::ClearScreen()
+    // commands are rejected when they exceed the GPU capacity
+    // for the current frame; they are counted for diagnostics
+    void V32GPU::RejectCommand( int32_t NeededPixels )
     {
-        // auto-reject the operation if the GPU is already out of capacity
-        if( RemainingPixels < 0 )
-          return;
+        RejectedCommands++;
+        RejectedPixels += NeededPixels;
         
+        if( Callbacks->TraceEvent )
+          Callbacks->TraceEvent( Callbacks->UserData, "GPU rejected", 'i', NeededPixels );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void V32GPU::ClearScreen()
+    {
         // calculate the needed capacity for this operation
         float CostFactor = 1 + Constants::GPUClearScreenPenalty;
         int32_t NeededPixels = CostFactor * Constants::ScreenPixels;
         
+        // auto-reject the operation if the GPU is already out of capacity
+        if( RemainingPixels < 0 )
+        {
+            RejectCommand( NeededPixels );
+            return;
+        }
+        
         // reject this request if it cannot be finished in this frame
         RemainingPixels -= NeededPixels;
         
         if( RemainingPixels < 0 )
         {
             RemainingPixels = -1;
+            RejectCommand( NeededPixels );
             return;
         }
         
+        // keep track of accepted commands
+        ClearCommands++;
+        
+        if( Callbacks->TraceEvent )
+          Callbacks->TraceEvent( Callbacks->UserData, "GPU clear", 'i', NeededPixels );
+        
         // clear the screen
-        Callbacks::ClearScreen( ClearColor );
+        Callbacks->ClearScreen( Callbacks->UserData, ClearColor );
     }
     
     // -----------------------------------------------------------------------------
@@ -250,10 +328,6 @@ namespace V32
     // draw region command, by varying the enabled transforms
     void V32GPU::DrawRegion( bool ScalingEnabled, bool RotationEnabled )
     {
-        // auto-reject the operation if the GPU is already out of capacity
-        if( RemainingPixels < 0 )
-          return;
-        
         // get active region
         GPURegion Region = *PointedRegion;
         
@@ -281,15 +355,30 @@ namespace V32
         
         int32_t NeededPixels = CostFactor * EffectiveWidth * EffectiveHeight;
         
+        // auto-reject the operation if the GPU is already out of capacity
+        // (the cost is still calculated, to keep count of rejected pixels)
+        if( RemainingPixels < 0 )
+        {
+            RejectCommand( NeededPixels );
+            return;
+        }
+        
         // reject this request if it cannot be finished in this frame
         RemainingPixels -= NeededPixels;
         
         if( RemainingPixels < 0 )
         {
             RemainingPixels = -1;
+            RejectCommand( NeededPixels );
             return;
         }
         
+        // keep track of accepted commands
+        DrawCommands++;
+        
+        if( Callbacks->TraceEvent )
+          Callbacks->TraceEvent( Callbacks->UserData, "GPU draw", 'i', NeededPixels );
+        
         // calculate absolute texture coordinates
         // (initially, they are pixel-centered and uncorrected)
         float TextureMinX = Region.MinX + 0.5;
@@ -420,6 +509,6 @@ namespace V32
         }
         
         // draw rectangle defined as a quad (4-vertex polygon)
-        Callbacks::DrawQuad( RegionQuad );
+        Callbacks->DrawQuad( Callbacks->UserData, RegionQuad );
     }
 }
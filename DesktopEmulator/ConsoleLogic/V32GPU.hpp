@@ -83,13 +83,22 @@ namespace V32
             
             // textures loaded into GPU
             GPUTexture BiosTexture;
-            std::vector< GPUTexture > CartridgeTextures;    // do not use a plain array: it is too large to hold in stack
+            std::vector< GPUTexture > CartridgeTextures;    // only as many as the cartridge has
             unsigned LoadedCartridgeTextures;
             
+            // on reset, cartridge texture regions are not
+            // cleared: instead each texture is cleared when
+            // first used, if its generation is not current
+            uint32_t RegionsGeneration;
+            std::vector< uint32_t > TextureGenerations;
+            
             // accessors to active entities
             GPUTexture* PointedTexture;
             GPURegion*  PointedRegion;
             
+            // connection with the host Vircon system
+            ConsoleCallbacks* Callbacks;
+            
             // GPU registers: GPU control
             int32_t Command;
             int32_t RemainingPixels;
@@ -111,6 +120,14 @@ namespace V32
             // quad coordinates for drawing regions
             GPUQuad RegionQuad;
             
+            // activity counters for current frame
+            // (for performance monitoring only)
+            uint32_t ClearCommands;
+            uint32_t DrawCommands;
+            uint32_t TextureSwitches;
+            uint32_t RejectedCommands;
+            uint32_t RejectedPixels;
+            
         public:
             
             // instance handling
@@ -129,7 +146,12 @@ namespace V32
             void ChangeFrame();
             void Reset();
             
+            // handling texture regions
+            GPUTexture* GetTextureForUse( int32_t TextureID );
+            void ClearOutdatedRegions();
+            
             // execution of GPU commands
+            void RejectCommand( int32_t NeededPixels );
             void ClearScreen();
             void DrawRegion( bool ScalingEnabled, bool RotationEnabled );
     };
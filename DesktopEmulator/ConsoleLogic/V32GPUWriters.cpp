@@ -81,7 +81,7 @@ namespace V32
         GPU.MultiplyColor = Value.AsColor;
         
         // notify the video library
-        Callbacks::SetMultiplyColor( Value.AsColor );
+        GPU.Callbacks->SetMultiplyColor( GPU.Callbacks->UserData, Value.AsColor );
         return true;
     }
     
@@ -115,7 +115,7 @@ namespace V32
         }
         
         // for valid modes, notify the video library
-        Callbacks::SetBlendingMode( Value.AsInteger );
+        GPU.Callbacks->SetBlendingMode( GPU.Callbacks->UserData, Value.AsInteger );
         return true;
     }
     
@@ -127,25 +127,19 @@ namespace V32
         if( Value.AsInteger < -1 || Value.AsInteger >= (int32_t)GPU.LoadedCartridgeTextures )
           return true;
             
+        // keep count of actual changes
+        if( Value.AsInteger != GPU.SelectedTexture )
+          GPU.TextureSwitches++;
+        
         // write the value
         GPU.SelectedTexture = Value.AsInteger;
         
         // notify the video library
-        Callbacks::SelectTexture( Value.AsInteger );
+        GPU.Callbacks->SelectTexture( GPU.Callbacks->UserData, Value.AsInteger );
         
         // now update the pointed entities
-        if( Value.AsInteger == -1 )
-        {
-            // special case for BIOS texture
-            GPU.PointedTexture = &GPU.BiosTexture;
-            GPU.PointedRegion = &GPU.PointedTexture->Regions[ GPU.SelectedRegion ];
-        }
-        else
-        {
-            // regular cartridge textures
-            GPU.PointedTexture = &GPU.CartridgeTextures[ GPU.SelectedTexture ];
-            GPU.PointedRegion = &GPU.PointedTexture->Regions[ GPU.SelectedRegion ];
-        }
+        GPU.PointedTexture = GPU.GetTextureForUse( GPU.SelectedTexture );
+        GPU.PointedRegion = &GPU.PointedTexture->Regions[ GPU.SelectedRegion ];
         
         return true;
     }
@@ -4,6 +4,10 @@
     
     // include C/C++ headers
     #include <cstring>          // [ ANSI C ] Strings
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // declare used namespaces
+    using namespace std;
 // *****************************************************************************
 
 
@@ -31,6 +35,7 @@ namespace V32
         MemorySize = NumberOfWords;
         
         // initially, set to zeroes
+        MarkAllPagesModified();
         ClearContents();
     }
     
@@ -39,6 +44,7 @@ namespace V32
     void V32RAM::Disconnect()
     {
         Memory.clear();
+        ModifiedPages.clear();
         MemorySize = 0;
     }
     
@@ -46,7 +52,27 @@ namespace V32
     
     void V32RAM::ClearContents()
     {
-        memset( &Memory[ 0 ], 0, Memory.size() * 4 );
+        int32_t NumberOfPages = ModifiedPages.size();
+        
+        // pages not modified are still all zeroes
+        for( int32_t Page = 0; Page < NumberOfPages; Page++ )
+        {
+            if( !ModifiedPages[ Page ] )
+              continue;
+            
+            int32_t FirstWord = Page * RAM_PageWords;
+            int32_t PageWords = min( RAM_PageWords, MemorySize - FirstWord );
+            memset( &Memory[ FirstWord ], 0, PageWords * 4 );
+            ModifiedPages[ Page ] = 0;
+        }
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void V32RAM::MarkAllPagesModified()
+    {
+        int32_t NumberOfPages = (MemorySize + RAM_PageWords - 1) / RAM_PageWords;
+        ModifiedPages.assign( NumberOfPages, 1 );
     }
     
     // -----------------------------------------------------------------------------
@@ -72,6 +98,7 @@ namespace V32
         
         // write value
         Memory[ LocalAddress ] = Value;
+        ModifiedPages[ (uint32_t)LocalAddress / RAM_PageWords ] = 1;
         return true;
     }
     
@@ -83,29 +110,24 @@ namespace V32
     
     V32ROM::V32ROM()
     {
+        Memory = nullptr;
         MemorySize = 0;
     }
     
     // -----------------------------------------------------------------------------
     
-    void V32ROM::Connect( void* Source, uint32_t NumberOfWords )
+    void V32ROM::Connect( const V32Word* Source, uint32_t NumberOfWords )
     {
-        // first, remove any previous memory
-        Disconnect();
-        
-        // resize ROM to new size
-        Memory.resize( NumberOfWords );
+        // the whole address space is just referenced
+        Memory = Source;
         MemorySize = NumberOfWords;
-        
-        // copy the whole address space
-        memcpy( &Memory[ 0 ], Source, NumberOfWords * 4 );
     }
     
     // -----------------------------------------------------------------------------
     
     void V32ROM::Disconnect()
     {
-        Memory.clear();
+        Memory = nullptr;
         MemorySize = 0;
     }
     
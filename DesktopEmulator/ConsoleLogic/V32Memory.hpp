@@ -18,6 +18,13 @@ namespace V32
     // =============================================================================
     
     
+    // RAM keeps track of modified pages (4096 words
+    // each) so that clearing memory on every console
+    // reset does not need to process all of it
+    const int32_t RAM_PageWords = 4096;
+    
+    // -----------------------------------------------------------------------------
+    
     class V32RAM: public VirconMemoryInterface
     {
         public:
@@ -25,6 +32,10 @@ namespace V32
             std::vector< V32Word > Memory;
             int32_t MemorySize;
             
+            // do not use vector< bool >: it
+            // is slower to write on every access
+            std::vector< uint8_t > ModifiedPages;
+            
         public:
             
             // instance handling
@@ -37,6 +48,9 @@ namespace V32
             // memory contents
             void ClearContents();
             
+            // call after writing to memory directly
+            void MarkAllPagesModified();
+            
             // bus connection
             virtual bool ReadAddress( int32_t LocalAddress, V32Word& Result );
             virtual bool WriteAddress( int32_t LocalAddress, V32Word Value );
@@ -48,11 +62,14 @@ namespace V32
     // =============================================================================
     
     
+    // ROM does not own its contents: they are kept in
+    // the loaded ROM contents, which may be shared by
+    // many consoles, and must outlive the connection
     class V32ROM: public VirconMemoryInterface
     {
         public:
             
-            std::vector< V32Word > Memory;
+            const V32Word* Memory;
             int32_t MemorySize;
             
         public:
@@ -62,7 +79,7 @@ namespace V32
             
             // memory connection
             // (unlike RAM, we can only get the contents upon connection)
-            void Connect( void* SourceData, uint32_t NumberOfWords );
+            void Connect( const V32Word* SourceData, uint32_t NumberOfWords );
             void Disconnect();
             
             // bus connection
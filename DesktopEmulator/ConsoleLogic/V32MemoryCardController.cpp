@@ -14,15 +14,15 @@ namespace V32
     V32MemoryCardController::V32MemoryCardController()
     {
         PendingSave = false;
+        PendingFrames = 0;
     }
     
     // -----------------------------------------------------------------------------
     
-    V32MemoryCardController::~V32MemoryCardController()
+    void V32MemoryCardController::MarkAsSaved()
     {
-        // ensure we always close the file
-        if( LinkedFile.is_open() )
-          LinkedFile.close();
+        PendingSave = false;
+        PendingFrames = 0;
     }
     
     // -----------------------------------------------------------------------------
@@ -56,11 +56,19 @@ namespace V32
     
     bool V32MemoryCardController::WriteAddress( int32_t LocalAddress, V32Word Value )
     {
-        // check that the normal RAM write is successful
-        if( !V32RAM::WriteAddress( LocalAddress, Value ) )
+        // check range
+        if( LocalAddress >= MemorySize )
           return false;
         
-        // data is now pending to save
+        // games often write the same data again,
+        // and that does not need to be saved
+        if( Memory[ LocalAddress ].AsBinary == Value.AsBinary )
+          return true;
+        
+        // write value
+        Memory[ LocalAddress ] = Value;
+        
+        // the card is now pending to save
         PendingSave = true;
         
         return true;
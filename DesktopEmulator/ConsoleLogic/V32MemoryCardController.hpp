@@ -9,7 +9,6 @@
     
     // include C/C++ headers
     #include <string>           // [ C++ STL ] Strings
-    #include <fstream>          // [ C++ STL ] File streams
 // *****************************************************************************
 
 
@@ -30,6 +29,11 @@ namespace V32
     // used as limit of local port numbers
     const int32_t MEM_LastPort = (int32_t)MEM_LocalPorts::Connected;
     
+    // the card is saved whole when it has been modified;
+    // saves are delayed to join the writes of many
+    // consecutive frames into a single file write
+    const int32_t MEM_SaveDelayFrames = 60;
+    
     
     // =============================================================================
     //      MEMORY CARD CONTROLLER CLASS
@@ -41,8 +45,9 @@ namespace V32
         public:
             
             // file save control
-            std::fstream LinkedFile;
+            std::string CardFilePath;
             bool PendingSave;
+            int32_t PendingFrames;
             
             // displayed file name for GUI
             std::string CardFileName;
@@ -51,7 +56,9 @@ namespace V32
             
             // instance handling
             V32MemoryCardController();
-           ~V32MemoryCardController();
+            
+            // call when memory matches the file
+            void MarkAsSaved();
             
             // connection to control bus
             virtual bool ReadPort( int32_t LocalPort, V32Word& Result );
@@ -0,0 +1,426 @@
+// *****************************************************************************
+    // include common Vircon32 headers
+    #include "../VirconDefinitions/Constants.hpp"
+    #include "../VirconDefinitions/FileFormats.hpp"
+    
+    // include console logic headers
+    #include "V32ROMContents.hpp"
+    #include "AuxiliaryFunctions.hpp"
+    
+    // include C/C++ headers
+    #include <fstream>          // [ C++ STL ] File streams
+    
+    // these are only needed to treat UTF-16 file paths
+    #if defined(__WIN32__)
+      #include <locale>         // [ C++ STL ] Locales
+      #include <codecvt>        // [ C++ STL ] Encoding conversions
+    #endif
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+namespace V32
+{
+    // =============================================================================
+    //      AUXILIARY FUNCTIONS FOR ROM FILES
+    // =============================================================================
+    
+    
+    static void OpenROMFile( ifstream& InputFile, const string& FilePath )
+    {
+        // on windows convert path from UTF-8 to UTF-16
+        #if defined(__WIN32__)
+          wstring_convert< std::codecvt_utf8_utf16< wchar_t > > converter;
+          wstring FilePathUTF16 = converter.from_bytes(FilePath);
+          InputFile.open( FilePathUTF16.c_str(), ios_base::binary | ios_base::ate );
+        #else
+          InputFile.open( FilePath, ios_base::binary | ios_base::ate );
+        #endif
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // checks locations and sizes common to BIOS and cartridges
+    static void CheckROMLocations( const ROMFileFormat::Header& ROMHeader, unsigned FileBytes, ConsoleCallbacks& Callbacks )
+    {
+        // check for correct program rom location
+        if( ROMHeader.ProgramROMLocation.StartOffset != sizeof(ROMFileFormat::Header) )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (program ROM is not located after file header)" );
+        
+        // check for correct video rom location
+        uint32_t SizeAfterProgramROM = ROMHeader.ProgramROMLocation.StartOffset + ROMHeader.ProgramROMLocation.Length;
+        
+        if( ROMHeader.VideoROMLocation.StartOffset != SizeAfterProgramROM )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (video ROM is not located after program ROM)" );
+        
+        // check for correct audio rom location
+        uint32_t SizeAfterVideoROM = ROMHeader.VideoROMLocation.StartOffset + ROMHeader.VideoROMLocation.Length;
+        
+        if( ROMHeader.AudioROMLocation.StartOffset != SizeAfterVideoROM )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (audio ROM is not located after video ROM)" );
+        
+        // check for correct file size
+        uint32_t SizeAfterAudioROM = ROMHeader.AudioROMLocation.StartOffset + ROMHeader.AudioROMLocation.Length;
+        
+        if( FileBytes != SizeAfterAudioROM )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file size does not match indicated ROM contents)" );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    // reads the pixels of a texture after its header was checked
+    static void ReadROMTexture( ifstream& InputFile, const TextureFileFormat::Header& TextureHeader, ROMTexture& Texture )
+    {
+        Texture.Width = TextureHeader.TextureWidth;
+        Texture.Height = TextureHeader.TextureHeight;
+        Texture.Pixels.resize( Texture.Width * Texture.Height );
+        InputFile.read( (char*)(&Texture.Pixels[ 0 ]), Texture.Pixels.size() * 4 );
+    }
+    
+    
+    // =============================================================================
+    //      LOADING BIOS FILES
+    // =============================================================================
+    
+    
+    shared_ptr< const ROMContents > LoadBiosContents( const string& FilePath, ConsoleCallbacks& Callbacks )
+    {
+        shared_ptr< ROMContents > Contents = make_shared< ROMContents >();
+        
+        // open bios file
+        ifstream InputFile;
+        OpenROMFile( InputFile, FilePath );
+        
+        if( InputFile.fail() )
+          Callbacks.ThrowException( Callbacks.UserData, "Cannot open BIOS file" );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 1: Load global information
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // get size and ensure it is a multiple of 4
+        // (otherwise file contents are wrong)
+        unsigned FileBytes = InputFile.tellg();
+        
+        if( (FileBytes % 4) != 0 )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file size must be a multiple of 4)" );
+        
+        // ensure that we can at least load the file header
+        if( FileBytes < sizeof(ROMFileFormat::Header) )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file is too small)" );
+        
+        // now we can safely read the global header
+        InputFile.seekg( 0, ios_base::beg );
+        ROMFileFormat::Header ROMHeader;
+        InputFile.read( (char*)(&ROMHeader), sizeof(ROMFileFormat::Header) );
+        
+        // check if the ROM is actually a cartridge
+        if( CheckSignature( ROMHeader.Signature, ROMFileFormat::CartridgeSignature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Input V32 ROM cannot be loaded as a BIOS (is it a cartridge instead)" );
+        
+        // now check the actual BIOS signature
+        if( !CheckSignature( ROMHeader.Signature, ROMFileFormat::BiosSignature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file does not have a valid signature)" );
+        
+        // check current Vircon version
+        if( ROMHeader.VirconVersion  > (unsigned)Constants::VirconVersion
+        ||  ROMHeader.VirconRevision > (unsigned)Constants::VirconRevision )
+          Callbacks.ThrowException( Callbacks.UserData, "This BIOS was made for a more recent version of Vircon32. Please use an updated emulator" );
+        
+        // report the title
+        ROMHeader.Title[ 63 ] = 0;
+        Callbacks.LogLine( Callbacks.UserData, string("BIOS title: \"") + ROMHeader.Title + "\"" );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 2: Check the declared rom contents
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // ensure that there is exactly 1 texture
+        if( ROMHeader.NumberOfTextures != 1 )
+          Callbacks.ThrowException( Callbacks.UserData, "A BIOS video rom should have exactly 1 texture" );
+        
+        // ensure that there is exactly 1 sound
+        if( ROMHeader.NumberOfSounds != 1 )
+          Callbacks.ThrowException( Callbacks.UserData, "A BIOS audio rom should have exactly 1 sound" );
+        
+        CheckROMLocations( ROMHeader, FileBytes, Callbacks );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 3: Load program rom
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // load a binary file header
+        BinaryFileFormat::Header BinaryHeader;
+        InputFile.read( (char*)(&BinaryHeader), sizeof(BinaryFileFormat::Header) );
+        
+        // check signature for embedded binary
+        if( !CheckSignature( BinaryHeader.Signature, BinaryFileFormat::Signature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "BIOS binary does not have a valid signature" );
+        
+        // checking program rom size limitations
+        if( !IsBetween( BinaryHeader.NumberOfWords, 1, Constants::MaximumBiosProgramROM ) )
+          Callbacks.ThrowException( Callbacks.UserData, "BIOS binary does not have a correct size (from 1 word up to 1M words)" );
+        
+        // load the binary contents
+        Contents->ProgramROM.resize( BinaryHeader.NumberOfWords );
+        InputFile.read( (char*)(&Contents->ProgramROM[ 0 ]), BinaryHeader.NumberOfWords * 4 );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 4: Load video rom
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // load a texture file signature
+        TextureFileFormat::Header TextureHeader;
+        InputFile.read( (char*)(&TextureHeader), sizeof(TextureFileFormat::Header) );
+        
+        // check signature for embedded texture
+        if( !CheckSignature( TextureHeader.Signature, TextureFileFormat::Signature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "BIOS texture does not have a valid signature" );
+        
+        // report texture size
+        Callbacks.LogLine( Callbacks.UserData, "BIOS texture is " + to_string( TextureHeader.TextureWidth )
+           + "x" + to_string( TextureHeader.TextureHeight ) );
+        
+        // check texture size limitations
+        if( !IsBetween( TextureHeader.TextureWidth , 1, Constants::GPUTextureSize )
+        ||  !IsBetween( TextureHeader.TextureHeight, 1, Constants::GPUTextureSize ) )
+          Callbacks.ThrowException( Callbacks.UserData, "BIOS texture does not have correct dimensions (from 1x1 up to 1024x1024 pixels)" );
+        
+        Contents->Textures.resize( 1 );
+        ReadROMTexture( InputFile, TextureHeader, Contents->Textures[ 0 ] );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 5: Load audio rom
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // load a sound file signature
+        SoundFileFormat::Header SoundHeader;
+        InputFile.read( (char*)(&SoundHeader), sizeof(SoundFileFormat::Header) );
+        
+        // check signature for embedded sound
+        if( !CheckSignature( SoundHeader.Signature, SoundFileFormat::Signature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "BIOS sound does not have a valid signature" );
+        
+        // report sound length
+        Callbacks.LogLine( Callbacks.UserData, "BIOS sound is " + to_string( SoundHeader.SoundSamples ) + " samples" );
+        
+        // check sound length limitations
+        if( !IsBetween( SoundHeader.SoundSamples, 1, Constants::SPUMaximumBiosSamples ) )
+          Callbacks.ThrowException( Callbacks.UserData, "BIOS sound does not have a correct length (from 1 up to 1M samples)" );
+        
+        // load the sound samples
+        Contents->Samples.resize( SoundHeader.SoundSamples );
+        InputFile.read( (char*)(&Contents->Samples[ 0 ]), SoundHeader.SoundSamples * 4 );
+        Contents->SoundLengths.push_back( SoundHeader.SoundSamples );
+        
+        // only when loading was successful:
+        // copy BIOS metadata
+        Contents->FileName = GetPathFileName( FilePath );
+        Contents->Title = ROMHeader.Title;
+        Contents->Version = ROMHeader.ROMVersion;
+        Contents->Revision = ROMHeader.ROMRevision;
+        
+        InputFile.close();
+        return Contents;
+    }
+    
+    
+    // =============================================================================
+    //      LOADING CARTRIDGE FILES
+    // =============================================================================
+    
+    
+    shared_ptr< const ROMContents > LoadCartridgeContents( const string& FilePath, ConsoleCallbacks& Callbacks )
+    {
+        shared_ptr< ROMContents > Contents = make_shared< ROMContents >();
+        
+        // open cartridge file
+        ifstream InputFile;
+        OpenROMFile( InputFile, FilePath );
+        
+        if( InputFile.fail() )
+          Callbacks.ThrowException( Callbacks.UserData, "Cannot open cartridge file" );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 1: Load global information
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // get size and ensure it is a multiple of 4
+        // (otherwise file contents are wrong)
+        unsigned FileBytes = InputFile.tellg();
+        
+        if( (FileBytes % 4) != 0 )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file size must be a multiple of 4)" );
+        
+        // ensure that we can at least load the file header
+        if( FileBytes < sizeof(ROMFileFormat::Header) )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file is too small)" );
+        
+        // now we can safely read the global header
+        InputFile.seekg( 0, ios_base::beg );
+        ROMFileFormat::Header ROMHeader;
+        InputFile.read( (char*)(&ROMHeader), sizeof(ROMFileFormat::Header) );
+        
+        // check if the ROM is actually a BIOS
+        if( CheckSignature( ROMHeader.Signature, ROMFileFormat::BiosSignature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Input V32 ROM cannot be loaded as a cartridge (is it a BIOS instead)" );
+        
+        // now check the actual cartridge signature
+        if( !CheckSignature( ROMHeader.Signature, ROMFileFormat::CartridgeSignature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (file does not have a valid signature)" );
+        
+        // check current Vircon version
+        if( ROMHeader.VirconVersion  > (unsigned)Constants::VirconVersion
+        ||  ROMHeader.VirconRevision > (unsigned)Constants::VirconRevision )
+          Callbacks.ThrowException( Callbacks.UserData, "This cartridge was made for a more recent version of Vircon32. Please use an updated emulator" );
+        
+        // report the title
+        ROMHeader.Title[ 63 ] = 0;
+        Callbacks.LogLine( Callbacks.UserData, string("Cartridge title: \"") + ROMHeader.Title + "\"" );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 2: Check the declared rom contents
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // check that there are not too many textures
+        Callbacks.LogLine( Callbacks.UserData, "Video ROM contains " + to_string( ROMHeader.NumberOfTextures ) + " textures" );
+        
+        if( ROMHeader.NumberOfTextures > (uint32_t)Constants::GPUMaximumCartridgeTextures )
+          Callbacks.ThrowException( Callbacks.UserData, "Video ROM contains too many textures (Vircon GPU only allows up to 256)" );
+        
+        // check that there are not too many sounds
+        Callbacks.LogLine( Callbacks.UserData, "Audio ROM contains " + to_string( ROMHeader.NumberOfSounds ) + " sounds" );
+        
+        if( ROMHeader.NumberOfSounds > (uint32_t)Constants::SPUMaximumCartridgeSounds )
+          Callbacks.ThrowException( Callbacks.UserData, "Audio ROM contains too many sounds (Vircon SPU only allows up to 1024)" );
+        
+        CheckROMLocations( ROMHeader, FileBytes, Callbacks );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 3: Load program rom
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        Callbacks.LogLine( Callbacks.UserData, "Loading cartridge program ROM" );
+        
+        // load a binary file signature
+        BinaryFileFormat::Header BinaryHeader;
+        InputFile.read( (char*)(&BinaryHeader), sizeof(BinaryFileFormat::Header) );
+        
+        // check signature for embedded binary
+        if( !CheckSignature( BinaryHeader.Signature, BinaryFileFormat::Signature ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Cartridge binary does not have a valid signature" );
+        
+        Callbacks.LogLine( Callbacks.UserData, "-> Program ROM is " + to_string( BinaryHeader.NumberOfWords ) + " words" );
+        
+        // check program rom size limitations
+        if( !IsBetween( BinaryHeader.NumberOfWords, 1, Constants::MaximumCartridgeProgramROM ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Cartridge program ROM does not have a correct size (from 1 word up to 128M words)" );
+        
+        // load the binary contents
+        Contents->ProgramROM.resize( BinaryHeader.NumberOfWords );
+        InputFile.read( (char*)(&Contents->ProgramROM[ 0 ]), BinaryHeader.NumberOfWords * 4 );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 4: Load video rom
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        Callbacks.LogLine( Callbacks.UserData, "Loading cartridge video ROM" );
+        Contents->Textures.resize( ROMHeader.NumberOfTextures );
+        
+        // load all textures in sequence
+        for( unsigned i = 0; i < ROMHeader.NumberOfTextures; i++ )
+        {
+            // load a texture file signature
+            TextureFileFormat::Header TextureHeader;
+            InputFile.read( (char*)(&TextureHeader), sizeof(TextureFileFormat::Header) );
+            
+            // check signature for embedded texture
+            if( !CheckSignature( TextureHeader.Signature, TextureFileFormat::Signature ) )
+              Callbacks.ThrowException( Callbacks.UserData, "Cartridge texture does not have a valid signature" );
+            
+            // report texture size
+            Callbacks.LogLine( Callbacks.UserData, "-> Texture " + to_string( i ) + ": " + to_string( TextureHeader.TextureWidth )
+               + " x " + to_string( TextureHeader.TextureHeight ) + " pixels" );
+            
+            // check texture size limitations
+            if( !IsBetween( TextureHeader.TextureWidth , 1, Constants::GPUTextureSize )
+            ||  !IsBetween( TextureHeader.TextureHeight, 1, Constants::GPUTextureSize ) )
+              Callbacks.ThrowException( Callbacks.UserData, "Cartridge texture does not have correct dimensions (1x1 up to 1024x1024 pixels)" );
+            
+            ReadROMTexture( InputFile, TextureHeader, Contents->Textures[ i ] );
+        }
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STEP 5: Load audio rom
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        Callbacks.LogLine( Callbacks.UserData, "Loading cartridge audio ROM" );
+        
+        // all sounds will be stored in a single allocation;
+        // the audio rom size is an upper bound for it, since
+        // the rest of its contents are the sound headers
+        uint32_t AudioROMWords = ROMHeader.AudioROMLocation.Length / 4;
+        uint32_t SoundHeaderWords = sizeof(SoundFileFormat::Header) / 4;
+        uint32_t AudioROMHeaderWords = ROMHeader.NumberOfSounds * SoundHeaderWords;
+        
+        if( AudioROMWords < AudioROMHeaderWords )
+          Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (audio ROM is too small for its declared sounds)" );
+        
+        uint32_t AudioROMSamples = AudioROMWords - AudioROMHeaderWords;
+        
+        if( AudioROMSamples > (uint32_t)Constants::SPUMaximumCartridgeSamples )
+          Callbacks.ThrowException( Callbacks.UserData, "Cartridge sounds contain too many total samples (Vircon SPU only allows up to 256M total samples)" );
+        
+        Contents->Samples.resize( AudioROMSamples );
+        
+        // keep count of the total sound samples
+        uint32_t TotalSPUSamples = 0;
+        
+        // load all sounds in sequence
+        for( unsigned i = 0; i < ROMHeader.NumberOfSounds; i++ )
+        {
+            // load a sound file signature
+            SoundFileFormat::Header SoundHeader;
+            InputFile.read( (char*)(&SoundHeader), sizeof(SoundFileFormat::Header) );
+            
+            // check signature for embedded sound
+            if( !CheckSignature( SoundHeader.Signature, SoundFileFormat::Signature ) )
+              Callbacks.ThrowException( Callbacks.UserData, "Cartridge sound does not have a valid signature" );
+            
+            // report sound length
+            Callbacks.LogLine( Callbacks.UserData, "-> Sound " + to_string( i ) + ": " + to_string( SoundHeader.SoundSamples )
+               + " samples (" + to_string( SoundHeader.SoundSamples/44100.0f ) + " seconds)" );
+            
+            // check length limitations for this sound
+            if( !IsBetween( SoundHeader.SoundSamples, 1, Constants::SPUMaximumCartridgeSamples ) )
+              Callbacks.ThrowException( Callbacks.UserData, "Cartridge sound does not have correct length (1 up to 256M samples)" );
+            
+            // check length limitations for the whole SPU
+            TotalSPUSamples += SoundHeader.SoundSamples;
+            
+            if( TotalSPUSamples > (uint32_t)Constants::SPUMaximumCartridgeSamples )
+              Callbacks.ThrowException( Callbacks.UserData, "Cartridge sounds contain too many total samples (Vircon SPU only allows up to 256M total samples)" );
+            
+            // sounds cannot go beyond the audio rom
+            if( TotalSPUSamples > AudioROMSamples )
+              Callbacks.ThrowException( Callbacks.UserData, "Incorrect V32 file format (sounds do not fit in the audio ROM)" );
+            
+            // place the samples right after the ones for the previous sound
+            SPUSample* SoundSamples = &Contents->Samples[ TotalSPUSamples - SoundHeader.SoundSamples ];
+            InputFile.read( (char*)SoundSamples, SoundHeader.SoundSamples * 4 );
+            Contents->SoundLengths.push_back( SoundHeader.SoundSamples );
+        }
+        
+        // only when loading was successful:
+        // copy cartridge metadata
+        Contents->FileName = GetPathFileName( FilePath );
+        Contents->Title = ROMHeader.Title;
+        Contents->Version = ROMHeader.ROMVersion;
+        Contents->Revision = ROMHeader.ROMRevision;
+        
+        InputFile.close();
+        return Contents;
+    }
+}
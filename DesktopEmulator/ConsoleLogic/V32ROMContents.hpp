@@ -0,0 +1,78 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef V32ROMCONTENTS_HPP
+    #define V32ROMCONTENTS_HPP
+    
+    // include common Vircon32 headers
+    #include "../VirconDefinitions/DataStructures.hpp"
+    
+    // include console logic headers
+    #include "ExternalInterfaces.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <memory>           // [ C++ STL ] Smart pointers
+// *****************************************************************************
+
+
+namespace V32
+{
+    // =============================================================================
+    //      CONTENTS OF ROM FILES
+    // =============================================================================
+    
+    
+    // textures are stored at their own size, and are
+    // only expanded to full size when sent to video
+    typedef struct
+    {
+        uint32_t Width;
+        uint32_t Height;
+        std::vector< GPUColor > Pixels;
+    }
+    ROMTexture;
+    
+    // -----------------------------------------------------------------------------
+    
+    // Everything loaded from a BIOS or cartridge file.
+    // Consoles never modify these contents, so a single
+    // copy can be used by any number of consoles at once
+    // (each of them keeps a reference while connected).
+    typedef struct
+    {
+        // metadata
+        std::string FileName;
+        std::string Title;
+        uint32_t Version;
+        uint32_t Revision;
+        
+        // program rom
+        std::vector< V32Word > ProgramROM;
+        
+        // video rom
+        std::vector< ROMTexture > Textures;
+        
+        // audio rom: all sounds are placed
+        // consecutively in a single allocation
+        std::vector< SPUSample > Samples;
+        std::vector< uint32_t > SoundLengths;
+    }
+    ROMContents;
+    
+    
+    // =============================================================================
+    //      LOADING ROM FILES
+    // =============================================================================
+    
+    
+    // callbacks are only used to log and report errors
+    std::shared_ptr< const ROMContents > LoadBiosContents( const std::string& FilePath, ConsoleCallbacks& Callbacks );
+    std::shared_ptr< const ROMContents > LoadCartridgeContents( const std::string& FilePath, ConsoleCallbacks& Callbacks );
+}
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
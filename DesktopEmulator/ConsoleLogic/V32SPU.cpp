@@ -47,9 +47,20 @@ namespace V32
     
     V32SPU::V32SPU()
     {
+        // no sounds are loaded yet
+        BiosSound.Samples = nullptr;
+        BiosSound.Length = 0;
+        
+        for( SPUSound& S: CartridgeSounds )
+        {
+            S.Samples = nullptr;
+            S.Length = 0;
+        }
+        
         // no entities were pointed yet
         PointedChannel = nullptr;
         PointedSound = nullptr;
+        Callbacks = nullptr;
         
         // no cartridge loaded yet
         LoadedCartridgeSounds = 0;
@@ -69,11 +80,11 @@ namespace V32
     // =============================================================================
     
     
-    void V32SPU::LoadSound( SPUSound& TargetSound, SPUSample* Samples, unsigned NumberOfSamples )
+    // samples are not copied: they must be already placed
+    // in ROM contents, and the sound will just refer to them
+    void V32SPU::LoadSound( SPUSound& TargetSound, const SPUSample* Samples, unsigned NumberOfSamples )
     {
-        // copy the buffer to target sound
-        TargetSound.Samples.resize( NumberOfSamples );
-        memcpy( &TargetSound.Samples[ 0 ], Samples, NumberOfSamples * 4 );
+        TargetSound.Samples = Samples;
         
         // update sound length
         TargetSound.Length = NumberOfSamples;
@@ -88,7 +99,7 @@ namespace V32
     
     void V32SPU::UnloadSound( SPUSound& TargetSound )
     {
-        TargetSound.Samples.clear();
+        TargetSound.Samples = nullptr;
         TargetSound.Length = 0;
     }
     
@@ -62,8 +62,9 @@ namespace V32
         int32_t LoopStart;
         int32_t LoopEnd;
         
-        // actual sound samples
-        std::vector< SPUSample > Samples;
+        // location of the sound samples within the
+        // loaded ROM contents (sounds do not own them)
+        const SPUSample* Samples;
     }
     SPUSound;
     
@@ -107,6 +108,9 @@ namespace V32
             SPUSound*   PointedSound;
             SPUChannel* PointedChannel;
             
+            // connection with the host Vircon system
+            ConsoleCallbacks* Callbacks;
+            
             // sound channels
             SPUChannel Channels[ Constants::SPUSoundChannels ];
             
@@ -120,7 +124,7 @@ namespace V32
            ~V32SPU();
             
             // handling of audio resources
-            void LoadSound( SPUSound& TargetSound, SPUSample* Samples, unsigned NumberOfSamples );
+            void LoadSound( SPUSound& TargetSound, const SPUSample* Samples, unsigned NumberOfSamples );
             void UnloadSound( SPUSound& TargetSound );
             
             // I/O bus connection
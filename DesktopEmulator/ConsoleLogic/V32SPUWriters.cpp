@@ -25,6 +25,10 @@ namespace V32
         {
             case (int32_t)IOPortValues::SPUCommand_PlaySelectedChannel:
                 SPU.PlayChannel( *SPU.PointedChannel );
+                
+                if( SPU.Callbacks->TraceEvent )
+                  SPU.Callbacks->TraceEvent( SPU.Callbacks->UserData, "SPU play", 'i', SPU.SelectedChannel );
+                
                 break;
                 
             case (int32_t)IOPortValues::SPUCommand_PauseSelectedChannel:
@@ -0,0 +1,291 @@
+// *****************************************************************************
+    // include console logic headers
+    #include "V32Savestates.hpp"
+    #include "V32Console.hpp"
+    
+    // include C/C++ headers
+    #include <cstring>          // [ ANSI C ] Strings
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+namespace V32
+{
+    // =============================================================================
+    //      SERIALIZATION (SAVE CONSOLE STATE TO BUFFER)
+    // =============================================================================
+    
+    
+    static void SaveCPUState( V32Console& Console, CPUState& State )
+    {
+        // all fields should be adjacent in memory
+        // so read registers and flags together
+        memcpy( &State, Console.CPU.Registers, sizeof(CPUState) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void SaveGPUState( V32Console& Console, GPUState& State )
+    {
+        V32GPU& GPU = Console.GPU;
+        
+        // read all registers as adjacent
+        memcpy( State.Registers, &GPU.Command, sizeof(State.Registers) );
+        
+        // copy the BIOS texture
+        memcpy( &State.BiosTexture, &GPU.BiosTexture, sizeof(GPUTexture) );
+        
+        // copy only the needed cartridge textures
+        // (regions are cleared lazily on reset)
+        GPU.ClearOutdatedRegions();
+        unsigned TexturesSize = sizeof(GPUTexture) * GPU.LoadedCartridgeTextures;
+        memcpy( State.CartridgeTextures, GPU.CartridgeTextures.data(), TexturesSize );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void SaveSPUState( V32Console& Console, SPUState& State )
+    {
+        V32SPU& SPU = Console.SPU;
+        
+        // read all registers as adjacent
+        memcpy( State.Registers, &SPU.Command, sizeof(State.Registers) );
+        
+        // read all channels as adjacent
+        memcpy( State.Channels, &SPU.Channels, sizeof(State.Channels) );
+        
+        // copy the BIOS sound
+        memcpy( &State.BiosSound, &SPU.BiosSound, sizeof(SPUSoundState) );
+        
+        // copy only the needed cartridge sounds
+        // (size will stay the same, but speed will increase)
+        unsigned CartridgeSounds = SPU.LoadedCartridgeSounds;
+        
+        // do not read data for all sounds as a block!!
+        // we don't want to copy the sample vector in each sound
+        for( unsigned SoundID = 0; SoundID < CartridgeSounds; SoundID++ )
+          memcpy( &State.CartridgeSounds[ SoundID ], &SPU.CartridgeSounds[ SoundID ], sizeof(SPUSoundState) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void SaveGamepadControllerState( V32Console& Console, GamepadControllerState& State )
+    {
+        State.SelectedGamepad = Console.GamepadController.SelectedGamepad;
+        
+        // read all gamepad states as adjacent
+        memcpy( State.GamepadStates, Console.GamepadController.RealTimeGamepadStates, sizeof(State.GamepadStates) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void SaveOtherConsoleState( V32Console& Console, OtherConsoleState& State )
+    {
+        // save state for minor chips
+        memcpy( State.TimerRegisters, &Console.Timer.CurrentDate, sizeof(State.TimerRegisters) );
+        State.RNGCurrentValue = Console.RNG.CurrentValue;
+        
+        // save the full RAM
+        memcpy( State.RAM, &Console.RAM.Memory[ 0 ], sizeof(State.RAM) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void SaveGameInfo( V32Console& Console, ROMInfo& Info )
+    {
+        // ensure title does not exceed 64 bytes and
+        // that its unused characters are all null
+        memset( Info.Title, 0, sizeof(Info.Title) );
+        strncpy( Info.Title, Console.CartridgeController.CartridgeTitle.c_str(), sizeof(Info.Title) - 1 );
+        
+        Info.Version = Console.CartridgeController.CartridgeVersion;
+        Info.Revision = Console.CartridgeController.CartridgeRevision;
+        Info.ProgramROMSize = Console.CartridgeController.MemorySize;
+        Info.NumberOfTextures = Console.CartridgeController.NumberOfTextures;
+        Info.NumberOfSounds = Console.CartridgeController.NumberOfSounds;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void SaveBiosInfo( V32Console& Console, ROMInfo& Info )
+    {
+        // ensure title does not exceed 64 bytes and
+        // that its unused characters are all null
+        memset( Info.Title, 0, sizeof(Info.Title) );
+        strncpy( Info.Title, Console.BiosTitle.c_str(), sizeof(Info.Title) - 1 );
+        
+        Info.Version = Console.BiosVersion;
+        Info.Revision = Console.BiosRevision;
+        Info.ProgramROMSize = Console.BiosProgramROM.MemorySize;
+        Info.NumberOfTextures = 1;
+        Info.NumberOfSounds = 1;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void V32Console::SaveState( ConsoleState* State )
+    {
+        // save info to identify the game and BIOS
+        SaveGameInfo( *this, State->Game );
+        SaveBiosInfo( *this, State->Bios );
+        
+        // save console state
+        SaveCPUState( *this, State->CPU );
+        SaveGPUState( *this, State->GPU );
+        SaveSPUState( *this, State->SPU );
+        SaveGamepadControllerState( *this, State->GamepadController );
+        SaveOtherConsoleState( *this, State->Others );
+    }
+    
+    
+    // =============================================================================
+    //      DESERIALIZATION (LOAD CONSOLE STATE FROM BUFFER)
+    // =============================================================================
+    
+    
+    static void LoadCPUState( V32Console& Console, const CPUState& State )
+    {
+        // all fields should be adjacent in memory
+        // so write registers and flags together
+        memcpy( Console.CPU.Registers, &State, sizeof(CPUState) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void LoadGPUState( V32Console& Console, const GPUState& State )
+    {
+        V32GPU& GPU = Console.GPU;
+        
+        // write all registers as adjacent
+        memcpy( &GPU.Command, State.Registers, sizeof(State.Registers) );
+        
+        // copy the BIOS texture
+        memcpy( &GPU.BiosTexture, &State.BiosTexture, sizeof(GPUTexture) );
+        
+        // copy only the needed cartridge textures; the rest
+        // must not keep regions from before the last reset
+        GPU.ClearOutdatedRegions();
+        unsigned TexturesSize = sizeof(GPUTexture) * GPU.LoadedCartridgeTextures;
+        memcpy( GPU.CartridgeTextures.data(), State.CartridgeTextures, TexturesSize );
+        
+        // update GPU pointers for the loaded selections
+        GPU.PointedTexture = GPU.GetTextureForUse( GPU.SelectedTexture );
+        GPU.PointedRegion = &GPU.PointedTexture->Regions[ GPU.SelectedRegion ];
+        
+        // make the needed updates in the video library
+        Console.Callbacks.SelectTexture( Console.Callbacks.UserData, GPU.SelectedTexture );
+        Console.Callbacks.SetMultiplyColor( Console.Callbacks.UserData, GPU.MultiplyColor );
+        Console.Callbacks.SetBlendingMode( Console.Callbacks.UserData, GPU.ActiveBlending );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void LoadSPUState( V32Console& Console, const SPUState& State )
+    {
+        V32SPU& SPU = Console.SPU;
+        
+        // write all registers as adjacent
+        memcpy( &SPU.Command, State.Registers, sizeof(State.Registers) );
+        
+        // write all channels as adjacent
+        memcpy( &SPU.Channels, State.Channels, sizeof(State.Channels) );
+        
+        // copy the BIOS sound
+        memcpy( (void*)&SPU.BiosSound, &State.BiosSound, sizeof(SPUSoundState) );
+        
+        // copy only the needed cartridge sounds
+        // (size will stay the same, but speed will increase)
+        unsigned CartridgeSounds = SPU.LoadedCartridgeSounds;
+        
+        // do not load data for all sounds as a block!!
+        // we must not overwrite the sample vector in each sound
+        for( unsigned SoundID = 0; SoundID < CartridgeSounds; SoundID++ )
+          memcpy( (void*)&SPU.CartridgeSounds[ SoundID ], &State.CartridgeSounds[ SoundID ], sizeof(SPUSoundState) );
+        
+        // make the needed updates in audio objects
+        V32Word WordValue;
+        
+        WordValue.AsInteger = SPU.SelectedSound;
+        SPU.WritePort( (int32_t)SPU_LocalPorts::SelectedSound, WordValue );
+        
+        WordValue.AsInteger = SPU.SelectedChannel;
+        SPU.WritePort( (int32_t)SPU_LocalPorts::SelectedChannel, WordValue );
+        
+        // update SPU pointers for the loaded selections
+        if( SPU.SelectedSound == -1 )
+          SPU.PointedSound = &SPU.BiosSound;
+        else
+          SPU.PointedSound = &SPU.CartridgeSounds[ SPU.SelectedSound ];
+        
+        SPU.PointedChannel = &SPU.Channels[ SPU.SelectedChannel ];
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void LoadGamepadControllerState( V32Console& Console, const GamepadControllerState& State )
+    {
+        // write the single exposed register
+        Console.GamepadController.SelectedGamepad = State.SelectedGamepad;
+        
+        // write all gamepad states as adjacent
+        memcpy( Console.GamepadController.RealTimeGamepadStates, State.GamepadStates, sizeof(State.GamepadStates) );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    static void LoadOtherConsoleState( V32Console& Console, const OtherConsoleState& State )
+    {
+        // load state for minor chips
+        memcpy( &Console.Timer.CurrentDate, State.TimerRegisters, sizeof(State.TimerRegisters) );
+        Console.RNG.CurrentValue = State.RNGCurrentValue;
+        
+        // load the full RAM
+        memcpy( &Console.RAM.Memory[ 0 ], State.RAM, sizeof(State.RAM) );
+        Console.RAM.MarkAllPagesModified();
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void V32Console::LoadState( const ConsoleState* State )
+    {
+        // try to identify the game and BIOS and see if they
+        // match current ones, to avoid loading incompatible states
+        ROMInfo CurrentGame, CurrentBios;
+        SaveGameInfo( *this, CurrentGame );
+        SaveBiosInfo( *this, CurrentBios );
+        
+        if( memcmp( &State->Game, &CurrentGame, sizeof(ROMInfo) ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Current cartridge is not the same one that was saved" );
+        
+        if( memcmp( &State->Bios, &CurrentBios, sizeof(ROMInfo) ) )
+          Callbacks.ThrowException( Callbacks.UserData, "Current BIOS is not the same one that was used when saving" );
+        
+        // load console state
+        LoadCPUState( *this, State->CPU );
+        LoadSPUState( *this, State->SPU );
+        LoadGPUState( *this, State->GPU );
+        LoadGamepadControllerState( *this, State->GamepadController );
+        LoadOtherConsoleState( *this, State->Others );
+    }
+    
+    
+    // =============================================================================
+    //      SIZE OF CONSOLE STATES
+    // =============================================================================
+    
+    
+    unsigned V32Console::GetStateSize()
+    {
+        // savestates may be a different size for each
+        // game, that is fine by libretro as long as
+        // that size is always the same for each game
+        unsigned UnusedCartridgeTextures = Constants::GPUMaximumCartridgeTextures;
+        
+        if( HasCartridge() )
+          UnusedCartridgeTextures -= GPU.LoadedCartridgeTextures;
+        
+        return sizeof( ConsoleState ) - UnusedCartridgeTextures * sizeof( GPUTexture );
+    }
+}
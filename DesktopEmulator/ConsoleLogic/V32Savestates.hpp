@@ -0,0 +1,174 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef V32SAVESTATES_HPP
+    #define V32SAVESTATES_HPP
+    
+    // include common Vircon32 headers
+    #include "../VirconDefinitions/Constants.hpp"
+    #include "../VirconDefinitions/DataStructures.hpp"
+    
+    // include console logic headers
+    #include "V32GPU.hpp"
+    #include "V32SPU.hpp"
+    #include "V32GamepadController.hpp"
+// *****************************************************************************
+
+
+namespace V32
+{
+    // =============================================================================
+    //      STRUCTURES TO HANDLE CONSOLE STATE
+    // =============================================================================
+    
+    
+    // a console state is saved as a plain memory buffer,
+    // so that any program can store or transmit it; its
+    // size depends on the loaded cartridge, as given by
+    // V32Console::GetStateSize()
+    
+    typedef struct
+    {
+        // all CPU registers
+        V32Word Registers[ 16 ];
+        V32Word InternalRegisters[ 3 ];
+        
+        // control flags
+        int32_t Halted;
+        int32_t Waiting;
+    }
+    CPUState;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        // all exposed GPU registers that are not
+        // affected by texture and region selection
+        // (12 words in total)
+        V32Word Registers[ 12 ];
+        
+        // configuration for the BIOS texture
+        // (note that this ties each savestate to a particular BIOS)
+        GPUTexture BiosTexture;
+        
+        // configuration for cartridge textures
+        GPUTexture CartridgeTextures[ Constants::GPUMaximumCartridgeTextures ];
+    }
+    GPUState;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        // same as SPUSound but not including the sound samples
+        int32_t Length;
+        int32_t PlayWithLoop;
+        int32_t LoopStart;
+        int32_t LoopEnd;
+    }
+    SPUSoundState;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        // all exposed SPU registers that are not
+        // affected by channel and sound selection
+        // (4 words in total)
+        V32Word Registers[ 4 ];
+        
+        // all SPU channels
+        SPUChannel Channels[ Constants::SPUSoundChannels ];
+        
+        // configuration for the BIOS sound
+        // (note that this ties each savestate to a particular BIOS)
+        SPUSoundState BiosSound;
+        
+        // configuration for cartridge sounds
+        SPUSoundState CartridgeSounds[ Constants::SPUMaximumCartridgeSounds ];
+    }
+    SPUState;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        // the single gamepad controller exposed register
+        // that is not affected by gamepad selection
+        int32_t SelectedGamepad;
+        
+        // state of all gamepads (both real-time and provided)
+        GamepadState GamepadStates[ 2 * Constants::GamepadPorts ];
+    }
+    GamepadControllerState;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        // RAM contents
+        V32Word RAM[ Constants::RAMSize ];
+        
+        // state for minor chips
+        V32Word TimerRegisters[ 4 ];
+        int32_t RNGCurrentValue;
+        
+        // NOTE 1: Power is assumed to be on when saving a
+        // state. On a core this should always be the case.
+        
+        // NOTE 2: Screen contents are persistent, so the
+        // drawing buffer should also be part of the state.
+        // However taking and redrawing screenshots would
+        // add significant size and complexity. Nearly all
+        // games redraw the whole screen every frame, so
+        // we will skip saving the screen.
+    }
+    OtherConsoleState;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        char Title[ 64 ];
+        uint32_t Version;
+        uint32_t Revision;
+        int32_t ProgramROMSize;
+        int32_t NumberOfTextures;
+        int32_t NumberOfSounds;
+    }
+    ROMInfo;
+    
+    // -----------------------------------------------------------------------------
+    
+    typedef struct
+    {
+        // data for the game itself; this is just a
+        // basic attempt at distinguish different
+        // games to prevent loading an incompatible
+        // savestate and messing things up
+        ROMInfo Game;
+        
+        // data to identify the BIOS; this is much
+        // less important than the game itself, but
+        // if different BIOSes are used to save and
+        // load it can produce graphic errors
+        ROMInfo Bios;
+        
+        // data for all stateful console components;
+        // make GPU last so that we can adjust size
+        // using a texture array (the last field)
+        // only as large as needed for each game
+        OtherConsoleState Others;
+        GamepadControllerState GamepadController;
+        CPUState CPU;
+        SPUState SPU;
+        GPUState GPU;
+    }
+    ConsoleState;
+}
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
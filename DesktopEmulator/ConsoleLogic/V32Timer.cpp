@@ -1,6 +1,7 @@
 // *****************************************************************************
     // include console logic headers
     #include "V32Timer.hpp"
+    #include "V32CPU.hpp"
     
     // include C/C++ headers
     #include <time.h>           // [ ANSI C ] Date and time
@@ -19,6 +20,8 @@ namespace V32
     
     V32Timer::V32Timer()
     {
+        CPU = nullptr;
+        
         // obtain current time
         time_t CreationTime;
         time( &CreationTime );
@@ -48,7 +51,7 @@ namespace V32
           Result.AsInteger = FrameCounter;
           
         else if( LocalPort == (int32_t)CLK_LocalPorts::CycleCounter )
-          Result.AsInteger = CycleCounter;
+          Result.AsInteger = CycleCounter + CPU->GetElapsedCycles();
           
         else if( LocalPort == (int32_t)CLK_LocalPorts::CurrentTime )
           Result.AsInteger = CurrentTime;
@@ -69,9 +72,9 @@ namespace V32
     
     // -----------------------------------------------------------------------------
     
-    void V32Timer::RunNextCycle()
+    void V32Timer::AdvanceCycles( int32_t Cycles )
     {
-        CycleCounter++;
+        CycleCounter += Cycles;
     }
     
     // -----------------------------------------------------------------------------
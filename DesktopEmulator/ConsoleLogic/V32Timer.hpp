@@ -10,6 +10,10 @@
 
 namespace V32
 {
+    // forward declarations
+    class V32CPU;
+    
+    
     // =============================================================================
     //      TIMER DEFINITIONS
     // =============================================================================
@@ -42,6 +46,13 @@ namespace V32
             int32_t FrameCounter;
             int32_t CycleCounter;
             
+        public:
+            
+            // the cycle counter is only advanced after each
+            // chunk of CPU execution, so reads within a chunk
+            // need to add the cycles run by the CPU so far
+            V32CPU* CPU;
+            
         public:
             
             // instance handling
@@ -52,7 +63,7 @@ namespace V32
             virtual bool WritePort( int32_t LocalPort, V32Word Value );
             
             // general operation
-            void RunNextCycle();
+            void AdvanceCycles( int32_t Cycles );
             void ChangeFrame();
             void Reset();
     };
@@ -6,6 +6,9 @@
     #include <iostream>         // [ C++ STL ] I/O Streams
     #include <iomanip>          // [ C++ STL ] I/O Manipulation
     #include <stdexcept>        // [ C++ STL ] Exceptions
+    #include <chrono>           // [ C++ STL ] Time measurement
+    #include <cstring>          // [ ANSI C ] Strings
+    #include <algorithm>        // [ C++ STL ] Algorithms
     #include <time.h>           // [ ANSI C ] Time
     
     // declare used namespaces
@@ -20,19 +23,42 @@
 
 Logger::Logger()
 // - - - - - - - - - - - -
-:   ConsoleMode( true )
+:   ConsoleMode( true ),
+    WritePosition( 0 ),
+    ReadPosition( 0 ),
+    DroppedMessages( 0 ),
+    DrainMustExit( false ),
+    MinimumLevel( (int)LogLevels::Debug )
 // - - - - - - - - - - - -
 {
-    // (do nothing)
+    // all entries start free to write
+    QueueEntries = new LogEntry[ LOG_QUEUE_ENTRIES ];
+    
+    for( uint32_t i = 0; i < LOG_QUEUE_ENTRIES; i++ )
+      QueueEntries[ i ].Sequence.store( i, memory_order_relaxed );
+    
+    // start writing in the background
+    DrainThread = thread( &Logger::DrainThreadFunction, this );
 }
 
 // -----------------------------------------------------------------------------
 
 Logger::~Logger()
 {
+    // stop the thread before closing the file
+    // (CloseFile will write any remaining messages)
+    DrainMustExit = true;
+    
+    if( DrainThread.joinable() )
+      DrainThread.join();
+    
     CloseFile();
+    Flush();
+    
+    delete[] QueueEntries;
 }
 
+
 // =============================================================================
 //      LOGGER: FILE HANDLING
 // =============================================================================
@@ -42,6 +68,10 @@ bool Logger::OpenFile( const string& File, const string& Title )
 {
     // close previous file, if any
     CloseFile();
+    
+    // pending messages still go to the console
+    lock_guard< mutex > Lock( ConsumerMutex );
+    DrainQueue();
     OutputFile.clear();
     
     // attempt to open the file
@@ -93,9 +123,14 @@ bool Logger::OpenFile( const string& File, const string& Title )
 
 void Logger::CloseFile()
 {
+    lock_guard< mutex > Lock( ConsumerMutex );
+    
     if( !OutputFile.is_open() || OutputFile.bad() )
       return;
     
+    // pending messages still go to the file
+    DrainQueue();
+    
     // configure log to use the file
     ConsoleMode = false;
     
@@ -180,19 +215,170 @@ void Logger::WriteTime()
 
 // -----------------------------------------------------------------------------
 
-void Logger::Flush()
+void Logger::WriteString( const string& Message )
 {
     if( !Target().bad() )
-      Target().flush();
+      if( !Message.empty() )
+        Target() << Message;
+}
+
+
+// =============================================================================
+//      LOGGER: MESSAGE QUEUE
+// =============================================================================
+
+
+// returns false when the message cannot be queued because
+// all entries are in use; positions are claimed in order,
+// but entries may be completed by producers in any order
+bool Logger::PushMessage( const char* Prefix, const string& Message )
+{
+    uint32_t Position = WritePosition.load( memory_order_relaxed );
+    LogEntry* Entry;
+    
+    while( true )
+    {
+        Entry = &QueueEntries[ Position % LOG_QUEUE_ENTRIES ];
+        uint32_t Sequence = Entry->Sequence.load( memory_order_acquire );
+        int32_t Difference = (int32_t)(Sequence - Position);
+        
+        // the entry is free: try to claim this position
+        // (on failure, Position gets the current one)
+        if( Difference == 0 )
+        {
+            if( WritePosition.compare_exchange_weak( Position, Position + 1, memory_order_relaxed ) )
+              break;
+        }
+        
+        // the entry is still waiting to be read
+        else if( Difference < 0 )
+          return false;
+        
+        // another producer took this position
+        else
+          Position = WritePosition.load( memory_order_relaxed );
+    }
+    
+    // copy as much of the message as fits
+    const size_t Capacity = LOG_ENTRY_CHARACTERS;
+    size_t PrefixLength = min( strlen( Prefix ), Capacity );
+    size_t MessageLength = min( Message.size(), Capacity - PrefixLength );
+    
+    memcpy( Entry->Text, Prefix, PrefixLength );
+    memcpy( Entry->Text + PrefixLength, Message.data(), MessageLength );
+    Entry->Length = PrefixLength + MessageLength;
+    
+    // show that cut messages are incomplete
+    if( PrefixLength + Message.size() > Capacity )
+      memcpy( Entry->Text + Capacity - 3, "...", 3 );
+    
+    // the entry can now be read
+    Entry->Sequence.store( Position + 1, memory_order_release );
+    return true;
 }
 
 // -----------------------------------------------------------------------------
 
-void Logger::WriteString( const string& Message )
+// writes the next message to the output; returns false
+// when there are no messages, and also when the next one
+// is still being copied by its producer (it will be
+// available on the next call); the caller must hold the
+// consumer mutex
+bool Logger::PopMessage()
 {
+    LogEntry* Entry = &QueueEntries[ ReadPosition % LOG_QUEUE_ENTRIES ];
+    
+    if( Entry->Sequence.load( memory_order_acquire ) != ReadPosition + 1 )
+      return false;
+    
     if( !Target().bad() )
-      if( !Message.empty() )
-        Target() << Message;
+    {
+        Target().write( Entry->Text, Entry->Length );
+        Target() << '\n';
+    }
+    
+    // free the entry for its next use in the ring
+    Entry->Sequence.store( ReadPosition + LOG_QUEUE_ENTRIES, memory_order_release );
+    ReadPosition++;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// writes all queued messages to the output;
+// the caller must hold the consumer mutex
+void Logger::DrainQueue()
+{
+    bool WroteAny = false;
+    
+    while( PopMessage() )
+      WroteAny = true;
+    
+    // report the messages that did not fit
+    uint32_t Dropped = DroppedMessages.exchange( 0 );
+    
+    if( Dropped > 0 )
+    {
+        WriteString( "WARNING: " + to_string( Dropped ) + " log messages were discarded (the queue was full)" );
+        AddLine();
+    }
+    
+    // flush once for each group of messages
+    if( WroteAny && !Target().bad() )
+      Target().flush();
+}
+
+// -----------------------------------------------------------------------------
+
+void Logger::DrainThreadFunction()
+{
+    while( !DrainMustExit )
+    {
+        {
+            lock_guard< mutex > Lock( ConsumerMutex );
+            DrainQueue();
+        }
+        
+        // writers never wake this thread, so poll
+        // often enough for the log to stay current
+        this_thread::sleep_for( chrono::milliseconds( 10 ) );
+    }
+}
+
+
+// =============================================================================
+//      LOGGER: WRITING MESSAGES
+// =============================================================================
+
+
+void Logger::SetMinimumLevel( LogLevels Level )
+{
+    MinimumLevel = (int)Level;
+}
+
+// -----------------------------------------------------------------------------
+
+// safe to call from any thread: the message is only
+// queued, and it will be written in the background
+// (the prefix is given apart, so that the caller
+// does not need to build a new string for it)
+void Logger::Write( LogLevels Level, const string& Message, const char* Prefix )
+{
+    if( (int)Level < MinimumLevel.load( memory_order_relaxed ) )
+      return;
+    
+    if( !PushMessage( Prefix, Message ) )
+      DroppedMessages.fetch_add( 1, memory_order_relaxed );
+}
+
+// -----------------------------------------------------------------------------
+
+// writes all pending messages before returning, so
+// the calling thread will wait for the output
+void Logger::Flush()
+{
+    lock_guard< mutex > Lock( ConsumerMutex );
+    DrainQueue();
 }
 
 
@@ -228,11 +414,9 @@ void LOG_TO_FILE( const string& Name )
 // wrapper function start the global log to the console
 void LOG_TO_CONSOLE()
 {
-    // close any previous files
+    // closing any previous file
+    // will switch to the console
     GlobalLog().CloseFile();
-    
-    // enable console
-    GlobalLog().ConsoleMode = true;
 }
 
 // -----------------------------------------------------------------------------
@@ -245,21 +429,57 @@ void LOG_END()
 
 // -----------------------------------------------------------------------------
 
+void SET_LOG_LEVEL( LogLevels MinimumLevel )
+{
+    GlobalLog().SetMinimumLevel( MinimumLevel );
+}
+
+// -----------------------------------------------------------------------------
+
 void LOG( const std::string& Message )
 {
-    GlobalLog().WriteString( Message );
-    GlobalLog().AddLine();
-    GlobalLog().Flush();
+    GlobalLog().Write( LogLevels::Info, Message );
+}
+
+// -----------------------------------------------------------------------------
+
+void LOG_WARNING( const std::string& Message )
+{
+    GlobalLog().Write( LogLevels::Warning, Message, "WARNING: " );
+}
+
+// -----------------------------------------------------------------------------
+
+void LOG_ERROR( const std::string& Message )
+{
+    GlobalLog().Write( LogLevels::Error, Message, "ERROR: " );
+}
+
+// -----------------------------------------------------------------------------
+
+#if defined( VIRCON32_DEBUG_LOG )
+
+void LOG_DEBUG_MESSAGE( const std::string& Message )
+{
+    GlobalLog().Write( LogLevels::Debug, Message, "DEBUG: " );
 }
 
+#endif
+
 // -----------------------------------------------------------------------------
 
 [[ noreturn ]] void THROW( const std::string& Message )
 {
-    GlobalLog().WriteTime();
-    GlobalLog().WriteString( "[EXCEPTION]: " );
-    GlobalLog().WriteString( Message );
-    GlobalLog().AddLine();
+    // add the time when the exception happened
+    time_t CurrentTime;
+    char TimeText[ 30 ];
+    time( &CurrentTime );
+    strftime( TimeText, 30, "[%H:%M:%S]", localtime( &CurrentTime ) );
+    
+    // exceptions may end the program, so ensure that
+    // the message has room in the queue and is not lost
+    GlobalLog().Flush();
+    GlobalLog().Write( LogLevels::Error, Message, (TimeText + string("[EXCEPTION]: ")).c_str() );
     GlobalLog().Flush();
     
     throw std::runtime_error( Message );
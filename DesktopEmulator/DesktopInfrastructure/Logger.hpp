@@ -6,27 +6,99 @@
     // include C/C++ headers
     #include <string>		    // [ C++ STL ] Strings
     #include <fstream>          // [ C++ STL ] File Streams
+    #include <atomic>           // [ C++ STL ] Atomic variables
+    #include <thread>           // [ C++ STL ] Threads
+    #include <mutex>            // [ C++ STL ] Mutexes
+    #include <cstdint>          // [ ANSI C ] Standard integers
 // *****************************************************************************
 
 
+// =============================================================================
+//     DEFINITIONS FOR THE LOG
+// =============================================================================
+
+
+// messages below the minimum level of the
+// log are discarded when they are written
+enum class LogLevels
+{
+    Debug = 0,
+    Info,
+    Warning,
+    Error
+};
+
+// -----------------------------------------------------------------------------
+
+// messages are copied into fixed-size entries, all
+// created with the log, so writers never allocate;
+// longer messages are cut, and when all entries are
+// in use new messages are dropped (and counted)
+#define LOG_QUEUE_ENTRIES    1024
+#define LOG_ENTRY_CHARACTERS 256
+
+// -----------------------------------------------------------------------------
+
+// the sequence number tells who owns the entry: it
+// is free to write when it matches the position in
+// the queue, and ready to read when it is 1 higher
+struct LogEntry
+{
+    std::atomic< uint32_t > Sequence;
+    uint32_t Length;
+    char Text[ LOG_ENTRY_CHARACTERS ];
+};
+
+
 // =============================================================================
 //     TEXT OUTPUT TO A LOG FILE
 // =============================================================================
 
 
+// Any thread can write messages without waiting or
+// allocating memory: they are copied to a lock-free ring
+// of preallocated entries (multiple producers, single
+// consumer) that a background thread drains to the
+// output. Only that consumer side uses the mutex, so
+// that the main thread can take the consumer role to
+// flush the log or to open and close its file.
 class Logger
 {
     private:
         
         std::ofstream OutputFile;
+        bool ConsoleMode;
+        
+        // message queue: producers claim positions to
+        // write, and the read position belongs to the
+        // consumer; both only increase (and wrap around)
+        LogEntry* QueueEntries;
+        std::atomic< uint32_t > WritePosition;
+        uint32_t ReadPosition;
+        std::atomic< uint32_t > DroppedMessages;
+        
+        // background writing
+        std::thread DrainThread;
+        std::atomic< bool > DrainMustExit;
+        std::mutex ConsumerMutex;
+        
+        // messages below this level are discarded
+        std::atomic< int > MinimumLevel;
         
         // internal auxiliary methods
         std::ostream& Target( void );
+        bool PushMessage( const char* Prefix, const std::string& Message );
+        bool PopMessage();
+        void DrainQueue();
+        void DrainThreadFunction();
         
-    public:
+        // direct output methods
+        // (only for the consumer)
+        void WriteString( const std::string& Message );
+        void WriteDate();
+        void WriteTime();
+        void AddLine();
         
-        bool ConsoleMode;
-    
     public:
         
         // instance handling
@@ -38,10 +110,8 @@ class Logger
         void CloseFile();
         
         // log methods
-        void WriteString( const std::string& Message );
-        void WriteDate();
-        void WriteTime();
-        void AddLine();
+        void SetMinimumLevel( LogLevels Level );
+        void Write( LogLevels Level, const std::string& Message, const char* Prefix = "" );
         void Flush();
 };
 
@@ -59,10 +129,25 @@ void LOG_TO_FILE( const std::string& Name );
 void LOG_TO_CONSOLE();
 void LOG_END();
 
+// configuration of the global log
+void SET_LOG_LEVEL( LogLevels MinimumLevel );
+
 // general use funcions for the global log
 void LOG( const std::string& Message );
+void LOG_WARNING( const std::string& Message );
+void LOG_ERROR( const std::string& Message );
 [[ noreturn ]] void THROW( const std::string& Message );
 
+// debug messages are removed at compile time, so
+// their arguments are not even evaluated, unless
+// VIRCON32_DEBUG_LOG is defined (as in debug builds)
+#if defined( VIRCON32_DEBUG_LOG )
+  void LOG_DEBUG_MESSAGE( const std::string& Message );
+  #define LOG_DEBUG( Message )  LOG_DEBUG_MESSAGE( Message )
+#else
+  #define LOG_DEBUG( Message )  ((void)0)
+#endif
+
 
 // *****************************************************************************
     // end include guard
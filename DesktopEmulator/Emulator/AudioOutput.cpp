@@ -8,60 +8,95 @@
     
     // include emulator headers
     #include "AudioOutput.hpp"
+    #include "EventTracer.hpp"
     #include "Globals.hpp"
     
     // include C/C++ headers
     #include <stdexcept>        // [ C++ STL ] Exceptions
     #include <iostream>         // [ C++ STL ] I/O Streams
-    #include <climits>          // [ ANSI C ] Numeric limits
+    #include <cstring>          // [ ANSI C ] Strings
     
     // declare used namespaces
     using namespace std;
     using namespace V32;
 // *****************************************************************************
 
-    
+
 // =============================================================================
-//      AUXILIARY AUDIO FUNCTIONS
+//      SOUND RING BUFFER: CLASS IMPLEMENTATION
 // =============================================================================
 
 
-bool IsOpenALActive()
+SoundRingBuffer::SoundRingBuffer()
 {
-    // STEP 1: Check there is an audio context
-    ALCcontext* AudioContext = alcGetCurrentContext();
-    
-    if( !AudioContext )
-      return false;
-    
-    alGetError();
-    
-    // STEP 2: Check there is an audio device
-    ALCdevice* AudioDevice = alcGetContextsDevice( AudioContext );
-    
-    if( !AudioDevice )
-      return false;
-    
-    alGetError();
-    
-    return true;
+    WritePosition = 0;
+    ReadPosition = 0;
+    memset( Samples, 0, sizeof(Samples) );
 }
 
 // -----------------------------------------------------------------------------
 
-ALenum GetSourceState( ALuint SourceID )
+unsigned SoundRingBuffer::GetFilledSamples()
 {
-    ALenum State;
-    alGetSourcei( SourceID, AL_SOURCE_STATE, &State );
-    
-    return State;
+    // positions are free-running, so unsigned
+    // subtraction is correct even on wrap-around
+    uint32_t Written = WritePosition.load( memory_order_acquire );
+    uint32_t Read = ReadPosition.load( memory_order_acquire );
+    return Written - Read;
 }
 
 // -----------------------------------------------------------------------------
 
-bool IsSourcePlaying( ALuint SourceID )
+unsigned SoundRingBuffer::GetFreeSamples()
 {
-    return (GetSourceState( SourceID ) == AL_PLAYING);
+    return RING_BUFFER_SAMPLES - GetFilledSamples();
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned SoundRingBuffer::Write( const SPUSample* Source, unsigned NumberOfSamples )
+{
+    // the producer is the only writer of its own position
+    uint32_t Written = WritePosition.load( memory_order_relaxed );
+    uint32_t Read = ReadPosition.load( memory_order_acquire );
+    
+    // never overwrite samples not yet consumed
+    unsigned FreeSamples = RING_BUFFER_SAMPLES - (Written - Read);
+    NumberOfSamples = min( NumberOfSamples, FreeSamples );
+    
+    // copy in up to 2 sections, since data may wrap around
+    unsigned StartIndex = Written & (RING_BUFFER_SAMPLES - 1);
+    unsigned FirstSection = min( NumberOfSamples, RING_BUFFER_SAMPLES - StartIndex );
+    memcpy( &Samples[ StartIndex ], Source, FirstSection * 4 );
+    memcpy( &Samples[ 0 ], Source + FirstSection, (NumberOfSamples - FirstSection) * 4 );
+    
+    // publish the samples only after they are copied
+    WritePosition.store( Written + NumberOfSamples, memory_order_release );
+    return NumberOfSamples;
+}
+
+// -----------------------------------------------------------------------------
+
+SPUSample SoundRingBuffer::Peek( unsigned Offset )
+{
+    uint32_t Read = ReadPosition.load( memory_order_relaxed );
+    return Samples[ (Read + Offset) & (RING_BUFFER_SAMPLES - 1) ];
+}
+
+// -----------------------------------------------------------------------------
+
+void SoundRingBuffer::Skip( unsigned NumberOfSamples )
+{
+    // release the samples back to the producer
+    uint32_t Read = ReadPosition.load( memory_order_relaxed );
+    ReadPosition.store( Read + NumberOfSamples, memory_order_release );
+}
+
+// -----------------------------------------------------------------------------
+
+void SoundRingBuffer::Clear()
+{
+    ReadPosition.store( WritePosition.load( memory_order_acquire ), memory_order_release );
 }
 
 
@@ -72,31 +107,29 @@ bool IsSourcePlaying( ALuint SourceID )
 
 AudioOutput::AudioOutput()
 {
-    // set null IDs for OpenAL objects
-    SoundSourceID = 0;
-    
-    // initial state for buffers
-    for( int i = 0; i < MAX_BUFFERS; i++ )
-      PlaybackBuffers[ i ].BufferID = 0;
+    // no audio device is open yet
+    DeviceID = 0;
     
     // set default configuration for sound buffers
     NumberOfBuffers = 6;      // audio latency would be (6 / 2) * (1/60 s) = 50 ms
+    TargetFillSamples = (NumberOfBuffers / 2) * Constants::SPUSamplesPerFrame;
     
     // initial state for playback variables
-    PlaybackThread = nullptr;
-    ThreadExitFlag = false;
-    ThreadPauseFlag = true;
+    PlaybackRate = 1.0;
+    ResamplingPhase = 0.0;
+    Underruns = 0;
     
     // initial state for output volume control
     OutputVolume = 1.0;
     Mute = false;
+    UpdateOutputGain();
 }
 
 // -----------------------------------------------------------------------------
 
 AudioOutput::~AudioOutput()
 {
-    // release OpenAL objects
+    // release the audio device
     Terminate();
 }
 
@@ -108,23 +141,30 @@ AudioOutput::~AudioOutput()
 
 void AudioOutput::Initialize()
 {
-    // don't try next operations without OpenAL active
-    if( !IsOpenALActive() )
-      THROW( "OpenAL is not active" );
-    
-    // create sound buffers to alternate streaming
-    for( int i = 0; i < MAX_BUFFERS; i++ )
-      alGenBuffers( 1, &PlaybackBuffers[ i ].BufferID );
-    
-    // create a sound SourceID to play the buffers
-    alGenSources( 1, &SoundSourceID );
-    
-    // configure sound source
-    alSource3f( SoundSourceID, AL_POSITION, 0, 0, 0 );
-    alSourcef ( SoundSourceID, AL_GAIN, (Mute? 0 : OutputVolume) );
-    
-    // start the playback thread
-    LaunchPlaybackThread();
+    LOG( "Opening audio device" );
+    
+    // request the same format produced by the SPU,
+    // so that SDL does not need to convert anything
+    SDL_AudioSpec RequestedSpec, ObtainedSpec;
+    SDL_zero( RequestedSpec );
+    RequestedSpec.freq = Constants::SPUSamplingRate;
+    RequestedSpec.format = AUDIO_S16SYS;
+    RequestedSpec.channels = 2;
+    RequestedSpec.samples = DEVICE_BUFFER_SAMPLES;
+    RequestedSpec.callback = AudioPlaybackCallback;
+    RequestedSpec.userdata = this;
+    
+    // if the device works differently SDL will convert our
+    // output, so our callback format is always the same
+    DeviceID = SDL_OpenAudioDevice( nullptr, 0, &RequestedSpec, &ObtainedSpec, 0 );
+    
+    if( !DeviceID )
+      THROW( string("Cannot open audio device: ") + SDL_GetError() );
+    
+    LOG( "Audio device buffer is " + to_string( ObtainedSpec.samples ) + " samples" );
+    
+    // stay silent until the console is powered on
+    SDL_PauseAudioDevice( DeviceID, 1 );
 }
 
 // -----------------------------------------------------------------------------
@@ -132,32 +172,14 @@ void AudioOutput::Initialize()
 void AudioOutput::Terminate()
 {
     // do nothing if audio was not initialized
-    if( !SoundSourceID )
+    if( !DeviceID )
       return;
     
-    // don't try next operations without OpenAL active
-    if( !IsOpenALActive() )
-      return;
-    
-    // stop sound emission
-    // (must be done before clearing queue or unattaching buffer)
-    alSourceStop( SoundSourceID );
-    
-    // remove any pending queued buffers
-    ClearBufferQueue();
-    
-    // unattach any buffer from the source
-    alSourcei( SoundSourceID, AL_BUFFER, 0 );
-    
-    // stop the playback thread
-    StopPlaybackThread();
-    
-    // delete sound buffers
-    for( int i = 0; i < MAX_BUFFERS; i++ )
-      alDeleteBuffers( 1, &PlaybackBuffers[ i ].BufferID );
+    LOG( "Closing audio device" );
     
-    // delete sound source
-    alDeleteSources( 1, &SoundSourceID );
+    // this also waits for any running callback to finish
+    SDL_CloseAudioDevice( DeviceID );
+    DeviceID = 0;
 }
 
 // =============================================================================
@@ -168,6 +190,10 @@ void AudioOutput::Terminate()
 void AudioOutput::SetNumberOfBuffers( int NewNumberOfBuffers )
 {
     NumberOfBuffers = NewNumberOfBuffers;
+    Clamp( NumberOfBuffers, MIN_BUFFERS, MAX_BUFFERS );
+    
+    // rate control will progressively adapt to the new target
+    TargetFillSamples = (NumberOfBuffers / 2) * Constants::SPUSamplesPerFrame;
 }
 
 // -----------------------------------------------------------------------------
@@ -185,29 +211,13 @@ int AudioOutput::GetNumberOfBuffers()
 
 void AudioOutput::Reset()
 {
-    // reset playback variables
-    ThreadExitFlag = false;
-    ThreadPauseFlag = true;
-    
     // stop any currently playing sounds
-    alSourceStop( SoundSourceID );
-    ClearBufferQueue();
-    
-    // reset all output buffers
-    for( int i = 0; i < MAX_BUFFERS; i++ )
-    {
-        memset( PlaybackBuffers[ i ].Contents.Samples, 0, Constants::SPUSamplesPerFrame * 4 );
-        PlaybackBuffers[ i ].State = SoundBufferStates::ToBeFilled;
-        PlaybackBuffers[ i ].Contents.SequenceNumber = 0;
-    }
+    SDL_PauseAudioDevice( DeviceID, 1 );
+    ClearOutputRing();
     
     // reinitialize audio playback
-    InitializeBufferQueue();
-    ThreadPauseFlag = false;
-    alSourcePlay( SoundSourceID );
-    
-    // reset sound volume
-    alSourcef( SoundSourceID, AL_GAIN, (Mute? 0 : OutputVolume) );
+    InitializeOutputRing();
+    SDL_PauseAudioDevice( DeviceID, 0 );
     
     // do NOT reset output volume configuration!
 }
@@ -216,15 +226,7 @@ void AudioOutput::Reset()
 
 void AudioOutput::ChangeFrame()
 {
-    // ensure sound is never paused while the SPU is
-    // actually running (this is a fail-safe mechanism
-    // to prevent the emulator from losing audio in
-    // some specific window, input or file events)
-    if( !IsSourcePlaying( SoundSourceID ) )
-      alSourcePlay( SoundSourceID );
-    
-    if( ThreadPauseFlag )
-      ThreadPauseFlag = false;
+    EnsureDevicePlays();
     
     // use next frame's sound
     FillNextSoundBuffer();
@@ -234,308 +236,282 @@ void AudioOutput::ChangeFrame()
 
 void AudioOutput::Pause()
 {
-    ThreadPauseFlag = true;
-    alSourcePause( SoundSourceID );
+    SDL_PauseAudioDevice( DeviceID, 1 );
 }
 
 // -----------------------------------------------------------------------------
 
 void AudioOutput::Resume()
 {
-    // do nothing when not applicable
-    if( !ThreadPauseFlag ) return;
-    
-    // take resume actions
-    alSourcePlay( SoundSourceID );
-    ThreadPauseFlag = false;
+    SDL_PauseAudioDevice( DeviceID, 0 );
 }
 
 
 // =============================================================================
-//      AUDIO OUTPUT: EXTERNAL VOLUME CONTROL
+//      AUDIO OUTPUT: FAST-FORWARD OPERATION
 // =============================================================================
 
 
-void AudioOutput::SetOutputVolume( float Volume )
+void AudioOutput::StoreCompressedFrame()
 {
-    OutputVolume = Volume;
-    Clamp( OutputVolume, 0, 1 );
+    // obtain sound output for the current frame
+    Console.GetFrameSoundOutput( FrameBuffer );
     
-    // within SPU output volume works linearly
-    // (it is just a gain level) but here we
-    // will treat it quadratically to get the
-    // human-perceived output volume level
-    // vary in a more progressive way
-    float QuadraticVolume = OutputVolume * OutputVolume;
-    alSourcef( SoundSourceID, AL_GAIN, (Mute? 0 : QuadraticVolume) );
+    // when too many frames accumulate, drop the rest
+    if( CompressionInput.size() >= (size_t)MAX_COMPRESSED_FRAMES * Constants::SPUSamplesPerFrame )
+      return;
+    
+    CompressionInput.insert
+    (
+        CompressionInput.end(),
+        FrameBuffer.Samples,
+        FrameBuffer.Samples + Constants::SPUSamplesPerFrame
+    );
 }
 
 // -----------------------------------------------------------------------------
 
-float AudioOutput::GetOutputVolume()
+void AudioOutput::OutputCompressedFrames( int RealTimeFrames )
 {
-    return OutputVolume;
+    // keep stored frames until some real time has passed
+    // (with high refresh rates not all updates advance it)
+    if( RealTimeFrames <= 0 || CompressionInput.empty() )
+      return;
+    
+    EnsureDevicePlays();
+    
+    // each output sample is the average of its group
+    // of input samples: this acts as a low-pass filter
+    // that avoids most of the aliasing from decimation
+    size_t InputSamples = CompressionInput.size();
+    size_t OutputSamples = min( InputSamples, (size_t)RealTimeFrames * Constants::SPUSamplesPerFrame );
+    CompressionOutput.resize( OutputSamples );
+    
+    for( size_t Output = 0; Output < OutputSamples; Output++ )
+    {
+        size_t GroupStart = Output * InputSamples / OutputSamples;
+        size_t GroupEnd = (Output + 1) * InputSamples / OutputSamples;
+        int SumLeft = 0, SumRight = 0;
+        
+        for( size_t Input = GroupStart; Input < GroupEnd; Input++ )
+        {
+            SumLeft += CompressionInput[ Input ].LeftSample;
+            SumRight += CompressionInput[ Input ].RightSample;
+        }
+        
+        int GroupSize = (int)(GroupEnd - GroupStart);
+        CompressionOutput[ Output ].LeftSample = SumLeft / GroupSize;
+        CompressionOutput[ Output ].RightSample = SumRight / GroupSize;
+    }
+    
+    // as in normal operation, excess is dropped if the ring is full
+    OutputRing.Write( CompressionOutput.data(), OutputSamples );
+    CompressionInput.clear();
 }
 
 // -----------------------------------------------------------------------------
 
-void AudioOutput::SetMute( bool NewMute )
+void AudioOutput::DiscardCompressedFrames()
 {
-    Mute = NewMute;
-    alSourcef( SoundSourceID, AL_GAIN, (Mute? 0 : OutputVolume) );
+    CompressionInput.clear();
 }
 
-// -----------------------------------------------------------------------------
 
-bool AudioOutput::IsMuted()
+// =============================================================================
+//      AUDIO OUTPUT: PLAYBACK STATUS
+// =============================================================================
+
+
+// current playback speed relative to the nominal one
+float AudioOutput::GetPlaybackRate()
 {
-    return Mute;
+    return PlaybackRate;
 }
 
+// -----------------------------------------------------------------------------
 
-// =============================================================================
-//      AUDIO OUTPUT: GENERATING SOUND
-// =============================================================================
+// this is the current audio latency, measured in frames
+float AudioOutput::GetBufferedFrames()
+{
+    return OutputRing.GetFilledSamples() / (float)Constants::SPUSamplesPerFrame;
+}
 
+// -----------------------------------------------------------------------------
 
-// this function is only called from the main thread;
-// returns true if successful
-bool AudioOutput::FillNextSoundBuffer()
+// number of times the audio device ran out of samples
+unsigned AudioOutput::GetUnderruns()
 {
-    SoundBuffer* Buffer = FindNextBufferToFill();
-    if( !Buffer ) return false;
-    
-    // obtain sound output for the current frame
-    Console.GetFrameSoundOutput( Buffer->Contents );
-    
-    // ignore OpenAL errors so far
-    alGetError();
-    
-    // copy our local buffer to internal OpenAL one
-    alBufferData( Buffer->BufferID, AL_FORMAT_STEREO16, Buffer->Contents.Samples, Constants::SPUSamplesPerFrame * 4, Constants::SPUSamplingRate );
-    
-    // finally, change buffer state
-    Buffer->State = SoundBufferStates::Filled;
-    return (alGetError() == AL_NO_ERROR);
+    return Underruns;
 }
 
 
 // =============================================================================
-//      AUDIO OUTPUT: SEARCHING FOR SOUND BUFFERS
+//      AUDIO OUTPUT: EXTERNAL VOLUME CONTROL
 // =============================================================================
 
 
-SoundBuffer& AudioOutput::FindBufferFromID( ALuint TargetID )
+void AudioOutput::SetOutputVolume( float Volume )
 {
-    for( int i = 0; i < NumberOfBuffers; i++ )
-      if( PlaybackBuffers[ i ].BufferID == TargetID )
-        return PlaybackBuffers[ i ];
-    
-    THROW( "Cannot find OpenAL buffer ID in SPU output buffers" );
+    OutputVolume = Volume;
+    Clamp( OutputVolume, 0, 1 );
+    UpdateOutputGain();
 }
 
 // -----------------------------------------------------------------------------
 
-SoundBuffer* AudioOutput::FindNextBufferToPlay()
+float AudioOutput::GetOutputVolume()
 {
-    int MinimumSequenceNumber = INT_MAX;
-    SoundBuffer* NextBufferToPlay = nullptr;
-    
-    for( int i = 0; i < NumberOfBuffers; i++ )
-      if( PlaybackBuffers[ i ].State == SoundBufferStates::Filled )
-        if( PlaybackBuffers[ i ].Contents.SequenceNumber <= MinimumSequenceNumber )
-        {
-            MinimumSequenceNumber = PlaybackBuffers[ i ].Contents.SequenceNumber;
-            NextBufferToPlay = &PlaybackBuffers[ i ];
-        }
-    
-    return NextBufferToPlay;
+    return OutputVolume;
 }
 
 // -----------------------------------------------------------------------------
 
-SoundBuffer* AudioOutput::FindNextBufferToFill()
+void AudioOutput::SetMute( bool NewMute )
 {
-    // we can refill buffers in any order, so we don't
-    // need to look for the lowest sequence number here
-    for( int i = 0; i < NumberOfBuffers; i++ )
-      if( PlaybackBuffers[ i ].State == SoundBufferStates::ToBeFilled )
-        return &PlaybackBuffers[ i ];
-    
-    return nullptr;
+    Mute = NewMute;
+    UpdateOutputGain();
 }
 
+// -----------------------------------------------------------------------------
 
-// =============================================================================
-//      AUDIO OUTPUT: HANDLING PLAYBACK BUFFER QUEUE
-// =============================================================================
-
-
-int AudioOutput::GetQueuedBuffers()
+bool AudioOutput::IsMuted()
 {
-    int QueuedBuffers = 0;
-    alGetSourcei( SoundSourceID, AL_BUFFERS_QUEUED, &QueuedBuffers );
-    
-    return max( QueuedBuffers, 0 );
+    return Mute;
 }
 
 // -----------------------------------------------------------------------------
 
-// NOTE: read the documentation for all cases regarding AL_BUFFERS_PROCESSED
-// (will only work right with source state AL_PLAYING)
-int AudioOutput::GetProcessedBuffers()
+void AudioOutput::UpdateOutputGain()
 {
-    // without this check, the playback thread produces "invalid operation" error on exit
-    int SourceState;
-    alGetSourcei( SoundSourceID, AL_SOURCE_STATE, &SourceState );
-    
-    if( SourceState != AL_PLAYING )
-      return 0;
-    
-    // now do the actual check for buffers
-    int ProcessedBuffers = 0;
-    alGetSourcei( SoundSourceID, AL_BUFFERS_PROCESSED, &ProcessedBuffers );
-    
-    return max( ProcessedBuffers, 0 );
+    // within SPU output volume works linearly
+    // (it is just a gain level) but here we
+    // will treat it quadratically to get the
+    // human-perceived output volume level
+    // vary in a more progressive way
+    float QuadraticVolume = OutputVolume * OutputVolume;
+    OutputGain = (Mute? 0 : QuadraticVolume);
 }
 
-// -----------------------------------------------------------------------------
 
-// NOTE: read the documentation for alSourceUnqueueBuffers
-// (will only work right with source state AL_STOPPED)
-void AudioOutput::ClearBufferQueue()
+// =============================================================================
+//      AUDIO OUTPUT: GENERATING SOUND
+// =============================================================================
+
+
+// called before any sound is queued, both for
+// normal frames and for compressed ones
+void AudioOutput::EnsureDevicePlays()
 {
-    int SourceState;
-    alGetSourcei( SoundSourceID, AL_SOURCE_STATE, &SourceState );
-    
-    if( SourceState != AL_STOPPED )
-      return;
-    
-    // remove all buffers from the queue
-    try
-    {
-        // obtain the number of buffers queued for play in the source
-        int QueuedBuffers = GetQueuedBuffers();
-        
-        // remove each buffer
-        while( QueuedBuffers-- )
-        {
-            ALuint QueuedBufferID = 0;
-            alSourceUnqueueBuffers( SoundSourceID, 1, &QueuedBufferID );
-        }
-        
-        // update state for all buffers
-        for( int i = 0; i < NumberOfBuffers; i++ )
-          PlaybackBuffers[ i ].State = SoundBufferStates::ToBeFilled;
-    }
-    
-    catch( const exception& e )
-    {
-        LOG( "Exception clearing sound buffer queue: " + string(e.what()) );
-    }
+    // ensure sound is never paused while the SPU is
+    // actually running (this is a fail-safe mechanism
+    // to prevent the emulator from losing audio in
+    // some specific window, input or file events)
+    if( SDL_GetAudioDeviceStatus( DeviceID ) != SDL_AUDIO_PLAYING )
+      SDL_PauseAudioDevice( DeviceID, 0 );
 }
 
 // -----------------------------------------------------------------------------
 
-void AudioOutput::InitializeBufferQueue()
+// this function is only called from the main thread;
+// returns true if the whole frame could be stored
+bool AudioOutput::FillNextSoundBuffer()
 {
-    // we will only fill half of the buffers
-    // (the rest are left free for later use)
-    for( int i = 0; i < NumberOfBuffers / 2 ; i++ )
-      FillNextSoundBuffer();
+    Tracer.Begin( "audio", "Audio queue" );
+    
+    // obtain sound output for the current frame
+    Console.GetFrameSoundOutput( FrameBuffer );
     
-    // as an exception, this one time we will
-    // need to call this from the main thread;
-    // but it is still safe: at this point the
-    // playback thread is paused and the sound
-    // source is stopped 
-    QueueFilledBuffers();
+    // when the ring is full the excess is dropped: this
+    // can only happen if the host runs frames faster than
+    // real time, so losing samples is the right response
+    unsigned Written = OutputRing.Write( FrameBuffer.Samples, Constants::SPUSamplesPerFrame );
+    
+    Tracer.Counter( "audio", "Queued samples", OutputRing.GetFilledSamples() );
+    Tracer.End( "audio", "Audio queue" );
+    return (Written == (unsigned)Constants::SPUSamplesPerFrame);
 }
 
 // -----------------------------------------------------------------------------
 
-// this function is only called from the playback thread,
-// with only one exception for initial queuing on reset
-void AudioOutput::QueueFilledBuffers()
+// this function is only called from the audio thread
+void AudioOutput::ProduceDeviceSamples( SPUSample* Output, int NumberOfSamples )
 {
-    while( true )
+    // dynamic rate control: consume samples slightly faster
+    // when the ring is above its target fill level, or
+    // slightly slower when below; this compensates small
+    // clock differences between emulation and audio device
+    // without the pitch shift being perceptible
+    int FilledSamples = OutputRing.GetFilledSamples();
+    int TargetSamples = TargetFillSamples;
+    float FillDeviation = (FilledSamples - TargetSamples) / (float)TargetSamples;
+    Clamp( FillDeviation, -1, 1 );
+    
+    float Rate = 1.0 + MAX_RATE_DEVIATION * FillDeviation;
+    float Gain = OutputGain;
+    PlaybackRate = Rate;
+    
+    // read samples with linear interpolation;
+    // a sample is only released when both of
+    // its neighbours have already been used
+    unsigned Consumed = 0;
+    int s = 0;
+    
+    for( ; s < NumberOfSamples; s++ )
     {
-        SoundBuffer* BufferToPlay = FindNextBufferToPlay();
-        if( !BufferToPlay ) return;
+        if( (int)(Consumed + 2) > FilledSamples )
+          break;
+        
+        SPUSample Previous = OutputRing.Peek( Consumed );
+        SPUSample Next = OutputRing.Peek( Consumed + 1 );
+        
+        float Left  = Previous.LeftSample  + ResamplingPhase * (Next.LeftSample  - Previous.LeftSample );
+        float Right = Previous.RightSample + ResamplingPhase * (Next.RightSample - Previous.RightSample);
+        Output[ s ].LeftSample  = (int16_t)(Gain * Left);
+        Output[ s ].RightSample = (int16_t)(Gain * Right);
         
-        // put them in the source play queue 
-        alSourceQueueBuffers( SoundSourceID, 1, &BufferToPlay->BufferID );
-        BufferToPlay->State = SoundBufferStates::QueuedToPlay;
+        // advance at current rate
+        ResamplingPhase += Rate;
+        unsigned Advance = (unsigned)ResamplingPhase;
+        ResamplingPhase -= Advance;
+        Consumed += Advance;
     }
-}
-
-// -----------------------------------------------------------------------------
-
-// this function is only called from the playback thread
-void AudioOutput::UnqueuePlayedBuffers()
-{
-    // state validations
-    if( !GetQueuedBuffers() )
-      return;
     
-    // query number of queued buffers already processed
-    int ProcessedBuffers = GetProcessedBuffers();
+    OutputRing.Skip( min( Consumed, (unsigned)FilledSamples ) );
     
-    // unqueue every processed buffer
-    while( ProcessedBuffers-- )
+    // on underrun, fill the rest with silence
+    if( s < NumberOfSamples )
     {
-        ALuint ProcessedBufferID = 0;
-        alSourceUnqueueBuffers( SoundSourceID, 1, &ProcessedBufferID );
-        
-        // buffer is ready to be refilled
-        SoundBuffer& UnqueuedBuffer = FindBufferFromID( ProcessedBufferID );
-        UnqueuedBuffer.State = SoundBufferStates::ToBeFilled;
+        memset( &Output[ s ], 0, (NumberOfSamples - s) * 4 );
+        Underruns++;
+        Tracer.Instant( "audio", "Underrun", NumberOfSamples - s );
     }
 }
 
 
 // =============================================================================
-//      AUDIO OUTPUT: HANDLING PLAYBACK THREAD
+//      AUDIO OUTPUT: HANDLING THE RING BUFFER
 // =============================================================================
 
 
-void AudioOutput::LaunchPlaybackThread()
+// this function is only called while the device is paused
+void AudioOutput::ClearOutputRing()
 {
-    LOG( "Creating audio playback thread" );
-    
-    // ensure thread continuity, but don't play yet
-    ThreadExitFlag = false;
-    ThreadPauseFlag = true;
-    
-    // create thread, if needed
-    if( !PlaybackThread )
-    {
-        PlaybackThread = SDL_CreateThread
-        (
-            AudioPlaybackThread,   // function to use as thread entry point
-            "Playback",            // thread name
-            this                   // function parameters (= the owner instance)
-        );
-    }
-    
-    if( !PlaybackThread )
-      THROW( "Could not create audio playback thread" );
+    // a paused device may still be inside a callback
+    SDL_LockAudioDevice( DeviceID );
+    OutputRing.Clear();
+    ResamplingPhase = 0.0;
+    PlaybackRate = 1.0;
+    SDL_UnlockAudioDevice( DeviceID );
 }
 
 // -----------------------------------------------------------------------------
 
-void AudioOutput::StopPlaybackThread()
+void AudioOutput::InitializeOutputRing()
 {
-    LOG( "Stopping audio playback thread" );
-    
-    ThreadExitFlag = true;
-    
-    // wait for thread to terminate (only for a limited time)
-    if( PlaybackThread )
-    {
-        int ExitCode = 0;
-        SDL_WaitThread( PlaybackThread, &ExitCode );
-    }
+    // start at the target fill level, so that the first
+    // frames can be produced before playback underruns
+    memset( FrameBuffer.Samples, 0, sizeof(FrameBuffer.Samples) );
     
-    PlaybackThread = nullptr;
+    for( int i = 0; i < NumberOfBuffers / 2; i++ )
+      OutputRing.Write( FrameBuffer.Samples, Constants::SPUSamplesPerFrame );
 }
@@ -8,15 +8,8 @@
     
     // include C/C++ headers
     #include <string>		    // [ C++ STL ] Strings
-    
-    // include OpenAL headers
-    #if defined(__APPLE__)
-      #include <OpenAL/al.h>    // [ OpenAL ] Main header
-      #include <OpenAL/alc.h>   // [ OpenAL ] Audio contexts
-    #else
-      #include <AL/al.h>        // [ OpenAL ] Main header
-      #include <AL/alc.h>       // [ OpenAL ] Audio contexts
-    #endif
+    #include <atomic>           // [ C++ STL ] Atomic variables
+    #include <vector>           // [ C++ STL ] Vectors
     
     // include SDL2 headers
     #define SDL_MAIN_HANDLED
@@ -25,59 +18,75 @@
 
 
 // =============================================================================
-//      DEFINITIONS FOR SOUND BUFFERS
+//      DEFINITIONS FOR SOUND BUFFERING
 // =============================================================================
 
 
-// Our sound system uses a set of sound buffers that are
-// continuously re-filled and re-queued to prevent audio
-// output from ever running out of sound samples (which
-// would produce clicks, silences, or terminate audio).
-// Buffers can be configured in number within these limits
-// to adapt audio timing to each system. Adding buffers
-// will increase audio latency but will ensure that less
-// capable systems have enough time to update audio and
-// therefore prevent sound problems.
+// The SPU generates 1 frame of audio (44100 / 60 samples)
+// each time the console runs a frame. These samples are
+// stored in a ring buffer that the audio device consumes
+// from its own thread. The configured number of buffers
+// (measured in frames) is kept within these limits, and
+// half of it is used as the target fill level for the
+// ring. Adding buffers will increase audio latency but
+// will ensure that less capable systems have enough time
+// to update audio and therefore prevent sound problems.
 
 #define MIN_BUFFERS            4
 #define MAX_BUFFERS           16
 
-// -----------------------------------------------------------------------------
-
-// We will use these 3 states to handle audio buffers.
-// Thread safety is achieved by making each thread act
-// only over different sets of buffer states, so they
-// can never be operating over the same buffer at once.
-enum class SoundBufferStates
-{
-    ToBeFilled,     // only handled by the main thread
-    Filled,         // only handled by the playback thread
-    QueuedToPlay    // only handled by the playback thread
-};
+// ring size in samples: must be a power of 2,
+// and large enough to hold MAX_BUFFERS frames
+#define RING_BUFFER_SAMPLES  16384
 
-// -----------------------------------------------------------------------------
+// number of samples requested by the audio device
+// on each callback (this determines its granularity)
+#define DEVICE_BUFFER_SAMPLES  512
 
-// define the sound buffers used for SPU audio output;
-// buffers contain 1 frame of audio = 44100 / 60 samples
-typedef struct
-{
-    ALuint BufferID;
-    SoundBufferStates State;
-    V32::SPUOutputBuffer Contents;
-}
-SoundBuffer;
+// the playback rate is nudged by at most this fraction
+// to drive the ring fill level towards its target,
+// (0.5% is below the threshold of perceptible pitch)
+#define MAX_RATE_DEVIATION    0.005
 
+// in fast-forward, audio from all frames run in an update
+// is compressed to last as long as the real time elapsed.
+// Frames beyond this limit are dropped before compression
+#define MAX_COMPRESSED_FRAMES    64
 
-// =============================================================================
-//      AUXILIARY AUDIO FUNCTIONS
-// =============================================================================
-
-// checking that OpenAL is active
-bool IsOpenALActive();
+// -----------------------------------------------------------------------------
 
-// source properties
-ALenum GetSourceState( ALuint SourceID );
-bool IsSourcePlaying ( ALuint SourceID );
+// Lock-free ring buffer for a single producer (the main
+// thread) and a single consumer (the audio thread). Both
+// positions are free-running counters: each thread only
+// writes its own position, and reads the other one
+class SoundRingBuffer
+{
+    private:
+        
+        V32::SPUSample Samples[ RING_BUFFER_SAMPLES ];
+        std::atomic< uint32_t > WritePosition;
+        std::atomic< uint32_t > ReadPosition;
+        
+    public:
+        
+        // instance handling
+        SoundRingBuffer();
+        
+        // can be called from either thread
+        unsigned GetFilledSamples();
+        unsigned GetFreeSamples();
+        
+        // only called from the producer thread;
+        // returns the number of samples written
+        unsigned Write( const V32::SPUSample* Source, unsigned NumberOfSamples );
+        
+        // only called from the consumer thread
+        V32::SPUSample Peek( unsigned Offset );
+        void Skip( unsigned NumberOfSamples );
+        
+        // only safe while the consumer is stopped
+        void Clear();
+};
 
 
 // =============================================================================
@@ -85,8 +94,8 @@ bool IsSourcePlaying ( ALuint SourceID );
 // =============================================================================
 
 
-// thread function for background continuous play
-int AudioPlaybackThread( void* Parameters );
+// callback invoked by SDL from its audio thread
+void AudioPlaybackCallback( void* Parameters, Uint8* Stream, int Bytes );
 
 
 // =============================================================================
@@ -98,21 +107,27 @@ class AudioOutput
 {
     public:
         
-        // OpenAL mixer objects
-        ALuint SoundSourceID;
+        // SDL audio device
+        SDL_AudioDeviceID DeviceID;
         
         // sound buffer configuration
         int NumberOfBuffers;
-        SoundBuffer PlaybackBuffers[ MAX_BUFFERS ];
-    
-        // Variables for playback thread
-        friend int AudioPlaybackThread( void* );
-        SDL_Thread* PlaybackThread;
+        SoundRingBuffer OutputRing;
+        
+        // buffer to receive each frame from the SPU
+        V32::SPUOutputBuffer FrameBuffer;
+        
+        // buffers to time-compress audio in fast-forward
+        std::vector< V32::SPUSample > CompressionInput;
+        std::vector< V32::SPUSample > CompressionOutput;
         
-        // variables accessed by the thread for playback control
-        std::string ThreadErrorMessage;     // used by the playback thread to report errors on exceptions
-        bool ThreadExitFlag;                // used by the main thread to stop the playing thread
-        bool ThreadPauseFlag;               // used by the main thread to hold the playing thread on pause
+        // variables accessed by the callback for playback control
+        friend void AudioPlaybackCallback( void*, Uint8*, int );
+        std::atomic< unsigned > TargetFillSamples;      // written by the main thread
+        std::atomic< float > OutputGain;                // written by the main thread
+        std::atomic< float > PlaybackRate;              // written by the audio thread
+        std::atomic< unsigned > Underruns;              // written by the audio thread
+        double ResamplingPhase;                         // only used by the audio thread
         
         // external volume control
         float OutputVolume;
@@ -125,24 +140,16 @@ class AudioOutput
         // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
         
         // generate sound to play
+        void EnsureDevicePlays();
         bool FillNextSoundBuffer();
         
-        // searching for sound buffers
-        SoundBuffer& FindBufferFromID( ALuint TargetID );
-        SoundBuffer* FindNextBufferToPlay();
-        SoundBuffer* FindNextBufferToFill();
+        // handling the ring buffer
+        void ClearOutputRing();
+        void InitializeOutputRing();
+        void UpdateOutputGain();
         
-        // handling playback buffer queue
-        int GetQueuedBuffers();
-        int GetProcessedBuffers();
-        void UnqueuePlayedBuffers();
-        void QueueFilledBuffers();
-        void ClearBufferQueue();
-        void InitializeBufferQueue();
-        
-        // operating the playback thread
-        void LaunchPlaybackThread();
-        void StopPlaybackThread();
+        // only called from the audio thread
+        void ProduceDeviceSamples( V32::SPUSample* Output, int NumberOfSamples );
         
     public:
         
@@ -164,6 +171,17 @@ class AudioOutput
         void Pause();
         void Resume();
         
+        // fast-forward operation: frames are stored, and
+        // then output together in the time of real frames
+        void StoreCompressedFrame();
+        void OutputCompressedFrames( int RealTimeFrames );
+        void DiscardCompressedFrames();
+        
+        // playback status
+        float GetPlaybackRate();
+        float GetBufferedFrames();
+        unsigned GetUnderruns();
+        
         // external volume control
         float GetOutputVolume();
         void SetOutputVolume( float Volume );
@@ -4,91 +4,49 @@
     
     // include emulator headers
     #include "AudioOutput.hpp"
+    #include "EventTracer.hpp"
+    #include "Globals.hpp"
     
     // include C/C++ headers
-    #include <stdexcept>        // [ C++ STL ] Exceptions
-    #include <iostream>         // [ C++ STL ] I/O Streams
+    #include <cstring>          // [ ANSI C ] Strings
     
     // declare used namespaces
     using namespace std;
+    using namespace V32;
 // *****************************************************************************
 
 
 /* -------------------------------------------------------------------------- //
     THREAD SAFETY CONSIDERATIONS:
     -------------------------------
-    (1) Thread needs synchronization to access AudioOutput instance variables
-    (2) Any exceptions thrown need to be caught, since they cannot trespass
-        the boundary to the main thread
+    (1) This callback runs in SDL's audio thread, so it can only access
+        the AudioOutput instance through its ring buffer and its atomic
+        playback control variables
+    (2) It must never block, allocate memory, or throw exceptions: when
+        no samples are available it just outputs silence
 // -------------------------------------------------------------------------- */
 
 
 // =============================================================================
-//      THREAD FUNCTION FOR BACKGROUND CONTINUOUS PLAY
+//      CALLBACK FUNCTION FOR BACKGROUND CONTINUOUS PLAY
 // =============================================================================
 
 
-int AudioPlaybackThread( void* Parameters )
+void AudioPlaybackCallback( void* Parameters, Uint8* Stream, int Bytes )
 {
-    // thread exit code defaults to success
-    int ExitCode = 0;
-    
     // (1) obtain class instance from parameters
-    if( !Parameters )
-    {
-        LOG( "Audio thread: Audio output instance not received" );
-        return 1;
-    }
-    
     AudioOutput* AudioInstance = (AudioOutput*)Parameters;
     
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    
-    try
-    {
-        // (2) keep thread alive until audio output stops it
-        while( !AudioInstance->ThreadExitFlag )
-        {
-            // (2.1) if not paused, update sound buffers
-            if( !AudioInstance->ThreadPauseFlag )
-            {
-                AudioInstance->QueueFilledBuffers();
-                AudioInstance->UnqueuePlayedBuffers();
-            }
-            
-            // (2.2) when idle, sleep and re-check playback state periodically
-            SDL_Delay( 5 );
-        }
-        
-        LOG( "Audio thread exiting" );
-    }
-    
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    //   THREAD TERMINATION HANDLING
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    
-    catch( const exception& e )
-    {
-        // log in thread
-        LOG( "[EXCEPTION]: In audio thread: " + string(e.what()) );
-        
-        // store exception message to treat it in the main thread
-        // (necessary since exceptions do not cross threads)
-        AudioInstance->ThreadErrorMessage = e.what();
-        
-        // provide an error exit code
-        ExitCode = 1;
-    }
-    
-    catch( ... )
+    if( !AudioInstance )
     {
-        // store exception message to treat it in the main thread
-        LOG( "[EXCEPTION]: In audio thread: Unknown exception happened" );
-        
-        // provide an error exit code
-        ExitCode = 2;
+        memset( Stream, 0, Bytes );
+        return;
     }
     
-    // provide exit code
-    return ExitCode;
+    // (2) device format is always stereo 16 bit,
+    // so each output sample takes 4 bytes
+    Tracer.SetThreadName( "Audio" );
+    Tracer.Begin( "audio", "Audio callback", Bytes / 4 );
+    AudioInstance->ProduceDeviceSamples( (SPUSample*)Stream, Bytes / 4 );
+    Tracer.End( "audio", "Audio callback" );
 }
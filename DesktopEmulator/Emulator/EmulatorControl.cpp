@@ -11,12 +11,15 @@
     #include "Settings.hpp"
     #include "AudioOutput.hpp"
     #include "VideoOutput.hpp"
+    #include "FrameCapture.hpp"
+    #include "FrameTelemetry.hpp"
     
     // include C/C++ headers
     #include <stdexcept>        // [ C++ STL ] Exceptions
     #include <iostream>         // [ C++ STL ] I/O Streams
     #include <climits>          // [ ANSI C ] Numeric limits
     #include <time.h>           // [ ANSI C ] Date and time
+    #include <algorithm>        // [ C++ STL ] Algorithms
     
     // declare used namespaces
     using namespace std;
@@ -33,6 +36,10 @@ EmulatorControl::EmulatorControl()
 {
     Paused = false;
     AutoCardHandling = true;
+    
+    FastForward = false;
+    SpeedMultiplier = 0;
+    PendingFastFrames = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -50,18 +57,18 @@ void EmulatorControl::Initialize()
     Audio.Initialize();
     
     // set console's video callbacks
-    V32::Callbacks::ClearScreen = CallbackFunctions::ClearScreen;
-    V32::Callbacks::DrawQuad = CallbackFunctions::DrawQuad;
-    V32::Callbacks::SetMultiplyColor = CallbackFunctions::SetMultiplyColor;
-    V32::Callbacks::SetBlendingMode = CallbackFunctions::SetBlendingMode;
-    V32::Callbacks::SelectTexture = CallbackFunctions::SelectTexture;
-    V32::Callbacks::LoadTexture = CallbackFunctions::LoadTexture;
-    V32::Callbacks::UnloadCartridgeTextures = CallbackFunctions::UnloadCartridgeTextures;
-    V32::Callbacks::UnloadBiosTexture = CallbackFunctions::UnloadBiosTexture;
+    Console.Callbacks.ClearScreen = CallbackFunctions::ClearScreen;
+    Console.Callbacks.DrawQuad = CallbackFunctions::DrawQuad;
+    Console.Callbacks.SetMultiplyColor = CallbackFunctions::SetMultiplyColor;
+    Console.Callbacks.SetBlendingMode = CallbackFunctions::SetBlendingMode;
+    Console.Callbacks.SelectTexture = CallbackFunctions::SelectTexture;
+    Console.Callbacks.LoadTexture = CallbackFunctions::LoadTexture;
+    Console.Callbacks.UnloadCartridgeTextures = CallbackFunctions::UnloadCartridgeTextures;
+    Console.Callbacks.UnloadBiosTexture = CallbackFunctions::UnloadBiosTexture;
     
     // set console's log callbacks
-    V32::Callbacks::LogLine = CallbackFunctions::LogLine;
-    V32::Callbacks::ThrowException = CallbackFunctions::ThrowException;
+    Console.Callbacks.LogLine = CallbackFunctions::LogLine;
+    Console.Callbacks.ThrowException = CallbackFunctions::ThrowException;
     
     // obtain current time
     time_t CreationTime;
@@ -158,15 +165,159 @@ void EmulatorControl::Reset()
 
 // -----------------------------------------------------------------------------
 
-void EmulatorControl::RunNextFrame()
+void EmulatorControl::RunNextFrame( bool Render )
 {
+    // when a frame is not rendered, the console still
+    // processes all GPU commands (so its timing and
+    // state are not affected) but no drawing operations
+    // reach the host GPU; all other callbacks still
+    // apply since their effects persist across frames
+    if( !Render )
+    {
+        Console.Callbacks.ClearScreen = CallbackFunctions::SkipClearScreen;
+        Console.Callbacks.DrawQuad = CallbackFunctions::SkipDrawQuad;
+    }
+    
+    TelemetryPhases PreviousPhase = Telemetry.SwitchPhase( TelemetryPhases::CPURun );
     Console.RunNextFrame();
-    Audio.ChangeFrame();
+    
+    ConsoleFrameCounters Counters;
+    Console.GetFrameCounters( Counters );
+    Telemetry.AddConsoleFrame( Counters );
+    
+    if( !Render )
+    {
+        Console.Callbacks.ClearScreen = CallbackFunctions::ClearScreen;
+        Console.Callbacks.DrawQuad = CallbackFunctions::DrawQuad;
+    }
+    
+    // in fast-forward, sound is output later
+    Telemetry.SwitchPhase( TelemetryPhases::AudioQueue );
+    
+    if( FastForward )
+      Audio.StoreCompressedFrame();
+    else
+      Audio.ChangeFrame();
+    
+    if( !Render )
+    {
+        Telemetry.SwitchPhase( PreviousPhase );
+        return;
+    }
     
     // ensure that all queued quads are rendered
+    Telemetry.SwitchPhase( TelemetryPhases::GPUSubmission );
     Video.RenderQuadQueue();
     
     // after running, ensure that all GPU
     // commands run in the current frame are drawn
     glFlush();   
+    Telemetry.SwitchPhase( PreviousPhase );
+    
+    // when recording, every rendered frame is captured
+    Capture.CaptureRenderedFrame();
+}
+
+// -----------------------------------------------------------------------------
+
+void EmulatorControl::RunFrames( int RealTimeFrames, double UpdatePeriod )
+{
+    if( !FastForward )
+    {
+        for( int i = 0; i < RealTimeFrames; i++ )
+          RunNextFrame();
+        
+        return;
+    }
+    
+    if( SpeedMultiplier > 0 )
+      RunFramesAtMultiplier( RealTimeFrames );
+    else
+      RunFramesAtMaximumSpeed( UpdatePeriod );
+    
+    // sound from all frames is played in real time
+    TelemetryPhases PreviousPhase = Telemetry.SwitchPhase( TelemetryPhases::AudioQueue );
+    Audio.OutputCompressedFrames( RealTimeFrames );
+    Telemetry.SwitchPhase( PreviousPhase );
+}
+
+// -----------------------------------------------------------------------------
+
+void EmulatorControl::RunFramesAtMultiplier( int RealTimeFrames )
+{
+    // accumulate fractions of frames across updates
+    PendingFastFrames += RealTimeFrames * SpeedMultiplier;
+    int Frames = min( (int)PendingFastFrames, FAST_FORWARD_MAX_FRAMES );
+    
+    // if the host cannot keep up, do not accumulate delays
+    PendingFastFrames = min( PendingFastFrames - Frames, 1.0 );
+    
+    for( int i = 0; i < Frames; i++ )
+      RunNextFrame( i == (Frames - 1) );
+}
+
+// -----------------------------------------------------------------------------
+
+void EmulatorControl::RunFramesAtMaximumSpeed( double UpdatePeriod )
+{
+    Uint64 CounterFrequency = SDL_GetPerformanceFrequency();
+    Uint64 StartTimestamp = SDL_GetPerformanceCounter();
+    Uint64 TimeBudget = UpdatePeriod * FAST_FORWARD_TIME_FRACTION * CounterFrequency;
+    Uint64 LastFrameTime = 0;
+    int Frames = 0;
+    
+    // we cannot know in advance which frame will be the last
+    // so it is predicted from the duration of previous ones
+    while( Frames < FAST_FORWARD_MAX_FRAMES )
+    {
+        Uint64 FrameTimestamp = SDL_GetPerformanceCounter();
+        Uint64 ElapsedTime = FrameTimestamp - StartTimestamp;
+        
+        bool IsLastFrame = (Frames == (FAST_FORWARD_MAX_FRAMES - 1))
+                        || (ElapsedTime + 2 * LastFrameTime >= TimeBudget);
+        
+        RunNextFrame( IsLastFrame );
+        LastFrameTime = SDL_GetPerformanceCounter() - FrameTimestamp;
+        Frames++;
+        
+        if( IsLastFrame )
+          break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void EmulatorControl::SetFastForward( bool Enabled )
+{
+    if( Enabled == FastForward )
+      return;
+    
+    LOG( string("Fast-forward ") + (Enabled? "enabled" : "disabled") );
+    FastForward = Enabled;
+    PendingFastFrames = 0;
+    
+    // sound not yet output is no longer needed
+    Audio.DiscardCompressedFrames();
+}
+
+// -----------------------------------------------------------------------------
+
+bool EmulatorControl::IsFastForward()
+{
+    return FastForward;
+}
+
+// -----------------------------------------------------------------------------
+
+void EmulatorControl::SetSpeedMultiplier( float Multiplier )
+{
+    SpeedMultiplier = max( Multiplier, 0.0f );
+    PendingFastFrames = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+float EmulatorControl::GetSpeedMultiplier()
+{
+    return SpeedMultiplier;
 }
@@ -9,6 +9,21 @@
 // *****************************************************************************
 
 
+// =============================================================================
+//      DEFINITIONS FOR FAST-FORWARD
+// =============================================================================
+
+
+// In fast-forward the console can run many frames on each
+// host update, but only the last one of them is rendered.
+// These limit how many frames can be run in an update and,
+// for maximum speed, the fraction of the update time that
+// can be used to run them (the rest is left for the GUI)
+
+#define FAST_FORWARD_MAX_FRAMES       64
+#define FAST_FORWARD_TIME_FRACTION    0.75
+
+
 // =============================================================================
 //      CLASS FOR EMULATOR CENTRAL CONTROL
 // =============================================================================
@@ -20,6 +35,15 @@ class EmulatorControl
         
         bool Paused;
         bool AutoCardHandling;
+        
+        // fast-forward control
+        bool FastForward;
+        float SpeedMultiplier;
+        double PendingFastFrames;
+        
+        // internal auxiliary methods
+        void RunFramesAtMultiplier( int RealTimeFrames );
+        void RunFramesAtMaximumSpeed( double UpdatePeriod );
     
     public:
         
@@ -42,7 +66,18 @@ class EmulatorControl
         void SetPower( bool On );
         bool IsPowerOn();
         void Reset();
-        void RunNextFrame();
+        void RunNextFrame( bool Render = true );
+        
+        // run the frames due for a host update,
+        // applying fast-forward when it is enabled
+        void RunFrames( int RealTimeFrames, double UpdatePeriod );
+        
+        // fast-forward configuration (a speed
+        // multiplier of 0 means maximum speed)
+        void SetFastForward( bool Enabled );
+        bool IsFastForward();
+        void SetSpeedMultiplier( float Multiplier );
+        float GetSpeedMultiplier();
 };
 
 
@@ -0,0 +1,275 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "DesktopInfrastructure/Logger.hpp"
+    
+    // include emulator headers
+    #include "EventTracer.hpp"
+    
+    // include C/C++ headers
+    #include <cstdio>           // [ ANSI C ] Standard I/O
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    #include <new>              // [ C++ STL ] Memory allocation
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+/* -------------------------------------------------------------------------- //
+    THREAD SAFETY CONSIDERATIONS:
+    -------------------------------
+    (1) Each buffer is only written by the thread that claimed it, and
+        its event count is published after the event is complete, so
+        the main thread can read all counted events at any time
+    (2) Threads detect a new tracing session by comparing its number,
+        and then claim a new buffer; buffers are only reset by the main
+        thread when starting a session, while tracing is disabled
+    (3) Buffer memory is created by the first thread that claims it,
+        and published with its atomic pointer; it is never deleted
+        until the tracer is, since a late event could still reach it
+// -------------------------------------------------------------------------- */
+
+
+// state of each thread
+static thread_local TraceThreadBuffer* ThreadBuffer = nullptr;
+static thread_local int ThreadSession = 0;
+static thread_local const char* ThreadName = nullptr;
+
+
+// =============================================================================
+//      EVENT TRACER: INSTANCE HANDLING
+// =============================================================================
+
+
+EventTracer::EventTracer()
+{
+    Enabled = false;
+    Session = 0;
+    StartTimestamp = 0;
+    ClaimedBuffers = 0;
+    
+    // buffers are not created until needed
+    for( TraceThreadBuffer& Buffer: Buffers )
+    {
+        Buffer.Events = nullptr;
+        Buffer.Count = 0;
+        Buffer.Dropped = 0;
+        Buffer.ThreadName = nullptr;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+EventTracer::~EventTracer()
+{
+    Enabled = false;
+    
+    for( TraceThreadBuffer& Buffer: Buffers )
+      delete[] Buffer.Events.load();
+}
+
+
+// =============================================================================
+//      EVENT TRACER: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+TraceThreadBuffer* EventTracer::GetThreadBuffer()
+{
+    int CurrentSession = Session.load( memory_order_acquire );
+    
+    // on its first event in a session, each
+    // thread claims the next available buffer
+    if( ThreadSession != CurrentSession )
+    {
+        ThreadSession = CurrentSession;
+        int Index = ClaimedBuffers.fetch_add( 1 );
+        
+        // when there are too many threads, the rest are not traced
+        if( Index >= TRACE_MAX_THREADS )
+          ThreadBuffer = nullptr;
+        
+        else
+        {
+            ThreadBuffer = &Buffers[ Index ];
+            ThreadBuffer->ThreadName = ThreadName;
+            
+            // no other thread can have this buffer yet if
+            // its memory was never created, so create it
+            // (if this fails the thread is not traced)
+            if( !ThreadBuffer->Events.load( memory_order_acquire ) )
+            {
+                TracedEvent* Events = new( nothrow ) TracedEvent[ TRACE_EVENTS_PER_THREAD ];
+                ThreadBuffer->Events.store( Events, memory_order_release );
+                
+                if( !Events )
+                  ThreadBuffer = nullptr;
+            }
+        }
+    }
+    
+    return ThreadBuffer;
+}
+
+// -----------------------------------------------------------------------------
+
+void EventTracer::RecordEvent( const char* Category, const char* Name, char Phase, int32_t Value )
+{
+    TraceThreadBuffer* Buffer = GetThreadBuffer();
+    
+    if( !Buffer )
+      return;
+    
+    // only this thread writes the count
+    int Position = Buffer->Count.load( memory_order_relaxed );
+    
+    if( Position >= TRACE_EVENTS_PER_THREAD )
+    {
+        Buffer->Dropped.fetch_add( 1, memory_order_relaxed );
+        return;
+    }
+    
+    TracedEvent& Event = Buffer->Events.load( memory_order_relaxed )[ Position ];
+    Event.Name = Name;
+    Event.Category = Category;
+    Event.Timestamp = SDL_GetPerformanceCounter();
+    Event.Value = Value;
+    Event.Phase = Phase;
+    
+    // the event becomes visible only when complete
+    Buffer->Count.store( Position + 1, memory_order_release );
+}
+
+
+// =============================================================================
+//      EVENT TRACER: TRACING CONTROL
+// =============================================================================
+
+
+void EventTracer::StartTracing()
+{
+    if( Enabled )
+      return;
+    
+    LOG( "Starting event tracing" );
+    
+    // buffer memory is kept from previous sessions
+    // (threads create it when they claim a new buffer)
+    for( TraceThreadBuffer& Buffer: Buffers )
+    {
+        Buffer.Count = 0;
+        Buffer.Dropped = 0;
+        Buffer.ThreadName = nullptr;
+    }
+    
+    ClaimedBuffers = 0;
+    StartTimestamp = SDL_GetPerformanceCounter();
+    
+    // threads will now claim new buffers
+    Session.fetch_add( 1, memory_order_release );
+    Enabled = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void EventTracer::StopTracing()
+{
+    if( !Enabled )
+      return;
+    
+    LOG( "Stopping event tracing" );
+    Enabled = false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool EventTracer::IsTracing()
+{
+    return Enabled;
+}
+
+// -----------------------------------------------------------------------------
+
+void EventTracer::SetThreadName( const char* Name )
+{
+    ThreadName = Name;
+}
+
+
+// =============================================================================
+//      EVENT TRACER: EXPORT
+// =============================================================================
+
+
+// the output follows the Chrome trace event format,
+// which can be opened with Perfetto or chrome://tracing
+void EventTracer::SaveJSON( const string& FilePath )
+{
+    if( Enabled )
+      THROW( "Cannot save events while tracing" );
+    
+    LOG( "Saving traced events to \"" + FilePath + "\"" );
+    FILE* JSONFile = fopen( FilePath.c_str(), "w" );
+    
+    if( !JSONFile )
+      THROW( "Cannot open output file" );
+    
+    fprintf( JSONFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+    fprintf( JSONFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Vircon32\"}}" );
+    
+    double MicrosecondsPerTick = 1000000.0 / SDL_GetPerformanceFrequency();
+    int TracedThreads = min( ClaimedBuffers.load(), TRACE_MAX_THREADS );
+    
+    for( int t = 0; t < TracedThreads; t++ )
+    {
+        TraceThreadBuffer& Buffer = Buffers[ t ];
+        int EventCount = Buffer.Count.load( memory_order_acquire );
+        TracedEvent* Events = Buffer.Events.load( memory_order_acquire );
+        
+        // a buffer may be claimed but still have no events
+        if( EventCount <= 0 || !Events )
+          continue;
+        
+        // thread IDs are just the buffer positions
+        int ThreadID = t + 1;
+        string Name = (Buffer.ThreadName? Buffer.ThreadName : "Thread " + to_string( ThreadID ));
+        fprintf( JSONFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", ThreadID, Name.c_str() );
+        
+        if( Buffer.Dropped > 0 )
+          LOG_WARNING( "Trace buffer for " + Name + " was full: " + to_string( Buffer.Dropped.load() ) + " events were discarded" );
+        
+        for( int i = 0; i < EventCount; i++ )
+        {
+            TracedEvent& Event = Events[ i ];
+            double Timestamp = (Event.Timestamp - StartTimestamp) * MicrosecondsPerTick;
+            
+            fprintf
+            (
+                JSONFile,
+                ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+                Event.Name,
+                Event.Category,
+                Event.Phase,
+                Timestamp,
+                ThreadID
+            );
+            
+            // instant events are shown only in their thread
+            if( Event.Phase == 'i' )
+              fprintf( JSONFile, ",\"s\":\"t\"" );
+            
+            // values are optional, except for counters
+            if( Event.Value != 0 || Event.Phase == 'C' )
+              fprintf( JSONFile, ",\"args\":{\"value\":%d}", Event.Value );
+            
+            fprintf( JSONFile, "}" );
+        }
+    }
+    
+    fprintf( JSONFile, "\n]}\n" );
+    
+    bool WriteFailed = ferror( JSONFile );
+    
+    if( fclose( JSONFile ) || WriteFailed )
+      THROW( "Cannot write output file" );
+}
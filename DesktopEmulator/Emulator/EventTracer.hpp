@@ -0,0 +1,155 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef EVENTTRACER_HPP
+    #define EVENTTRACER_HPP
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <atomic>           // [ C++ STL ] Atomic variables
+    #include <cstdint>          // [ ANSI C ] Standard integers
+    
+    // include SDL2 headers
+    #define SDL_MAIN_HANDLED
+    #include "SDL.h"            // [ SDL2 ] Main header
+// *****************************************************************************
+
+
+// =============================================================================
+//      DEFINITIONS FOR EVENT TRACING
+// =============================================================================
+
+
+// Events are recorded by each thread into its own buffer,
+// without any locks, so tracing can be used even from the
+// audio callback. Every thread claims a buffer with its
+// first event in a session; the memory for each buffer is
+// only created the first time it is claimed, and then kept
+// for later sessions. When a buffer is full, further events
+// are discarded.
+
+// maximum number of traced threads
+#define TRACE_MAX_THREADS       8
+
+// capacity of each thread buffer (at 32 bytes per event,
+// each traced thread takes 16MB: the total is only 128MB
+// if all possible threads record events)
+#define TRACE_EVENTS_PER_THREAD (1 << 19)
+
+// -----------------------------------------------------------------------------
+
+// names and categories must be static strings
+// since only their pointers are stored; phases
+// follow the Chrome trace event format
+struct TracedEvent
+{
+    const char* Name;
+    const char* Category;
+    Uint64 Timestamp;
+    int32_t Value;
+    char Phase;         // 'B' = begin, 'E' = end, 'i' = instant, 'C' = counter
+};
+
+// -----------------------------------------------------------------------------
+
+struct TraceThreadBuffer
+{
+    std::atomic< TracedEvent* > Events;
+    std::atomic< int > Count;
+    std::atomic< int > Dropped;
+    const char* ThreadName;
+};
+
+
+// =============================================================================
+//      EVENT TRACER CLASS
+// =============================================================================
+
+
+class EventTracer
+{
+    private:
+        
+        // tracing control
+        std::atomic< bool > Enabled;
+        std::atomic< int > Session;
+        Uint64 StartTimestamp;
+        
+        // buffers are assigned to threads in order
+        TraceThreadBuffer Buffers[ TRACE_MAX_THREADS ];
+        std::atomic< int > ClaimedBuffers;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // Internal auxiliary methods
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        TraceThreadBuffer* GetThreadBuffer();
+        void RecordEvent( const char* Category, const char* Name, char Phase, int32_t Value );
+        
+    public:
+        
+        // instance handling
+        EventTracer();
+       ~EventTracer();
+        
+        // tracing control (only from the main thread)
+        void StartTracing();
+        void StopTracing();
+        bool IsTracing();
+        
+        // save events of the last session, once stopped
+        void SaveJSON( const std::string& FilePath );
+        
+        // each thread can give a name for itself
+        // (it will be applied to its next buffer)
+        void SetThreadName( const char* Name );
+        
+        // recording, from any thread
+        void Begin( const char* Category, const char* Name, int32_t Value = 0 );
+        void End( const char* Category, const char* Name );
+        void Instant( const char* Category, const char* Name, int32_t Value = 0 );
+        void Counter( const char* Category, const char* Name, int32_t Value );
+};
+
+
+// =============================================================================
+//      INLINE RECORDING FUNCTIONS
+// =============================================================================
+
+
+// these are called very often, so when tracing
+// is disabled they must return as fast as possible
+inline void EventTracer::Begin( const char* Category, const char* Name, int32_t Value )
+{
+    if( Enabled.load( std::memory_order_relaxed ) )
+      RecordEvent( Category, Name, 'B', Value );
+}
+
+// -----------------------------------------------------------------------------
+
+inline void EventTracer::End( const char* Category, const char* Name )
+{
+    if( Enabled.load( std::memory_order_relaxed ) )
+      RecordEvent( Category, Name, 'E', 0 );
+}
+
+// -----------------------------------------------------------------------------
+
+inline void EventTracer::Instant( const char* Category, const char* Name, int32_t Value )
+{
+    if( Enabled.load( std::memory_order_relaxed ) )
+      RecordEvent( Category, Name, 'i', Value );
+}
+
+// -----------------------------------------------------------------------------
+
+inline void EventTracer::Counter( const char* Category, const char* Name, int32_t Value )
+{
+    if( Enabled.load( std::memory_order_relaxed ) )
+      RecordEvent( Category, Name, 'C', Value );
+}
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -0,0 +1,582 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "DesktopInfrastructure/Logger.hpp"
+    
+    // include emulator headers
+    #include "FrameCapture.hpp"
+    #include "VideoOutput.hpp"
+    #include "EventTracer.hpp"
+    #include "Globals.hpp"
+    
+    // include C/C++ headers
+    #include <stdexcept>        // [ C++ STL ] Exceptions
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // include libpng headers
+    #include <png.h>            // [ libpng ] Main header
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+/* -------------------------------------------------------------------------- //
+    THREAD SAFETY CONSIDERATIONS:
+    -------------------------------
+    (1) Only the main thread uses OpenGL: it starts the readbacks,
+        collects them into buffers and then submits jobs
+    (2) The worker thread only does encoding and file writing, and
+        returns each used buffer to the free list when done
+    (3) Job and result queues and the list of free buffers are
+        protected by the mutex; the condition variable is signaled
+        both when jobs are added and when buffers are freed
+// -------------------------------------------------------------------------- */
+
+
+// =============================================================================
+//      PNG ENCODING
+// =============================================================================
+
+
+// this runs on the worker thread, so it does not use
+// THROW: errors are returned to the main thread as a
+// result, and ProcessJob writes them to the log
+void SaveImageAsPNG( const string& FilePath, uint8_t* Pixels )
+{
+    // pixels are given from top to bottom
+    png_byte* RowPointers[ Constants::ScreenHeight ];
+    
+    for( int y = 0; y < Constants::ScreenHeight; y++ )
+      RowPointers[ y ] = &Pixels[ 4 * Constants::ScreenWidth * y ];
+    
+    // open output file
+    FILE *PNGFile = fopen( FilePath.c_str(), "wb" );
+    
+    if( !PNGFile )
+      throw runtime_error( "Cannot open output file" );
+    
+    // initialize PNG functions
+    png_struct* PNGHandler = png_create_write_struct( PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr );
+    
+    if( !PNGHandler )
+    {
+        fclose( PNGFile );
+        throw runtime_error( "Cannot create PNG handler" );
+    }
+    
+    png_info* PNGInfo = png_create_info_struct( PNGHandler );
+    
+    if( !PNGInfo )
+    {
+        fclose( PNGFile );
+        png_destroy_write_struct( &PNGHandler, nullptr );
+        throw runtime_error( "Cannot write PNG information" );
+    }
+    
+    // define a callback function expected by libpng for error handling
+    if( setjmp( png_jmpbuf(PNGHandler) ) )
+    {
+        fclose( PNGFile );
+        png_destroy_write_struct( &PNGHandler, &PNGInfo );
+        throw runtime_error( "Cannot initialize PNG error handling" );
+    }
+    
+    // begin writing
+    png_init_io( PNGHandler, PNGFile );
+    
+    // define output as 8bit depth in RGBA format
+    png_set_IHDR
+    (
+        PNGHandler,
+        PNGInfo,
+        Constants::ScreenWidth,
+        Constants::ScreenHeight,
+        8,
+        PNG_COLOR_TYPE_RGBA,
+        PNG_INTERLACE_NONE,
+        PNG_COMPRESSION_TYPE_DEFAULT,
+        PNG_FILTER_TYPE_DEFAULT
+    );
+    
+    // write basic image info
+    png_write_info( PNGHandler, PNGInfo );
+    
+    // write the actual pixel data for all rows
+    png_write_image( PNGHandler, RowPointers );
+    
+    // end writing
+    png_write_end( PNGHandler, nullptr );
+    
+    // clean-up
+    fclose( PNGFile );
+    png_destroy_write_struct( &PNGHandler, &PNGInfo );
+}
+
+
+// =============================================================================
+//      WORKER THREAD FUNCTION
+// =============================================================================
+
+
+int CaptureThreadFunction( void* Parameters )
+{
+    FrameCapture* Capture = (FrameCapture*)Parameters;
+    Tracer.SetThreadName( "Capture" );
+    SDL_LockMutex( Capture->QueueMutex );
+    
+    while( true )
+    {
+        // wait for jobs
+        while( Capture->PendingJobs.empty() && !Capture->WorkerMustExit )
+          SDL_CondWait( Capture->QueueChanged, Capture->QueueMutex );
+        
+        // only exit after all jobs are done
+        if( Capture->PendingJobs.empty() )
+          break;
+        
+        CaptureJob Job = Capture->PendingJobs.front();
+        Capture->PendingJobs.pop_front();
+        
+        // do the actual work without holding the lock
+        SDL_UnlockMutex( Capture->QueueMutex );
+        Tracer.Begin( "capture", "Capture job", (int)Job.Type );
+        Capture->ProcessJob( Job );
+        Tracer.End( "capture", "Capture job" );
+        SDL_LockMutex( Capture->QueueMutex );
+        
+        // the buffer is now free for new images
+        if( Job.Pixels )
+        {
+            Capture->FreeBuffers.push_back( Job.Pixels );
+            SDL_CondBroadcast( Capture->QueueChanged );
+        }
+    }
+    
+    SDL_UnlockMutex( Capture->QueueMutex );
+    return 0;
+}
+
+
+// =============================================================================
+//      FRAME CAPTURE: INSTANCE HANDLING
+// =============================================================================
+
+
+FrameCapture::FrameCapture()
+{
+    WorkerThread = nullptr;
+    QueueMutex = nullptr;
+    QueueChanged = nullptr;
+    WorkerMustExit = false;
+    AllocatedBuffers = 0;
+    
+    CapturingVideo = false;
+    VideoFormat = VideoCaptureFormats::Y4M;
+    VideoFile = nullptr;
+    CapturedFrames = 0;
+    VideoWriteFailed = false;
+}
+
+// -----------------------------------------------------------------------------
+
+FrameCapture::~FrameCapture()
+{
+    Terminate();
+}
+
+
+// =============================================================================
+//      FRAME CAPTURE: RESOURCE MANAGEMENT
+// =============================================================================
+
+
+void FrameCapture::Initialize()
+{
+    LOG( "Initializing frame capture" );
+    
+    QueueMutex = SDL_CreateMutex();
+    QueueChanged = SDL_CreateCond();
+    
+    if( !QueueMutex || !QueueChanged )
+      THROW( "Cannot create synchronization objects for frame capture" );
+    
+    WorkerMustExit = false;
+    WorkerThread = SDL_CreateThread( CaptureThreadFunction, "FrameCapture", this );
+    
+    if( !WorkerThread )
+      THROW( string("Cannot create frame capture thread: ") + SDL_GetError() );
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameCapture::Terminate()
+{
+    if( !WorkerThread )
+      return;
+    
+    LOG( "Terminating frame capture" );
+    
+    // collect any pending images so they get saved
+    StopVideoCapture();
+    
+    while( !ReadbackJobs.empty() )
+      FinishReadback();
+    
+    // let the worker finish its queue, then exit
+    SDL_LockMutex( QueueMutex );
+    WorkerMustExit = true;
+    SDL_CondBroadcast( QueueChanged );
+    SDL_UnlockMutex( QueueMutex );
+    
+    SDL_WaitThread( WorkerThread, nullptr );
+    WorkerThread = nullptr;
+    
+    // now it is safe to release everything
+    for( uint8_t* Buffer: FreeBuffers )
+      delete[] Buffer;
+    
+    FreeBuffers.clear();
+    AllocatedBuffers = 0;
+    
+    SDL_DestroyCond( QueueChanged );
+    SDL_DestroyMutex( QueueMutex );
+    QueueChanged = nullptr;
+    QueueMutex = nullptr;
+}
+
+
+// =============================================================================
+//      FRAME CAPTURE: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+uint8_t* FrameCapture::ObtainBuffer()
+{
+    SDL_LockMutex( QueueMutex );
+    
+    // when all buffers are in use, wait for the
+    // worker thread to finish with one of them
+    while( FreeBuffers.empty() && AllocatedBuffers >= CAPTURE_MAX_BUFFERS )
+      SDL_CondWait( QueueChanged, QueueMutex );
+    
+    uint8_t* Buffer = nullptr;
+    
+    if( !FreeBuffers.empty() )
+    {
+        Buffer = FreeBuffers.back();
+        FreeBuffers.pop_back();
+    }
+    
+    else
+    {
+        Buffer = new uint8_t[ READBACK_IMAGE_BYTES ];
+        AllocatedBuffers++;
+    }
+    
+    SDL_UnlockMutex( QueueMutex );
+    return Buffer;
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameCapture::BeginReadback( CaptureJobTypes Type, const string& FilePath )
+{
+    // when all readback buffers are busy,
+    // first collect the oldest of them
+    if( Video.GetPendingReadbacks() >= READBACK_BUFFERS )
+      FinishReadback();
+    
+    CaptureJob Job;
+    Job.Type = Type;
+    Job.Pixels = nullptr;
+    Job.FilePath = FilePath;
+    Job.VideoFile = VideoFile;
+    Job.VideoFormat = VideoFormat;
+    
+    if( Video.BeginFramebufferReadback() )
+      ReadbackJobs.push_back( Job );
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameCapture::FinishReadback()
+{
+    if( ReadbackJobs.empty() )
+      return;
+    
+    CaptureJob Job = ReadbackJobs.front();
+    ReadbackJobs.pop_front();
+    Job.Pixels = ObtainBuffer();
+    
+    if( !Video.FinishFramebufferReadback( Job.Pixels ) )
+    {
+        // the buffer was not used after all
+        SDL_LockMutex( QueueMutex );
+        FreeBuffers.push_back( Job.Pixels );
+        
+        if( Job.Type == CaptureJobTypes::Screenshot )
+          FinishedResults.push_back( CaptureResult{ Job.Type, false, "Cannot read the framebuffer" } );
+        
+        SDL_UnlockMutex( QueueMutex );
+        return;
+    }
+    
+    SubmitJob( Job );
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameCapture::SubmitJob( const CaptureJob& Job )
+{
+    SDL_LockMutex( QueueMutex );
+    PendingJobs.push_back( Job );
+    SDL_CondBroadcast( QueueChanged );
+    SDL_UnlockMutex( QueueMutex );
+}
+
+// -----------------------------------------------------------------------------
+
+// this is only called from the worker thread
+void FrameCapture::ProcessJob( CaptureJob& Job )
+{
+    CaptureResult Result;
+    Result.Type = Job.Type;
+    Result.Success = true;
+    
+    if( Job.Type == CaptureJobTypes::Screenshot )
+    {
+        try
+        {
+            SaveImageAsPNG( Job.FilePath, Job.Pixels );
+        }
+        catch( exception& e )
+        {
+            Result.Success = false;
+            Result.ErrorMessage = e.what();
+        }
+    }
+    
+    else if( Job.Type == CaptureJobTypes::VideoFrame )
+    {
+        WriteVideoFrame( Job );
+        return;
+    }
+    
+    else if( Job.Type == CaptureJobTypes::EndVideo )
+    {
+        if( fclose( Job.VideoFile ) != 0 || VideoWriteFailed )
+        {
+            Result.Success = false;
+            Result.ErrorMessage = "Cannot write to video file";
+        }
+        
+        VideoWriteFailed = false;
+    }
+    
+    // the log can be written from any thread
+    if( !Result.Success )
+      LOG_ERROR( "Frame capture failed: " + Result.ErrorMessage );
+    
+    SDL_LockMutex( QueueMutex );
+    FinishedResults.push_back( Result );
+    SDL_UnlockMutex( QueueMutex );
+}
+
+// -----------------------------------------------------------------------------
+
+// this is only called from the worker thread
+void FrameCapture::WriteVideoFrame( CaptureJob& Job )
+{
+    bool FrameWritten;
+    
+    if( Job.VideoFormat == VideoCaptureFormats::RawRGBA )
+      FrameWritten = (fwrite( Job.Pixels, READBACK_IMAGE_BYTES, 1, Job.VideoFile ) == 1);
+    
+    // Y4M frames have a header, then the 3 planes
+    else
+    {
+        ConvertToYUV420( Job.Pixels );
+        fputs( "FRAME\n", Job.VideoFile );
+        FrameWritten = (fwrite( YUVPlanes.data(), YUVPlanes.size(), 1, Job.VideoFile ) == 1);
+    }
+    
+    // the result is only given when the video ends,
+    // but the log shows when writing started to fail
+    if( !FrameWritten && !VideoWriteFailed )
+      LOG_ERROR( "Cannot write frame to video file" );
+    
+    if( !FrameWritten )
+      VideoWriteFailed = true;
+}
+
+// -----------------------------------------------------------------------------
+
+// uses full range BT.601 (as in JPEG), so that the
+// output matches the "C420jpeg" Y4M color space;
+// coefficients are in fixed point, scaled by 256
+void FrameCapture::ConvertToYUV420( uint8_t* Pixels )
+{
+    const int Width = Constants::ScreenWidth;
+    const int Height = Constants::ScreenHeight;
+    
+    YUVPlanes.resize( Width * Height * 3 / 2 );
+    uint8_t* PlaneY = &YUVPlanes[ 0 ];
+    uint8_t* PlaneU = PlaneY + Width * Height;
+    uint8_t* PlaneV = PlaneU + (Width / 2) * (Height / 2);
+    
+    // luma is taken for every pixel
+    for( int i = 0; i < Width * Height; i++ )
+    {
+        int R = Pixels[ 4*i + 0 ], G = Pixels[ 4*i + 1 ], B = Pixels[ 4*i + 2 ];
+        PlaneY[ i ] = (77*R + 150*G + 29*B + 128) >> 8;
+    }
+    
+    // chroma is taken from the average of 2x2 blocks
+    for( int y = 0; y < Height; y += 2 )
+      for( int x = 0; x < Width; x += 2 )
+      {
+          int R = 0, G = 0, B = 0;
+          
+          for( int dy = 0; dy < 2; dy++ )
+            for( int dx = 0; dx < 2; dx++ )
+            {
+                uint8_t* Pixel = &Pixels[ 4 * ((y + dy) * Width + (x + dx)) ];
+                R += Pixel[ 0 ];
+                G += Pixel[ 1 ];
+                B += Pixel[ 2 ];
+            }
+          
+          R /= 4; G /= 4; B /= 4;
+          
+          // the offset (128 * 256 + 128) keeps these positive
+          int U = (-43*R - 85*G + 128*B + 32896) >> 8;
+          int V = (128*R - 107*G - 21*B + 32896) >> 8;
+          
+          int ChromaPosition = (y / 2) * (Width / 2) + (x / 2);
+          PlaneU[ ChromaPosition ] = min( U, 255 );
+          PlaneV[ ChromaPosition ] = min( V, 255 );
+      }
+}
+
+
+// =============================================================================
+//      FRAME CAPTURE: SCREENSHOTS
+// =============================================================================
+
+
+void FrameCapture::RequestScreenshot( const string& FilePath )
+{
+    LOG( "Requesting a screenshot" );
+    BeginReadback( CaptureJobTypes::Screenshot, FilePath );
+}
+
+// -----------------------------------------------------------------------------
+
+bool FrameCapture::GetCaptureResult( CaptureResult& Result )
+{
+    if( !QueueMutex )
+      return false;
+    
+    SDL_LockMutex( QueueMutex );
+    bool ResultFound = !FinishedResults.empty();
+    
+    if( ResultFound )
+    {
+        Result = FinishedResults.front();
+        FinishedResults.pop_front();
+    }
+    
+    SDL_UnlockMutex( QueueMutex );
+    return ResultFound;
+}
+
+
+// =============================================================================
+//      FRAME CAPTURE: CONTINUOUS VIDEO CAPTURE
+// =============================================================================
+
+
+void FrameCapture::StartVideoCapture( const string& FilePath, VideoCaptureFormats Format )
+{
+    StopVideoCapture();
+    LOG( "Starting video capture to \"" + FilePath + "\"" );
+    
+    VideoFile = fopen( FilePath.c_str(), "wb" );
+    
+    if( !VideoFile )
+      THROW( "Cannot open output file" );
+    
+    // Y4M files start with a global header
+    if( Format == VideoCaptureFormats::Y4M )
+      fprintf( VideoFile, "YUV4MPEG2 W%d H%d F60:1 Ip A1:1 C420jpeg\n", Constants::ScreenWidth, Constants::ScreenHeight );
+    
+    VideoFormat = Format;
+    CapturingVideo = true;
+    CapturedFrames = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameCapture::StopVideoCapture()
+{
+    if( !CapturingVideo )
+      return;
+    
+    LOG( "Stopping video capture after " + to_string( CapturedFrames ) + " frames" );
+    
+    // ensure all captured frames are written
+    while( !ReadbackJobs.empty() )
+      FinishReadback();
+    
+    // the worker closes the file after the last frame
+    CaptureJob Job;
+    Job.Type = CaptureJobTypes::EndVideo;
+    Job.Pixels = nullptr;
+    Job.VideoFile = VideoFile;
+    Job.VideoFormat = VideoFormat;
+    SubmitJob( Job );
+    
+    VideoFile = nullptr;
+    CapturingVideo = false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool FrameCapture::IsCapturingVideo()
+{
+    return CapturingVideo;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned FrameCapture::GetCapturedFrames()
+{
+    return CapturedFrames;
+}
+
+
+// =============================================================================
+//      FRAME CAPTURE: GENERAL OPERATION
+// =============================================================================
+
+
+void FrameCapture::CaptureRenderedFrame()
+{
+    if( !CapturingVideo )
+      return;
+    
+    BeginReadback( CaptureJobTypes::VideoFrame, "" );
+    CapturedFrames++;
+}
+
+// -----------------------------------------------------------------------------
+
+// readbacks started on previous updates have had
+// at least one buffer swap to complete, so they
+// can now be collected without stalling the GPU
+void FrameCapture::Update()
+{
+    while( !ReadbackJobs.empty() )
+      FinishReadback();
+}
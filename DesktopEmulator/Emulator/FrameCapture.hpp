@@ -0,0 +1,169 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef FRAMECAPTURE_HPP
+    #define FRAMECAPTURE_HPP
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <deque>            // [ C++ STL ] Double-ended queues
+    #include <cstdio>           // [ ANSI C ] Standard I/O
+    #include <cstdint>          // [ ANSI C ] Standard integers
+    
+    // include SDL2 headers
+    #define SDL_MAIN_HANDLED
+    #include "SDL.h"            // [ SDL2 ] Main header
+// *****************************************************************************
+
+
+// =============================================================================
+//      DEFINITIONS FOR FRAME CAPTURE
+// =============================================================================
+
+
+// Captured images are read back asynchronously from the
+// GPU, and then saved to disk by a worker thread. Each
+// image in flight uses one of these buffers; if they are
+// all in use, capture waits for the worker instead of
+// dropping frames (60 buffers are 1 second of video)
+#define CAPTURE_MAX_BUFFERS  60
+
+// -----------------------------------------------------------------------------
+
+enum class VideoCaptureFormats
+{
+    RawRGBA,    // just 640x360 RGBA images, one after another
+    Y4M         // YUV4MPEG2 with 4:2:0 chroma, readable by most tools
+};
+
+// -----------------------------------------------------------------------------
+
+enum class CaptureJobTypes
+{
+    Screenshot,     // save a PNG image to the given path
+    VideoFrame,     // append a frame to the video file
+    EndVideo        // close the video file
+};
+
+// -----------------------------------------------------------------------------
+
+struct CaptureJob
+{
+    CaptureJobTypes Type;
+    uint8_t* Pixels;
+    
+    // output file for each type of job
+    std::string FilePath;
+    FILE* VideoFile;
+    VideoCaptureFormats VideoFormat;
+};
+
+// -----------------------------------------------------------------------------
+
+// results are only reported for screenshots
+// and for videos (when they are closed)
+struct CaptureResult
+{
+    CaptureJobTypes Type;
+    bool Success;
+    std::string ErrorMessage;
+};
+
+
+// =============================================================================
+//      FUNCTIONS EXTERNAL TO THE CAPTURE CLASS
+// =============================================================================
+
+
+// PNG encoding for screenshots
+void SaveImageAsPNG( const std::string& FilePath, uint8_t* Pixels );
+
+// function executed by the worker thread
+int CaptureThreadFunction( void* Parameters );
+
+
+// =============================================================================
+//      FRAME CAPTURE CLASS
+// =============================================================================
+
+
+class FrameCapture
+{
+    private:
+        
+        // worker thread control
+        SDL_Thread* WorkerThread;
+        SDL_mutex* QueueMutex;
+        SDL_cond* QueueChanged;
+        bool WorkerMustExit;
+        
+        // shared with the worker thread (use mutex)
+        std::deque< CaptureJob > PendingJobs;
+        std::deque< CaptureResult > FinishedResults;
+        std::vector< uint8_t* > FreeBuffers;
+        int AllocatedBuffers;
+        
+        // jobs waiting for their GPU readback
+        // (only used in the main thread)
+        std::deque< CaptureJob > ReadbackJobs;
+        
+        // video capture state; once capture has started
+        // the file is only written by the worker thread
+        bool CapturingVideo;
+        VideoCaptureFormats VideoFormat;
+        FILE* VideoFile;
+        unsigned CapturedFrames;
+        
+        // only used by the worker thread
+        std::vector< uint8_t > YUVPlanes;
+        bool VideoWriteFailed;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // Internal auxiliary methods
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // used by the main thread
+        uint8_t* ObtainBuffer();
+        void BeginReadback( CaptureJobTypes Type, const std::string& FilePath );
+        void FinishReadback();
+        void SubmitJob( const CaptureJob& Job );
+        
+        // used by the worker thread
+        friend int CaptureThreadFunction( void* );
+        void ProcessJob( CaptureJob& Job );
+        void WriteVideoFrame( CaptureJob& Job );
+        void ConvertToYUV420( uint8_t* Pixels );
+        
+    public:
+        
+        // instance handling
+        FrameCapture();
+       ~FrameCapture();
+        
+        // resource management
+        void Initialize();
+        void Terminate();
+        
+        // screenshots: results are reported later,
+        // once the image has actually been saved
+        void RequestScreenshot( const std::string& FilePath );
+        bool GetCaptureResult( CaptureResult& Result );
+        
+        // continuous video capture
+        void StartVideoCapture( const std::string& FilePath, VideoCaptureFormats Format );
+        void StopVideoCapture();
+        bool IsCapturingVideo();
+        unsigned GetCapturedFrames();
+        
+        // called by the emulator after each rendered frame
+        void CaptureRenderedFrame();
+        
+        // called once per update of the main loop
+        void Update();
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -0,0 +1,298 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "DesktopInfrastructure/Logger.hpp"
+    
+    // include emulator headers
+    #include "FramePacer.hpp"
+    
+    // include C/C++ headers
+    #include <cmath>            // [ ANSI C ] Mathematics
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      FRAME PACER: INSTANCE HANDLING
+// =============================================================================
+
+
+FramePacer::FramePacer()
+{
+    CounterFrequency = SDL_GetPerformanceFrequency();
+    LastSwapTimestamp = 0;
+    LastSwapIsValid = false;
+    
+    // until a display is known, assume 60Hz
+    ReportedPeriod = 1.0 / 60;
+    RefreshPeriod = ReportedPeriod;
+    VSyncIsEffective = false;
+    SwapStartTimestamp = 0;
+    SwapBlockTime = 0;
+    
+    PendingFrames = 0;
+    
+    HistoryPosition = 0;
+    HistoryCount = 0;
+}
+
+
+// =============================================================================
+//      FRAME PACER: RESOURCE MANAGEMENT
+// =============================================================================
+
+
+void FramePacer::Initialize( SDL_Window* Window )
+{
+    LOG( "Initializing frame pacer" );
+    
+    // take the refresh rate reported by the display
+    // only as a first estimate, since it is rounded
+    // to an integer and some drivers report it wrong
+    SDL_DisplayMode DisplayMode;
+    int DisplayIndex = SDL_GetWindowDisplayIndex( Window );
+    
+    if( DisplayIndex >= 0 && !SDL_GetCurrentDisplayMode( DisplayIndex, &DisplayMode ) && DisplayMode.refresh_rate > 0 )
+      ReportedPeriod = 1.0 / DisplayMode.refresh_rate;
+    else
+      ReportedPeriod = 1.0 / 60;
+    
+    RefreshPeriod = ReportedPeriod;
+    LOG( "Reported display refresh rate: " + to_string( 1.0 / ReportedPeriod ) + " Hz" );
+    
+    // even when vsync is requested, it might be
+    // overriden by the driver: we will assume it
+    // works until swap timings show otherwise
+    VSyncIsEffective = (SDL_GL_GetSwapInterval() != 0);
+    SwapBlockTime = (VSyncIsEffective? ReportedPeriod / 2 : 0);
+    
+    Reset();
+}
+
+
+// =============================================================================
+//      FRAME PACER: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+void FramePacer::SleepUntil( Uint64 Deadline )
+{
+    Uint64 SleepStart = SDL_GetPerformanceCounter();
+    
+    if( SleepStart >= Deadline )
+      return;
+    
+    // first let the OS scheduler sleep for most
+    // of the time, without using the host CPU
+    double RemainingTime = double( Deadline - SleepStart ) / CounterFrequency;
+    
+    if( RemainingTime > PACER_SPIN_MARGIN )
+      SDL_Delay( (Uint32)((RemainingTime - PACER_SPIN_MARGIN) * 1000) );
+    
+    // then wait actively for the rest
+    while( SDL_GetPerformanceCounter() < Deadline )
+      continue;
+}
+
+// -----------------------------------------------------------------------------
+
+void FramePacer::MeasureSwapInterval( double Interval, double BlockTime )
+{
+    // keep history for statistics
+    SwapIntervals[ HistoryPosition ] = Interval;
+    HistoryPosition = (HistoryPosition + 1) % PACER_HISTORY_SIZE;
+    HistoryCount = min( HistoryCount + 1, PACER_HISTORY_SIZE );
+    
+    // with vsync, swaps block until the next refresh
+    // so if they keep returning immediately, vsync is
+    // not working (even if the driver accepted it)
+    SwapBlockTime += 0.1 * (BlockTime - SwapBlockTime);
+    bool VSyncWasEffective = VSyncIsEffective;
+    VSyncIsEffective = (SwapBlockTime > 0.15 * RefreshPeriod);
+    
+    if( VSyncIsEffective != VSyncWasEffective )
+      LOG( string("Frame pacer: vsync is ") + (VSyncIsEffective? "effective" : "not effective, pacing by timer") );
+    
+    // refine the display period, but only from
+    // intervals that span a single refresh
+    if( VSyncIsEffective && fabs( Interval - RefreshPeriod ) < 0.25 * RefreshPeriod )
+      RefreshPeriod += 0.02 * (Interval - RefreshPeriod);
+}
+
+
+// =============================================================================
+//      FRAME PACER: SCHEDULING
+// =============================================================================
+
+
+int FramePacer::GetFramesToRun()
+{
+    // tolerate small timing errors so that
+    // frames are not delayed by one refresh
+    int Frames = min( (int)(PendingFrames + 0.05), PACER_MAX_FRAMES );
+    
+    if( Frames <= 0 )
+      return 0;
+    
+    PendingFrames -= Frames;
+    return Frames;
+}
+
+// -----------------------------------------------------------------------------
+
+void FramePacer::WaitBeforeSwap()
+{
+    // when vsync does not work, present at 60Hz
+    // sleeping instead of spinning until the deadline
+    // (otherwise, the swap itself will do the wait)
+    if( !VSyncIsEffective && LastSwapIsValid )
+    {
+        Uint64 Deadline = LastSwapTimestamp + CounterFrequency / 60;
+        SleepUntil( Deadline );
+    }
+    
+    SwapStartTimestamp = SDL_GetPerformanceCounter();
+}
+
+// -----------------------------------------------------------------------------
+
+void FramePacer::RegisterSwap()
+{
+    Uint64 SwapTimestamp = SDL_GetPerformanceCounter();
+    
+    // after a reset we have no reference, so
+    // just schedule a single frame for next swap
+    if( !LastSwapIsValid )
+    {
+        PendingFrames = 1;
+        LastSwapTimestamp = SwapTimestamp;
+        LastSwapIsValid = true;
+        return;
+    }
+    
+    double Interval = double( SwapTimestamp - LastSwapTimestamp ) / CounterFrequency;
+    LastSwapTimestamp = SwapTimestamp;
+    
+    // long intervals are pauses, not slowdowns,
+    // so emulation should not try to catch up
+    if( Interval > PACER_MAX_INTERVAL )
+    {
+        PendingFrames = 1;
+        return;
+    }
+    
+    double BlockTime = double( SwapTimestamp - SwapStartTimestamp ) / CounterFrequency;
+    MeasureSwapInterval( Interval, BlockTime );
+    
+    // with vsync, the actual time between images shown
+    // is a whole number of refreshes, so the measured
+    // interval is snapped to it to cancel swap jitter
+    double Refreshes = floor( Interval / RefreshPeriod + 0.5 );
+    bool IntervalIsSnapped = VSyncIsEffective && Refreshes >= 1
+                          && fabs( Interval - Refreshes * RefreshPeriod ) < 0.2 * RefreshPeriod;
+    
+    // on a display that matches the console rate, each
+    // refresh is one frame; audio absorbs the difference
+    if( IntervalIsSnapped && IsSyncedToDisplay() )
+      PendingFrames += Refreshes;
+    
+    else if( IntervalIsSnapped )
+      PendingFrames += Refreshes * RefreshPeriod * 60;
+    
+    else
+      PendingFrames += Interval * 60;
+    
+    // never accumulate more than we can run
+    PendingFrames = min( PendingFrames, (double)PACER_MAX_FRAMES );
+}
+
+// -----------------------------------------------------------------------------
+
+void FramePacer::Reset()
+{
+    LastSwapIsValid = false;
+    PendingFrames = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void FramePacer::WaitWhileInactive()
+{
+    // nothing is being shown, so there is no need
+    // for precision: just avoid using the host CPU
+    SDL_Delay( 10 );
+    Reset();
+}
+
+
+// =============================================================================
+//      FRAME PACER: TIMING STATUS
+// =============================================================================
+
+
+double FramePacer::GetRefreshRate()
+{
+    return 1.0 / RefreshPeriod;
+}
+
+// -----------------------------------------------------------------------------
+
+// time between updates of the main loop: either
+// the refresh period or, without vsync, 1/60 s
+double FramePacer::GetUpdatePeriod()
+{
+    return (VSyncIsEffective? RefreshPeriod : 1.0 / 60);
+}
+
+// -----------------------------------------------------------------------------
+
+bool FramePacer::IsSyncedToDisplay()
+{
+    if( !VSyncIsEffective )
+      return false;
+    
+    double RateDifference = fabs( GetRefreshRate() - 60 ) / 60;
+    return (RateDifference < PACER_SYNC_TOLERANCE);
+}
+
+// -----------------------------------------------------------------------------
+
+bool FramePacer::IsVSyncEffective()
+{
+    return VSyncIsEffective;
+}
+
+// -----------------------------------------------------------------------------
+
+double FramePacer::GetAverageFrameTime()
+{
+    if( HistoryCount <= 0 )
+      return 0;
+    
+    double Sum = 0;
+    
+    for( int i = 0; i < HistoryCount; i++ )
+      Sum += SwapIntervals[ i ];
+    
+    return Sum / HistoryCount;
+}
+
+// -----------------------------------------------------------------------------
+
+// jitter is measured as the standard
+// deviation of recent swap intervals
+double FramePacer::GetFrameTimeJitter()
+{
+    if( HistoryCount <= 1 )
+      return 0;
+    
+    double Average = GetAverageFrameTime();
+    double SquaresSum = 0;
+    
+    for( int i = 0; i < HistoryCount; i++ )
+      SquaresSum += (SwapIntervals[ i ] - Average) * (SwapIntervals[ i ] - Average);
+    
+    return sqrt( SquaresSum / (HistoryCount - 1) );
+}
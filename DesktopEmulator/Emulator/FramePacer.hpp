@@ -0,0 +1,118 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef FRAMEPACER_HPP
+    #define FRAMEPACER_HPP
+    
+    // include SDL2 headers
+    #define SDL_MAIN_HANDLED
+    #include "SDL.h"            // [ SDL2 ] Main header
+// *****************************************************************************
+
+
+// =============================================================================
+//      DEFINITIONS FOR FRAME PACING
+// =============================================================================
+
+
+// Emulation is scheduled from the timestamps of buffer
+// swaps instead of free-running timers. When the display
+// refreshes close enough to 60Hz (such as 59.94Hz) the
+// console runs exactly 1 frame per swap, and the small
+// speed difference is absorbed by the audio resampling.
+// On other displays, emulated time is accumulated per
+// swap and whole frames are run as they become due.
+
+// refresh rates within this fraction of 60Hz
+// are treated as a 1:1 match with the console
+#define PACER_SYNC_TOLERANCE    0.01
+
+// limit for frames run on a single update, so that
+// a hitch does not cause a burst of catch-up frames
+#define PACER_MAX_FRAMES        3
+
+// swap intervals longer than this (in seconds) are
+// considered pauses, and are not used for timing
+#define PACER_MAX_INTERVAL      0.25
+
+// number of past swap intervals kept for statistics
+#define PACER_HISTORY_SIZE      120
+
+// when sleeping, wake up this long (in seconds) before
+// the deadline and wait the rest actively, since the
+// operating system scheduler is not precise enough
+#define PACER_SPIN_MARGIN       0.002
+
+
+// =============================================================================
+//      FRAME PACER CLASS
+// =============================================================================
+
+
+class FramePacer
+{
+    private:
+        
+        // SDL high resolution counter
+        Uint64 CounterFrequency;
+        Uint64 LastSwapTimestamp;
+        bool LastSwapIsValid;
+        
+        // display refresh, as reported and as measured
+        double ReportedPeriod;
+        double RefreshPeriod;
+        bool VSyncIsEffective;
+        
+        // average time blocked within buffer swaps:
+        // it stays near zero when vsync is not working
+        Uint64 SwapStartTimestamp;
+        double SwapBlockTime;
+        
+        // emulation scheduling (in console frames)
+        double PendingFrames;
+        
+        // statistics of recent swap intervals
+        double SwapIntervals[ PACER_HISTORY_SIZE ];
+        int HistoryPosition;
+        int HistoryCount;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // Internal auxiliary methods
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        void SleepUntil( Uint64 Deadline );
+        void MeasureSwapInterval( double Interval, double BlockTime );
+        
+    public:
+        
+        // instance handling
+        FramePacer();
+        
+        // resource management
+        void Initialize( SDL_Window* Window );
+        
+        // scheduling, in the order used each update
+        int GetFramesToRun();
+        void WaitBeforeSwap();
+        void RegisterSwap();
+        
+        // forget about timing when there
+        // are pauses, such as window events
+        void Reset();
+        
+        // idle waiting while nothing is shown
+        void WaitWhileInactive();
+        
+        // timing status (times are in seconds)
+        double GetRefreshRate();
+        double GetUpdatePeriod();
+        bool IsSyncedToDisplay();
+        bool IsVSyncEffective();
+        double GetAverageFrameTime();
+        double GetFrameTimeJitter();
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -0,0 +1,342 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "DesktopInfrastructure/Logger.hpp"
+    
+    // include emulator headers
+    #include "FrameTelemetry.hpp"
+    
+    // include imgui headers
+    #include <imgui/imgui.h>    // [ Dear ImGui ] Main header
+    
+    // include C/C++ headers
+    #include <cstdio>           // [ ANSI C ] Standard I/O
+    #include <cstring>          // [ ANSI C ] Strings
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      PHASE NAMES
+// =============================================================================
+
+
+// names shown in the overlay
+static const char* PhaseNames[ TELEMETRY_PHASES ] =
+{
+    "CPU run",
+    "GPU submission",
+    "SPU mix",
+    "Audio queue",
+    "GUI render",
+    "Swap",
+    "Other"
+};
+
+// names used as CSV columns
+static const char* PhaseColumns[ TELEMETRY_PHASES ] =
+{
+    "CPURunMs",
+    "GPUSubmissionMs",
+    "SPUMixMs",
+    "AudioQueueMs",
+    "GUIRenderMs",
+    "SwapMs",
+    "OtherMs"
+};
+
+
+// =============================================================================
+//      FRAME TELEMETRY: INSTANCE HANDLING
+// =============================================================================
+
+
+FrameTelemetry::FrameTelemetry()
+{
+    CounterFrequency = SDL_GetPerformanceFrequency();
+    UpdateStart = 0;
+    PhaseStart = 0;
+    
+    CurrentPhase = TelemetryPhases::Other;
+    memset( &CurrentRecord, 0, sizeof(CurrentRecord) );
+    Measuring = false;
+    
+    HistoryPosition = 0;
+    HistoryCount = 0;
+    
+    OverlayVisible = false;
+}
+
+
+// =============================================================================
+//      FRAME TELEMETRY: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+// index 0 is the oldest record kept
+TelemetryRecord& FrameTelemetry::GetRecord( int Index )
+{
+    int FirstPosition = (HistoryCount < TELEMETRY_HISTORY_SIZE? 0 : HistoryPosition);
+    return History[ (FirstPosition + Index) % TELEMETRY_HISTORY_SIZE ];
+}
+
+
+// =============================================================================
+//      FRAME TELEMETRY: MEASUREMENT OF UPDATES
+// =============================================================================
+
+
+void FrameTelemetry::BeginUpdate()
+{
+    memset( &CurrentRecord, 0, sizeof(CurrentRecord) );
+    UpdateStart = SDL_GetPerformanceCounter();
+    PhaseStart = UpdateStart;
+    CurrentPhase = TelemetryPhases::Other;
+    Measuring = true;
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameTelemetry::EndUpdate()
+{
+    if( !Measuring )
+      return;
+    
+    // account for the last active phase
+    SwitchPhase( TelemetryPhases::Other );
+    CurrentRecord.TotalTime = 1000.0 * (PhaseStart - UpdateStart) / CounterFrequency;
+    
+    // store the record, replacing the oldest one
+    History[ HistoryPosition ] = CurrentRecord;
+    HistoryPosition = (HistoryPosition + 1) % TELEMETRY_HISTORY_SIZE;
+    HistoryCount = min( HistoryCount + 1, TELEMETRY_HISTORY_SIZE );
+    Measuring = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameTelemetry::Clear()
+{
+    HistoryPosition = 0;
+    HistoryCount = 0;
+    Measuring = false;
+}
+
+// -----------------------------------------------------------------------------
+
+TelemetryPhases FrameTelemetry::SwitchPhase( TelemetryPhases NewPhase )
+{
+    TelemetryPhases PreviousPhase = CurrentPhase;
+    CurrentPhase = NewPhase;
+    
+    // outside of updates, phases are tracked but not timed
+    if( !Measuring || NewPhase == PreviousPhase )
+      return PreviousPhase;
+    
+    Uint64 Now = SDL_GetPerformanceCounter();
+    CurrentRecord.PhaseTimes[ (int)PreviousPhase ] += 1000.0 * (Now - PhaseStart) / CounterFrequency;
+    PhaseStart = Now;
+    
+    return PreviousPhase;
+}
+
+
+// =============================================================================
+//      FRAME TELEMETRY: ACTIVITY COUNTS
+// =============================================================================
+
+
+void FrameTelemetry::AddConsoleFrame( const V32::ConsoleFrameCounters& Counters )
+{
+    if( !Measuring )
+      return;
+    
+    CurrentRecord.ConsoleFrames++;
+    CurrentRecord.CPUCycles        += Counters.CPUCycles;
+    CurrentRecord.PortWrites       += Counters.PortWrites;
+    CurrentRecord.GPUCommands      += Counters.ClearCommands + Counters.DrawCommands;
+    CurrentRecord.TextureSwitches  += Counters.TextureSwitches;
+    CurrentRecord.RejectedCommands += Counters.RejectedCommands;
+    CurrentRecord.RejectedPixels   += Counters.RejectedPixels;
+    
+    // sound was generated by the console while the CPU
+    // phase was active, so move that time to its phase
+    float SPUMixTime = 1000.0 * Counters.SPUMixTime;
+    CurrentRecord.PhaseTimes[ (int)TelemetryPhases::SPUMix ] += SPUMixTime;
+    CurrentRecord.PhaseTimes[ (int)TelemetryPhases::CPURun ] -= SPUMixTime;
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameTelemetry::AddDrawCall( int Quads )
+{
+    if( !Measuring )
+      return;
+    
+    CurrentRecord.DrawCalls++;
+    CurrentRecord.DrawnQuads += Quads;
+}
+
+
+// =============================================================================
+//      FRAME TELEMETRY: DISPLAY
+// =============================================================================
+
+
+void FrameTelemetry::SetOverlayVisible( bool Visible )
+{
+    OverlayVisible = Visible;
+}
+
+// -----------------------------------------------------------------------------
+
+bool FrameTelemetry::IsOverlayVisible()
+{
+    return OverlayVisible;
+}
+
+// -----------------------------------------------------------------------------
+
+void FrameTelemetry::ShowOverlay()
+{
+    if( !OverlayVisible )
+      return;
+    
+    // the overlay is placed below the menu bar, and it
+    // must not take any mouse input from the emulator
+    ImGuiWindowFlags Flags = ImGuiWindowFlags_NoDecoration
+                           | ImGuiWindowFlags_AlwaysAutoResize
+                           | ImGuiWindowFlags_NoSavedSettings
+                           | ImGuiWindowFlags_NoFocusOnAppearing
+                           | ImGuiWindowFlags_NoNav
+                           | ImGuiWindowFlags_NoInputs;
+    
+    ImGui::SetNextWindowPos( ImVec2( 5, ImGui::GetFrameHeight() + 5 ) );
+    ImGui::SetNextWindowBgAlpha( 0.6f );
+    
+    if( !ImGui::Begin( "Performance", nullptr, Flags ) )
+    {
+        ImGui::End();
+        return;
+    }
+    
+    if( HistoryCount <= 0 )
+    {
+        ImGui::Text( "(No data)" );
+        ImGui::End();
+        return;
+    }
+    
+    // histograms are given in chronological order
+    int PlotOffset = (HistoryCount < TELEMETRY_HISTORY_SIZE? 0 : HistoryPosition);
+    int PlotStride = sizeof(TelemetryRecord);
+    
+    // find average and maximum times
+    float AverageTimes[ TELEMETRY_PHASES ] = { 0 };
+    float MaximumTimes[ TELEMETRY_PHASES ] = { 0 };
+    float AverageTotal = 0, MaximumTotal = 0;
+    
+    for( int i = 0; i < HistoryCount; i++ )
+    {
+        TelemetryRecord& Record = History[ i ];
+        
+        for( int p = 0; p < TELEMETRY_PHASES; p++ )
+        {
+            AverageTimes[ p ] += Record.PhaseTimes[ p ] / HistoryCount;
+            MaximumTimes[ p ] = max( MaximumTimes[ p ], Record.PhaseTimes[ p ] );
+        }
+        
+        AverageTotal += Record.TotalTime / HistoryCount;
+        MaximumTotal = max( MaximumTotal, Record.TotalTime );
+    }
+    
+    // total time for the whole update, using the same
+    // scale for all phases so they can be compared
+    float PlotMaximum = max( MaximumTotal, 1000.0f / 60 );
+    ImGui::Text( "Update: avg %.2f ms, max %.2f ms", AverageTotal, MaximumTotal );
+    ImGui::PlotHistogram( "##Total", &History[ 0 ].TotalTime, HistoryCount, PlotOffset, nullptr, 0, PlotMaximum, ImVec2( 300, 40 ), PlotStride );
+    
+    for( int p = 0; p < TELEMETRY_PHASES; p++ )
+    {
+        ImGui::PushID( p );
+        ImGui::PlotHistogram( "##Phase", &History[ 0 ].PhaseTimes[ p ], HistoryCount, PlotOffset, nullptr, 0, PlotMaximum, ImVec2( 120, 16 ), PlotStride );
+        ImGui::SameLine();
+        ImGui::Text( "%-15s avg %5.2f, max %5.2f", PhaseNames[ p ], AverageTimes[ p ], MaximumTimes[ p ] );
+        ImGui::PopID();
+    }
+    
+    // activity counts are shown for the last update
+    TelemetryRecord& Last = GetRecord( HistoryCount - 1 );
+    ImGui::Separator();
+    ImGui::Text( "Console frames: %u, CPU cycles: %u", Last.ConsoleFrames, Last.CPUCycles );
+    ImGui::Text( "Port writes: %u, GPU commands: %u", Last.PortWrites, Last.GPUCommands );
+    ImGui::Text( "Texture switches: %u", Last.TextureSwitches );
+    ImGui::Text( "Rejected: %u commands, %u pixels", Last.RejectedCommands, Last.RejectedPixels );
+    ImGui::Text( "Host draw calls: %u, quads: %u", Last.DrawCalls, Last.DrawnQuads );
+    
+    // draw calls are the most common cause for driver slowdowns
+    auto GetDrawCalls = []( void* Data, int Index ) -> float
+    {
+        FrameTelemetry* Telemetry = (FrameTelemetry*)Data;
+        return Telemetry->GetRecord( Index ).DrawCalls;
+    };
+    
+    ImGui::PlotHistogram( "##DrawCalls", GetDrawCalls, this, HistoryCount, 0, nullptr, 0, FLT_MAX, ImVec2( 300, 30 ) );
+    ImGui::End();
+}
+
+
+// =============================================================================
+//      FRAME TELEMETRY: EXPORT
+// =============================================================================
+
+
+void FrameTelemetry::ExportCSV( const string& FilePath )
+{
+    LOG( "Exporting telemetry to \"" + FilePath + "\"" );
+    FILE* CSVFile = fopen( FilePath.c_str(), "w" );
+    
+    if( !CSVFile )
+      THROW( "Cannot open output file" );
+    
+    // header row
+    fprintf( CSVFile, "Update,TotalMs" );
+    
+    for( int p = 0; p < TELEMETRY_PHASES; p++ )
+      fprintf( CSVFile, ",%s", PhaseColumns[ p ] );
+    
+    fprintf( CSVFile, ",ConsoleFrames,CPUCycles,PortWrites,GPUCommands,TextureSwitches" );
+    fprintf( CSVFile, ",RejectedCommands,RejectedPixels,DrawCalls,DrawnQuads\n" );
+    
+    // one row per record, from oldest to newest
+    for( int i = 0; i < HistoryCount; i++ )
+    {
+        TelemetryRecord& Record = GetRecord( i );
+        fprintf( CSVFile, "%d,%.3f", i, Record.TotalTime );
+        
+        for( int p = 0; p < TELEMETRY_PHASES; p++ )
+          fprintf( CSVFile, ",%.3f", Record.PhaseTimes[ p ] );
+        
+        fprintf
+        (
+            CSVFile,
+            ",%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+            Record.ConsoleFrames,
+            Record.CPUCycles,
+            Record.PortWrites,
+            Record.GPUCommands,
+            Record.TextureSwitches,
+            Record.RejectedCommands,
+            Record.RejectedPixels,
+            Record.DrawCalls,
+            Record.DrawnQuads
+        );
+    }
+    
+    bool WriteFailed = ferror( CSVFile );
+    
+    if( fclose( CSVFile ) || WriteFailed )
+      THROW( "Cannot write output file" );
+}
@@ -0,0 +1,140 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef FRAMETELEMETRY_HPP
+    #define FRAMETELEMETRY_HPP
+    
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <cstdint>          // [ ANSI C ] Standard integers
+    
+    // include SDL2 headers
+    #define SDL_MAIN_HANDLED
+    #include "SDL.h"            // [ SDL2 ] Main header
+// *****************************************************************************
+
+
+// =============================================================================
+//      DEFINITIONS FOR FRAME TELEMETRY
+// =============================================================================
+
+
+// Each update of the main loop is measured as a record.
+// Time is split in exclusive phases: at any moment only
+// one phase is active, and nested measurements (such as
+// GPU submissions done while the CPU runs) just switch
+// to their own phase and then back to the previous one.
+
+// number of records kept (10 seconds at 60Hz)
+#define TELEMETRY_HISTORY_SIZE  600
+
+// -----------------------------------------------------------------------------
+
+enum class TelemetryPhases: int
+{
+    CPURun = 0,         // console emulation, except the phases below
+    GPUSubmission,      // sending batches of quads to the host GPU
+    SPUMix,             // generating sound for the console frame
+    AudioQueue,         // sending generated sound to the audio device
+    GUIRender,          // processing and rendering the ImGui windows
+    Swap,               // waiting for vsync and presenting the image
+    Other,              // events, captures, showing the framebuffer...
+    
+    NumberOfPhases
+};
+
+#define TELEMETRY_PHASES ((int)TelemetryPhases::NumberOfPhases)
+
+// -----------------------------------------------------------------------------
+
+struct TelemetryRecord
+{
+    // times in milliseconds
+    float PhaseTimes[ TELEMETRY_PHASES ];
+    float TotalTime;
+    
+    // console activity, added for all frames run
+    // (in fast-forward there can be many of them)
+    uint32_t ConsoleFrames;
+    uint32_t CPUCycles;
+    uint32_t PortWrites;
+    uint32_t GPUCommands;
+    uint32_t TextureSwitches;
+    uint32_t RejectedCommands;
+    uint32_t RejectedPixels;
+    
+    // activity of the host GPU
+    uint32_t DrawCalls;
+    uint32_t DrawnQuads;
+};
+
+
+// =============================================================================
+//      FRAME TELEMETRY CLASS
+// =============================================================================
+
+
+class FrameTelemetry
+{
+    private:
+        
+        // SDL high resolution counter
+        Uint64 CounterFrequency;
+        Uint64 UpdateStart;
+        Uint64 PhaseStart;
+        
+        // measurement of the current update
+        TelemetryPhases CurrentPhase;
+        TelemetryRecord CurrentRecord;
+        bool Measuring;
+        
+        // recent records, used as a ring buffer
+        TelemetryRecord History[ TELEMETRY_HISTORY_SIZE ];
+        int HistoryPosition;
+        int HistoryCount;
+        
+        // display control
+        bool OverlayVisible;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // Internal auxiliary methods
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        // access to history in chronological order
+        TelemetryRecord& GetRecord( int Index );
+        
+    public:
+        
+        // instance handling
+        FrameTelemetry();
+        
+        // measurement of each main loop update; an
+        // update that does not end is just discarded
+        void BeginUpdate();
+        void EndUpdate();
+        void Clear();
+        
+        // phase timing: returns the previous phase
+        // so that callers can go back to it later
+        TelemetryPhases SwitchPhase( TelemetryPhases NewPhase );
+        
+        // activity counts
+        void AddConsoleFrame( const V32::ConsoleFrameCounters& Counters );
+        void AddDrawCall( int Quads );
+        
+        // display as a GUI window (call within an ImGui frame)
+        void SetOverlayVisible( bool Visible );
+        bool IsOverlayVisible();
+        void ShowOverlay();
+        
+        // save all recent records as a CSV file
+        void ExportCSV( const std::string& FilePath );
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -12,6 +12,10 @@
     #include "GamepadsInput.hpp"
     #include "VideoOutput.hpp"
     #include "AudioOutput.hpp"
+    #include "FramePacer.hpp"
+    #include "FrameCapture.hpp"
+    #include "FrameTelemetry.hpp"
+    #include "EventTracer.hpp"
     #include "Texture.hpp"
     #include "Savestates.hpp"
     #include "Globals.hpp"
@@ -25,9 +29,6 @@
     // include osdialog headers
     #include <osdialog/osdialog.h>  // [ Dear ImGui ] Main header
     
-    // include libpng headers
-    #include <png.h>                // [ libpng ] Main header
-    
     // include imgui headers
     #include <imgui/imgui.h>                // [ Dear ImGui ] Main header
     #include <imgui/imgui_impl_sdl.h>       // [ Dear ImGui ] SDL2 backend header
@@ -217,92 +218,6 @@ void SetFullScreen()
 
 // -----------------------------------------------------------------------------
 
-void SaveScreenshot( const string& FilePath )
-{
-    LOG( "Saving a screenshot" );
-    
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // STEP 1: Read the contents of the framebuffer object
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    
-    // allocate space for the image
-    uint8_t* Pixels =  new uint8_t[ 4 * Constants::ScreenWidth * Constants::ScreenHeight ];
-    uint8_t** RowPointers = new uint8_t*[ Constants::ScreenHeight ];
-    
-    // images on framebuffer are rendered inverted in Y, so
-    // we invert the order of rows to reflect it back to normal
-    for( int y = 0; y < Constants::ScreenHeight; y++ )
-      RowPointers[ (Constants::ScreenHeight-1) - y ] = &Pixels[ 4 * Constants::ScreenWidth * y ];
-      
-    // dump content of framebuffer
-    glBindFramebuffer( GL_FRAMEBUFFER, Video.GetFramebufferID() );
-    glReadBuffer( GL_COLOR_ATTACHMENT0 );
-    glReadPixels( 0, 0, Constants::ScreenWidth, Constants::ScreenHeight, GL_RGBA, GL_UNSIGNED_BYTE, Pixels );
-    
-    // unbind framebuffer, since this function is called from GUI
-    glBindFramebuffer( GL_FRAMEBUFFER, 0 );
-    
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // STEP 2: Save those contents in PNG format
-    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    
-    // open output file
-    FILE *PNGFile = fopen( FilePath.c_str(), "wb" );
-    
-    if( !PNGFile )
-      THROW( "Cannot open output file" );
-    
-    // initialize PNG functions
-    png_struct* PNGHandler = png_create_write_struct( PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr );
-    
-    if( !PNGHandler )
-      THROW( "Cannot create PNG handler" );
-
-    png_info* PNGInfo = png_create_info_struct( PNGHandler );
-    
-    if( !PNGInfo )
-      THROW( "Cannot write PNG information" );
-
-    // define a callback function expected by libpng for error handling
-    if( setjmp( png_jmpbuf(PNGHandler) ) )
-      THROW( "Cannot initialize PNG error handling" );
-      
-    // begin writing
-    png_init_io( PNGHandler, PNGFile );
-
-    // define output as 8bit depth in RGBA format
-    png_set_IHDR
-    (
-        PNGHandler,
-        PNGInfo,
-        Constants::ScreenWidth,
-        Constants::ScreenHeight,
-        8,
-        PNG_COLOR_TYPE_RGBA,
-        PNG_INTERLACE_NONE,
-        PNG_COMPRESSION_TYPE_DEFAULT,
-        PNG_FILTER_TYPE_DEFAULT
-    );
-    
-    // write basic image info
-    png_write_info( PNGHandler, PNGInfo );
-    
-    // write the actual pixel data for all rows
-    png_write_image( PNGHandler, RowPointers );
-    
-    // end writing
-    png_write_end( PNGHandler, nullptr );
-    
-    // clean-up
-    fclose( PNGFile );
-    png_destroy_write_struct( &PNGHandler, &PNGInfo );
-    
-    delete Pixels;
-    delete RowPointers;
-}
-
-// -----------------------------------------------------------------------------
-
 void AddRecentCartridgePath( const string& CartridgePath )
 {
     // avoid duplicates
@@ -677,21 +592,200 @@ void GUI_SaveScreenshot( string FilePath )
             FilePath = EmulatorFolder + "Screenshots" + PathSeparator + FileName;
         }
         
-        // now just call the screenshot save function
-        SaveScreenshot( FilePath );
+        // the image is saved in the background,
+        // and the result will be reported later
+        Capture.RequestScreenshot( FilePath );
+    }
+    
+    catch( exception& e )
+    {
+        string MessageBoxText = Texts( TextIDs::Errors_SaveScreenshot_Label ) + string(e.what());
+        DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", MessageBoxText.c_str() );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void GUI_StartVideoCapture( VideoCaptureFormats Format )
+{
+    try
+    {
+        // obtain current time
+        time_t CreationTime;
+        time( &CreationTime );
+        struct tm* CreationTimeInfo = localtime( &CreationTime );
+        
+        // determine a file name from current date and time
+        // (Careful! C gives year counting from 1900)
+        char FileName[ 40 ];
+        
+        sprintf
+        (
+            FileName,
+            "%04d-%02d-%02d %02d.%02d.%02d.%s",
+            CreationTimeInfo->tm_year+1900,
+            CreationTimeInfo->tm_mon+1,
+            CreationTimeInfo->tm_mday,
+            CreationTimeInfo->tm_hour,
+            CreationTimeInfo->tm_min,
+            CreationTimeInfo->tm_sec,
+            (Format == VideoCaptureFormats::Y4M? "y4m" : "rgba")
+        );
+        
+        // videos are placed with the screenshots
+        string FilePath = EmulatorFolder + "Screenshots" + PathSeparator + FileName;
+        Capture.StartVideoCapture( FilePath, Format );
+    }
+    
+    catch( exception& e )
+    {
+        string MessageBoxText = Texts( TextIDs::Errors_VideoCapture_Label ) + string(e.what());
+        DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", MessageBoxText.c_str() );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void GUI_StopVideoCapture()
+{
+    Capture.StopVideoCapture();
+}
+
+// -----------------------------------------------------------------------------
+
+// screenshots and videos are saved in the background,
+// so their results can only be reported when done
+void GUI_ReportCaptureResults()
+{
+    CaptureResult Result;
+    
+    while( Capture.GetCaptureResult( Result ) )
+    {
+        if( Result.Type == CaptureJobTypes::Screenshot && Result.Success )
+        {
+            DelayedMessageBox
+            (
+                SDL_MESSAGEBOX_INFORMATION,
+                Texts( TextIDs::Dialogs_Done ),
+                Texts( TextIDs::Dialogs_ScreenshotSaved_Label )
+            );
+        }
+        
+        else if( Result.Type == CaptureJobTypes::Screenshot )
+        {
+            string MessageBoxText = Texts( TextIDs::Errors_SaveScreenshot_Label ) + Result.ErrorMessage;
+            DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", MessageBoxText.c_str() );
+        }
+        
+        else if( !Result.Success )
+        {
+            string MessageBoxText = Texts( TextIDs::Errors_VideoCapture_Label ) + Result.ErrorMessage;
+            DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", MessageBoxText.c_str() );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void GUI_ExportTelemetry()
+{
+    try
+    {
+        // obtain current time
+        time_t CreationTime;
+        time( &CreationTime );
+        struct tm* CreationTimeInfo = localtime( &CreationTime );
+        
+        // determine a file name from current date and time
+        // (Careful! C gives year counting from 1900)
+        char FileName[ 50 ];
+        
+        sprintf
+        (
+            FileName,
+            "Performance %04d-%02d-%02d %02d.%02d.%02d.csv",
+            CreationTimeInfo->tm_year+1900,
+            CreationTimeInfo->tm_mon+1,
+            CreationTimeInfo->tm_mday,
+            CreationTimeInfo->tm_hour,
+            CreationTimeInfo->tm_min,
+            CreationTimeInfo->tm_sec
+        );
+        
+        // place the file along with captures
+        string FilePath = EmulatorFolder + "Screenshots" + PathSeparator + FileName;
+        Telemetry.ExportCSV( FilePath );
         
-        // report success
         DelayedMessageBox
         (
             SDL_MESSAGEBOX_INFORMATION,
             Texts( TextIDs::Dialogs_Done ),
-            Texts( TextIDs::Dialogs_ScreenshotSaved_Label )
+            Texts( TextIDs::Dialogs_TelemetryExported_Label )
         );
     }
     
     catch( exception& e )
     {
-        string MessageBoxText = Texts( TextIDs::Errors_SaveScreenshot_Label ) + string(e.what());
+        string MessageBoxText = Texts( TextIDs::Errors_ExportTelemetry_Label ) + string(e.what());
+        DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", MessageBoxText.c_str() );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void GUI_StartTracing()
+{
+    Tracer.StartTracing();
+    
+    // events from the console are traced too
+    Console.Callbacks.TraceEvent = CallbackFunctions::TraceEvent;
+}
+
+// -----------------------------------------------------------------------------
+
+void GUI_StopTracing()
+{
+    Console.Callbacks.TraceEvent = nullptr;
+    Tracer.StopTracing();
+    
+    try
+    {
+        // obtain current time
+        time_t CreationTime;
+        time( &CreationTime );
+        struct tm* CreationTimeInfo = localtime( &CreationTime );
+        
+        // determine a file name from current date and time
+        // (Careful! C gives year counting from 1900)
+        char FileName[ 50 ];
+        
+        sprintf
+        (
+            FileName,
+            "Trace %04d-%02d-%02d %02d.%02d.%02d.json",
+            CreationTimeInfo->tm_year+1900,
+            CreationTimeInfo->tm_mon+1,
+            CreationTimeInfo->tm_mday,
+            CreationTimeInfo->tm_hour,
+            CreationTimeInfo->tm_min,
+            CreationTimeInfo->tm_sec
+        );
+        
+        // place the file along with captures
+        string FilePath = EmulatorFolder + "Screenshots" + PathSeparator + FileName;
+        Tracer.SaveJSON( FilePath );
+        
+        DelayedMessageBox
+        (
+            SDL_MESSAGEBOX_INFORMATION,
+            Texts( TextIDs::Dialogs_Done ),
+            Texts( TextIDs::Dialogs_TraceSaved_Label )
+        );
+    }
+    
+    catch( exception& e )
+    {
+        string MessageBoxText = Texts( TextIDs::Errors_SaveTrace_Label ) + string(e.what());
         DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", MessageBoxText.c_str() );
     }
 }
@@ -1105,6 +1199,31 @@ void ProcessMenuOptions()
         ImGui::EndMenu();
     }
     
+    if( ImGui::BeginMenu( Texts(TextIDs::Options_FastForward) ) )
+    {
+        if( ImGui::MenuItem( Texts(TextIDs::Options_FastForwardOn), nullptr, Emulator.IsFastForward(), true ) )
+          Emulator.SetFastForward( !Emulator.IsFastForward() );
+        
+        ImGui::Separator();
+        
+        // speed multipliers
+        float Multiplier = Emulator.GetSpeedMultiplier();
+        
+        if( ImGui::MenuItem( "x2", nullptr, (Multiplier == 2), true ) )
+          Emulator.SetSpeedMultiplier( 2 );
+        
+        if( ImGui::MenuItem( "x4", nullptr, (Multiplier == 4), true ) )
+          Emulator.SetSpeedMultiplier( 4 );
+        
+        if( ImGui::MenuItem( "x8", nullptr, (Multiplier == 8), true ) )
+          Emulator.SetSpeedMultiplier( 8 );
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Options_SpeedMaximum), nullptr, (Multiplier == 0), true ) )
+          Emulator.SetSpeedMultiplier( 0 );
+        
+        ImGui::EndMenu();
+    }
+    
     if( ImGui::BeginMenu( Texts(TextIDs::Options_Language) ) )
     {
         if( ImGui::MenuItem( Texts(TextIDs::Options_English), nullptr, (CurrentLanguage == &LanguageEnglish[0]), true ) )
@@ -1134,6 +1253,47 @@ void ProcessMenuOptions()
     if( ImGui::MenuItem( Texts(TextIDs::Options_Screenshot), nullptr, false, Emulator.IsPowerOn() ) )
       GUI_SaveScreenshot();
     
+    if( ImGui::BeginMenu( Texts(TextIDs::Options_VideoCapture) ) )
+    {
+        bool Capturing = Capture.IsCapturingVideo();
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Capture_StartY4M), nullptr, false, !Capturing ) )
+          GUI_StartVideoCapture( VideoCaptureFormats::Y4M );
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Capture_StartRaw), nullptr, false, !Capturing ) )
+          GUI_StartVideoCapture( VideoCaptureFormats::RawRGBA );
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Capture_Stop), nullptr, false, Capturing ) )
+          GUI_StopVideoCapture();
+        
+        ImGui::EndMenu();
+    }
+    
+    if( ImGui::BeginMenu( Texts(TextIDs::Options_Performance) ) )
+    {
+        bool OverlayVisible = Telemetry.IsOverlayVisible();
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Performance_Overlay), nullptr, OverlayVisible, true ) )
+          Telemetry.SetOverlayVisible( !OverlayVisible );
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Performance_Export) ) )
+          GUI_ExportTelemetry();
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Performance_Clear) ) )
+          Telemetry.Clear();
+        
+        ImGui::Separator();
+        bool Tracing = Tracer.IsTracing();
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Performance_StartTrace), nullptr, false, !Tracing ) )
+          GUI_StartTracing();
+        
+        if( ImGui::MenuItem( Texts(TextIDs::Performance_StopTrace), nullptr, false, Tracing ) )
+          GUI_StopTracing();
+        
+        ImGui::EndMenu();
+    }
+    
     ImGui::EndMenu();
 }
 
@@ -1208,6 +1368,27 @@ void ProcessLabelCPU()
         int CPULoad = Console.GetCPULoad();
         int GPULoad = Console.GetGPULoad();
         ImGui::Text( "CPU %d%%, GPU %d%%", CPULoad, GPULoad );
+        
+        // indicate when video is being captured
+        if( Capture.IsCapturingVideo() )
+          ImGui::Text( "REC %u", Capture.GetCapturedFrames() );
+        
+        // indicate when fast-forward is active
+        if( Emulator.IsFastForward() )
+        {
+            float Multiplier = Emulator.GetSpeedMultiplier();
+            
+            if( Multiplier > 0 )
+              ImGui::Text( ">> x%g", Multiplier );
+            else
+              ImGui::Text( ">> MAX" );
+        }
+        
+        // also show display timing, with jitter
+        // as the deviation of frame times in ms
+        float RefreshRate = Pacer.GetRefreshRate();
+        float Jitter = 1000 * Pacer.GetFrameTimeJitter();
+        ImGui::Text( "%.2f Hz, jitter %.2f ms", RefreshRate, Jitter );
     }
     
     ImGui::PopStyleVar();
@@ -1287,6 +1468,15 @@ void RenderGUI()
     ImGui_ImplSDL2_NewFrame( Video.GetWindow() );
     ImGui::NewFrame();
     
+    // when only the performance overlay is shown, the menu
+    // bar is still processed (as it happens when no GUI is
+    // shown) but it is made invisible
+    bool GUIIsDrawn = GUIMustBeDrawn();
+    bool OnlyOverlayIsDrawn = !GUIIsDrawn && Telemetry.IsOverlayVisible();
+    
+    if( OnlyOverlayIsDrawn )
+      ImGui::PushStyleVar( ImGuiStyleVar_Alpha, 0 );
+    
     // show the main menu bar
     if( ImGui::BeginMainMenuBar() )
     {
@@ -1304,8 +1494,14 @@ void RenderGUI()
         ImGui::EndMainMenuBar();
     }
     
+    if( OnlyOverlayIsDrawn )
+      ImGui::PopStyleVar();
+    
+    // the overlay is shown even while playing
+    Telemetry.ShowOverlay();
+    
     // (2) Render imgui
-    if( GUIMustBeDrawn() )
+    if( GUIIsDrawn || OnlyOverlayIsDrawn )
     {
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
@@ -6,6 +6,9 @@
     // include C/C++ headers
     #include <string>           // [ C++ STL ] Strings
     #include <cstdint>          // [ ANSI C ] Standard integer types
+    
+    // forward declarations for needed types
+    enum class VideoCaptureFormats;
 // *****************************************************************************
 
 
@@ -34,7 +37,6 @@ void ShowDelayedMessageBox();
 
 void SetWindowZoom( int ZoomFactor );
 void SetFullScreen();
-void SaveScreenshot( const std::string& FilePath );
 void AddRecentCartridgePath( const std::string& CartridgePath );
 void AddRecentMemoryCardPath( const std::string& MemoryCardPath );
 void CheckCartridgePaths();
@@ -57,6 +59,12 @@ void GUI_UnloadCartridge();
 void GUI_LoadCartridge( std::string CartridgePath = "" );
 void GUI_ChangeCartridge( std::string CartridgePath = "" );
 void GUI_SaveScreenshot( std::string FilePath = "" );
+void GUI_StartVideoCapture( VideoCaptureFormats Format );
+void GUI_StopVideoCapture();
+void GUI_ReportCaptureResults();
+void GUI_ExportTelemetry();
+void GUI_StartTracing();
+void GUI_StopTracing();
 void GUI_LoadState();
 void GUI_SaveState();
 
@@ -10,6 +10,10 @@
     #include "GamepadsInput.hpp"
     #include "VideoOutput.hpp"
     #include "AudioOutput.hpp"
+    #include "FramePacer.hpp"
+    #include "FrameCapture.hpp"
+    #include "FrameTelemetry.hpp"
+    #include "EventTracer.hpp"
     #include "Texture.hpp"
     #include "Globals.hpp"
     
@@ -51,6 +55,16 @@ VideoOutput Video;
 AudioOutput Audio;
 GamepadsInput Gamepads;
 
+// timing of the main loop
+FramePacer Pacer;
+
+// screenshots and video capture
+FrameCapture Capture;
+
+// performance measurement
+FrameTelemetry Telemetry;
+EventTracer Tracer;
+
 // video resources
 Texture NoSignalTexture;
 
@@ -82,21 +96,21 @@ void InitializeGlobalVariables()
 
 namespace CallbackFunctions
 {
-    void ClearScreen( V32::GPUColor ClearColor )
+    void ClearScreen( void* UserData, V32::GPUColor ClearColor )
     {
         Video.ClearScreen( ClearColor );
     }
 
     // -----------------------------------------------------------------------------
 
-    void DrawQuad( V32::GPUQuad& DrawnQuad )
+    void DrawQuad( void* UserData, V32::GPUQuad& DrawnQuad )
     {
         Video.AddQuadToQueue( DrawnQuad );
     }
 
     // -----------------------------------------------------------------------------
 
-    void SetMultiplyColor( V32::GPUColor NewMultiplyColor )
+    void SetMultiplyColor( void* UserData, V32::GPUColor NewMultiplyColor )
     {
         // GPU colors are not directly comparable so use words
         V32::V32Word New, Old;
@@ -111,7 +125,7 @@ namespace CallbackFunctions
 
     // -----------------------------------------------------------------------------
 
-    void SetBlendingMode( int NewBlendingMode )
+    void SetBlendingMode( void* UserData, int NewBlendingMode )
     {
         // set blending mode only when needed, so that
         // quad groups are not broken without need
@@ -121,7 +135,7 @@ namespace CallbackFunctions
 
     // -----------------------------------------------------------------------------
 
-    void SelectTexture( int GPUTextureID )
+    void SelectTexture( void* UserData, int GPUTextureID )
     {
         // select texture only when needed, so that
         // quad groups are not broken without need
@@ -131,14 +145,14 @@ namespace CallbackFunctions
 
     // -----------------------------------------------------------------------------
 
-    void LoadTexture( int GPUTextureID, void* Pixels )
+    void LoadTexture( void* UserData, int GPUTextureID, void* Pixels )
     {
         Video.LoadTexture( GPUTextureID, Pixels );
     }
 
     // -----------------------------------------------------------------------------
 
-    void UnloadCartridgeTextures()
+    void UnloadCartridgeTextures( void* UserData )
     {
         for( int i = 0; i < V32::Constants::GPUMaximumCartridgeTextures; i++ )
           Video.UnloadTexture( i );
@@ -146,22 +160,48 @@ namespace CallbackFunctions
     
     // -----------------------------------------------------------------------------
 
-    void UnloadBiosTexture()
+    void UnloadBiosTexture( void* UserData )
     {
         Video.UnloadTexture( -1 );
     }
     
     // -----------------------------------------------------------------------------
 
-    void LogLine( const string& Message )
+    void SkipClearScreen( void* UserData, V32::GPUColor ClearColor )
+    {
+        // nothing to do
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SkipDrawQuad( void* UserData, V32::GPUQuad& DrawnQuad )
+    {
+        // nothing to do
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void LogLine( void* UserData, const string& Message )
     {
         LOG( Message );
     }
     
     // -----------------------------------------------------------------------------
 
-    void ThrowException( const string& Message )
+    void ThrowException( void* UserData, const string& Message )
     {
         THROW( Message );
     }
+    
+    // -----------------------------------------------------------------------------
+    
+    void TraceEvent( void* UserData, const char* Name, char Phase, int32_t Value )
+    {
+        if( Phase == 'B' )
+          Tracer.Begin( "guest", Name, Value );
+        else if( Phase == 'E' )
+          Tracer.End( "guest", Name );
+        else
+          Tracer.Instant( "guest", Name, Value );
+    }
 }
@@ -18,6 +18,10 @@
     class GamepadsInput;
     class VideoOutput;
     class AudioOutput;
+    class FramePacer;
+    class FrameCapture;
+    class FrameTelemetry;
+    class EventTracer;
     class Texture;
 // *****************************************************************************
 
@@ -55,6 +59,16 @@ extern VideoOutput Video;
 extern AudioOutput Audio;
 extern GamepadsInput Gamepads;
 
+// timing of the main loop
+extern FramePacer Pacer;
+
+// screenshots and video capture
+extern FrameCapture Capture;
+
+// performance measurement
+extern FrameTelemetry Telemetry;
+extern EventTracer Tracer;
+
 // video resources
 extern Texture NoSignalTexture;
 
@@ -72,21 +86,31 @@ void InitializeGlobalVariables();
 // =============================================================================
 
 
+// this program has a single console, whose
+// frontend is global, so user data is not used
 namespace CallbackFunctions
 {
     // video functions callable by the console
-    void ClearScreen( V32::GPUColor ClearColor );
-    void DrawQuad( V32::GPUQuad& DrawnQuad );
-    void SetMultiplyColor( V32::GPUColor NewMultiplyColor );
-    void SetBlendingMode( int NewBlendingMode );
-    void SelectTexture( int GPUTextureID );
-    void LoadTexture( int GPUTextureID, void* Pixels );
-    void UnloadCartridgeTextures();
-    void UnloadBiosTexture();
+    void ClearScreen( void* UserData, V32::GPUColor ClearColor );
+    void DrawQuad( void* UserData, V32::GPUQuad& DrawnQuad );
+    void SetMultiplyColor( void* UserData, V32::GPUColor NewMultiplyColor );
+    void SetBlendingMode( void* UserData, int NewBlendingMode );
+    void SelectTexture( void* UserData, int GPUTextureID );
+    void LoadTexture( void* UserData, int GPUTextureID, void* Pixels );
+    void UnloadCartridgeTextures( void* UserData );
+    void UnloadBiosTexture( void* UserData );
+    
+    // replacements to skip drawing on frames
+    // that are not shown, in fast-forward
+    void SkipClearScreen( void* UserData, V32::GPUColor ClearColor );
+    void SkipDrawQuad( void* UserData, V32::GPUQuad& DrawnQuad );
     
     // log functions callable by the console
-    void LogLine( const std::string& Message );
-    void ThrowException( const std::string& Message );
+    void LogLine( void* UserData, const std::string& Message );
+    void ThrowException( void* UserData, const std::string& Message );
+    
+    // tracing of console events (only set while tracing)
+    void TraceEvent( void* UserData, const char* Name, char Phase, int32_t Value );
 }
 
 
@@ -123,6 +123,19 @@ string LanguageEnglish[] =
     "Manual (use card menu)",
     "English",
     "Spanish",
+    "Fast forward",
+    "Enabled  (Ctrl+T)",
+    "Maximum speed",
+    "Video capture",
+    "Record video (Y4M)",
+    "Record video (raw RGBA)",
+    "Stop recording",
+    "Performance monitor",
+    "Show overlay",
+    "Export to CSV file",
+    "Clear data",
+    "Start event trace",
+    "Stop and save trace",
     "Quick guide",
     "Show Readme file",
     "About",
@@ -137,6 +150,8 @@ string LanguageEnglish[] =
     "Done",
     "Memory card is created",
     "Screenshot is saved",
+    "Performance data is saved",
+    "Event trace is saved",
     "About Vircon32 Emulator",
     AboutTextEnglish,
     "Quick guide",
@@ -154,6 +169,9 @@ string LanguageEnglish[] =
     "Cannot unload cartridge.\nReason: ",
     "Cannot change cartridge.\nReason: ",
     "Cannot save screenshot.\nReason: ",
+    "Cannot record video.\nReason: ",
+    "Cannot export performance data.\nReason: ",
+    "Cannot save event trace.\nReason: ",
     "Cannot save state.\nReason: ",
     "Cannot load state.\nReason: ",
     "Cannot load controls file.\nReason: ",
@@ -262,6 +280,19 @@ string LanguageSpanish[] =
     "Manual (usar men\u00FA)",
     "Ingl\u00E9s",
     "Espa\u00F1ol",
+    "Avance r\u00E1pido",
+    "Activado  (Ctrl+T)",
+    "Velocidad m\u00E1xima",
+    "Captura de video",
+    "Grabar video (Y4M)",
+    "Grabar video (RGBA sin formato)",
+    "Detener grabaci\u00F3n",
+    "Monitor de rendimiento",
+    "Mostrar superposici\u00F3n",
+    "Exportar a archivo CSV",
+    "Borrar datos",
+    "Iniciar traza de eventos",
+    "Detener y guardar traza",
     "Gu\u00EDa r\u00E1pida",
     "Ver archivo Readme",
     "Acerca de",
@@ -276,6 +307,8 @@ string LanguageSpanish[] =
     "Hecho",
     "Se ha creado la tarjeta de memoria",
     "La captura de pantalla se ha guardado",
+    "Los datos de rendimiento se han guardado",
+    "La traza de eventos se ha guardado",
     "Sobre el emulador de Vircon32",
     AboutTextSpanish,
     "Gu\u00EDa r\u00E1pida",
@@ -293,6 +326,9 @@ string LanguageSpanish[] =
     "No se puede quitar el cartucho.\nCausa: ",
     "No se puede cambiar el cartucho.\nCausa: ",
     "No se puede guardar la captura de pantalla.\nCausa: ",
+    "No se puede grabar el video.\nCausa: ",
+    "No se pueden exportar los datos de rendimiento.\nCausa: ",
+    "No se puede guardar la traza de eventos.\nCausa: ",
     "No se puede guardar el estado.\nCausa: ",
     "No se puede cargar el estado.\nCausa: ",
     "No se puede cargar el archivo de controles.\nCausa: ",
@@ -57,6 +57,19 @@ enum class TextIDs: int
     Options_CardsManual,
     Options_English,
     Options_Spanish,
+    Options_FastForward,
+    Options_FastForwardOn,
+    Options_SpeedMaximum,
+    Options_VideoCapture,
+    Capture_StartY4M,
+    Capture_StartRaw,
+    Capture_Stop,
+    Options_Performance,
+    Performance_Overlay,
+    Performance_Export,
+    Performance_Clear,
+    Performance_StartTrace,
+    Performance_StopTrace,
     Help_QuickGuide,
     Help_ShowReadme,
     Help_About,
@@ -71,6 +84,8 @@ enum class TextIDs: int
     Dialogs_Done,
     Dialogs_CardCreated_Label,
     Dialogs_ScreenshotSaved_Label,
+    Dialogs_TelemetryExported_Label,
+    Dialogs_TraceSaved_Label,
     Dialogs_About_Title,
     Dialogs_About_Label,
     Dialogs_Guide_Title,
@@ -88,6 +103,9 @@ enum class TextIDs: int
     Errors_UnloadCartridge_Label,
     Errors_ChangeCartridge_Label,
     Errors_SaveScreenshot_Label,
+    Errors_VideoCapture_Label,
+    Errors_ExportTelemetry_Label,
+    Errors_SaveTrace_Label,
     Errors_SaveState_Label,
     Errors_LoadState_Label,
     Errors_LoadControls_Label,
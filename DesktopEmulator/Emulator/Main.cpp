@@ -15,7 +15,10 @@
     #include "Settings.hpp"
     #include "Globals.hpp"
     #include "Languages.hpp"
-    #include "StopWatch.hpp"
+    #include "FramePacer.hpp"
+    #include "FrameCapture.hpp"
+    #include "FrameTelemetry.hpp"
+    #include "EventTracer.hpp"
     #include "Texture.hpp"
     
     // include C/C++ headers
@@ -30,15 +33,6 @@
     #include <imgui/imgui_impl_sdl.h>       // [ Dear ImGui ] SDL2 backend header
     #include <imgui/imgui_impl_opengl3.h>   // [ Dear ImGui ] OpenGL 3 backend header
     
-    // include OpenAL headers
-    #if defined(__APPLE__)
-      #include <OpenAL/al.h>    // [ OpenAL ] Main header
-      #include <AL/alut.h>      // [ OpenAL ] Utility Toolkit
-    #else
-      #include <AL/al.h>        // [ OpenAL ] Main header
-      #include <AL/alut.h>      // [ OpenAL ] Utility Toolkit
-    #endif
-    
     // on Linux, include GTK headers
     #if defined(__linux__)
       #include <gtk/gtk.h>      // [ GTK ] Main header
@@ -220,21 +214,17 @@ int main( int NumberOfArguments, char* Arguments[] )
         
         // create a framebuffer object
         Video.CreateFramebuffer();
+        Video.CreateReadbackBuffers();
         Video.RenderToScreen();
         
+        // start the thread that saves captured images
+        Capture.Initialize();
+        
         // set alpha blending
         LOG( "Enabling alpha blending" );
         glEnable( GL_BLEND );
         Video.SetBlendingMode( IOPortValues::GPUBlendingMode_Alpha );
         
-        //initialize audio
-        LOG( "Initializing audio" );
-        alutInit( NULL, NULL );
-        
-        // locating listener
-        alListener3f( AL_POSITION, 0, 0, 0 );
-        alListenerf( AL_GAIN, 1.0 );
-        
         // initialize languages
         Languages[ "English" ] = LanguageEnglish;
         Languages[ "Spanish" ] = LanguageSpanish;
@@ -275,6 +265,9 @@ int main( int NumberOfArguments, char* Arguments[] )
           gtk_init( &NumberOfArguments, &Arguments );
         #endif
         
+        // start timing from the display used by the window
+        Pacer.Initialize( Video.GetWindow() );
+        
         // -----------------------------------------------------------------------------
         
         // turn on Vircon VM
@@ -300,14 +293,14 @@ int main( int NumberOfArguments, char* Arguments[] )
         LOG( "---------------------------------------------------------------------" );
         GlobalLoopActive = true;
         bool WindowActive = true;
-        float PendingFrames = 1;
-        
-        // timing control
-        StopWatch Watch;
+        Tracer.SetThreadName( "Main" );
         
         // begin message loop
         while( GlobalLoopActive )
         {
+            // measure each update, from the start
+            Telemetry.BeginUpdate();
+            
             // process window events
             SDL_Event Event;
             
@@ -366,7 +359,7 @@ int main( int NumberOfArguments, char* Arguments[] )
                       MouseIsOnWindow = false;
                     
                     // on any window event (such as lose focus) "stop time"
-                    Watch.GetStepTime();
+                    Pacer.Reset();
                 }
                 
                 // respond to keys being pressed
@@ -454,6 +447,10 @@ int main( int NumberOfArguments, char* Arguments[] )
                         // Ctrl+M = Mute toggle
                         if( Key == SDLK_m )
                           Audio.SetMute( !Audio.IsMuted() );
+                        
+                        // Ctrl+T = Fast-forward toggle
+                        if( Key == SDLK_t )
+                          Emulator.SetFastForward( !Emulator.IsFastForward() );
                     }
                 }
                 
@@ -466,30 +463,26 @@ int main( int NumberOfArguments, char* Arguments[] )
             }
             
             // update frame only when needed
-            if( !WindowActive ) continue;
+            if( !WindowActive )
+            {
+                Pacer.WaitWhileInactive();
+                continue;
+            }
+            
+            // collect images read back in previous updates
+            Capture.Update();
             
             // redirect all rendering to emulator's display
             Video.RenderToFramebuffer();
             Video.BeginFrame();
             
-            // measure cycle time
-            double TimeStep = Watch.GetStepTime();
+            // the pacer decides how many frames are due
+            // for this update (which can be none) from
+            // the timestamps of previous buffer swaps
+            int FramesToRun = Pacer.GetFramesToRun();
             
             if( Emulator.IsPowerOn() && !Emulator.IsPaused() )
-            {
-                // execute frames as needed
-                PendingFrames += TimeStep * 60.0;
-                if( PendingFrames < 0.9 ) continue;
-                
-                while( PendingFrames >= 0.9 )
-                {
-                    // run another frame
-                    Emulator.RunNextFrame();
-                    
-                    // this frame is done
-                    PendingFrames = max( PendingFrames - 1, 0.0f );
-                }
-            }
+              Emulator.RunFrames( FramesToRun, Pacer.GetUpdatePeriod() );
             
             // - - - - - - - - - - - - - - - - - - - - - - - - - -
             // THE FOLLOWING WILL BE DONE JUST ONCE PER UPDATE
@@ -498,17 +491,31 @@ int main( int NumberOfArguments, char* Arguments[] )
             ShowEmulatorWindow();
             
             // (2) Render GUI (on full screen, only when needed)
+            Telemetry.SwitchPhase( TelemetryPhases::GUIRender );
+            Tracer.Begin( "emulator", "GUI" );
             RenderGUI();
+            Tracer.End( "emulator", "GUI" );
             
-            // (3) Show updates on screen
+            // (3) Show updates on screen; when vsync is
+            // not available, sleep here until it is time
+            Telemetry.SwitchPhase( TelemetryPhases::Swap );
+            Tracer.Begin( "emulator", "Swap" );
+            Pacer.WaitBeforeSwap();
             SDL_GL_SwapWindow( Video.GetWindow() );
+            Pacer.RegisterSwap();
+            Tracer.End( "emulator", "Swap" );
+            Telemetry.EndUpdate();
             
             // (4) Show message boxes when needed
+            GUI_ReportCaptureResults();
             ShowDelayedMessageBox();
         }
         
         // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
         
+        // finish saving any captured images
+        Capture.Terminate();
+        
         // turn off Vircon VM
         Emulator.Terminate();
         
@@ -523,10 +530,6 @@ int main( int NumberOfArguments, char* Arguments[] )
         // end connection to SDL joysticks
         Gamepads.CloseAllJoysticks();
         
-        // shut down ALUT
-        LOG( "Terminating audio" );
-        alutExit();
-        
         // shut down imgui
         LOG( "Shutting down ImGui" );
         ImGui_ImplOpenGL3_Shutdown();
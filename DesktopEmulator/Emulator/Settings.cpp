@@ -325,7 +325,7 @@ void LoadControls( const std::string& FilePath )
     // as backup, set our default configuration
     catch( exception& e )
     {
-        LOG( "Cannot load controls file: " + string(e.what()) );
+        LOG_WARNING( "Cannot load controls file: " + string(e.what()) );
         
         string Message = Texts( TextIDs::Errors_LoadControls_Label ) + string(e.what()) + "\n";
         Message += Texts( TextIDs::Errors_LoadControls_SetDefaults );
@@ -605,7 +605,7 @@ void LoadSettings( const string& FilePath )
     // as backup, set our default configuration
     catch( exception& e )
     {
-        LOG( "Cannot load settings file: " + string(e.what()) );
+        LOG_WARNING( "Cannot load settings file: " + string(e.what()) );
         
         string Message = Texts( TextIDs::Errors_LoadSettings_Label ) + string(e.what()) + "\n";
         Message += Texts( TextIDs::Errors_LoadSettings_SetDefaults );
@@ -741,7 +741,7 @@ void SaveSettings( const string& FilePath )
     // as backup, set our default configuration
     catch( exception& e )
     {
-        LOG( "Cannot save settings file: " + string(e.what()) );
+        LOG_WARNING( "Cannot save settings file: " + string(e.what()) );
         
         string Message = Texts( TextIDs::Errors_SaveSettings_Label ) + string(e.what());
         DelayedMessageBox( SDL_MESSAGEBOX_ERROR, "Error", Message.c_str() );
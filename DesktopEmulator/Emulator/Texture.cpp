@@ -58,7 +58,7 @@ void Texture::Load( const string& FileName )
     // STEP 1: USE SDL_IMAGE TO LOAD IMAGE FROM FILE
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     
-    LOG( "Texture -> Load \"" + FileName + "\"" );
+    LOG_DEBUG( "Texture -> Load \"" + FileName + "\"" );
     SDL_Surface* LoadedImage = NULL;
     
     // load image from file
@@ -160,7 +160,7 @@ void Texture::Release()
     if( !TextureID ) return;
     
     // delete the OpenGL texture
-    LOG( "Texture -> Release \"" + LoadedFile + "\"" );
+    LOG_DEBUG( "Texture -> Release \"" + LoadedFile + "\"" );
     glDeleteTextures( 1, &TextureID );
     TextureID = 0;
 }
@@ -8,6 +8,12 @@
     
     // include emulator headers
     #include "VideoOutput.hpp"
+    #include "FrameTelemetry.hpp"
+    #include "EventTracer.hpp"
+    #include "Globals.hpp"
+    
+    // include C/C++ headers
+    #include <cstring>          // [ ANSI C ] Strings
     
     // declare used namespaces
     using namespace std;
@@ -143,6 +149,13 @@ VideoOutput::VideoOutput()
     SelectedTexture = -1;
     QueuedQuads = 0;
     
+    // readback buffers not created yet
+    for( int i = 0; i < READBACK_BUFFERS; i++ )
+      ReadbackPBOs[ i ] = 0;
+    
+    FirstReadback = 0;
+    PendingReadbacks = 0;
+    
     // all texture IDs are initially 0
     BiosTextureID = 0;
     WhiteTextureID = 0;
@@ -229,14 +242,14 @@ void VideoOutput::CreateOpenGLWindow()
     if( !OpenGLContext )
       THROW( string("OpenGL context cannot be created: ") + SDL_GetError() );
     else
-      LOG( "OpenGL context created successfully" );
+      LOG_DEBUG( "OpenGL context created successfully" );
     
     SDL_GL_MakeCurrent( Window, OpenGLContext );
     
     // GLAD loader has to be called after OpenGL is initialized (i.e. window is created)
     // but, before we make any calls related to framebuffer objects
     // (alternatively, use gladLoadGL() instead)
-    LOG( "Initializing GLAD" );
+    LOG_DEBUG( "Initializing GLAD" );
     
     if( !gladLoadGLLoader( (GLADloadproc)SDL_GL_GetProcAddress ) )
       THROW( "There was an error initializing GLAD" );
@@ -264,13 +277,13 @@ void VideoOutput::CreateOpenGLWindow()
     LOG( string("GLSL version: ") + (char*)glGetString( GL_SHADING_LANGUAGE_VERSION ) );
     
     // use vsync
-    LOG( "Activating VSync" );
+    LOG_DEBUG( "Activating VSync" );
     SDL_GL_SetSwapInterval( 1 );
     
     // configure viewport
     // (CAREFUL: do not call RenderToScreen for this, as it includes
     // a framebuffer binding and fraebuffer is not created yet)
-    LOG( "Setting 2D viewport" );
+    LOG_DEBUG( "Setting 2D viewport" );
     glViewport( 0, 0, WindowWidth, WindowHeight );
     
     // any render clipping is no longer necessary
@@ -287,7 +300,7 @@ void VideoOutput::CreateFramebuffer()
     ClearOpenGLErrors();
     
     // create our frame buffer and select it
-    LOG( "Creating Framebuffer object" );
+    LOG_DEBUG( "Creating Framebuffer object" );
     
     glGenFramebuffers( 1, &FramebufferID );
     LogOpenGLResult( "glGenFramebuffers" );
@@ -302,7 +315,7 @@ void VideoOutput::CreateFramebuffer()
     FramebufferHeight = NextPowerOf2( Constants::ScreenHeight );
     
     // create our texture for the frame buffer and select it
-    LOG( "Creating a new texture" );
+    LOG_DEBUG( "Creating a new texture" );
         
     glGenTextures( 1, &FBColorTextureID );
     LogOpenGLResult( "glGenTextures" );
@@ -332,22 +345,22 @@ void VideoOutput::CreateFramebuffer()
     
     // PART 2: FRAME BUFFER
     // Set our color texture as framebuffer's colour attachment #0
-    LOG( "Binding the render buffer to the Framebuffer" );
+    LOG_DEBUG( "Binding the render buffer to the Framebuffer" );
     
     if( glFramebufferTexture2D == nullptr )
-      LOG( "Function glFramebufferTexture is not linked!" );
+      LOG_WARNING( "Function glFramebufferTexture is not linked!" );
     
     glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, FBColorTextureID, 0 );
     LogOpenGLResult( "glFramebufferTexture" );
     
-    LOG( "Checking status of the created Framebuffer" );
+    LOG_DEBUG( "Checking status of the created Framebuffer" );
     GLenum FBOStatus = glCheckFramebufferStatus( GL_FRAMEBUFFER );
     LogOpenGLResult( "glCheckFramebufferStatus" );
     
     if( FBOStatus != GL_FRAMEBUFFER_COMPLETE )
       THROW( string("Framebuffer status is not complete. Status: ") + (const char*)glGetString( FBOStatus ) );
     
-    LOG( "Framebuffer status OK" );
+    LOG_DEBUG( "Framebuffer status OK" );
     
     // Set the list of draw buffers.
     GLenum ColorBuffers[ 1 ] = { GL_COLOR_ATTACHMENT0 };
@@ -383,7 +396,7 @@ bool VideoOutput::CompileShaderProgram()
         GLchar* GLInfoLog = new GLchar[ GLInfoLogLength + 1 ];
         glGetShaderInfoLog( VertexShaderID, GLInfoLogLength, nullptr, GLInfoLog );    
         
-        LOG( string("ERROR: Vertex shader compilation failed: ") + (char*)GLInfoLog );
+        LOG_ERROR( string("Vertex shader compilation failed: ") + (char*)GLInfoLog );
         delete GLInfoLog;
         
         glDeleteShader( VertexShaderID );
@@ -391,7 +404,7 @@ bool VideoOutput::CompileShaderProgram()
         return false;
     }
     
-    LOG( "Vertex shader compiled successfully! ID = " + to_string( VertexShaderID ) );
+    LOG_DEBUG( "Vertex shader compiled successfully! ID = " + to_string( VertexShaderID ) );
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // PART 2: Compile our fragment shader
@@ -409,7 +422,7 @@ bool VideoOutput::CompileShaderProgram()
         GLchar* GLInfoLog = new GLchar[ GLInfoLogLength + 1 ];
         glGetShaderInfoLog( FragmentShaderID, GLInfoLogLength, nullptr, GLInfoLog );    
         
-        LOG( string("ERROR: Fragment shader compilation failed: ") + (char*)GLInfoLog );
+        LOG_ERROR( string("Fragment shader compilation failed: ") + (char*)GLInfoLog );
         delete GLInfoLog;
         
         glDeleteShader( VertexShaderID );
@@ -418,7 +431,7 @@ bool VideoOutput::CompileShaderProgram()
         return false;
     }
     
-    LOG( "Fragment shader compiled successfully! ID = " + to_string( FragmentShaderID ) );
+    LOG_DEBUG( "Fragment shader compiled successfully! ID = " + to_string( FragmentShaderID ) );
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // PART 3: Link our compiled shaders to form a GLSL program
@@ -437,7 +450,7 @@ bool VideoOutput::CompileShaderProgram()
         GLchar* GLInfoLog = new GLchar[ GLInfoLogLength + 1 ];
         glGetShaderInfoLog( ShaderProgramID, GLInfoLogLength, nullptr, GLInfoLog );    
         
-        LOG( string("ERROR: Linking shader program failed: ") + (char*)GLInfoLog );
+        LOG_ERROR( string("Linking shader program failed: ") + (char*)GLInfoLog );
         delete GLInfoLog;
         
         glDeleteShader( VertexShaderID );
@@ -445,7 +458,7 @@ bool VideoOutput::CompileShaderProgram()
         return false;
     }
     
-    LOG( "Shader program linked successfully! ID = " + to_string( ShaderProgramID ) );
+    LOG_DEBUG( "Shader program linked successfully! ID = " + to_string( ShaderProgramID ) );
     
     // clean-up temporary compilation objects
     glDetachShader( ShaderProgramID, VertexShaderID );
@@ -464,7 +477,7 @@ void VideoOutput::InitRendering()
     ClearOpenGLErrors();
     
     // compile our shader program
-    LOG( "Compiling GLSL shader program" );
+    LOG_DEBUG( "Compiling GLSL shader program" );
     
     if( !CompileShaderProgram() )
       THROW( "Cannot compile GLSL shader program" );
@@ -584,8 +597,50 @@ void VideoOutput::CreateWhiteTexture()
 
 // -----------------------------------------------------------------------------
 
+void VideoOutput::CreateReadbackBuffers()
+{
+    LOG( "Creating readback buffers" );
+    ClearOpenGLErrors();
+    
+    // without buffer mapping, pixel buffers are of no
+    // use and readbacks will be done synchronously
+    if( glMapBufferRange == nullptr )
+    {
+        LOG_WARNING( "Function glMapBufferRange is not linked! Using synchronous readback" );
+        
+        for( int i = 0; i < READBACK_BUFFERS; i++ )
+          ReadbackImages[ i ].resize( READBACK_IMAGE_BYTES );
+        
+        return;
+    }
+    
+    glGenBuffers( READBACK_BUFFERS, ReadbackPBOs );
+    
+    // GL_STREAM_READ hints that each image is
+    // written once by GPU and read once by CPU
+    for( int i = 0; i < READBACK_BUFFERS; i++ )
+    {
+        glBindBuffer( GL_PIXEL_PACK_BUFFER, ReadbackPBOs[ i ] );
+        glBufferData( GL_PIXEL_PACK_BUFFER, READBACK_IMAGE_BYTES, nullptr, GL_STREAM_READ );
+    }
+    
+    glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+    LogOpenGLResult( "glBufferData" );
+}
+
+// -----------------------------------------------------------------------------
+
 void VideoOutput::Destroy()
 {
+    // release readback buffers
+    if( OpenGLContext && ReadbackPBOs[ 0 ] != 0 )
+    {
+        glDeleteBuffers( READBACK_BUFFERS, ReadbackPBOs );
+        
+        for( int i = 0; i < READBACK_BUFFERS; i++ )
+          ReadbackPBOs[ i ] = 0;
+    }
+    
     // release all textures
     if( OpenGLContext )
     {
@@ -760,6 +815,109 @@ void VideoOutput::BeginFrame()
 }
 
 
+// =============================================================================
+//      VIDEO OUTPUT: FRAMEBUFFER READBACK
+// =============================================================================
+
+
+// starts copying the current framebuffer contents to
+// the next free readback buffer; with pixel buffers
+// this returns immediately and the copy runs on the GPU
+bool VideoOutput::BeginFramebufferReadback()
+{
+    if( PendingReadbacks >= READBACK_BUFFERS )
+      return false;
+    
+    int NextReadback = (FirstReadback + PendingReadbacks) % READBACK_BUFFERS;
+    
+    // ensure that all queued quads are part of the image
+    RenderQuadQueue();
+    Tracer.Begin( "video", "Readback" );
+    
+    // this can be called while rendering either to the
+    // screen or the framebuffer, so restore it afterwards
+    GLint PreviousFramebuffer = 0;
+    glGetIntegerv( GL_FRAMEBUFFER_BINDING, &PreviousFramebuffer );
+    glBindFramebuffer( GL_FRAMEBUFFER, FramebufferID );
+    glReadBuffer( GL_COLOR_ATTACHMENT0 );
+    
+    if( ReadbackPBOs[ NextReadback ] != 0 )
+    {
+        // with a pack buffer bound, the last
+        // parameter is an offset into the buffer
+        glBindBuffer( GL_PIXEL_PACK_BUFFER, ReadbackPBOs[ NextReadback ] );
+        glReadPixels( 0, 0, Constants::ScreenWidth, Constants::ScreenHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+        glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+    }
+    
+    else
+    {
+        uint8_t* Image = ReadbackImages[ NextReadback ].data();
+        glReadPixels( 0, 0, Constants::ScreenWidth, Constants::ScreenHeight, GL_RGBA, GL_UNSIGNED_BYTE, Image );
+    }
+    
+    glBindFramebuffer( GL_FRAMEBUFFER, PreviousFramebuffer );
+    PendingReadbacks++;
+    
+    Tracer.End( "video", "Readback" );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// copies the oldest pending readback to the given
+// buffer: if its GPU transfer is not done yet this
+// will wait for it, so call it as late as possible
+bool VideoOutput::FinishFramebufferReadback( uint8_t* Pixels )
+{
+    if( PendingReadbacks <= 0 )
+      return false;
+    
+    const uint8_t* Image = nullptr;
+    
+    if( ReadbackPBOs[ FirstReadback ] != 0 )
+    {
+        glBindBuffer( GL_PIXEL_PACK_BUFFER, ReadbackPBOs[ FirstReadback ] );
+        Image = (const uint8_t*)glMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, READBACK_IMAGE_BYTES, GL_MAP_READ_BIT );
+    }
+    
+    else
+      Image = ReadbackImages[ FirstReadback ].data();
+    
+    // images on framebuffer are rendered inverted in Y,
+    // so we invert the order of rows to reflect it back
+    if( Image )
+    {
+        int RowBytes = 4 * Constants::ScreenWidth;
+        
+        for( int y = 0; y < Constants::ScreenHeight; y++ )
+          memcpy( &Pixels[ RowBytes * ((Constants::ScreenHeight-1) - y) ], &Image[ RowBytes * y ], RowBytes );
+    }
+    
+    if( ReadbackPBOs[ FirstReadback ] != 0 )
+    {
+        glUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+        glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+    }
+    
+    FirstReadback = (FirstReadback + 1) % READBACK_BUFFERS;
+    PendingReadbacks--;
+    
+    // a failed mapping still consumes the readback
+    if( !Image )
+      LOG_WARNING( "Cannot map readback buffer: " + GLErrorString( glGetError() ) );
+    
+    return (Image != nullptr);
+}
+
+// -----------------------------------------------------------------------------
+
+int VideoOutput::GetPendingReadbacks()
+{
+    return PendingReadbacks;
+}
+
+
 // =============================================================================
 //      VIDEO OUTPUT: COLOR FUNCTIONS
 // =============================================================================
@@ -857,6 +1015,11 @@ void VideoOutput::RenderQuadQueue()
 {
     if( QueuedQuads == 0 ) return;
     
+    // this is timed apart from the work that queued the quads
+    TelemetryPhases PreviousPhase = Telemetry.SwitchPhase( TelemetryPhases::GPUSubmission );
+    Telemetry.AddDrawCall( QueuedQuads );
+    Tracer.Begin( "video", "Draw batch", QueuedQuads );
+    
     // send attributes (i.e. shader input variables)
     glBindBuffer( GL_ARRAY_BUFFER, VBOVertexInfo );
 
@@ -884,6 +1047,8 @@ void VideoOutput::RenderQuadQueue()
     
     // reset the queue
     QueuedQuads = 0;
+    Tracer.End( "video", "Draw batch" );
+    Telemetry.SwitchPhase( PreviousPhase );
 }
 
 // -----------------------------------------------------------------------------
@@ -944,6 +1109,8 @@ void VideoOutput::LoadTexture( int GPUTextureID, void* Pixels )
     glGetError();
     
     // create an OpenGL texture from the received pixel data
+    Tracer.Begin( "video", "Texture upload", GPUTextureID );
+    
     glTexImage2D
     (
         GL_TEXTURE_2D,              // texture is a 2D rectangle
@@ -957,6 +1124,8 @@ void VideoOutput::LoadTexture( int GPUTextureID, void* Pixels )
         Pixels                      // buffer storing the texture data
     );
     
+    Tracer.End( "video", "Texture upload" );
+    
     // check correct conversion
     if( glGetError() != GL_NO_ERROR )
       THROW( "Could not create an OpenGL texture from pixel data" );
@@ -21,6 +21,9 @@
     
     // include OpenGL headers
     #include <glad/glad.h>      // [ OpenGL ] GLAD Loader (already includes <GL/gl.h>)
+    
+    // include C/C++ headers
+    #include <vector>           // [ C++ STL ] Vectors
 // *****************************************************************************
 
 
@@ -29,6 +32,15 @@
 // queue size and acts as group size limit
 #define QUAD_QUEUE_SIZE 20
 
+// framebuffer contents are read back to the CPU
+// asynchronously using these many pixel buffers:
+// a readback is collected while the next one is
+// still being transferred, so the GPU never stalls
+#define READBACK_BUFFERS 2
+
+// size of a read back image (RGBA, 640x360)
+#define READBACK_IMAGE_BYTES (4 * V32::Constants::ScreenWidth * V32::Constants::ScreenHeight)
+
 
 // =============================================================================
 //      2D-SPECIALIZED OPENGL CONTEXT
@@ -80,6 +92,16 @@ class VideoOutput
         // rendering control for quad groups
         int QueuedQuads;
         
+        // asynchronous readback of the framebuffer,
+        // with pending readbacks used as a FIFO queue
+        GLuint ReadbackPBOs[ READBACK_BUFFERS ];
+        int FirstReadback;
+        int PendingReadbacks;
+        
+        // when pixel buffers are not supported the
+        // framebuffer is read at once into these
+        std::vector< uint8_t > ReadbackImages[ READBACK_BUFFERS ];
+        
         // positions of shader parameters
         GLuint VertexInfoLocation;
         GLuint TextureUnitLocation;
@@ -96,6 +118,7 @@ class VideoOutput
         void CreateFramebuffer();
         bool CompileShaderProgram();
         void CreateWhiteTexture();
+        void CreateReadbackBuffers();
         void InitRendering();
         
         // release functions
@@ -119,6 +142,12 @@ class VideoOutput
         void DrawFramebufferOnScreen();
         void BeginFrame();
         
+        // framebuffer readback (images are
+        // returned in RGBA, from top to bottom)
+        bool BeginFramebufferReadback();
+        bool FinishFramebufferReadback( uint8_t* Pixels );
+        int GetPendingReadbacks();
+        
         // color control functions
         void SetMultiplyColor( V32::GPUColor NewMultiplyColor );
         V32::GPUColor GetMultiplyColor();
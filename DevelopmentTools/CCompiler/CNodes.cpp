@@ -698,6 +698,8 @@ FunctionNode::FunctionNode( CNode* Parent_ )
 {
     ReturnType = nullptr;
     SizeOfArguments = 0;
+    IsInline = false;
+    PassesArgumentsInRegisters = false;
     HasBody = false;
 }
 
@@ -444,6 +444,13 @@ class FunctionNode: public StackFrameNode
         // allocation of function stack frame
         int SizeOfArguments;            // fixed size
         
+        // calls can be replaced by the function body
+        // (the emitter decides if it is possible)
+        bool IsInline;
+        
+        // calling convention, decided by the emitter
+        bool PassesArgumentsInRegisters;
+        
     public:
         
         // instance handling
@@ -66,7 +66,8 @@ enum class KeywordTypes
     Typedef,
     Asm,
     Embedded,
-    Extern
+    Extern,
+    Inline
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,1540 @@
+// *****************************************************************************
+    // include project headers
+    #include "ControlFlowGraph.hpp"
+    #include "ExpressionOptimizer.hpp"
+    
+    // include C/C++ headers
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    #include <cstdio>           // [ ANSI C ] Standard I/O
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+bool IsWithin( CNode* Node, CNode* Container )
+{
+    for( CNode* Current = Node; Current; Current = Current->Parent )
+      if( Current == Container )
+        return true;
+    
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool FindEntryPoints( CNode* Node, CNode* Container )
+{
+    // some contructs have optional parts!
+    if( !Node ) return false;
+    
+    switch( Node->Type() )
+    {
+        // asm code can also define labels
+        case CNodeTypes::Label:
+        case CNodeTypes::AssemblyBlock:
+            return true;
+        
+        case CNodeTypes::Case:
+            return !IsWithin( ((CaseNode*)Node)->SwitchContext, Container );
+        
+        case CNodeTypes::Default:
+            return !IsWithin( ((DefaultNode*)Node)->SwitchContext, Container );
+        
+        case CNodeTypes::Block:
+        case CNodeTypes::Switch:
+        {
+            for( CNode* Statement: ((BlockNode*)Node)->Statements )
+              if( FindEntryPoints( Statement, Container ) )
+                return true;
+            
+            return false;
+        }
+        
+        case CNodeTypes::If:
+            return FindEntryPoints( ((IfNode*)Node)->TrueStatement, Container )
+                || FindEntryPoints( ((IfNode*)Node)->FalseStatement, Container );
+        
+        case CNodeTypes::While:
+            return FindEntryPoints( ((WhileNode*)Node)->LoopStatement, Container );
+        
+        case CNodeTypes::Do:
+            return FindEntryPoints( ((DoNode*)Node)->LoopStatement, Container );
+        
+        case CNodeTypes::For:
+            return FindEntryPoints( ((ForNode*)Node)->LoopStatement, Container );
+        
+        default:
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool HasEntryPoints( CNode* Node )
+{
+    return FindEntryPoints( Node, Node );
+}
+
+// -----------------------------------------------------------------------------
+
+// float conditions are never taken as static, since
+// the emitter does not compare them as integers
+bool GetStaticCondition( ExpressionNode* Condition, bool& IsTrue )
+{
+    if( !Condition->IsStatic() || DividesByStaticZero( Condition ) )
+      return false;
+    
+    if( TypeIsFloat( Condition->ReturnedType ) )
+      return false;
+    
+    IsTrue = (Condition->GetStaticValue().Word.AsInteger != 0);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static string OperatorSymbol( UnaryOperators Operator )
+{
+    switch( Operator )
+    {
+        case UnaryOperators::MinusSign:  return "-";
+        case UnaryOperators::LogicalNot: return "!";
+        case UnaryOperators::BitwiseNot: return "~";
+        default: return UnaryOperatorToString( Operator );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+static string OperatorSymbol( BinaryOperators Operator )
+{
+    switch( Operator )
+    {
+        case BinaryOperators::Addition:       return "+";
+        case BinaryOperators::Subtraction:    return "-";
+        case BinaryOperators::Product:        return "*";
+        case BinaryOperators::Division:       return "/";
+        case BinaryOperators::Modulus:        return "%";
+        case BinaryOperators::Equal:          return "==";
+        case BinaryOperators::NotEqual:       return "!=";
+        case BinaryOperators::LessThan:       return "<";
+        case BinaryOperators::LessOrEqual:    return "<=";
+        case BinaryOperators::GreaterThan:    return ">";
+        case BinaryOperators::GreaterOrEqual: return ">=";
+        case BinaryOperators::BitwiseOr:      return "|";
+        case BinaryOperators::BitwiseAnd:     return "&";
+        case BinaryOperators::BitwiseXor:     return "^";
+        case BinaryOperators::ShiftLeft:      return "<<";
+        case BinaryOperators::ShiftRight:     return ">>";
+        default: return BinaryOperatorToString( Operator );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// non printable characters are written as hex codes
+static string QuotedString( const string& Text )
+{
+    string Result = "\"";
+    
+    for( char c: Text )
+    {
+        if( c >= 32 && c < 127 && c != '"' && c != '\\' )
+          Result += c;
+        
+        else
+        {
+            char Code[ 8 ];
+            sprintf( Code, "\\x%02X", (unsigned char)c );
+            Result += Code;
+        }
+    }
+    
+    return Result + "\"";
+}
+
+// -----------------------------------------------------------------------------
+
+static IROperand VariableOperand( VariableNode* Variable )
+{
+    IROperand Operand;
+    Operand.Type = IROperandTypes::Variable;
+    Operand.Variable = Variable;
+    return Operand;
+}
+
+// -----------------------------------------------------------------------------
+
+static IROperand IntegerOperand( int32_t Value )
+{
+    IROperand Operand;
+    Operand.Type = IROperandTypes::Constant;
+    Operand.Value = StaticValue( Value );
+    Operand.ValueType = PrimitiveTypes::Int;
+    return Operand;
+}
+
+// -----------------------------------------------------------------------------
+
+// variables that are handled as a single value
+// (the rest are only accessed through their address)
+static VariableNode* ScalarVariable( ExpressionNode* Expression )
+{
+    VariableNode* Variable = NamedVariable( Expression );
+    
+    if( !Variable )
+      return nullptr;
+    
+    DataTypes Type = Variable->DeclaredType->Type();
+    
+    if( Type == DataTypes::Array || Type == DataTypes::Structure || Type == DataTypes::Union )
+      return nullptr;
+    
+    return Variable;
+}
+
+
+// =============================================================================
+//      IR OPERAND
+// =============================================================================
+
+
+IROperand::IROperand()
+// - - - - - - - - - - - - - - - - - -
+:   Value( (int32_t)0 )
+// - - - - - - - - - - - - - - - - - -
+{
+    Type = IROperandTypes::None;
+    ValueType = PrimitiveTypes::Int;
+    Variable = nullptr;
+    Temporary = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+string IROperand::ToString() const
+{
+    switch( Type )
+    {
+        case IROperandTypes::Constant:
+        {
+            if( ValueType == PrimitiveTypes::Float )
+              return to_string( Value.Word.AsFloat );
+            
+            if( ValueType == PrimitiveTypes::Bool )
+              return (Value.Word.AsInteger? "true" : "false");
+            
+            return to_string( Value.Word.AsInteger );
+        }
+        
+        case IROperandTypes::Variable:
+            return Variable->Name;
+        
+        case IROperandTypes::Temporary:
+            return "%" + to_string( Temporary );
+        
+        case IROperandTypes::Symbol:
+            return Symbol;
+        
+        default:
+            return "";
+    }
+}
+
+
+// =============================================================================
+//      IR INSTRUCTION
+// =============================================================================
+
+
+IRInstruction::IRInstruction( IROperations Operation_, CNode* Source_ )
+{
+    Operation = Operation_;
+    UnaryOperator = UnaryOperators::PlusSign;
+    BinaryOperator = BinaryOperators::Addition;
+    Source = Source_;
+}
+
+// -----------------------------------------------------------------------------
+
+bool IRInstruction::IsTerminator() const
+{
+    return (Operation == IROperations::Jump
+        ||  Operation == IROperations::Branch
+        ||  Operation == IROperations::Switch
+        ||  Operation == IROperations::Return);
+}
+
+// -----------------------------------------------------------------------------
+
+VariableNode* IRInstruction::AssignedVariable() const
+{
+    if( Operation != IROperations::Copy || Result.Type != IROperandTypes::Variable )
+      return nullptr;
+    
+    return Result.Variable;
+}
+
+// -----------------------------------------------------------------------------
+
+// taking the address of a variable does not read it
+void IRInstruction::AddReadVariables( set< VariableNode* >& Variables ) const
+{
+    if( Operation == IROperations::AddressOf )
+      return;
+    
+    if( Left.Type == IROperandTypes::Variable )
+      Variables.insert( Left.Variable );
+    
+    if( Right.Type == IROperandTypes::Variable )
+      Variables.insert( Right.Variable );
+}
+
+// -----------------------------------------------------------------------------
+
+string IRInstruction::ToString() const
+{
+    string Assigned = (Result.Type != IROperandTypes::None? Result.ToString() + " = " : "");
+    
+    switch( Operation )
+    {
+        case IROperations::Copy:
+            return Assigned + Left.ToString();
+        
+        case IROperations::Unary:
+            return Assigned + OperatorSymbol( UnaryOperator ) + Left.ToString();
+        
+        case IROperations::Binary:
+            return Assigned + Left.ToString() + " " + OperatorSymbol( BinaryOperator ) + " " + Right.ToString();
+        
+        case IROperations::Conversion:
+            return Assigned + "(" + ((ExpressionNode*)Source)->ReturnedType->ToString() + ")" + Left.ToString();
+        
+        case IROperations::AddressOf:
+            return Assigned + "&" + Left.ToString();
+        
+        case IROperations::Load:
+            return Assigned + "[" + Left.ToString() + "]";
+        
+        case IROperations::Store:
+            return "[" + Left.ToString() + "] = " + Right.ToString();
+        
+        case IROperations::Argument:
+            return "argument " + Left.ToString();
+        
+        case IROperations::Call:
+            return Assigned + "call " + Left.ToString();
+        
+        case IROperations::Assembly:
+            return "asm";
+        
+        case IROperations::Jump:
+            return "jump";
+        
+        case IROperations::Branch:
+            return "branch " + Left.ToString();
+        
+        case IROperations::Switch:
+            return "switch " + Left.ToString();
+        
+        case IROperations::Return:
+            return "return " + Left.ToString();
+        
+        default:
+            return "";
+    }
+}
+
+
+// =============================================================================
+//      BASIC BLOCK
+// =============================================================================
+
+
+BasicBlock::BasicBlock( int Number_ )
+{
+    Number = Number_;
+    LoopStatement = nullptr;
+    IsReachable = false;
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: INSTANCE HANDLING
+// =============================================================================
+
+
+ControlFlowGraph::ControlFlowGraph()
+{
+    Function = nullptr;
+    Exit = nullptr;
+    CurrentBlock = nullptr;
+    NextTemporary = 1;
+}
+
+// -----------------------------------------------------------------------------
+
+ControlFlowGraph::~ControlFlowGraph()
+{
+    Clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlFlowGraph::Clear()
+{
+    for( BasicBlock* Block: Blocks )
+      delete Block;
+    
+    Blocks.clear();
+    TrackedVariables.clear();
+    Loops.clear();
+    TemporaryDefinitions.clear();
+    BreakTargets.clear();
+    ContinueTargets.clear();
+    CaseBlocks.clear();
+    LabelBlocks.clear();
+    
+    Function = nullptr;
+    Exit = nullptr;
+    CurrentBlock = nullptr;
+    NextTemporary = 1;
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: CONSTRUCTION OF BLOCKS
+// =============================================================================
+
+
+BasicBlock* ControlFlowGraph::NewBlock()
+{
+    BasicBlock* Block = new BasicBlock( Blocks.size() );
+    Blocks.push_back( Block );
+    return Block;
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlFlowGraph::AddEdge( BasicBlock* From, BasicBlock* To )
+{
+    From->Successors.push_back( To );
+    To->Predecessors.push_back( From );
+}
+
+// -----------------------------------------------------------------------------
+
+// code after a jump is placed in a new block,
+// that can only be reached if it gets labeled
+void ControlFlowGraph::JumpTo( BasicBlock* Target, CNode* Source )
+{
+    AddInstruction( IROperations::Jump, Source );
+    AddEdge( CurrentBlock, Target );
+    CurrentBlock = NewBlock();
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlFlowGraph::BranchTo( IROperand Condition, BasicBlock* TrueTarget, BasicBlock* FalseTarget, CNode* Source )
+{
+    IRInstruction& Branch = AddInstruction( IROperations::Branch, Source );
+    Branch.Left = Condition;
+    
+    AddEdge( CurrentBlock, TrueTarget );
+    AddEdge( CurrentBlock, FalseTarget );
+    CurrentBlock = NewBlock();
+}
+
+// -----------------------------------------------------------------------------
+
+IRInstruction& ControlFlowGraph::AddInstruction( IROperations Operation, CNode* Source )
+{
+    CurrentBlock->Instructions.push_back( IRInstruction( Operation, Source ) );
+    return CurrentBlock->Instructions.back();
+}
+
+// -----------------------------------------------------------------------------
+
+IROperand ControlFlowGraph::NewTemporary()
+{
+    IROperand Temporary;
+    Temporary.Type = IROperandTypes::Temporary;
+    Temporary.Temporary = NextTemporary++;
+    return Temporary;
+}
+
+// -----------------------------------------------------------------------------
+
+// blocks left empty after jumps are not part of the code
+void ControlFlowGraph::RemoveEmptyBlocks()
+{
+    bool BlocksWereRemoved = true;
+    
+    while( BlocksWereRemoved )
+    {
+        BlocksWereRemoved = false;
+        
+        for( unsigned i = 1; i < Blocks.size(); i++ )
+        {
+            BasicBlock* Block = Blocks[ i ];
+            
+            if( Block == Exit || !Block->Predecessors.empty() || !Block->Statements.empty() )
+              continue;
+            
+            if( Block->Instructions.size() > 1 )
+              continue;
+            
+            if( Block->Instructions.size() == 1 && Block->Instructions[ 0 ].Operation != IROperations::Jump )
+              continue;
+            
+            for( BasicBlock* Successor: Block->Successors )
+            {
+                auto& Predecessors = Successor->Predecessors;
+                Predecessors.erase( find( Predecessors.begin(), Predecessors.end(), Block ) );
+            }
+            
+            delete Block;
+            Blocks.erase( Blocks.begin() + i );
+            i--;
+            
+            BlocksWereRemoved = true;
+        }
+    }
+    
+    for( unsigned i = 0; i < Blocks.size(); i++ )
+      Blocks[ i ]->Number = i;
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: LOWERING OF EXPRESSIONS
+// =============================================================================
+
+
+IROperand ControlFlowGraph::LowerOperation( IROperations Operation, IROperand Left, IROperand Right, CNode* Source )
+{
+    IROperand Result = NewTemporary();
+    
+    IRInstruction& Instruction = AddInstruction( Operation, Source );
+    Instruction.Result = Result;
+    Instruction.Left = Left;
+    Instruction.Right = Right;
+    
+    return Result;
+}
+
+// -----------------------------------------------------------------------------
+
+IROperand ControlFlowGraph::LowerUnaryOperation( UnaryOperationNode* Operation )
+{
+    switch( Operation->Operator )
+    {
+        case UnaryOperators::PlusSign:
+            return LowerExpression( Operation->Operand );
+        
+        case UnaryOperators::MinusSign:
+        case UnaryOperators::LogicalNot:
+        case UnaryOperators::BitwiseNot:
+        {
+            IROperand Operand = LowerExpression( Operation->Operand );
+            IROperand Result = LowerOperation( IROperations::Unary, Operand, IROperand(), Operation );
+            CurrentBlock->Instructions.back().UnaryOperator = Operation->Operator;
+            return Result;
+        }
+        
+        case UnaryOperators::Reference:
+            return LowerPlacement( Operation->Operand );
+        
+        case UnaryOperators::Dereference:
+        {
+            IROperand Address = LowerExpression( Operation->Operand );
+            
+            if( Operation->ReturnedType->Type() == DataTypes::Array )
+              return Address;
+            
+            return LowerOperation( IROperations::Load, Address, IROperand(), Operation );
+        }
+        
+        // increments and decrements
+        default:
+        {
+            bool IsIncrement = (Operation->Operator == UnaryOperators::PreIncrement
+                            ||  Operation->Operator == UnaryOperators::PostIncrement);
+            
+            bool IsPost = (Operation->Operator == UnaryOperators::PostIncrement
+                       ||  Operation->Operator == UnaryOperators::PostDecrement);
+            
+            IROperand OldValue, NewValue, Address;
+            VariableNode* Target = ScalarVariable( Operation->Operand );
+            
+            if( Target )
+            {
+                OldValue = VariableOperand( Target );
+                
+                // keep the previous value before it changes
+                if( IsPost )
+                  OldValue = LowerOperation( IROperations::Copy, OldValue, IROperand(), Operation );
+            }
+            
+            else
+            {
+                Address = LowerPlacement( Operation->Operand );
+                OldValue = LowerOperation( IROperations::Load, Address, IROperand(), Operation );
+            }
+            
+            NewValue = LowerOperation( IROperations::Binary, OldValue, IntegerOperand( 1 ), Operation );
+            IRInstruction& Change = CurrentBlock->Instructions.back();
+            Change.BinaryOperator = (IsIncrement? BinaryOperators::Addition : BinaryOperators::Subtraction);
+            
+            if( Target )
+            {
+                IRInstruction& Copy = AddInstruction( IROperations::Copy, Operation );
+                Copy.Result = VariableOperand( Target );
+                Copy.Left = NewValue;
+            }
+            
+            else
+            {
+                IRInstruction& Store = AddInstruction( IROperations::Store, Operation );
+                Store.Left = Address;
+                Store.Right = NewValue;
+            }
+            
+            return (IsPost? OldValue : NewValue);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// the right operand is in a separate block,
+// since it is only evaluated when needed
+IROperand ControlFlowGraph::LowerLogicalOperation( BinaryOperationNode* Operation )
+{
+    IROperand Result = NewTemporary();
+    IROperand LeftValue = LowerExpression( Operation->LeftOperand );
+    
+    IRInstruction& LeftCopy = AddInstruction( IROperations::Copy, Operation );
+    LeftCopy.Result = Result;
+    LeftCopy.Left = LeftValue;
+    
+    BasicBlock* RightBlock = NewBlock();
+    BasicBlock* EndBlock = NewBlock();
+    
+    if( Operation->Operator == BinaryOperators::LogicalAnd )
+      BranchTo( Result, RightBlock, EndBlock, Operation );
+    else
+      BranchTo( Result, EndBlock, RightBlock, Operation );
+    
+    CurrentBlock = RightBlock;
+    IROperand RightValue = LowerExpression( Operation->RightOperand );
+    
+    IRInstruction& RightCopy = AddInstruction( IROperations::Copy, Operation );
+    RightCopy.Result = Result;
+    RightCopy.Left = RightValue;
+    
+    JumpTo( EndBlock, Operation );
+    CurrentBlock = EndBlock;
+    return Result;
+}
+
+// -----------------------------------------------------------------------------
+
+IROperand ControlFlowGraph::LowerBinaryOperation( BinaryOperationNode* Operation )
+{
+    if( Operation->Operator == BinaryOperators::LogicalAnd
+    ||  Operation->Operator == BinaryOperators::LogicalOr )
+      return LowerLogicalOperation( Operation );
+    
+    // regular operations
+    BinaryOperators CompoundOperation;
+    bool IsCompound = GetCompoundOperation( Operation->Operator, CompoundOperation );
+    
+    if( Operation->Operator != BinaryOperators::Assignment && !IsCompound )
+    {
+        IROperand Left = LowerExpression( Operation->LeftOperand );
+        IROperand Right = LowerExpression( Operation->RightOperand );
+        IROperand Result = LowerOperation( IROperations::Binary, Left, Right, Operation );
+        CurrentBlock->Instructions.back().BinaryOperator = Operation->Operator;
+        return Result;
+    }
+    
+    // assignments
+    IROperand Value = LowerExpression( Operation->RightOperand );
+    VariableNode* Target = ScalarVariable( Operation->LeftOperand );
+    IROperand Address;
+    
+    if( !Target )
+      Address = LowerPlacement( Operation->LeftOperand );
+    
+    if( IsCompound )
+    {
+        IROperand OldValue;
+        
+        if( Target )
+          OldValue = VariableOperand( Target );
+        else
+          OldValue = LowerOperation( IROperations::Load, Address, IROperand(), Operation );
+        
+        Value = LowerOperation( IROperations::Binary, OldValue, Value, Operation );
+        CurrentBlock->Instructions.back().BinaryOperator = CompoundOperation;
+    }
+    
+    if( Target )
+    {
+        IRInstruction& Copy = AddInstruction( IROperations::Copy, Operation );
+        Copy.Result = VariableOperand( Target );
+        Copy.Left = Value;
+    }
+    
+    else
+    {
+        IRInstruction& Store = AddInstruction( IROperations::Store, Operation );
+        Store.Left = Address;
+        Store.Right = Value;
+    }
+    
+    return Value;
+}
+
+// -----------------------------------------------------------------------------
+
+IROperand ControlFlowGraph::LowerExpression( ExpressionNode* Expression )
+{
+    // static values need no code
+    if( Expression->IsStatic() && !DividesByStaticZero( Expression ) )
+    {
+        IROperand Constant;
+        Constant.Type = IROperandTypes::Constant;
+        Constant.Value = Expression->GetStaticValue();
+        
+        if( TypeIsThisPrimitive( Expression->ReturnedType, PrimitiveTypes::Float ) )
+          Constant.ValueType = PrimitiveTypes::Float;
+        
+        else if( TypeIsThisPrimitive( Expression->ReturnedType, PrimitiveTypes::Bool ) )
+          Constant.ValueType = PrimitiveTypes::Bool;
+        
+        return Constant;
+    }
+    
+    switch( Expression->Type() )
+    {
+        // only variables are not static
+        case CNodeTypes::ExpressionAtom:
+        {
+            VariableNode* Variable = ((ExpressionAtomNode*)Expression)->ResolvedVariable;
+            
+            if( ScalarVariable( Expression ) )
+              return VariableOperand( Variable );
+            
+            // arrays are used by their address, and
+            // structures and unions are read from it
+            IROperand Address = LowerPlacement( Expression );
+            
+            if( Variable->DeclaredType->Type() == DataTypes::Array )
+              return Address;
+            
+            return LowerOperation( IROperations::Load, Address, IROperand(), Expression );
+        }
+        
+        case CNodeTypes::FunctionCall:
+        {
+            FunctionCallNode* FunctionCall = (FunctionCallNode*)Expression;
+            vector< IROperand > Arguments;
+            
+            for( ExpressionNode* Parameter: FunctionCall->Parameters )
+              Arguments.push_back( LowerExpression( Parameter ) );
+            
+            for( IROperand& Argument: Arguments )
+              AddInstruction( IROperations::Argument, FunctionCall ).Left = Argument;
+            
+            IROperand Result;
+            
+            if( FunctionCall->ReturnedType->Type() != DataTypes::Void )
+              Result = NewTemporary();
+            
+            IRInstruction& Call = AddInstruction( IROperations::Call, FunctionCall );
+            Call.Result = Result;
+            Call.Left.Type = IROperandTypes::Symbol;
+            Call.Left.Symbol = FunctionCall->FunctionName;
+            return Result;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+        case CNodeTypes::MemberAccess:
+        case CNodeTypes::PointedMemberAccess:
+        {
+            IROperand Address = LowerPlacement( Expression );
+            
+            if( Expression->ReturnedType->Type() == DataTypes::Array )
+              return Address;
+            
+            return LowerOperation( IROperations::Load, Address, IROperand(), Expression );
+        }
+        
+        case CNodeTypes::UnaryOperation:
+            return LowerUnaryOperation( (UnaryOperationNode*)Expression );
+        
+        case CNodeTypes::BinaryOperation:
+            return LowerBinaryOperation( (BinaryOperationNode*)Expression );
+        
+        case CNodeTypes::EnclosedExpression:
+            return LowerExpression( ((EnclosedExpressionNode*)Expression)->InternalExpression );
+        
+        case CNodeTypes::LiteralString:
+        {
+            IROperand String;
+            String.Type = IROperandTypes::Symbol;
+            String.Symbol = QuotedString( ((LiteralStringNode*)Expression)->Value );
+            return String;
+        }
+        
+        case CNodeTypes::TypeConversion:
+        {
+            IROperand Operand = LowerExpression( ((TypeConversionNode*)Expression)->ConvertedExpression );
+            return LowerOperation( IROperations::Conversion, Operand, IROperand(), Expression );
+        }
+        
+        default:
+            return IROperand();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// gives the memory address of an expression
+IROperand ControlFlowGraph::LowerPlacement( ExpressionNode* Expression )
+{
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::ExpressionAtom:
+        {
+            VariableNode* Variable = ((ExpressionAtomNode*)Expression)->ResolvedVariable;
+            
+            if( !Variable )
+              return LowerExpression( Expression );
+            
+            return LowerOperation( IROperations::AddressOf, VariableOperand( Variable ), IROperand(), Expression );
+        }
+        
+        case CNodeTypes::ArrayAccess:
+        {
+            ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Expression;
+            IROperand Base;
+            
+            if( ArrayAccess->ArrayOperand->ReturnedType->Type() == DataTypes::Array )
+              Base = LowerPlacement( ArrayAccess->ArrayOperand );
+            else
+              Base = LowerExpression( ArrayAccess->ArrayOperand );
+            
+            IROperand Index = LowerExpression( ArrayAccess->IndexOperand );
+            int ElementSize = ArrayAccess->ReturnedType->SizeInWords();
+            
+            if( ElementSize != 1 )
+            {
+                Index = LowerOperation( IROperations::Binary, Index, IntegerOperand( ElementSize ), ArrayAccess );
+                CurrentBlock->Instructions.back().BinaryOperator = BinaryOperators::Product;
+            }
+            
+            return LowerOperation( IROperations::Binary, Base, Index, ArrayAccess );
+        }
+        
+        case CNodeTypes::MemberAccess:
+        case CNodeTypes::PointedMemberAccess:
+        {
+            IROperand Base;
+            MemberNode* Member;
+            
+            if( Expression->Type() == CNodeTypes::MemberAccess )
+            {
+                Base = LowerPlacement( ((MemberAccessNode*)Expression)->GroupOperand );
+                Member = ((MemberAccessNode*)Expression)->ResolvedMember;
+            }
+            
+            else
+            {
+                Base = LowerExpression( ((PointedMemberAccessNode*)Expression)->GroupOperand );
+                Member = ((PointedMemberAccessNode*)Expression)->ResolvedMember;
+            }
+            
+            if( Member->OffsetInGroup == 0 )
+              return Base;
+            
+            return LowerOperation( IROperations::Binary, Base, IntegerOperand( Member->OffsetInGroup ), Expression );
+        }
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* Operation = (UnaryOperationNode*)Expression;
+            
+            if( Operation->Operator == UnaryOperators::Dereference )
+              return LowerExpression( Operation->Operand );
+            
+            return LowerExpression( Expression );
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+            return LowerPlacement( ((EnclosedExpressionNode*)Expression)->InternalExpression );
+        
+        default:
+            return LowerExpression( Expression );
+    }
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: LOWERING OF STATEMENTS
+// =============================================================================
+
+
+void ControlFlowGraph::LowerCondition( ExpressionNode* Condition, BasicBlock* TrueTarget, BasicBlock* FalseTarget, CNode* Source )
+{
+    bool IsTrue;
+    
+    if( GetStaticCondition( Condition, IsTrue ) )
+      JumpTo( IsTrue? TrueTarget : FalseTarget, Source );
+    
+    else
+    {
+        IROperand Value = LowerExpression( Condition );
+        BranchTo( Value, TrueTarget, FalseTarget, Source );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// values in initialization lists are not
+// separated, since they are only stored
+void ControlFlowGraph::LowerInitialization( IROperand Address, CNode* InitialValue )
+{
+    if( InitialValue->Type() == CNodeTypes::InitializationList )
+    {
+        for( CNode* Value: ((InitializationListNode*)InitialValue)->AssignedValues )
+          LowerInitialization( Address, Value );
+        
+        return;
+    }
+    
+    IROperand Value = LowerExpression( (ExpressionNode*)InitialValue );
+    
+    IRInstruction& Store = AddInstruction( IROperations::Store, InitialValue );
+    Store.Left = Address;
+    Store.Right = Value;
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlFlowGraph::LowerStatement( CNode*& Statement, list< CNode* >* List, list< CNode* >::iterator Position )
+{
+    // some contructs have optional parts!
+    if( !Statement ) return;
+    
+    // these start a new block, where they are placed
+    if( Statement->Type() == CNodeTypes::Case || Statement->Type() == CNodeTypes::Default )
+    {
+        BasicBlock* CaseBlock = CaseBlocks[ Statement ];
+        JumpTo( CaseBlock, Statement );
+        CurrentBlock = CaseBlock;
+    }
+    
+    else if( Statement->Type() == CNodeTypes::Label )
+    {
+        BasicBlock*& LabelBlock = LabelBlocks[ (LabelNode*)Statement ];
+        
+        if( !LabelBlock )
+          LabelBlock = NewBlock();
+        
+        JumpTo( LabelBlock, Statement );
+        CurrentBlock = LabelBlock;
+    }
+    
+    StatementPosition NewPosition;
+    NewPosition.Slot = &Statement;
+    NewPosition.List = List;
+    NewPosition.Position = Position;
+    CurrentBlock->Statements.push_back( NewPosition );
+    
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+            {
+                if( !Variable->InitialValue )
+                  continue;
+                
+                // single values are copied to the variable
+                if( Variable->InitialValue->IsExpression() && Variable->DeclaredType->SizeInWords() == 1 )
+                {
+                    IROperand Value = LowerExpression( (ExpressionNode*)Variable->InitialValue );
+                    
+                    IRInstruction& Copy = AddInstruction( IROperations::Copy, Variable );
+                    Copy.Result = VariableOperand( Variable );
+                    Copy.Left = Value;
+                }
+                
+                else
+                {
+                    IROperand Address = LowerOperation( IROperations::AddressOf, VariableOperand( Variable ), IROperand(), Variable );
+                    LowerInitialization( Address, Variable->InitialValue );
+                }
+            }
+            
+            break;
+        }
+        
+        case CNodeTypes::Block:
+            LowerStatementList( ((BlockNode*)Statement)->Statements );
+            break;
+        
+        case CNodeTypes::If:
+        {
+            IfNode* If = (IfNode*)Statement;
+            BasicBlock* TrueBlock = NewBlock();
+            BasicBlock* FalseBlock = (If->FalseStatement? NewBlock() : nullptr);
+            BasicBlock* EndBlock = NewBlock();
+            
+            LowerCondition( If->Condition, TrueBlock, (FalseBlock? FalseBlock : EndBlock), If );
+            
+            CurrentBlock = TrueBlock;
+            LowerStatement( If->TrueStatement, nullptr, list< CNode* >::iterator() );
+            JumpTo( EndBlock, If );
+            
+            if( FalseBlock )
+            {
+                CurrentBlock = FalseBlock;
+                LowerStatement( If->FalseStatement, nullptr, list< CNode* >::iterator() );
+                JumpTo( EndBlock, If );
+            }
+            
+            CurrentBlock = EndBlock;
+            break;
+        }
+        
+        case CNodeTypes::While:
+        {
+            WhileNode* While = (WhileNode*)Statement;
+            BasicBlock* ConditionBlock = NewBlock();
+            BasicBlock* BodyBlock = NewBlock();
+            BasicBlock* EndBlock = NewBlock();
+            
+            ConditionBlock->LoopStatement = While;
+            BreakTargets[ While ] = EndBlock;
+            ContinueTargets[ While ] = ConditionBlock;
+            
+            JumpTo( ConditionBlock, While );
+            CurrentBlock = ConditionBlock;
+            LowerCondition( While->Condition, BodyBlock, EndBlock, While );
+            
+            CurrentBlock = BodyBlock;
+            LowerStatement( While->LoopStatement, nullptr, list< CNode* >::iterator() );
+            JumpTo( ConditionBlock, While );
+            
+            CurrentBlock = EndBlock;
+            break;
+        }
+        
+        case CNodeTypes::Do:
+        {
+            DoNode* Do = (DoNode*)Statement;
+            BasicBlock* BodyBlock = NewBlock();
+            BasicBlock* ConditionBlock = NewBlock();
+            BasicBlock* EndBlock = NewBlock();
+            
+            BodyBlock->LoopStatement = Do;
+            BreakTargets[ Do ] = EndBlock;
+            ContinueTargets[ Do ] = ConditionBlock;
+            
+            JumpTo( BodyBlock, Do );
+            CurrentBlock = BodyBlock;
+            LowerStatement( Do->LoopStatement, nullptr, list< CNode* >::iterator() );
+            JumpTo( ConditionBlock, Do );
+            
+            CurrentBlock = ConditionBlock;
+            LowerCondition( Do->Condition, BodyBlock, EndBlock, Do );
+            
+            CurrentBlock = EndBlock;
+            break;
+        }
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Statement;
+            LowerStatement( For->InitialAction, nullptr, list< CNode* >::iterator() );
+            
+            BasicBlock* ConditionBlock = NewBlock();
+            BasicBlock* BodyBlock = NewBlock();
+            BasicBlock* IterationBlock = NewBlock();
+            BasicBlock* EndBlock = NewBlock();
+            
+            ConditionBlock->LoopStatement = For;
+            BreakTargets[ For ] = EndBlock;
+            ContinueTargets[ For ] = IterationBlock;
+            
+            JumpTo( ConditionBlock, For );
+            CurrentBlock = ConditionBlock;
+            
+            if( For->Condition )
+              LowerCondition( For->Condition, BodyBlock, EndBlock, For );
+            else
+              JumpTo( BodyBlock, For );
+            
+            CurrentBlock = BodyBlock;
+            LowerStatement( For->LoopStatement, nullptr, list< CNode* >::iterator() );
+            JumpTo( IterationBlock, For );
+            
+            CurrentBlock = IterationBlock;
+            
+            if( For->IterationAction )
+              LowerExpression( For->IterationAction );
+            
+            JumpTo( ConditionBlock, For );
+            CurrentBlock = EndBlock;
+            break;
+        }
+        
+        case CNodeTypes::Return:
+        {
+            ReturnNode* Return = (ReturnNode*)Statement;
+            IROperand Value;
+            
+            if( Return->ReturnedExpression )
+              Value = LowerExpression( Return->ReturnedExpression );
+            
+            AddInstruction( IROperations::Return, Return ).Left = Value;
+            AddEdge( CurrentBlock, Exit );
+            CurrentBlock = NewBlock();
+            break;
+        }
+        
+        case CNodeTypes::Break:
+            JumpTo( BreakTargets[ ((BreakNode*)Statement)->Context ], Statement );
+            break;
+        
+        case CNodeTypes::Continue:
+            JumpTo( ContinueTargets[ ((ContinueNode*)Statement)->LoopContext ], Statement );
+            break;
+        
+        case CNodeTypes::Switch:
+        {
+            SwitchNode* Switch = (SwitchNode*)Statement;
+            BasicBlock* EndBlock = NewBlock();
+            BreakTargets[ Switch ] = EndBlock;
+            
+            IROperand Value = LowerExpression( Switch->Condition );
+            AddInstruction( IROperations::Switch, Switch ).Left = Value;
+            
+            // a static condition only goes to one of the cases
+            bool IsStatic = (Value.Type == IROperandTypes::Constant && Value.ValueType != PrimitiveTypes::Float);
+            bool CaseIsFound = false;
+            
+            for( auto& CasePair: Switch->HandledCases )
+            {
+                BasicBlock* CaseBlock = NewBlock();
+                CaseBlocks[ CasePair.second ] = CaseBlock;
+                
+                if( !IsStatic || CasePair.first == Value.Value.Word.AsInteger )
+                {
+                    AddEdge( CurrentBlock, CaseBlock );
+                    CaseIsFound = true;
+                }
+            }
+            
+            BasicBlock* DefaultBlock = EndBlock;
+            
+            if( Switch->DefaultCase )
+            {
+                DefaultBlock = NewBlock();
+                CaseBlocks[ Switch->DefaultCase ] = DefaultBlock;
+            }
+            
+            if( !IsStatic || !CaseIsFound )
+              AddEdge( CurrentBlock, DefaultBlock );
+            
+            // code before the first case is never reached
+            CurrentBlock = NewBlock();
+            LowerStatementList( Switch->Statements );
+            JumpTo( EndBlock, Switch );
+            
+            CurrentBlock = EndBlock;
+            break;
+        }
+        
+        case CNodeTypes::Goto:
+        {
+            BasicBlock*& LabelBlock = LabelBlocks[ ((GotoNode*)Statement)->TargetLabel ];
+            
+            if( !LabelBlock )
+              LabelBlock = NewBlock();
+            
+            JumpTo( LabelBlock, Statement );
+            break;
+        }
+        
+        case CNodeTypes::AssemblyBlock:
+            AddInstruction( IROperations::Assembly, Statement );
+            break;
+        
+        default:
+        {
+            if( Statement->IsExpression() )
+              LowerExpression( (ExpressionNode*)Statement );
+            
+            // other statements have no code
+            break;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlFlowGraph::LowerStatementList( list< CNode* >& Statements )
+{
+    for( auto Position = Statements.begin(); Position != Statements.end(); Position++ )
+      LowerStatement( *Position, &Statements, Position );
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: MAIN FUNCTIONS
+// =============================================================================
+
+
+void ControlFlowGraph::Build( FunctionNode* Function_ )
+{
+    Clear();
+    Function = Function_;
+    FindOptimizedVariables( Function, TrackedVariables );
+    
+    CurrentBlock = NewBlock();
+    Exit = NewBlock();
+    
+    LowerStatementList( Function->Statements );
+    JumpTo( Exit, Function );
+    
+    // the exit goes last
+    Blocks.erase( find( Blocks.begin(), Blocks.end(), Exit ) );
+    Blocks.push_back( Exit );
+    RemoveEmptyBlocks();
+    
+    FindReachableBlocks();
+    FindDominators();
+    FindLoops();
+    FindLiveVariables();
+    FindTemporaryDefinitions();
+}
+
+// -----------------------------------------------------------------------------
+
+void ControlFlowGraph::FindReachableBlocks()
+{
+    for( BasicBlock* Block: Blocks )
+      Block->IsReachable = false;
+    
+    vector< BasicBlock* > PendingBlocks = { Blocks[ 0 ] };
+    Blocks[ 0 ]->IsReachable = true;
+    
+    while( !PendingBlocks.empty() )
+    {
+        BasicBlock* Block = PendingBlocks.back();
+        PendingBlocks.pop_back();
+        
+        for( BasicBlock* Successor: Block->Successors )
+        {
+            if( Successor->IsReachable )
+              continue;
+            
+            Successor->IsReachable = true;
+            PendingBlocks.push_back( Successor );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// a block dominates another if all paths
+// from the entry to the other go through it
+void ControlFlowGraph::FindDominators()
+{
+    set< BasicBlock* > ReachableBlocks;
+    
+    for( BasicBlock* Block: Blocks )
+    {
+        Block->Dominators.clear();
+        
+        if( Block->IsReachable )
+          ReachableBlocks.insert( Block );
+    }
+    
+    for( BasicBlock* Block: ReachableBlocks )
+      Block->Dominators = ReachableBlocks;
+    
+    Blocks[ 0 ]->Dominators = { Blocks[ 0 ] };
+    bool DominatorsChanged = true;
+    
+    while( DominatorsChanged )
+    {
+        DominatorsChanged = false;
+        
+        for( unsigned i = 1; i < Blocks.size(); i++ )
+        {
+            BasicBlock* Block = Blocks[ i ];
+            
+            if( !Block->IsReachable )
+              continue;
+            
+            set< BasicBlock* > NewDominators = ReachableBlocks;
+            
+            for( BasicBlock* Predecessor: Block->Predecessors )
+            {
+                if( !Predecessor->IsReachable )
+                  continue;
+                
+                set< BasicBlock* > Common;
+                set_intersection( NewDominators.begin(), NewDominators.end(),
+                                  Predecessor->Dominators.begin(), Predecessor->Dominators.end(),
+                                  inserter( Common, Common.begin() ) );
+                NewDominators.swap( Common );
+            }
+            
+            NewDominators.insert( Block );
+            
+            if( NewDominators != Block->Dominators )
+            {
+                Block->Dominators.swap( NewDominators );
+                DominatorsChanged = true;
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// a jump back to a block that dominates the jump
+// forms a loop with all blocks that reach the jump
+// without going through that block first
+void ControlFlowGraph::FindLoops()
+{
+    Loops.clear();
+    
+    for( BasicBlock* Block: Blocks )
+    {
+        if( !Block->IsReachable )
+          continue;
+        
+        for( BasicBlock* Header: Block->Successors )
+        {
+            if( !Block->Dominators.count( Header ) )
+              continue;
+            
+            // loops with the same header are joined
+            NaturalLoop* Loop = nullptr;
+            
+            for( NaturalLoop& OtherLoop: Loops )
+              if( OtherLoop.Header == Header )
+                Loop = &OtherLoop;
+            
+            if( !Loop )
+            {
+                Loops.push_back( NaturalLoop() );
+                Loop = &Loops.back();
+                Loop->Header = Header;
+                Loop->Blocks.insert( Header );
+            }
+            
+            vector< BasicBlock* > PendingBlocks;
+            
+            if( Loop->Blocks.insert( Block ).second )
+              PendingBlocks.push_back( Block );
+            
+            while( !PendingBlocks.empty() )
+            {
+                BasicBlock* LoopBlock = PendingBlocks.back();
+                PendingBlocks.pop_back();
+                
+                for( BasicBlock* Predecessor: LoopBlock->Predecessors )
+                  if( Predecessor->IsReachable && Loop->Blocks.insert( Predecessor ).second )
+                    PendingBlocks.push_back( Predecessor );
+            }
+        }
+    }
+    
+    // outer loops start first
+    sort( Loops.begin(), Loops.end(),
+          []( const NaturalLoop& L1, const NaturalLoop& L2 ){ return L1.Header->Number < L2.Header->Number; } );
+}
+
+// -----------------------------------------------------------------------------
+
+// a variable is live at some point if its
+// current value can be read afterwards
+void ControlFlowGraph::FindLiveVariables()
+{
+    map< BasicBlock*, set< VariableNode* > > ReadBeforeWritten;
+    map< BasicBlock*, set< VariableNode* > > Written;
+    
+    for( BasicBlock* Block: Blocks )
+    {
+        Block->LiveIn.clear();
+        Block->LiveOut.clear();
+        
+        for( IRInstruction& Instruction: Block->Instructions )
+        {
+            set< VariableNode* > ReadVariables;
+            Instruction.AddReadVariables( ReadVariables );
+            
+            for( VariableNode* Variable: ReadVariables )
+              if( TrackedVariables.count( Variable ) && !Written[ Block ].count( Variable ) )
+                ReadBeforeWritten[ Block ].insert( Variable );
+            
+            VariableNode* AssignedVariable = Instruction.AssignedVariable();
+            
+            if( AssignedVariable && TrackedVariables.count( AssignedVariable ) )
+              Written[ Block ].insert( AssignedVariable );
+        }
+    }
+    
+    bool LivenessChanged = true;
+    
+    while( LivenessChanged )
+    {
+        LivenessChanged = false;
+        
+        for( auto Position = Blocks.rbegin(); Position != Blocks.rend(); Position++ )
+        {
+            BasicBlock* Block = *Position;
+            
+            for( BasicBlock* Successor: Block->Successors )
+              Block->LiveOut.insert( Successor->LiveIn.begin(), Successor->LiveIn.end() );
+            
+            set< VariableNode* > NewLiveIn = ReadBeforeWritten[ Block ];
+            
+            for( VariableNode* Variable: Block->LiveOut )
+              if( !Written[ Block ].count( Variable ) )
+                NewLiveIn.insert( Variable );
+            
+            if( NewLiveIn != Block->LiveIn )
+            {
+                Block->LiveIn.swap( NewLiveIn );
+                LivenessChanged = true;
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// temporaries given a value in more than one
+// place are not used to follow addresses
+void ControlFlowGraph::FindTemporaryDefinitions()
+{
+    TemporaryDefinitions.clear();
+    
+    for( BasicBlock* Block: Blocks )
+      for( IRInstruction& Instruction: Block->Instructions )
+      {
+          if( Instruction.Result.Type != IROperandTypes::Temporary )
+            continue;
+          
+          int Temporary = Instruction.Result.Temporary;
+          
+          if( TemporaryDefinitions.count( Temporary ) )
+            TemporaryDefinitions[ Temporary ] = nullptr;
+          else
+            TemporaryDefinitions[ Temporary ] = &Instruction;
+      }
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: QUERIES
+// =============================================================================
+
+
+// follows an address back to the variable it was calculated
+// from (such as an element of an array or a structure member);
+// returns null when the address is read from memory instead
+VariableNode* ControlFlowGraph::FindAccessedVariable( const IROperand& Address )
+{
+    IROperand Current = Address;
+    
+    while( Current.Type == IROperandTypes::Temporary )
+    {
+        auto DefinitionPair = TemporaryDefinitions.find( Current.Temporary );
+        
+        if( DefinitionPair == TemporaryDefinitions.end() || !DefinitionPair->second )
+          return nullptr;
+        
+        IRInstruction* Definition = DefinitionPair->second;
+        
+        if( Definition->Operation == IROperations::AddressOf )
+          return Definition->Left.Variable;
+        
+        // offsets are always added to the base address
+        bool KeepsBase = (Definition->Operation == IROperations::Copy)
+                      || (Definition->Operation == IROperations::Binary && Definition->BinaryOperator == BinaryOperators::Addition);
+        
+        if( !KeepsBase )
+          return nullptr;
+        
+        Current = Definition->Left;
+    }
+    
+    return nullptr;
+}
+
+
+// =============================================================================
+//      CONTROL FLOW GRAPH: LOG & DEBUG
+// =============================================================================
+
+
+void ControlFlowGraph::Dump( ostream& Output )
+{
+    Output << "function " << Function->Name << endl;
+    
+    for( BasicBlock* Block: Blocks )
+    {
+        Output << "  B" << Block->Number << ":";
+        
+        if( Block == Exit )
+          Output << " exit";
+        
+        if( Block->LoopStatement )
+          Output << " loop";
+        
+        if( !Block->IsReachable )
+          Output << " unreachable";
+        
+        if( !Block->Predecessors.empty() )
+        {
+            Output << " (from";
+            
+            for( BasicBlock* Predecessor: Block->Predecessors )
+              Output << " B" << Predecessor->Number;
+            
+            Output << ")";
+        }
+        
+        Output << endl;
+        
+        for( IRInstruction& Instruction: Block->Instructions )
+        {
+            Output << "    " << Instruction.ToString();
+            
+            if( Instruction.IsTerminator() )
+              for( unsigned i = 0; i < Block->Successors.size(); i++ )
+                Output << (i == 0? " -> " : ", ") << "B" << Block->Successors[ i ]->Number;
+            
+            Output << endl;
+        }
+    }
+    
+    Output << endl;
+}
@@ -0,0 +1,268 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef CONTROLFLOWGRAPH_HPP
+    #define CONTROLFLOWGRAPH_HPP
+    
+    // include project headers
+    #include "CNodes.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <list>             // [ C++ STL ] Lists
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+    #include <ostream>          // [ C++ STL ] Output streams
+// *****************************************************************************
+
+
+// =============================================================================
+//      THREE-ADDRESS INTERMEDIATE REPRESENTATION
+// =============================================================================
+
+
+enum class IROperandTypes
+{
+    None,
+    Constant,
+    Variable,
+    Temporary,
+    Symbol          // functions and literal strings
+};
+
+// -----------------------------------------------------------------------------
+
+class IROperand
+{
+    public:
+        
+        IROperandTypes Type;
+        
+        // constants keep the type of their expression
+        // (static values of bools are not reliable)
+        StaticValue Value;
+        PrimitiveTypes ValueType;
+        
+        // for the other types
+        VariableNode* Variable;
+        int Temporary;
+        std::string Symbol;
+        
+    public:
+        
+        // instance handling
+        IROperand();
+        
+        // log & debug
+        std::string ToString() const;
+};
+
+// -----------------------------------------------------------------------------
+
+enum class IROperations
+{
+    Copy,           // Result = Left
+    Unary,          // Result = (operator) Left
+    Binary,         // Result = Left (operator) Right
+    Conversion,     // Result = (type) Left
+    AddressOf,      // Result = &Left
+    Load,           // Result = [Left]
+    Store,          // [Left] = Right
+    Argument,       // Left is passed to the next call
+    Call,           // Result = call Left
+    Assembly,       // asm block
+    
+    // terminators, which go to the block successors
+    Jump,
+    Branch,         // to successor 0 if Left is true, else to 1
+    Switch,         // Left selects one of the successors
+    Return
+};
+
+// -----------------------------------------------------------------------------
+
+class IRInstruction
+{
+    public:
+        
+        IROperations Operation;
+        UnaryOperators UnaryOperator;
+        BinaryOperators BinaryOperator;
+        IROperand Result, Left, Right;
+        
+        // the AST node that this instruction comes from
+        CNode* Source;
+        
+    public:
+        
+        // instance handling
+        IRInstruction( IROperations Operation_, CNode* Source_ );
+        
+        // queries
+        bool IsTerminator() const;
+        VariableNode* AssignedVariable() const;
+        void AddReadVariables( std::set< VariableNode* >& Variables ) const;
+        
+        // log & debug
+        std::string ToString() const;
+};
+
+
+// =============================================================================
+//      BASIC BLOCKS AND CONTROL FLOW GRAPH
+// =============================================================================
+
+
+// a statement of the AST, and where it is placed: its list
+// position is only known when it belongs to a statement list
+typedef struct
+{
+    CNode** Slot;
+    std::list< CNode* >* List;
+    std::list< CNode* >::iterator Position;
+}
+StatementPosition;
+
+// -----------------------------------------------------------------------------
+
+class BasicBlock
+{
+    public:
+        
+        int Number;
+        std::vector< IRInstruction > Instructions;
+        std::vector< BasicBlock* > Successors;
+        std::vector< BasicBlock* > Predecessors;
+        
+        // the statements that start in this block
+        std::vector< StatementPosition > Statements;
+        
+        // loop statement, for blocks where loops start
+        CNode* LoopStatement;
+        
+        // results of the analyses
+        bool IsReachable;
+        std::set< BasicBlock* > Dominators;
+        std::set< VariableNode* > LiveIn;
+        std::set< VariableNode* > LiveOut;
+        
+    public:
+        
+        // instance handling
+        BasicBlock( int Number_ );
+};
+
+// -----------------------------------------------------------------------------
+
+// a loop whose header dominates all of its blocks
+typedef struct
+{
+    BasicBlock* Header;
+    std::set< BasicBlock* > Blocks;
+}
+NaturalLoop;
+
+// -----------------------------------------------------------------------------
+
+// Lowers the AST of a function to three-address instructions
+// grouped in basic blocks, so that passes can analyze how the
+// code flows. The AST is still what gets emitted: passes use
+// the Source node of instructions and the statement positions
+// of blocks to apply their decisions to the AST. Conditions
+// that are static only lead to the branch that is taken, so
+// dead code is left in blocks that cannot be reached.
+class ControlFlowGraph
+{
+    public:
+        
+        // analyzed function
+        FunctionNode* Function;
+        
+        // the entry is the first block; returns
+        // go to an empty block at the end
+        std::vector< BasicBlock* > Blocks;
+        BasicBlock* Exit;
+        
+        // variables that no pointers or asm blocks
+        // can access (liveness only considers these)
+        std::set< VariableNode* > TrackedVariables;
+        
+        // results of the analyses
+        std::vector< NaturalLoop > Loops;
+        std::map< int, IRInstruction* > TemporaryDefinitions;
+        
+    protected:
+        
+        // state while the AST is lowered
+        BasicBlock* CurrentBlock;
+        int NextTemporary;
+        std::map< CNode*, BasicBlock* > BreakTargets;
+        std::map< CNode*, BasicBlock* > ContinueTargets;
+        std::map< CNode*, BasicBlock* > CaseBlocks;
+        std::map< LabelNode*, BasicBlock* > LabelBlocks;
+        
+        // construction of blocks
+        BasicBlock* NewBlock();
+        void AddEdge( BasicBlock* From, BasicBlock* To );
+        void JumpTo( BasicBlock* Target, CNode* Source );
+        void BranchTo( IROperand Condition, BasicBlock* TrueTarget, BasicBlock* FalseTarget, CNode* Source );
+        IRInstruction& AddInstruction( IROperations Operation, CNode* Source );
+        IROperand NewTemporary();
+        
+        // lowering of the AST
+        IROperand LowerExpression( ExpressionNode* Expression );
+        IROperand LowerPlacement( ExpressionNode* Expression );
+        IROperand LowerOperation( IROperations Operation, IROperand Left, IROperand Right, CNode* Source );
+        IROperand LowerUnaryOperation( UnaryOperationNode* Operation );
+        IROperand LowerBinaryOperation( BinaryOperationNode* Operation );
+        IROperand LowerLogicalOperation( BinaryOperationNode* Operation );
+        void LowerCondition( ExpressionNode* Condition, BasicBlock* TrueTarget, BasicBlock* FalseTarget, CNode* Source );
+        void LowerInitialization( IROperand Address, CNode* InitialValue );
+        void LowerStatement( CNode*& Statement, std::list< CNode* >* List, std::list< CNode* >::iterator Position );
+        void LowerStatementList( std::list< CNode* >& Statements );
+        void RemoveEmptyBlocks();
+        
+    public:
+        
+        // instance handling
+        ControlFlowGraph();
+       ~ControlFlowGraph();
+        void Clear();
+        
+        // main functions
+        void Build( FunctionNode* Function_ );
+        void FindReachableBlocks();
+        void FindDominators();
+        void FindLoops();
+        void FindLiveVariables();
+        void FindTemporaryDefinitions();
+        
+        // queries
+        VariableNode* FindAccessedVariable( const IROperand& Address );
+        
+        // log & debug
+        void Dump( std::ostream& Output );
+};
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// tells if a node is the container or is placed within it
+bool IsWithin( CNode* Node, CNode* Container );
+
+// tells if a part of the code can be entered from outside
+// of it, other than from its start (labels and the cases
+// of switches that contain it)
+bool HasEntryPoints( CNode* Node );
+
+// tells if a condition is static, and then if it is true
+bool GetStaticCondition( ExpressionNode* Condition, bool& IsTrue );
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -125,3 +125,21 @@ void SaveParserLog( const string& FilePath, const VirconCParser& Parser )
     
     LogFile.close();
 }
+
+// -----------------------------------------------------------------------------
+
+void SaveIRLog( const string& FilePath, const PassManager& Passes )
+{
+    if( VerboseMode )
+      cout << "Debug mode: Saving IR log" << endl;
+    
+    ofstream LogFile;
+    LogFile.open( FilePath );
+    
+    if( LogFile.fail() )
+      throw runtime_error( "cannot open IR log file \"" + FilePath + "\"" );
+    
+    // log the basic blocks of every function
+    LogFile << Passes.IRLog.str();
+    LogFile.close();
+}
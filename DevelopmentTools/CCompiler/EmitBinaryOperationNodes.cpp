@@ -61,13 +61,11 @@ void VirconCEmitter::EmitAddition( BinaryOperationNode* BinaryOperation, Registe
         // CASE 1.2: Integer operand has to be emitted
         else
         {
-            // reserve an additional register
-            int IntegerRegister = Registers.FirstFreeRegister();
+            // place integer value in an additional register
+            // (unless it can be used in place)
+            int IntegerRegister = EmitOperandRegister( IntegerOperand, Registers, PointedSize != 1 );
             string IntegerRegisterName = "R" + to_string(IntegerRegister);
             
-            // place integer value in the additional register
-            EmitDependentExpression( IntegerOperand, Registers, IntegerRegister );
-            
             // pointer arithetic uses pointed type as unit
             if( PointedSize != 1 )
               ProgramLines.push_back( "imul " + IntegerRegisterName + ", " + to_string(PointedSize) );
@@ -131,15 +129,14 @@ void VirconCEmitter::EmitAddition( BinaryOperationNode* BinaryOperation, Registe
         if( ResultIsFloat && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ResultIsFloat && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ResultIsFloat && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the addition
@@ -173,13 +170,11 @@ void VirconCEmitter::EmitSubtraction( BinaryOperationNode* BinaryOperation, Regi
         // emit left pointer value into result register
         EmitDependentExpression( BinaryOperation->LeftOperand, Registers, ResultRegister );
         
-        // reserve register to emit right pointer value
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, false );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right pointer value into reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit the subtraction
         ProgramLines.push_back( "isub " + ResultRegisterName + ", " + RightRegisterName );
         
@@ -228,13 +223,11 @@ void VirconCEmitter::EmitSubtraction( BinaryOperationNode* BinaryOperation, Regi
         // CASE 1.2: Integer operand has to be emitted
         else
         {
-            // reserve an additional register
-            int IntegerRegister = Registers.FirstFreeRegister();
+            // place integer value in an additional register
+            // (unless it can be used in place)
+            int IntegerRegister = EmitOperandRegister( IntegerOperand, Registers, PointedSize != 1 );
             string IntegerRegisterName = "R" + to_string(IntegerRegister);
             
-            // place integer value in the additional register
-            EmitDependentExpression( IntegerOperand, Registers, IntegerRegister );
-            
             // pointer arithetic uses pointed type as unit
             if( PointedSize != 1 )
               ProgramLines.push_back( "imul " + IntegerRegisterName + ", " + to_string(PointedSize) );
@@ -322,15 +315,14 @@ void VirconCEmitter::EmitSubtraction( BinaryOperationNode* BinaryOperation, Regi
         if( ResultIsFloat && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ResultIsFloat && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ResultIsFloat && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the subtraction
@@ -401,15 +393,14 @@ void VirconCEmitter::EmitProduct( BinaryOperationNode* BinaryOperation, Register
         if( ResultIsFloat && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ResultIsFloat && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ResultIsFloat && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the product
@@ -488,15 +479,14 @@ void VirconCEmitter::EmitDivision( BinaryOperationNode* BinaryOperation, Registe
         if( ResultIsFloat && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ResultIsFloat && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ResultIsFloat && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the division
@@ -546,13 +536,11 @@ void VirconCEmitter::EmitModulus( BinaryOperationNode* BinaryOperation, Register
         // emit left value to result register
         EmitDependentExpression( BinaryOperation->LeftOperand, Registers, ResultRegister );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, false );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit the modulus
         ProgramLines.push_back( "imod " + ResultRegisterName + ", " + RightRegisterName );
         
@@ -634,15 +622,14 @@ void VirconCEmitter::EmitEqual( BinaryOperationNode* BinaryOperation, RegisterAl
         if( ResultIsFloat && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ResultIsFloat && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ResultIsFloat && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the comparison
@@ -726,15 +713,14 @@ void VirconCEmitter::EmitNotEqual( BinaryOperationNode* BinaryOperation, Registe
         if( ThereAreFloats && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ThereAreFloats && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ThereAreFloats && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the comparison
@@ -824,15 +810,14 @@ void VirconCEmitter::EmitLessThan( BinaryOperationNode* BinaryOperation, Registe
         if( ThereAreFloats && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ThereAreFloats && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ThereAreFloats && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the comparison
@@ -920,15 +905,14 @@ void VirconCEmitter::EmitLessOrEqual( BinaryOperationNode* BinaryOperation, Regi
         if( ThereAreFloats && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ThereAreFloats && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ThereAreFloats && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the comparison
@@ -1016,15 +1000,14 @@ void VirconCEmitter::EmitGreaterThan( BinaryOperationNode* BinaryOperation, Regi
         if( ThereAreFloats && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ThereAreFloats && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ThereAreFloats && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the comparison
@@ -1112,15 +1095,14 @@ void VirconCEmitter::EmitGreaterOrEqual( BinaryOperationNode* BinaryOperation, R
         if( ThereAreFloats && !LeftIsFloat )
           EmitRegisterTypeConversion( ResultRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        bool RightNeedsConversion = (ThereAreFloats && !RightIsFloat);
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, RightNeedsConversion );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit type conversion for right value
-        if( ThereAreFloats && !RightIsFloat )
+        if( RightNeedsConversion )
           EmitRegisterTypeConversion( RightRegister, PrimitiveTypes::Int, PrimitiveTypes::Float );
         
         // emit the comparison
@@ -1285,13 +1267,11 @@ void VirconCEmitter::EmitBitwiseOr( BinaryOperationNode* BinaryOperation, Regist
         // emit left value to result register
         EmitDependentExpression( BinaryOperation->LeftOperand, Registers, ResultRegister );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, false );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit the bitwise operation
         ProgramLines.push_back( "or " + ResultRegisterName + ", " + RightRegisterName );
         
@@ -1337,13 +1317,11 @@ void VirconCEmitter::EmitBitwiseAnd( BinaryOperationNode* BinaryOperation, Regis
         // emit left value to result register
         EmitDependentExpression( BinaryOperation->LeftOperand, Registers, ResultRegister );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, false );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit the bitwise operation
         ProgramLines.push_back( "and " + ResultRegisterName + ", " + RightRegisterName );
         
@@ -1389,13 +1367,11 @@ void VirconCEmitter::EmitBitwiseXor( BinaryOperationNode* BinaryOperation, Regis
         // emit left value to result register
         EmitDependentExpression( BinaryOperation->LeftOperand, Registers, ResultRegister );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, false );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit the bitwise operation
         ProgramLines.push_back( "xor " + ResultRegisterName + ", " + RightRegisterName );
         
@@ -1438,13 +1414,11 @@ void VirconCEmitter::EmitShiftLeft( BinaryOperationNode* BinaryOperation, Regist
         // emit left value to result register
         EmitDependentExpression( BinaryOperation->LeftOperand, Registers, ResultRegister );
         
-        // reserve an additional register
-        int RightRegister = Registers.FirstFreeRegister();
+        // emit right value to an additional register
+        // (unless it can be used in place)
+        int RightRegister = EmitOperandRegister( BinaryOperation->RightOperand, Registers, false );
         string RightRegisterName = "R" + to_string(RightRegister);
         
-        // emit right value to reserved register
-        EmitDependentExpression( BinaryOperation->RightOperand, Registers, RightRegister );
-        
         // emit the bit shift
         ProgramLines.push_back( "shl " + ResultRegisterName + ", " + RightRegisterName );
         
@@ -1574,8 +1548,15 @@ void VirconCEmitter::EmitAssignment( BinaryOperationNode* BinaryOperation, Regis
         Registers.RegisterUsed[ TempRegister ] = false;
     }
     
-    // 2-A: left address is static
-    if( BinaryOperation->LeftOperand->HasStaticPlacement() )
+    // 2-A: left operand is kept in a register
+    if( VariableRegister( BinaryOperation->LeftOperand ) )
+    {
+        string LeftRegisterName = "R" + to_string( VariableRegister( BinaryOperation->LeftOperand ) );
+        ProgramLines.push_back( "mov " + LeftRegisterName + ", " + ResultRegisterName );
+    }
+    
+    // 2-B: left address is static
+    else if( BinaryOperation->LeftOperand->HasStaticPlacement() )
     {
         // get placement for left operand
         MemoryPlacement LeftPlacement = BinaryOperation->LeftOperand->GetStaticPlacement();
@@ -1584,7 +1565,7 @@ void VirconCEmitter::EmitAssignment( BinaryOperationNode* BinaryOperation, Regis
         ProgramLines.push_back( "mov [" + LeftPlacement.AccessAddressString() + "], " + ResultRegisterName );
     }
     
-    // 2-B: left address is not static
+    // 2-C: left address is not static
     else
     {
         // use a register for left placement
@@ -1620,7 +1601,15 @@ void VirconCEmitter::EmitComplementaryAssignment( BinaryOperationNode* BinaryOpe
         Registers.RegisterUsed[ TempRegister ] = false;
     }
     
-    // CASE 1: left operand has a static address
+    // CASE 1: left operand is kept in a register
+    if( VariableRegister( BinaryOperation->LeftOperand ) )
+    {
+        string LeftRegisterName = "R" + to_string( VariableRegister( BinaryOperation->LeftOperand ) );
+        ProgramLines.push_back( "mov " + LeftRegisterName + ", " + ResultRegisterName );
+        return;
+    }
+    
+    // CASE 2: left operand has a static address
     if( BinaryOperation->LeftOperand->HasStaticPlacement() )
     {
         // perform assignment to the static placement
@@ -1629,7 +1618,7 @@ void VirconCEmitter::EmitComplementaryAssignment( BinaryOperationNode* BinaryOpe
         return;
     }
     
-    // CASE 2: general case (unoptimized)
+    // CASE 3: general case (unoptimized)
     else
     {
         // we need an extra register
@@ -18,9 +18,17 @@ void VirconCEmitter::EmitExpressionAtom( ExpressionAtomNode* ExpressionAtom, Reg
     // if this function gets called, the atom is not static
     // (which means it can only be a variable)
     string ResultRegisterName = "R" + to_string(ResultRegister);
-    string VariableAddress = ExpressionAtom->ResolvedVariable->Placement.AccessAddressString();
+    MemoryPlacement& VariablePlacement = ExpressionAtom->ResolvedVariable->Placement;
+    
+    // variables kept in a register are just copied
+    if( VariablePlacement.IsInRegister() )
+    {
+        ProgramLines.push_back( "mov " + ResultRegisterName + ", " + VariablePlacement.RegisterName() );
+        return;
+    }
     
     // place the variable value in the register
+    string VariableAddress = VariablePlacement.AccessAddressString();
     ProgramLines.push_back( "mov " + ResultRegisterName + ", [" + VariableAddress + "]" );
 }
 
@@ -30,6 +38,39 @@ void VirconCEmitter::EmitFunctionCall( FunctionCallNode* FunctionCall, RegisterA
 {
     // obtain the called function
     FunctionNode* Function = FunctionCall->ResolvedFunction;
+    int RegisterArguments = RegisterArgumentsCount( Function );
+    
+    // OPTIMIZATION: small functions are emitted in place of their calls
+    if( Inlining.Find( Function ) )
+    {
+        EmitInlinedCall( FunctionCall, Registers, ResultRegister );
+        return;
+    }
+    
+    // with the register convention, the function can modify
+    // some registers that may be in use (and we also need the
+    // ones for arguments), so those are saved in the stack;
+    // space for arguments must then be reserved after them
+    vector< int > SavedRegisters;
+    
+    if( Function->PassesArgumentsInRegisters )
+    {
+        set< int > ModifiedRegisters;
+        AddRegistersInLine( "call __function_" + Function->Name, FunctionClobbers, ModifiedRegisters );
+        
+        for( int i = 0; i < RegisterArguments; i++ )
+          ModifiedRegisters.insert( FirstArgumentRegister + i );
+        
+        for( int i = 1; i < 14; i++ )
+          if( Registers.RegisterUsed[ i ] && i != ResultRegister && ModifiedRegisters.count( i ) )
+          {
+              ProgramLines.push_back( "push R" + to_string( i ) );
+              SavedRegisters.push_back( i );
+          }
+        
+        if( !SavedRegisters.empty() && Function->SizeOfArguments > 0 )
+          ProgramLines.push_back( "isub SP, " + to_string( Function->SizeOfArguments ) );
+    }
     
     // use a single register for all parameters
     // (but avoid reserving a register if not needed)
@@ -94,16 +135,44 @@ void VirconCEmitter::EmitFunctionCall( FunctionCallNode* FunctionCall, RegisterA
         ParameterPositionRev++;
     }
     
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Arguments passed in registers are evaluated directly into them,
+    // so other parameters must not use those registers; the single
+    // register for the rest has to be chosen again
+    bool ArgumentRegisterWasUsed[ MaximumRegisterArguments ];
+    
+    if( RegisterArguments > 0 )
+    {
+        Registers.RegisterUsed[ ParameterRegister ] = false;
+        
+        for( int i = 0; i < RegisterArguments; i++ )
+        {
+            ArgumentRegisterWasUsed[ i ] = Registers.RegisterUsed[ FirstArgumentRegister + i ];
+            Registers.RegisterUsed[ FirstArgumentRegister + i ] = true;
+        }
+        
+        ParameterRegister = 0;
+        
+        if( (int)FunctionCall->Parameters.size() > RegisterArguments )
+          ParameterRegister = Registers.FirstFreeRegister();
+    }
+    
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // Second pass: process other arguments, and use the precalculated ones
     auto ArgumentPosition = Function->Arguments.begin();
     auto ParameterPosition = FunctionCall->Parameters.begin();
+    int ArgumentNumber = 0;
     
     while( ArgumentPosition != Function->Arguments.end() )
     {
         ExpressionNode* Parameter = *ParameterPosition;
         VariableNode* Argument = *ArgumentPosition;
         
+        // choose where this argument is evaluated
+        bool IsPassedInRegister = (ArgumentNumber < RegisterArguments);
+        int ArgumentRegister = (IsPassedInRegister? FirstArgumentRegister + ArgumentNumber : ParameterRegister);
+        ParameterRegisterName = "R" + to_string( ArgumentRegister );
+        
         if( Parameter->UsesFunctionCalls() )
         {
             // free the used space in the stack of temporaries
@@ -120,24 +189,34 @@ void VirconCEmitter::EmitFunctionCall( FunctionCallNode* FunctionCall, RegisterA
         else
         {
             // emit the evaluation of this parameter
-            EmitDependentExpression( Parameter, Registers, ParameterRegister );
+            EmitDependentExpression( Parameter, Registers, ArgumentRegister );
             
             // perform type promotion where needed
             DataType* NeededType = Argument->DeclaredType;
             DataType* ProducedType = Parameter->ReturnedType;
-            EmitRegisterTypeConversion( ParameterRegister, ProducedType, NeededType );
+            EmitRegisterTypeConversion( ArgumentRegister, ProducedType, NeededType );
         }
         
         // place the result as a passed parameter (end of the stack frame)
-        string PassingAddress = Argument->Placement.PassingAddressString();
-        ProgramLines.push_back( "mov [" + PassingAddress + "], " + ParameterRegisterName );
+        if( !IsPassedInRegister )
+        {
+            string PassingAddress = Argument->Placement.PassingAddressString();
+            ProgramLines.push_back( "mov [" + PassingAddress + "], " + ParameterRegisterName );
+        }
         
         ArgumentPosition++;
         ParameterPosition++;
+        ArgumentNumber++;
     }
     
-    // emit the function call itself
+    for( int i = 0; i < RegisterArguments; i++ )
+      Registers.RegisterUsed[ FirstArgumentRegister + i ] = ArgumentRegisterWasUsed[ i ];
+    
+    // emit the function call itself, keeping any
+    // variables in registers that it could modify
+    EmitVariableSaves( FunctionCall, false );
     ProgramLines.push_back( "call __function_" + Function->Name );
+    EmitVariableSaves( FunctionCall, true );
     
     // By calling convention, calls produce their result in R0.
     // If needed, place the result in the requested register
@@ -147,12 +226,178 @@ void VirconCEmitter::EmitFunctionCall( FunctionCallNode* FunctionCall, RegisterA
         ProgramLines.push_back( "mov " + ResultRegisterName + ", R0" );
     }
     
+    // restore any registers saved before the call
+    if( !SavedRegisters.empty() && Function->SizeOfArguments > 0 )
+      ProgramLines.push_back( "iadd SP, " + to_string( Function->SizeOfArguments ) );
+    
+    for( auto Register = SavedRegisters.rbegin(); Register != SavedRegisters.rend(); Register++ )
+      ProgramLines.push_back( "pop R" + to_string( *Register ) );
+    
     // release the arguments register
     Registers.RegisterUsed[ ParameterRegister ] = false;
 }
 
 // -----------------------------------------------------------------------------
 
+// The code of an inlined function is emitted with its arguments
+// kept in registers that its asm blocks don't use, so there are
+// no stack frames or argument copies. Constant parameters can be
+// written directly in asm lines, and variables already kept in a
+// register can be used from there if the function only reads them
+void VirconCEmitter::EmitInlinedCall( FunctionCallNode* FunctionCall, RegisterAllocation& Registers, int ResultRegister )
+{
+    const InlinedFunction& Inlined = *Inlining.Find( FunctionCall->ResolvedFunction );
+    FunctionNode* Function = Inlined.Definition;
+    
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // First: bind every argument to the value of its parameter
+    map< VariableNode*, int > PreviousArgumentRegisters;
+    vector< int > ArgumentRegisters;
+    auto ParameterPosition = FunctionCall->Parameters.begin();
+    
+    for( VariableNode* Argument: Function->Arguments )
+    {
+        ExpressionNode* Parameter = *ParameterPosition;
+        ParameterPosition++;
+        
+        PreviousArgumentRegisters[ Argument ] = Argument->Placement.Register;
+        DataType* ArgumentType = Argument->DeclaredType;
+        
+        // CASE 1: constants are placed in the asm lines
+        if( Inlined.ImmediateArguments.count( Argument ) && Parameter->IsStatic() )
+          if( ArgumentType->Type() == DataTypes::Primitive )
+          {
+              StaticValue ArgumentValue = Parameter->GetStaticValue();
+              ArgumentValue.ConvertToType( ((PrimitiveType*)ArgumentType)->Which );
+              InlinedArgumentValues[ Argument ] = ArgumentValue.ToString();
+              continue;
+          }
+        
+        // CASE 2: variables in registers are used from there
+        ExpressionNode* Variable = Parameter;
+        int ParameterRegister = 0;
+        
+        while( Variable->Type() == CNodeTypes::EnclosedExpression )
+          Variable = ((EnclosedExpressionNode*)Variable)->InternalExpression;
+        
+        if( Variable->Type() == CNodeTypes::ExpressionAtom )
+          ParameterRegister = VariableRegister( Variable );
+        
+        if( ParameterRegister && Inlined.ReadOnlyArguments.count( Argument ) )
+          if( !Inlined.ModifiedRegisters.count( ParameterRegister ) && AreEqual( Parameter->ReturnedType, ArgumentType ) )
+          {
+              Argument->Placement.Register = ParameterRegister;
+              continue;
+          }
+        
+        // CASE 3: the parameter is evaluated into a register
+        // that none of the inlined asm code modifies
+        bool RegisterWasUsed[ 14 ];
+        
+        for( int i = 0; i < 14; i++ )
+          RegisterWasUsed[ i ] = Registers.RegisterUsed[ i ];
+        
+        for( int Register: Inlined.ModifiedRegisters )
+          Registers.RegisterUsed[ Register ] = true;
+        
+        int ArgumentRegister = Registers.FirstFreeRegister();
+        
+        for( int i = 0; i < 14; i++ )
+          if( i != ArgumentRegister )
+            Registers.RegisterUsed[ i ] = RegisterWasUsed[ i ];
+        
+        EmitDependentExpression( Parameter, Registers, ArgumentRegister );
+        EmitRegisterTypeConversion( ArgumentRegister, Parameter->ReturnedType, ArgumentType );
+        
+        // like variables, it must not be released by operations
+        Registers.RegisterReserved[ ArgumentRegister ] = true;
+        Argument->Placement.Register = ArgumentRegister;
+        ArgumentRegisters.push_back( ArgumentRegister );
+    }
+    
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Second: save the registers in use that asm code will modify
+    // (for local variables, just like in a call)
+    vector< int > SavedRegisters;
+    
+    for( int Register: Inlined.AssemblyRegisters )
+      if( Registers.RegisterUsed[ Register ] && Register != ResultRegister )
+      {
+          ProgramLines.push_back( "push R" + to_string( Register ) );
+          SavedRegisters.push_back( Register );
+      }
+    
+    EmitVariableSaves( FunctionCall, false );
+    
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Third: emit the function body (like in a normal function,
+    // asm blocks may leave the result in R0 with no return)
+    string ResultRegisterName = "R" + to_string( ResultRegister );
+    bool ResultIsInR0 = (Function->ReturnType->Type() != DataTypes::Void);
+    
+    for( CNode* Statement: Function->Statements )
+    {
+        if( Statement->Type() == CNodeTypes::AssemblyBlock )
+          EmitAssemblyLines( (AssemblyBlockNode*)Statement );
+        
+        else if( Statement->Type() == CNodeTypes::Return )
+        {
+            ExpressionNode* ReturnedExpression = ((ReturnNode*)Statement)->ReturnedExpression;
+            if( !ReturnedExpression ) continue;
+            
+            // calls within the expression may use R0, so
+            // then it is not used for the partial results
+            int ReturnedRegister = ResultRegister;
+            
+            if( ResultRegister == 0 && ReturnedExpression->UsesFunctionCalls() )
+              ReturnedRegister = Registers.FirstFreeRegister();
+            
+            EmitDependentExpression( ReturnedExpression, Registers, ReturnedRegister );
+            EmitRegisterTypeConversion( ReturnedRegister, ReturnedExpression->ReturnedType, Function->ReturnType );
+            
+            if( ReturnedRegister != ResultRegister )
+            {
+                ProgramLines.push_back( "mov " + ResultRegisterName + ", R" + to_string( ReturnedRegister ) );
+                Registers.RegisterUsed[ ReturnedRegister ] = false;
+            }
+            
+            ResultIsInR0 = false;
+        }
+        
+        // other statements can only be expressions
+        else if( Statement->IsExpression() )
+        {
+            int StatementRegister = Registers.FirstFreeRegister();
+            EmitDependentExpression( (ExpressionNode*)Statement, Registers, StatementRegister );
+            Registers.RegisterUsed[ StatementRegister ] = false;
+        }
+    }
+    
+    if( ResultIsInR0 && ResultRegister != 0 )
+      ProgramLines.push_back( "mov " + ResultRegisterName + ", R0" );
+    
+    // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+    // Fourth: restore saved registers, and release the arguments
+    EmitVariableSaves( FunctionCall, true );
+    
+    for( auto Register = SavedRegisters.rbegin(); Register != SavedRegisters.rend(); Register++ )
+      ProgramLines.push_back( "pop R" + to_string( *Register ) );
+    
+    for( int Register: ArgumentRegisters )
+    {
+        Registers.RegisterUsed[ Register ] = false;
+        Registers.RegisterReserved[ Register ] = false;
+    }
+    
+    for( auto& ArgumentPair: PreviousArgumentRegisters )
+    {
+        ArgumentPair.first->Placement.Register = ArgumentPair.second;
+        InlinedArgumentValues.erase( ArgumentPair.first );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void VirconCEmitter::EmitArrayAccess( ArrayAccessNode* ArrayAccess, RegisterAllocation& Registers, int ResultRegister )
 {
     // do some common precalculations
@@ -200,9 +445,9 @@ void VirconCEmitter::EmitArrayAccess( ArrayAccessNode* ArrayAccess, RegisterAllo
     // CASE 3: Both array and index need to be determined
     else
     {
-        // reserve additional register for the index
-        int IndexRegister = Registers.FirstFreeRegister();
-        string IndexRegisterName = "R" + to_string(IndexRegister);
+        // find out the type of the array elements
+        DataType* ElementType = ArrayAccess->ReturnedType;
+        int ElementSize = ElementType->SizeInWords();
         
         // obtain placement for the resulting array:
         // - for pointers, this emits its stored value;
@@ -210,11 +455,9 @@ void VirconCEmitter::EmitArrayAccess( ArrayAccessNode* ArrayAccess, RegisterAllo
         EmitDependentExpression( ArrayAccess->ArrayOperand, Registers, ResultRegister );
         
         // emit index, i.e. obtain offset of this element in the array
-        EmitDependentExpression( ArrayAccess->IndexOperand, Registers, IndexRegister );
-        
-        // find out the type of the array elements
-        DataType* ElementType = ArrayAccess->ReturnedType;
-        int ElementSize = ElementType->SizeInWords();
+        // (in an additional register, unless it can be used in place)
+        int IndexRegister = EmitOperandRegister( ArrayAccess->IndexOperand, Registers, ElementSize != 1 );
+        string IndexRegisterName = "R" + to_string(IndexRegister);
         
         // only if element size is not 1, we need to scale the offset
         if( ElementSize != 1 )
@@ -2,10 +2,15 @@
     // include common Vircon headers
     #include "../../VirconDefinitions/Enumerations.hpp"
     
+    // include infrastructure headers
+    #include "../DevToolsInfrastructure/StringFunctions.hpp"
+    
     // include project headers
     #include "VirconCEmitter.hpp"
     #include "CheckNodes.hpp"
     #include "CompilerInfrastructure.hpp"
+    #include "Globals.hpp"
+    #include "ExpressionOptimizer.hpp"
     
     // declare used namespaces
     using namespace std;
@@ -91,12 +96,119 @@ int VirconCEmitter::EmitVariable( VariableNode* Variable )
 
 // -----------------------------------------------------------------------------
 
+// Registers R11 to R13 (CR, SR, DR) are not used for
+// variables since string operations modify them
+const int LastVariableRegister = (int)CPURegisters::CountRegister - 1;
+
+// -----------------------------------------------------------------------------
+
+// without a stack frame, code cannot use BP or change SP
+// (calls are fine, since they leave SP as it was)
+static bool LinesUseStack( const vector< string >& Lines )
+{
+    for( const string& Line: Lines )
+    {
+        vector< string > Words = SplitAssemblyLine( Line );
+        
+        if( Words.empty() )
+          continue;
+        
+        string Instruction = ToLowerCase( Words[ 0 ] );
+        
+        if( Instruction == "push" || Instruction == "pop" )
+          return true;
+        
+        for( string& Word: Words )
+          if( ToLowerCase( Word ) == "bp" || ToLowerCase( Word ) == "sp" )
+            return true;
+    }
+    
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
 int VirconCEmitter::EmitFunction( FunctionNode* Function )
 {
     // emit only if it is a full definition
     if( !Function->HasBody )
       return 0;
     
+    // keep the start of the function, in case
+    // its emission needs to be done again
+    int ProgramStartPosition = ProgramLines.size();
+    int DataStartPosition = DataLines.size();
+    
+    // first emit the function with all variables in memory,
+    // to find out how many registers expressions will need
+    LocalVariableRegisters.Clear();
+    int HighestRegister = EmitFunctionCode( Function );
+    
+    // OPTIMIZATION: keep local variables in the remaining registers
+    // (using a register may require the function to preserve it)
+    bool FunctionReturnsValue = (Function->ReturnType->Type() != DataTypes::Void);
+    set< int > PreservedRegisters;
+    
+    if( Function->PassesArgumentsInRegisters )
+    {
+        for( int i = FirstCalleeSavedRegister; i <= LastCalleeSavedRegister; i++ )
+          PreservedRegisters.insert( i );
+    }
+    
+    else if( FunctionReturnsValue )
+    {
+        for( int i = 1; i <= LastVariableRegister; i++ )
+          PreservedRegisters.insert( i );
+    }
+    
+    if( OptimizationLevel >= 1 )
+    {
+        LocalVariableRegisters.Analyze( Function, FunctionClobbers, Inlining );
+        LocalVariableRegisters.AssignRegisters( HighestRegister + 1, LastVariableRegister, PreservedRegisters );
+    }
+    
+    // when some were placed in registers, the
+    // first emission is discarded and redone
+    if( LocalVariableRegisters.HighestRegister() > 0 )
+    {
+        ProgramLines.resize( ProgramStartPosition );
+        DataLines.resize( DataStartPosition );
+        LineMapping.erase( LineMapping.lower_bound( ProgramStartPosition + 2 ), LineMapping.end() );
+        AssemblyBlockLines.erase( AssemblyBlockLines.lower_bound( ProgramStartPosition ), AssemblyBlockLines.end() );
+        
+        HighestRegister = EmitFunctionCode( Function );
+    }
+    
+    // keep track of the registers that callers may see modified
+    // (the ones this function preserves are then removed)
+    set< int > ModifiedRegisters;
+    
+    for( unsigned i = ProgramStartPosition; i < ProgramLines.size(); i++ )
+      AddRegistersInLine( ProgramLines[ i ], FunctionClobbers, ModifiedRegisters );
+    
+    if( Function->PassesArgumentsInRegisters )
+    {
+        for( int Register = FirstCalleeSavedRegister; Register <= LastCalleeSavedRegister; Register++ )
+          ModifiedRegisters.erase( Register );
+    }
+    
+    else if( FunctionReturnsValue )
+    {
+        for( int Register = 1; Register <= max( HighestRegister, LocalVariableRegisters.HighestRegister() ); Register++ )
+          ModifiedRegisters.erase( Register );
+    }
+    
+    FunctionClobbers[ "__function_" + Function->Name ] = ModifiedRegisters;
+    
+    // variables go back to memory for other functions
+    LocalVariableRegisters.Clear();
+    return HighestRegister;
+}
+
+// -----------------------------------------------------------------------------
+
+int VirconCEmitter::EmitFunctionCode( FunctionNode* Function )
+{
     // add info to determine line correspondence
     AddDebugInfo( Function );
     
@@ -125,25 +237,70 @@ int VirconCEmitter::EmitFunction( FunctionNode* Function )
     vector< string > BodyLines( ProgramLines.begin()+BodyStartPosition, ProgramLines.end() );
     ProgramLines.erase( ProgramLines.begin()+BodyStartPosition, ProgramLines.end() );
     
-    // determine if function must preserve its used registers
-    // so that it can safely be used inside expressions
+    // arguments kept in registers are placed there at
+    // the start (after the stack frame is allocated)
+    EmitArgumentsEntry( Function );
+    
+    vector< string > EntryLines( ProgramLines.begin()+BodyStartPosition, ProgramLines.end() );
+    ProgramLines.erase( ProgramLines.begin()+BodyStartPosition, ProgramLines.end() );
+    
+    // determine the registers that the function must preserve:
+    // - with the stack convention, functions that return a value
+    //   preserve all their used registers so that they can safely
+    //   be used inside expressions (including those used by local
+    //   variables, if any)
+    // - with the register convention, all functions preserve the
+    //   callee-saved registers that they modify
     bool FunctionReturnsValue = (Function->ReturnType->Type() != DataTypes::Void);
-    bool PreserveRegisters = (FunctionReturnsValue && (HighestRegister > 0));
+    vector< int > PreservedRegisters;
+    
+    if( Function->PassesArgumentsInRegisters )
+    {
+        set< int > ModifiedRegisters;
+        
+        for( string& Line: EntryLines )
+          AddRegistersInLine( Line, FunctionClobbers, ModifiedRegisters );
+        
+        for( string& Line: BodyLines )
+          AddRegistersInLine( Line, FunctionClobbers, ModifiedRegisters );
+        
+        for( int i = FirstCalleeSavedRegister; i <= LastCalleeSavedRegister; i++ )
+          if( ModifiedRegisters.count( i ) )
+            PreservedRegisters.push_back( i );
+    }
+    
+    else if( FunctionReturnsValue )
+    {
+        int HighestPreservedRegister = max( HighestRegister, LocalVariableRegisters.HighestRegister() );
+        
+        for( int i = 1; i <= HighestPreservedRegister; i++ )
+          PreservedRegisters.push_back( i );
+    }
+    
+    // OPTIMIZATION: with the register convention, functions
+    // that never access the stack don't need a stack frame
+    bool NeedsStackFrame = !Function->PassesArgumentsInRegisters
+                        || Function->StackSizeForFunctionCalls > 0
+                        || LinesUseStack( EntryLines )
+                        || LinesUseStack( BodyLines );
+    
+    if( !NeedsStackFrame )
+      ProgramLines.erase( ProgramLines.end() - 2, ProgramLines.end() );
     
     // CASE 1: when some registers need to be preserved,
     // they have to be positioned in the stack frame so
     // that function calls are still at the end (at SP)
-    if( PreserveRegisters )
+    if( !PreservedRegisters.empty() )
     {
         // first allocate the stack frame without function calls
         int StackFrameSize = Function->StackSizeForVariables + Function->StackSizeForTemporaries;
         
-        if( StackFrameSize > 0 )
+        if( NeedsStackFrame && StackFrameSize > 0 )
           ProgramLines.push_back( "isub SP, " + to_string( StackFrameSize ) );
         
         // now push the used registers
-        for( int i = 1; i <= HighestRegister; i++ )
-          ProgramLines.push_back( "push R" + to_string(i) );
+        for( int Register: PreservedRegisters )
+          ProgramLines.push_back( "push R" + to_string( Register ) );
         
         // then allocate the space for function calls
         if( Function->StackSizeForFunctionCalls > 0 )
@@ -151,7 +308,7 @@ int VirconCEmitter::EmitFunction( FunctionNode* Function )
     }
     
     // CASE 2: otherwise, the whole stack can be allocated at once
-    else
+    else if( NeedsStackFrame )
     {
         int StackFrameSize = Function->StackSizeForVariables
                            + Function->StackSizeForTemporaries
@@ -161,8 +318,20 @@ int VirconCEmitter::EmitFunction( FunctionNode* Function )
           ProgramLines.push_back( "isub SP, " + to_string( StackFrameSize ) );
     }
     
+    // lines from asm blocks in the body were marked
+    // at their original positions, so move the marks
+    int BodyShift = ProgramLines.size() + EntryLines.size() - BodyStartPosition;
+    set< int > BodyAssemblyLines( AssemblyBlockLines.lower_bound( BodyStartPosition ), AssemblyBlockLines.end() );
+    AssemblyBlockLines.erase( AssemblyBlockLines.lower_bound( BodyStartPosition ), AssemblyBlockLines.end() );
+    
+    for( int Position: BodyAssemblyLines )
+      AssemblyBlockLines.insert( Position + BodyShift );
+    
     // now we have finished inserting before the body;
     // we can resume writing at the end of the program
+    for( string Line: EntryLines )
+      ProgramLines.push_back( Line );
+    
     for( string Line: BodyLines )
       ProgramLines.push_back( Line );
     
@@ -175,23 +344,19 @@ int VirconCEmitter::EmitFunction( FunctionNode* Function )
     EmitLabel( ReturnLabel );
     
     // CASE 1: if registers were saved, we need to restore them
-    if( PreserveRegisters )
+    if( !PreservedRegisters.empty() )
     {
         // first deallocate the space for function calls
         if( Function->StackSizeForFunctionCalls > 0 )
           ProgramLines.push_back( "iadd SP, " + to_string( Function->StackSizeForFunctionCalls ) );
         
         // now pop the used registers in reverse order
-        for( int i = HighestRegister; i >= 1; i-- )
-          ProgramLines.push_back( "pop R" + to_string(i) );
-        
-        // finally deallocate the rest of the stack frame
-        ProgramLines.push_back( "mov SP, BP" );
-        ProgramLines.push_back( "pop BP" );
+        for( auto Register = PreservedRegisters.rbegin(); Register != PreservedRegisters.rend(); Register++ )
+          ProgramLines.push_back( "pop R" + to_string( *Register ) );
     }
     
-    // CASE 2: just deallocate all the stack frame at once
-    else
+    // finally deallocate the rest of the stack frame
+    if( NeedsStackFrame )
     {
         ProgramLines.push_back( "mov SP, BP" );
         ProgramLines.push_back( "pop BP" );
@@ -256,6 +421,7 @@ int VirconCEmitter::EmitInitialization( MemoryPlacement LeftPlacement, DataType*
         {
             // we will need this to track the used registers in this case
             RegisterAllocation Registers( InitialValue->Location );
+            LocalVariableRegisters.ReserveRegisters( Registers );
             
             // there are no literal multi-word literal values, so we
             // can safely assume that the assigned value has an address
@@ -307,7 +473,11 @@ int VirconCEmitter::EmitSingleInitialization( MemoryPlacement LeftPlacement, Dat
 {
     int HighestRegister = 0;
     
-    string LeftAddress = LeftPlacement.AccessAddressString();
+    // variables kept in a register are initialized there
+    string LeftAddress = "[" + LeftPlacement.AccessAddressString() + "]";
+    
+    if( LeftPlacement.IsInRegister() )
+      LeftAddress = LeftPlacement.RegisterName();
     
     // CASE 1: Optimize when assigned value is known at compile time
     if( Value->IsStatic() )
@@ -320,9 +490,16 @@ int VirconCEmitter::EmitSingleInitialization( MemoryPlacement LeftPlacement, Dat
           if( LeftType->Type() == DataTypes::Primitive )
             AssignedValue.ConvertToType( ((PrimitiveType*)LeftType)->Which );
         
+        // a register can get the value directly
+        if( LeftPlacement.IsInRegister() )
+          ProgramLines.push_back( "mov " + LeftAddress + ", " + AssignedValue.ToString() );
+        
         // place result directly into destination
-        ProgramLines.push_back( "mov R0, " + AssignedValue.ToString() );
-        ProgramLines.push_back( "mov [" + LeftAddress + "], R0" );
+        else
+        {
+            ProgramLines.push_back( "mov R0, " + AssignedValue.ToString() );
+            ProgramLines.push_back( "mov " + LeftAddress + ", R0" );
+        }
     }
     
     // CASE 2: General case in which we calculate the value
@@ -330,7 +507,7 @@ int VirconCEmitter::EmitSingleInitialization( MemoryPlacement LeftPlacement, Dat
     {
         HighestRegister = EmitRootExpression( Value );
         EmitRegisterTypeConversion( 0, Value->ReturnedType, LeftType );
-        ProgramLines.push_back( "mov [" + LeftAddress + "], R0" );
+        ProgramLines.push_back( "mov " + LeftAddress + ", R0" );
     }
     
     return HighestRegister;
@@ -564,6 +741,15 @@ int VirconCEmitter::EmitFor( ForNode* For )
     // (CANNOT be done until parsing has ended!)
     For->CalculateLocalVariablesOffset();
     
+    // OPTIMIZATION: loops that only copy or fill
+    // array elements use a single block operation
+    BinaryOperationNode* BlockAssignment;
+    ExpressionNode* BlockLimit;
+    bool BlockLimitIsIncluded;
+    
+    if( OptimizationLevel >= 1 && IsBlockOperationLoop( For, BlockAssignment, BlockLimit, BlockLimitIsIncluded ) )
+      return EmitBlockOperationLoop( For, BlockAssignment, BlockLimit, BlockLimitIsIncluded );
+    
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     
     // make labels
@@ -688,6 +874,16 @@ int VirconCEmitter::EmitContinue( ContinueNode* Continue )
 
 // -----------------------------------------------------------------------------
 
+// negative values would break the label
+// so for them just add a "minus" text
+static string GetCaseLabel( SwitchNode* Switch, int Value )
+{
+    string ValueText = string(Value < 0? "minus_" : "") + to_string( abs(Value) );
+    return Switch->NodeLabel() + "_case_" + ValueText;
+}
+
+// -----------------------------------------------------------------------------
+
 int VirconCEmitter::EmitSwitch( SwitchNode* Switch )
 {
     // add info to determine line correspondence
@@ -712,28 +908,24 @@ int VirconCEmitter::EmitSwitch( SwitchNode* Switch )
     EmitRegisterTypeConversion( 0, Switch->Condition->ReturnedType, &IntegerType );
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-    // emit all handled cases
-    for( auto Pair: Switch->HandledCases )
-    {
-        int Value = Pair.first;
-        string ValueText = string(Value < 0? "minus_" : "") + to_string( abs(Value) );
-        string CaseLabel = Switch->NodeLabel() + "_case_" + ValueText;
-        
-        ProgramLines.push_back( "mov R1, " + to_string(Value) );
-        ProgramLines.push_back( "ieq R1, R0" );
-        ProgramLines.push_back( "jt R1, " + CaseLabel );
-    }
+    // when no case is matched, go to default if there
+    // is one; otherwise no code will run
+    string DefaultLabel = EndLabel;
     
-    // emit default behavior
     if( Switch->DefaultCase )
-    {
-        string DefaultLabel = Switch->NodeLabel() + "_default";
-        ProgramLines.push_back( "jmp " + DefaultLabel );
-    }
+      DefaultLabel = Switch->NodeLabel() + "_default";
+    
+    // handled cases are already sorted by value
+    vector< int > CaseValues;
+    
+    for( auto Pair: Switch->HandledCases )
+      CaseValues.push_back( Pair.first );
     
-    // when there is no default, if no
-    // case is matched no code will run
-    else ProgramLines.push_back( "jmp " + EndLabel );
+    // jump to the case matching the condition
+    if( CaseValues.empty() )
+      ProgramLines.push_back( "jmp " + DefaultLabel );
+    else
+      EmitSwitchDispatch( Switch, CaseValues, 0, CaseValues.size() - 1, DefaultLabel );
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // now we can emit every statement in the block
@@ -758,11 +950,7 @@ int VirconCEmitter::EmitCase( CaseNode* Case )
     if( !Case->SwitchContext )
       RaiseFatalError( Case->Location, "switch context has not been resolved for \"case\"" );
     
-    // negative values would break the label
-    // so for them just add a "minus" text
-    string ValueText = string(Case->Value < 0? "minus_" : "") + to_string( abs(Case->Value) );
-    string CaseLabel = Case->SwitchContext->NodeLabel() + "_case_" + ValueText;
-    EmitLabel( CaseLabel );
+    EmitLabel( GetCaseLabel( Case->SwitchContext, Case->Value ) );
     
     return 0;
 }
@@ -840,8 +1028,23 @@ int VirconCEmitter::EmitAssemblyBlock( AssemblyBlockNode* AssemblyBlock )
     // add info to determine line correspondence
     AddDebugInfo( AssemblyBlock );
     
+    // the block may modify registers used by variables
+    EmitVariableSaves( AssemblyBlock, false );
+    EmitAssemblyLines( AssemblyBlock );
+    EmitVariableSaves( AssemblyBlock, true );
+    
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void VirconCEmitter::EmitAssemblyLines( AssemblyBlockNode* AssemblyBlock )
+{
     for( auto AssemblyLine: AssemblyBlock->AssemblyLines )
     {
+        // let later stages know this line is not ours
+        AssemblyBlockLines.insert( ProgramLines.size() );
+        
         // lines not containing variables are emitted verbatim
         if( !AssemblyLine.EmbeddedAtom )
         {
@@ -855,13 +1058,242 @@ int VirconCEmitter::EmitAssemblyBlock( AssemblyBlockNode* AssemblyBlock )
         unsigned Length = (CloseBracePosition - OpenBracePosition + 1);
         
         // replace variables with their address
+        // (or their register, if they are kept in one)
         VariableNode* EmbeddedVariable = AssemblyLine.EmbeddedAtom->ResolvedVariable;
         string VariableAddress = "[" + EmbeddedVariable->Placement.AccessAddressString() + "]";
+        
+        if( EmbeddedVariable->Placement.IsInRegister() )
+          VariableAddress = EmbeddedVariable->Placement.RegisterName();
+        
+        // arguments of inlined functions may be constants
+        auto ArgumentValue = InlinedArgumentValues.find( EmbeddedVariable );
+        
+        if( ArgumentValue != InlinedArgumentValues.end() )
+          VariableAddress = ArgumentValue->second;
+        
         string ProcessedLine = AssemblyLine.Text.replace( OpenBracePosition, Length, VariableAddress );
         
         // emit the processed line
         ProgramLines.push_back( ProcessedLine );
     }
+}
+
+
+// =============================================================================
+//      EMIT FUNCTIONS FOR SWITCH DISPATCH
+// =============================================================================
+
+
+// Cases are selected with a jump table when their values are
+// dense enough, which takes the same time for any value. For
+// sparse values, a binary search splits them until each part
+// is dense or small enough: in the worst case it only needs
+// a few comparisons for each time the number of cases doubles.
+
+// below this, comparing each case is faster than a table
+const int SwitchMinimumTableCases = 4;
+
+// tables can have at most this many entries per case
+// (unused values in the range also need an entry)
+const int SwitchMaximumTableEntriesPerCase = 3;
+
+// parts with up to this many cases are compared one by one
+const int SwitchMaximumLinearCases = 3;
+
+// -----------------------------------------------------------------------------
+
+// emits code to jump to the case label for the value in R0
+// (or to the default label), searching only among values
+// in positions First to Last; R0 is kept until a table is used
+void VirconCEmitter::EmitSwitchDispatch( SwitchNode* Switch, const vector< int >& Values, int First, int Last, const string& DefaultLabel )
+{
+    int NumberOfCases = Last - First + 1;
+    int64_t Range = (int64_t)Values[ Last ] - Values[ First ] + 1;
+    
+    // CASE 1: dense values use a jump table
+    // (the lowest integer cannot be offset below)
+    bool TableIsDense = (Range <= (int64_t)NumberOfCases * SwitchMaximumTableEntriesPerCase);
+    
+    if( NumberOfCases >= SwitchMinimumTableCases && TableIsDense && Values[ First ] != INT32_MIN )
+    {
+        EmitSwitchJumpTable( Switch, Values, First, Last, DefaultLabel );
+        return;
+    }
     
-    return 0;
+    // CASE 2: few values are compared one by one
+    if( NumberOfCases <= SwitchMaximumLinearCases )
+    {
+        for( int i = First; i <= Last; i++ )
+        {
+            ProgramLines.push_back( "mov R1, " + to_string( Values[ i ] ) );
+            ProgramLines.push_back( "ieq R1, R0" );
+            ProgramLines.push_back( "jt R1, " + GetCaseLabel( Switch, Values[ i ] ) );
+        }
+        
+        ProgramLines.push_back( "jmp " + DefaultLabel );
+        return;
+    }
+    
+    // CASE 3: otherwise split values in 2 halves,
+    // first searching the upper half (fall-through)
+    int Middle = (First + Last + 1) / 2;
+    string LowerHalfLabel = Switch->NodeLabel() + "_search_" + to_string( First ) + "_" + to_string( Middle - 1 );
+    
+    ProgramLines.push_back( "mov R1, R0" );
+    ProgramLines.push_back( "ilt R1, " + to_string( Values[ Middle ] ) );
+    ProgramLines.push_back( "jt R1, " + LowerHalfLabel );
+    EmitSwitchDispatch( Switch, Values, Middle, Last, DefaultLabel );
+    
+    EmitLabel( LowerHalfLabel );
+    EmitSwitchDispatch( Switch, Values, First, Middle - 1, DefaultLabel );
+}
+
+// -----------------------------------------------------------------------------
+
+// the table has an entry for each value in the range, plus
+// one at each end for values out of range; R0 is clamped to
+// the table limits instead of checking them with jumps
+void VirconCEmitter::EmitSwitchJumpTable( SwitchNode* Switch, const vector< int >& Values, int First, int Last, const string& DefaultLabel )
+{
+    string TableLabel = Switch->NodeLabel() + "_table_" + to_string( First );
+    int32_t TableEntries = Values[ Last ] - Values[ First ] + 3;
+    
+    // place lowest value at table entry 1
+    int32_t Offset = Values[ First ] - 1;
+    
+    if( Offset > 0 )
+      ProgramLines.push_back( "isub R0, " + to_string( Offset ) );
+    
+    else if( Offset < 0 )
+      ProgramLines.push_back( "iadd R0, " + to_string( -(int64_t)Offset ) );
+    
+    // clamp, so that values out of range use the end entries
+    ProgramLines.push_back( "imax R0, 0" );
+    ProgramLines.push_back( "imin R0, " + to_string( TableEntries - 1 ) );
+    
+    // read the table entry and jump to it
+    ProgramLines.push_back( "mov R1, " + TableLabel );
+    ProgramLines.push_back( "iadd R0, R1" );
+    ProgramLines.push_back( "mov R0, [R0]" );
+    ProgramLines.push_back( "jmp R0" );
+    
+    // data section: emit the table label
+    DataLines.push_back( TableLabel + ":" );
+    
+    // data section: emit the table, with values not handled
+    // going to default (write a few entries on each line)
+    int NextCase = First;
+    string TableLine;
+    
+    for( int32_t Entry = 0; Entry < TableEntries; Entry++ )
+    {
+        int64_t Value = (int64_t)Offset + Entry;
+        string EntryLabel = DefaultLabel;
+        
+        if( NextCase <= Last && Values[ NextCase ] == Value )
+        {
+            EntryLabel = GetCaseLabel( Switch, Values[ NextCase ] );
+            NextCase++;
+        }
+        
+        TableLine += (TableLine.empty()? "pointer " : ", ") + EntryLabel;
+        
+        if( (Entry % 8) == 7 || Entry == TableEntries - 1 )
+        {
+            DataLines.push_back( TableLine );
+            TableLine.clear();
+        }
+    }
+}
+
+
+// =============================================================================
+//      EMIT FUNCTIONS FOR BLOCK OPERATIONS
+// =============================================================================
+
+
+// emits a for loop recognized by IsBlockOperationLoop: all
+// elements are copied with MOVS or filled with SETS at once,
+// skipping when there are none, and the index is left with
+// the same final value that the loop would give it
+int VirconCEmitter::EmitBlockOperationLoop( ForNode* For, BinaryOperationNode* Assignment, ExpressionNode* Limit, bool LimitIsIncluded )
+{
+    ArrayAccessNode* Destination = (ArrayAccessNode*)Unenclosed( Assignment->LeftOperand );
+    ExpressionNode* Index = Destination->IndexOperand;
+    ExpressionNode* Value = Unenclosed( Assignment->RightOperand );
+    int ElementSize = Destination->ReturnedType->SizeInWords();
+    string EndLabel = For->NodeLabel() + "_end";
+    
+    // initial action
+    int HighestRegister = EmitCNode( For->InitialAction );
+    
+    RegisterAllocation Registers( For->Location );
+    LocalVariableRegisters.ReserveRegisters( Registers );
+    
+    // block operations need these registers
+    Registers.RegisterUsed[ (int)CPURegisters::CountRegister ] = true;
+    Registers.RegisterUsed[ (int)CPURegisters::SourceRegister ] = true;
+    Registers.RegisterUsed[ (int)CPURegisters::DestinationRegister ] = true;
+    
+    // count the elements, and skip when there are none
+    // (MOVS and SETS always process at least 1 word)
+    int CountRegister = Registers.FirstFreeRegister();
+    string CountRegisterName = "R" + to_string( CountRegister );
+    EmitDependentExpression( Limit, Registers, CountRegister );
+    
+    int IndexRegister = EmitOperandRegister( Index, Registers, false );
+    ProgramLines.push_back( "isub " + CountRegisterName + ", R" + to_string( IndexRegister ) );
+    Registers.RegisterUsed[ IndexRegister ] = false;
+    
+    if( LimitIsIncluded )
+      ProgramLines.push_back( "iadd " + CountRegisterName + ", 1" );
+    
+    int TestRegister = Registers.FirstFreeRegister();
+    string TestRegisterName = "R" + to_string( TestRegister );
+    ProgramLines.push_back( "mov " + TestRegisterName + ", " + CountRegisterName );
+    ProgramLines.push_back( "igt " + TestRegisterName + ", 0" );
+    ProgramLines.push_back( "jf " + TestRegisterName + ", " + EndLabel );
+    Registers.RegisterUsed[ TestRegister ] = false;
+    
+    if( ElementSize != 1 )
+      ProgramLines.push_back( "imul " + CountRegisterName + ", " + to_string( ElementSize ) );
+    
+    ProgramLines.push_back( "mov CR, " + CountRegisterName );
+    Registers.RegisterUsed[ CountRegister ] = false;
+    
+    // the first element is at the start index
+    EmitExpressionPlacement( Destination, Registers, (int)CPURegisters::DestinationRegister );
+    
+    if( Value->Type() == CNodeTypes::ArrayAccess )
+    {
+        EmitExpressionPlacement( Value, Registers, (int)CPURegisters::SourceRegister );
+        ProgramLines.push_back( "movs" );
+    }
+    
+    else
+    {
+        EmitDependentExpression( Value, Registers, (int)CPURegisters::SourceRegister );
+        EmitRegisterTypeConversion( (int)CPURegisters::SourceRegister, Value->ReturnedType, Destination->ReturnedType );
+        ProgramLines.push_back( "sets" );
+    }
+    
+    // an index declared outside of the loop
+    // keeps the value that ended the loop
+    if( For->InitialAction->Type() != CNodeTypes::VariableList )
+    {
+        int FinalRegister = Registers.FirstFreeRegister();
+        EmitDependentExpression( Limit, Registers, FinalRegister );
+        
+        if( LimitIsIncluded )
+          ProgramLines.push_back( "iadd R" + to_string( FinalRegister ) + ", 1" );
+        
+        BinaryOperationNode* Initialization = (BinaryOperationNode*)Unenclosed( (ExpressionNode*)For->InitialAction );
+        EmitComplementaryAssignment( Initialization, Registers, FinalRegister );
+        Registers.RegisterUsed[ FinalRegister ] = false;
+    }
+    
+    // mark loop end
+    EmitLabel( EndLabel );
+    
+    return max( HighestRegister, Registers.HighestUsedRegister );
 }
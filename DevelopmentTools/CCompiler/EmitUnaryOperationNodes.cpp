@@ -65,8 +65,17 @@ void VirconCEmitter::EmitPreIncrement( UnaryOperationNode* UnaryOperation, Regis
     // convert register to string
     string ResultRegisterName = "R" + to_string(ResultRegister);
     
+    // optimized case: operand kept in a register
+    if( VariableRegister( UnaryOperation->Operand ) )
+    {
+        string OperandRegisterName = "R" + to_string( VariableRegister( UnaryOperation->Operand ) );
+        
+        ProgramLines.push_back( Instruction + " " + OperandRegisterName + ", " + Value );
+        ProgramLines.push_back( "mov " + ResultRegisterName + ", " + OperandRegisterName );
+    }
+    
     // optimized case: operand with static placement
-    if( UnaryOperation->Operand->HasStaticPlacement() )
+    else if( UnaryOperation->Operand->HasStaticPlacement() )
     {
         MemoryPlacement OperandPlacement = UnaryOperation->Operand->GetStaticPlacement();
         
@@ -125,8 +134,17 @@ void VirconCEmitter::EmitPreDecrement( UnaryOperationNode* UnaryOperation, Regis
     // convert register to string
     string ResultRegisterName = "R" + to_string(ResultRegister);
     
+    // optimized case: operand kept in a register
+    if( VariableRegister( UnaryOperation->Operand ) )
+    {
+        string OperandRegisterName = "R" + to_string( VariableRegister( UnaryOperation->Operand ) );
+        
+        ProgramLines.push_back( Instruction + " " + OperandRegisterName + ", " + Value );
+        ProgramLines.push_back( "mov " + ResultRegisterName + ", " + OperandRegisterName );
+    }
+    
     // optimized case: operand with static placement
-    if( UnaryOperation->Operand->HasStaticPlacement() )
+    else if( UnaryOperation->Operand->HasStaticPlacement() )
     {
         MemoryPlacement OperandPlacement = UnaryOperation->Operand->GetStaticPlacement();
         
@@ -185,6 +203,17 @@ void VirconCEmitter::EmitPostIncrement( UnaryOperationNode* UnaryOperation, Regi
     // convert register to string
     string ResultRegisterName = "R" + to_string(ResultRegister);
     
+    // optimized case: operand kept in a register
+    // (the initial value is copied to the result first)
+    if( VariableRegister( UnaryOperation->Operand ) )
+    {
+        string OperandRegisterName = "R" + to_string( VariableRegister( UnaryOperation->Operand ) );
+        
+        ProgramLines.push_back( "mov " + ResultRegisterName + ", " + OperandRegisterName );
+        ProgramLines.push_back( Instruction + " " + OperandRegisterName + ", " + Value );
+        return;
+    }
+    
     // reserve a register to do the increment
     // (needed since the initial value must be returned)
     int IncrementRegister = Registers.FirstFreeRegister();
@@ -260,6 +289,17 @@ void VirconCEmitter::EmitPostDecrement( UnaryOperationNode* UnaryOperation, Regi
     // convert register to string
     string ResultRegisterName = "R" + to_string(ResultRegister);
     
+    // optimized case: operand kept in a register
+    // (the initial value is copied to the result first)
+    if( VariableRegister( UnaryOperation->Operand ) )
+    {
+        string OperandRegisterName = "R" + to_string( VariableRegister( UnaryOperation->Operand ) );
+        
+        ProgramLines.push_back( "mov " + ResultRegisterName + ", " + OperandRegisterName );
+        ProgramLines.push_back( Instruction + " " + OperandRegisterName + ", " + Value );
+        return;
+    }
+    
     // reserve a register to do the decrement
     // (needed since the initial value must be returned)
     int DecrementRegister = Registers.FirstFreeRegister();
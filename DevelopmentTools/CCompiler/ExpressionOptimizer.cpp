@@ -0,0 +1,1913 @@
+// *****************************************************************************
+    // include project headers
+    #include "ExpressionOptimizer.hpp"
+    
+    // include C/C++ headers
+    #include <cstdlib>          // [ ANSI C ] General utilities
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+ExpressionNode* Unenclosed( ExpressionNode* Expression )
+{
+    while( Expression->Type() == CNodeTypes::EnclosedExpression )
+      Expression = ((EnclosedExpressionNode*)Expression)->InternalExpression;
+    
+    return Expression;
+}
+
+// -----------------------------------------------------------------------------
+
+static bool IsIntExpression( ExpressionNode* Expression )
+{
+    return TypeIsThisPrimitive( Expression->ReturnedType, PrimitiveTypes::Int );
+}
+
+// -----------------------------------------------------------------------------
+
+// (assignments are the last binary operators)
+bool IsAssignment( BinaryOperators Operator )
+{
+    return (Operator >= BinaryOperators::Assignment);
+}
+
+// -----------------------------------------------------------------------------
+
+bool IsIncrementOrDecrement( UnaryOperators Operator )
+{
+    return (Operator == UnaryOperators::PreIncrement
+        ||  Operator == UnaryOperators::PreDecrement
+        ||  Operator == UnaryOperators::PostIncrement
+        ||  Operator == UnaryOperators::PostDecrement);
+}
+
+// -----------------------------------------------------------------------------
+
+// the operation done by a compound assignment
+bool GetCompoundOperation( BinaryOperators Operator, BinaryOperators& Operation )
+{
+    switch( Operator )
+    {
+        case BinaryOperators::AdditionAssignment:    Operation = BinaryOperators::Addition;    return true;
+        case BinaryOperators::SubtractionAssignment: Operation = BinaryOperators::Subtraction; return true;
+        case BinaryOperators::ProductAssignment:     Operation = BinaryOperators::Product;     return true;
+        case BinaryOperators::DivisionAssignment:    Operation = BinaryOperators::Division;    return true;
+        case BinaryOperators::ModulusAssignment:     Operation = BinaryOperators::Modulus;     return true;
+        case BinaryOperators::BitwiseAndAssignment:  Operation = BinaryOperators::BitwiseAnd;  return true;
+        case BinaryOperators::BitwiseOrAssignment:   Operation = BinaryOperators::BitwiseOr;   return true;
+        case BinaryOperators::BitwiseXorAssignment:  Operation = BinaryOperators::BitwiseXor;  return true;
+        case BinaryOperators::ShiftLeftAssignment:   Operation = BinaryOperators::ShiftLeft;   return true;
+        case BinaryOperators::ShiftRightAssignment:  Operation = BinaryOperators::ShiftRight;  return true;
+        default: return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// variable directly named by an expression, if any
+VariableNode* NamedVariable( ExpressionNode* Expression )
+{
+    Expression = Unenclosed( Expression );
+    
+    if( Expression->Type() != CNodeTypes::ExpressionAtom )
+      return nullptr;
+    
+    ExpressionAtomNode* Atom = (ExpressionAtomNode*)Expression;
+    
+    if( Atom->AtomType != AtomTypes::Variable )
+      return nullptr;
+    
+    return Atom->ResolvedVariable;
+}
+
+// -----------------------------------------------------------------------------
+
+// tells if an expression is a constant with the given
+// value (bools are excluded, since they are not numbers)
+static bool HasStaticValue( ExpressionNode* Expression, int32_t Value )
+{
+    if( !Expression->IsStatic() )
+      return false;
+    
+    if( TypeIsThisPrimitive( Expression->ReturnedType, PrimitiveTypes::Int ) )
+      return (Expression->GetStaticValue().Word.AsInteger == Value);
+    
+    if( TypeIsThisPrimitive( Expression->ReturnedType, PrimitiveTypes::Float ) )
+      return (Expression->GetStaticValue().Word.AsFloat == Value);
+    
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+// the emitter evaluates static divisions, so replacing
+// variables must not create any that divide by zero
+bool DividesByStaticZero( ExpressionNode* Expression )
+{
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::FunctionCall:
+        {
+            for( ExpressionNode* Parameter: ((FunctionCallNode*)Expression)->Parameters )
+              if( DividesByStaticZero( Parameter ) )
+                return true;
+            
+            return false;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+            return DividesByStaticZero( ((ArrayAccessNode*)Expression)->ArrayOperand )
+                || DividesByStaticZero( ((ArrayAccessNode*)Expression)->IndexOperand );
+        
+        case CNodeTypes::UnaryOperation:
+            return DividesByStaticZero( ((UnaryOperationNode*)Expression)->Operand );
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* Operation = (BinaryOperationNode*)Expression;
+            
+            if( DividesByStaticZero( Operation->LeftOperand )
+            ||  DividesByStaticZero( Operation->RightOperand ) )
+              return true;
+            
+            bool IsDivision = (Operation->Operator == BinaryOperators::Division
+                           ||  Operation->Operator == BinaryOperators::Modulus
+                           ||  Operation->Operator == BinaryOperators::DivisionAssignment
+                           ||  Operation->Operator == BinaryOperators::ModulusAssignment);
+            
+            if( !IsDivision || !Operation->RightOperand->IsStatic() )
+              return false;
+            
+            StaticValue Divisor = Operation->RightOperand->GetStaticValue();
+            
+            if( Divisor.Word.AsInteger == 0 )
+              return true;
+            
+            return (TypeIsThisPrimitive( Operation->RightOperand->ReturnedType, PrimitiveTypes::Float )
+                &&  Divisor.Word.AsFloat == 0);
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+            return DividesByStaticZero( ((EnclosedExpressionNode*)Expression)->InternalExpression );
+        
+        case CNodeTypes::MemberAccess:
+            return DividesByStaticZero( ((MemberAccessNode*)Expression)->GroupOperand );
+        
+        case CNodeTypes::PointedMemberAccess:
+            return DividesByStaticZero( ((PointedMemberAccessNode*)Expression)->GroupOperand );
+        
+        case CNodeTypes::TypeConversion:
+            return DividesByStaticZero( ((TypeConversionNode*)Expression)->ConvertedExpression );
+        
+        default:
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// finds which variables a part of the code declares,
+// reads or assigns, and which ones are used by address
+void FindVariableUses( CNode* Node, VariableUses& Uses, VariableAccesses Access )
+{
+    // some contructs have optional parts!
+    if( !Node ) return;
+    
+    switch( Node->Type() )
+    {
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // expressions
+        case CNodeTypes::ExpressionAtom:
+        {
+            VariableNode* Variable = NamedVariable( (ExpressionNode*)Node );
+            
+            if( !Variable )
+              break;
+            
+            if( Access == VariableAccesses::Address )
+              Uses.AccessedByAddress.insert( Variable );
+            
+            if( Access == VariableAccesses::Write || Access == VariableAccesses::ReadWrite )
+              Uses.Assigned.insert( Variable );
+            
+            if( Access != VariableAccesses::Write )
+              Uses.Reads[ Variable ]++;
+            
+            break;
+        }
+        
+        case CNodeTypes::FunctionCall:
+        {
+            for( ExpressionNode* Parameter: ((FunctionCallNode*)Node)->Parameters )
+              FindVariableUses( Parameter, Uses );
+            
+            break;
+        }
+        
+        // arrays and structures are accessed in
+        // place, so their access type is kept
+        case CNodeTypes::ArrayAccess:
+            FindVariableUses( ((ArrayAccessNode*)Node)->ArrayOperand, Uses, Access );
+            FindVariableUses( ((ArrayAccessNode*)Node)->IndexOperand, Uses );
+            break;
+        
+        case CNodeTypes::MemberAccess:
+            FindVariableUses( ((MemberAccessNode*)Node)->GroupOperand, Uses, Access );
+            break;
+        
+        case CNodeTypes::PointedMemberAccess:
+            FindVariableUses( ((PointedMemberAccessNode*)Node)->GroupOperand, Uses );
+            break;
+        
+        case CNodeTypes::EnclosedExpression:
+            FindVariableUses( ((EnclosedExpressionNode*)Node)->InternalExpression, Uses, Access );
+            break;
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* Operation = (UnaryOperationNode*)Node;
+            
+            if( Operation->Operator == UnaryOperators::Reference )
+              FindVariableUses( Operation->Operand, Uses, VariableAccesses::Address );
+            
+            else if( IsIncrementOrDecrement( Operation->Operator ) )
+              FindVariableUses( Operation->Operand, Uses, VariableAccesses::ReadWrite );
+            
+            else
+              FindVariableUses( Operation->Operand, Uses );
+            
+            break;
+        }
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* Operation = (BinaryOperationNode*)Node;
+            
+            if( Operation->Operator == BinaryOperators::Assignment )
+              FindVariableUses( Operation->LeftOperand, Uses, VariableAccesses::Write );
+            
+            else if( IsAssignment( Operation->Operator ) )
+              FindVariableUses( Operation->LeftOperand, Uses, VariableAccesses::ReadWrite );
+            
+            else
+              FindVariableUses( Operation->LeftOperand, Uses );
+            
+            FindVariableUses( Operation->RightOperand, Uses );
+            break;
+        }
+        
+        case CNodeTypes::TypeConversion:
+            FindVariableUses( ((TypeConversionNode*)Node)->ConvertedExpression, Uses );
+            break;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // declarations
+        case CNodeTypes::Function:
+        {
+            FunctionNode* Function = (FunctionNode*)Node;
+            
+            for( VariableNode* Argument: Function->Arguments )
+              Uses.Declared.insert( Argument );
+            
+            for( CNode* Statement: Function->Statements )
+              FindVariableUses( Statement, Uses );
+            
+            break;
+        }
+        
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Node)->Variables )
+            {
+                Uses.Declared.insert( Variable );
+                
+                if( Variable->InitialValue )
+                {
+                    Uses.Assigned.insert( Variable );
+                    FindVariableUses( Variable->InitialValue, Uses );
+                }
+            }
+            
+            break;
+        }
+        
+        case CNodeTypes::InitializationList:
+        {
+            for( CNode* Value: ((InitializationListNode*)Node)->AssignedValues )
+              FindVariableUses( Value, Uses );
+            
+            break;
+        }
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // statements
+        case CNodeTypes::Block:
+        {
+            for( CNode* Statement: ((BlockNode*)Node)->Statements )
+              FindVariableUses( Statement, Uses );
+            
+            break;
+        }
+        
+        case CNodeTypes::Switch:
+        {
+            SwitchNode* Switch = (SwitchNode*)Node;
+            FindVariableUses( Switch->Condition, Uses );
+            
+            for( CNode* Statement: Switch->Statements )
+              FindVariableUses( Statement, Uses );
+            
+            break;
+        }
+        
+        case CNodeTypes::If:
+            FindVariableUses( ((IfNode*)Node)->Condition, Uses );
+            FindVariableUses( ((IfNode*)Node)->TrueStatement, Uses );
+            FindVariableUses( ((IfNode*)Node)->FalseStatement, Uses );
+            break;
+        
+        case CNodeTypes::While:
+            FindVariableUses( ((WhileNode*)Node)->Condition, Uses );
+            FindVariableUses( ((WhileNode*)Node)->LoopStatement, Uses );
+            break;
+        
+        case CNodeTypes::Do:
+            FindVariableUses( ((DoNode*)Node)->LoopStatement, Uses );
+            FindVariableUses( ((DoNode*)Node)->Condition, Uses );
+            break;
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Node;
+            FindVariableUses( For->InitialAction, Uses );
+            FindVariableUses( For->Condition, Uses );
+            FindVariableUses( For->LoopStatement, Uses );
+            FindVariableUses( For->IterationAction, Uses );
+            break;
+        }
+        
+        case CNodeTypes::Return:
+            FindVariableUses( ((ReturnNode*)Node)->ReturnedExpression, Uses );
+            break;
+        
+        // asm code can do anything with its variables
+        case CNodeTypes::AssemblyBlock:
+        {
+            for( auto& AssemblyLine: ((AssemblyBlockNode*)Node)->AssemblyLines )
+              FindVariableUses( AssemblyLine.EmbeddedAtom, Uses, VariableAccesses::Address );
+            
+            break;
+        }
+        
+        // other nodes don't use variables
+        // (sizeof does not evaluate its operand)
+        default:
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// only local variables of primitive types are
+// optimized, if their address is never taken
+void FindOptimizedVariables( FunctionNode* Function, set< VariableNode* >& OptimizedVariables )
+{
+    VariableUses Uses;
+    FindVariableUses( Function, Uses );
+    
+    for( VariableNode* Variable: Uses.Declared )
+      if( Variable->DeclaredType->Type() == DataTypes::Primitive && !Variable->IsExtern
+      &&  !Uses.AccessedByAddress.count( Variable ) )
+        OptimizedVariables.insert( Variable );
+}
+
+// -----------------------------------------------------------------------------
+
+// A for loop that only copies consecutive array elements,
+// or sets all of them to the same value, can be done with a
+// single MOVS or SETS instruction. Loops are recognized when
+// an int variable goes up by 1 from any start to a limit and
+// is used as the index of every accessed element:
+//   for( i = S; i < N; i++ )  D[ i ] = Source[ i ];
+//   for( i = S; i < N; i++ )  D[ i ] = Value;
+// Since these instructions process elements in the same
+// order as the loop, the result is the same even if both
+// arrays overlap. Values that the loop reads on every step
+// can only be kept the same if writes through a pointer
+// cannot change them.
+
+// tells if an expression is the address of consecutive array
+// elements: a named array or pointer, or an array within one
+// of those selected by a constant or a variable; the root
+// variable and the ones that select it are returned
+static VariableNode* FindElementsRoot( ExpressionNode* Expression, VariableNode* Index, set< VariableNode* >& SelectingVariables )
+{
+    Expression = Unenclosed( Expression );
+    
+    if( Expression->Type() == CNodeTypes::ArrayAccess )
+    {
+        ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Expression;
+        
+        if( ArrayAccess->ArrayOperand->ReturnedType->Type() != DataTypes::Array )
+          return nullptr;
+        
+        if( !ArrayAccess->IndexOperand->IsStatic() )
+        {
+            VariableNode* Selector = NamedVariable( ArrayAccess->IndexOperand );
+            
+            if( !Selector || Selector == Index )
+              return nullptr;
+            
+            SelectingVariables.insert( Selector );
+        }
+        
+        return FindElementsRoot( ArrayAccess->ArrayOperand, Index, SelectingVariables );
+    }
+    
+    VariableNode* Root = NamedVariable( Expression );
+    
+    if( !Root || Root == Index )
+      return nullptr;
+    
+    DataTypes RootType = Root->DeclaredType->Type();
+    
+    if( RootType != DataTypes::Array && RootType != DataTypes::Pointer )
+      return nullptr;
+    
+    return Root;
+}
+
+// -----------------------------------------------------------------------------
+
+// tells if an expression is an int constant or a named
+// int variable different from the loop index
+static bool IsSimpleLimit( ExpressionNode* Limit, VariableNode* Index )
+{
+    if( !TypeIsThisPrimitive( Limit->ReturnedType, PrimitiveTypes::Int ) )
+      return false;
+    
+    if( Limit->IsStatic() )
+      return true;
+    
+    VariableNode* Variable = NamedVariable( Limit );
+    return (Variable && Variable != Index);
+}
+
+// -----------------------------------------------------------------------------
+
+// tells if a for loop can be done with a block operation;
+// if so, the body assignment and the index limit are given
+bool IsBlockOperationLoop( ForNode* For, BinaryOperationNode*& Assignment, ExpressionNode*& Limit, bool& LimitIsIncluded )
+{
+    if( !For->InitialAction || !For->Condition || !For->IterationAction || !For->LoopStatement )
+      return false;
+    
+    // the body is a single assignment to an array element
+    CNode* Body = For->LoopStatement;
+    
+    if( Body->Type() == CNodeTypes::Block )
+    {
+        list< CNode* >& Statements = ((BlockNode*)Body)->Statements;
+        
+        if( Statements.size() != 1 )
+          return false;
+        
+        Body = Statements.front();
+    }
+    
+    if( !Body->IsExpression() )
+      return false;
+    
+    ExpressionNode* Statement = Unenclosed( (ExpressionNode*)Body );
+    
+    if( Statement->Type() != CNodeTypes::BinaryOperation )
+      return false;
+    
+    Assignment = (BinaryOperationNode*)Statement;
+    
+    if( Assignment->Operator != BinaryOperators::Assignment )
+      return false;
+    
+    ExpressionNode* Left = Unenclosed( Assignment->LeftOperand );
+    
+    if( Left->Type() != CNodeTypes::ArrayAccess )
+      return false;
+    
+    ArrayAccessNode* Destination = (ArrayAccessNode*)Left;
+    VariableNode* Index = NamedVariable( Destination->IndexOperand );
+    
+    if( !Index || !TypeIsThisPrimitive( Index->DeclaredType, PrimitiveTypes::Int ) )
+      return false;
+    
+    // the index gets its start value
+    if( For->InitialAction->Type() == CNodeTypes::VariableList )
+    {
+        VariableListNode* VariableList = (VariableListNode*)For->InitialAction;
+        
+        if( VariableList->Variables.size() != 1 || VariableList->Variables.front() != Index )
+          return false;
+        
+        if( !VariableList->Variables.front()->InitialValue )
+          return false;
+    }
+    
+    else
+    {
+        if( !For->InitialAction->IsExpression() )
+          return false;
+        
+        ExpressionNode* InitialAction = Unenclosed( (ExpressionNode*)For->InitialAction );
+        
+        if( InitialAction->Type() != CNodeTypes::BinaryOperation )
+          return false;
+        
+        BinaryOperationNode* Initialization = (BinaryOperationNode*)InitialAction;
+        
+        if( Initialization->Operator != BinaryOperators::Assignment || NamedVariable( Initialization->LeftOperand ) != Index )
+          return false;
+    }
+    
+    // the index goes up by 1
+    ExpressionNode* IterationAction = Unenclosed( For->IterationAction );
+    
+    if( IterationAction->Type() == CNodeTypes::UnaryOperation )
+    {
+        UnaryOperationNode* Increment = (UnaryOperationNode*)IterationAction;
+        
+        if( Increment->Operator != UnaryOperators::PreIncrement && Increment->Operator != UnaryOperators::PostIncrement )
+          return false;
+        
+        if( NamedVariable( Increment->Operand ) != Index )
+          return false;
+    }
+    
+    else if( IterationAction->Type() == CNodeTypes::BinaryOperation )
+    {
+        BinaryOperationNode* Increment = (BinaryOperationNode*)IterationAction;
+        
+        if( Increment->Operator != BinaryOperators::AdditionAssignment || NamedVariable( Increment->LeftOperand ) != Index )
+          return false;
+        
+        if( !Increment->RightOperand->IsStatic() || !TypeIsThisPrimitive( Increment->RightOperand->ReturnedType, PrimitiveTypes::Int ) )
+          return false;
+        
+        if( Increment->RightOperand->GetStaticValue().Word.AsInteger != 1 )
+          return false;
+    }
+    
+    else return false;
+    
+    // the index is compared with its limit
+    ExpressionNode* ConditionExpression = Unenclosed( For->Condition );
+    
+    if( ConditionExpression->Type() != CNodeTypes::BinaryOperation )
+      return false;
+    
+    BinaryOperationNode* Condition = (BinaryOperationNode*)ConditionExpression;
+    BinaryOperators Comparison = Condition->Operator;
+    
+    if( (Comparison == BinaryOperators::LessThan || Comparison == BinaryOperators::LessOrEqual)
+    &&  NamedVariable( Condition->LeftOperand ) == Index )
+      Limit = Condition->RightOperand;
+    
+    else if( (Comparison == BinaryOperators::GreaterThan || Comparison == BinaryOperators::GreaterOrEqual)
+    &&  NamedVariable( Condition->RightOperand ) == Index )
+      Limit = Condition->LeftOperand;
+    
+    else return false;
+    
+    LimitIsIncluded = (Comparison == BinaryOperators::LessOrEqual || Comparison == BinaryOperators::GreaterOrEqual);
+    
+    if( !IsSimpleLimit( Limit, Index ) )
+      return false;
+    
+    // values read on every step of the loop
+    set< VariableNode* > ReadVariables;
+    ReadVariables.insert( Index );
+    
+    if( !Limit->IsStatic() )
+      ReadVariables.insert( NamedVariable( Limit ) );
+    
+    // find the destination elements
+    VariableNode* DestinationRoot = FindElementsRoot( Destination->ArrayOperand, Index, ReadVariables );
+    
+    if( !DestinationRoot )
+      return false;
+    
+    // copies need the same type on both sides
+    ExpressionNode* Right = Unenclosed( Assignment->RightOperand );
+    
+    if( Right->Type() == CNodeTypes::ArrayAccess )
+    {
+        ArrayAccessNode* Source = (ArrayAccessNode*)Right;
+        
+        if( NamedVariable( Source->IndexOperand ) != Index )
+          return false;
+        
+        VariableNode* SourceRoot = FindElementsRoot( Source->ArrayOperand, Index, ReadVariables );
+        
+        if( !SourceRoot )
+          return false;
+        
+        if( SourceRoot->DeclaredType->Type() == DataTypes::Pointer )
+          ReadVariables.insert( SourceRoot );
+        
+        if( Source->ReturnedType->ToString() != Destination->ReturnedType->ToString() )
+          return false;
+    }
+    
+    // fills can only set single words
+    else
+    {
+        if( Destination->ReturnedType->SizeInWords() != 1 )
+          return false;
+        
+        if( Right->ReturnedType->Type() != DataTypes::Primitive && Right->ReturnedType->Type() != DataTypes::Pointer )
+          return false;
+        
+        if( !Right->IsStatic() )
+        {
+            VariableNode* Value = NamedVariable( Right );
+            
+            if( !Value || Value == Index )
+              return false;
+            
+            ReadVariables.insert( Value );
+        }
+    }
+    
+    // named arrays can only be written within their
+    // elements, but pointers could write anywhere
+    if( DestinationRoot->DeclaredType->Type() != DataTypes::Pointer )
+      return true;
+    
+    ReadVariables.insert( DestinationRoot );
+    CNode* Function = For->Parent;
+    
+    while( Function && Function->Type() != CNodeTypes::Function )
+      Function = Function->Parent;
+    
+    if( !Function )
+      return false;
+    
+    VariableUses Uses;
+    FindVariableUses( Function, Uses );
+    
+    for( VariableNode* Variable: ReadVariables )
+      if( !Uses.Declared.count( Variable ) || Variable->IsExtern || Uses.AccessedByAddress.count( Variable ) )
+        return false;
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+ExpressionAtomNode* NewLiteral( const StaticValue& Value, CNode* Parent, const SourceLocation& Location )
+{
+    ExpressionAtomNode* Atom = new ExpressionAtomNode( Parent );
+    Atom->Location = Location;
+    
+    if( Value.Type == PrimitiveTypes::Float )
+    {
+        Atom->AtomType = AtomTypes::LiteralFloat;
+        Atom->FloatValue = Value.Word.AsFloat;
+    }
+    
+    else if( Value.Type == PrimitiveTypes::Bool )
+    {
+        Atom->AtomType = AtomTypes::LiteralBoolean;
+        Atom->BoolValue = (Value.Word.AsInteger != 0);
+    }
+    
+    else
+    {
+        Atom->AtomType = AtomTypes::LiteralInteger;
+        Atom->IntValue = Value.Word.AsInteger;
+    }
+    
+    Atom->DetermineReturnedType();
+    return Atom;
+}
+
+// -----------------------------------------------------------------------------
+
+ExpressionAtomNode* NewVariableAtom( VariableNode* Variable, CNode* Parent, const SourceLocation& Location )
+{
+    ExpressionAtomNode* Atom = new ExpressionAtomNode( Parent );
+    Atom->Location = Location;
+    Atom->AtomType = AtomTypes::Variable;
+    Atom->IdentifierName = Variable->Name;
+    Atom->ResolvedVariable = Variable;
+    Atom->DetermineReturnedType();
+    return Atom;
+}
+
+// -----------------------------------------------------------------------------
+
+BinaryOperationNode* NewBinaryOperation( BinaryOperators Operator, ExpressionNode* Left, ExpressionNode* Right, CNode* Parent, const SourceLocation& Location )
+{
+    BinaryOperationNode* Operation = new BinaryOperationNode( Parent );
+    Operation->Location = Location;
+    Operation->Operator = Operator;
+    Operation->LeftOperand = Left;
+    Operation->RightOperand = Right;
+    Left->Parent = Operation;
+    Right->Parent = Operation;
+    Operation->DetermineReturnedType();
+    return Operation;
+}
+
+// -----------------------------------------------------------------------------
+
+static UnaryOperationNode* NewNegation( ExpressionNode* Operand, CNode* Parent, const SourceLocation& Location )
+{
+    UnaryOperationNode* Operation = new UnaryOperationNode( Parent );
+    Operation->Location = Location;
+    Operation->Operator = UnaryOperators::MinusSign;
+    Operation->Operand = Operand;
+    Operand->Parent = Operation;
+    Operation->DetermineReturnedType();
+    return Operation;
+}
+
+// -----------------------------------------------------------------------------
+
+// replaces an expression with one of its parts
+// (which is detached so that it is not deleted)
+static ExpressionNode* ReplaceWithPart( ExpressionNode* Expression, ExpressionNode*& Part )
+{
+    ExpressionNode* Result = Part;
+    Part = nullptr;
+    
+    Result->Parent = Expression->Parent;
+    delete Expression;
+    return Result;
+}
+
+// -----------------------------------------------------------------------------
+
+// deletes an operation whose operands are used elsewhere
+static void DeleteWithoutOperands( ExpressionNode* Operation )
+{
+    if( Operation->Type() == CNodeTypes::UnaryOperation )
+      ((UnaryOperationNode*)Operation)->Operand = nullptr;
+    
+    else if( Operation->Type() == CNodeTypes::BinaryOperation )
+    {
+        ((BinaryOperationNode*)Operation)->LeftOperand = nullptr;
+        ((BinaryOperationNode*)Operation)->RightOperand = nullptr;
+    }
+    
+    else if( Operation->Type() == CNodeTypes::EnclosedExpression )
+      ((EnclosedExpressionNode*)Operation)->InternalExpression = nullptr;
+    
+    delete Operation;
+}
+
+// -----------------------------------------------------------------------------
+
+// an int expression made of additions, subtractions,
+// negations and products by constants is a sum of terms
+// with constant factors; this finds them, and also the
+// operations that are no longer needed when written so
+// (int operations wrap around, so all of this is exact)
+typedef struct
+{
+    ExpressionNode* Term;
+    int32_t Factor;
+}
+ScaledTerm;
+
+typedef struct
+{
+    std::vector< ScaledTerm > Terms;
+    uint32_t Constant;
+    std::vector< ExpressionNode* > Operations;
+    std::vector< ExpressionNode* > Constants;
+    int NumberOfOperations;
+}
+TermDecomposition;
+
+static void DecomposeTerms( ExpressionNode* Expression, uint32_t Factor, TermDecomposition& Result )
+{
+    if( Expression->IsStatic() )
+    {
+        Result.Constant += Factor * (uint32_t)Expression->GetStaticValue().Word.AsInteger;
+        Result.Constants.push_back( Expression );
+        return;
+    }
+    
+    if( Expression->Type() == CNodeTypes::EnclosedExpression )
+    {
+        Result.Operations.push_back( Expression );
+        DecomposeTerms( ((EnclosedExpressionNode*)Expression)->InternalExpression, Factor, Result );
+        return;
+    }
+    
+    if( Expression->Type() == CNodeTypes::UnaryOperation )
+    {
+        UnaryOperationNode* Operation = (UnaryOperationNode*)Expression;
+        
+        if( Operation->Operator == UnaryOperators::MinusSign && IsIntExpression( Operation->Operand ) )
+        {
+            Result.Operations.push_back( Expression );
+            Result.NumberOfOperations++;
+            DecomposeTerms( Operation->Operand, -Factor, Result );
+            return;
+        }
+    }
+    
+    if( Expression->Type() == CNodeTypes::BinaryOperation )
+    {
+        BinaryOperationNode* Operation = (BinaryOperationNode*)Expression;
+        ExpressionNode* Left = Operation->LeftOperand;
+        ExpressionNode* Right = Operation->RightOperand;
+        bool OperandsAreInts = IsIntExpression( Left ) && IsIntExpression( Right );
+        
+        if( OperandsAreInts && (Operation->Operator == BinaryOperators::Addition
+                            ||  Operation->Operator == BinaryOperators::Subtraction) )
+        {
+            bool IsSubtraction = (Operation->Operator == BinaryOperators::Subtraction);
+            Result.Operations.push_back( Expression );
+            Result.NumberOfOperations++;
+            DecomposeTerms( Left, Factor, Result );
+            DecomposeTerms( Right, IsSubtraction? -Factor : Factor, Result );
+            return;
+        }
+        
+        // a product by a constant only scales the other operand,
+        // but that is only worth it when it has a single term
+        if( OperandsAreInts && Operation->Operator == BinaryOperators::Product
+        && (Left->IsStatic() || Right->IsStatic()) )
+        {
+            ExpressionNode* Scale = (Left->IsStatic()? Left : Right);
+            ExpressionNode* Scaled = (Left->IsStatic()? Right : Left);
+            uint32_t ScaleValue = Scale->GetStaticValue().Word.AsInteger;
+            
+            TermDecomposition ScaledResult;
+            ScaledResult.Constant = 0;
+            ScaledResult.NumberOfOperations = 0;
+            DecomposeTerms( Scaled, 1, ScaledResult );
+            
+            if( ScaledResult.Terms.size() <= 1 )
+            {
+                for( ScaledTerm& Term: ScaledResult.Terms )
+                  Result.Terms.push_back( { Term.Term, (int32_t)(Term.Factor * ScaleValue * Factor) } );
+                
+                Result.Constant += ScaledResult.Constant * ScaleValue * Factor;
+                Result.Operations.insert( Result.Operations.end(), ScaledResult.Operations.begin(), ScaledResult.Operations.end() );
+                Result.Constants.insert( Result.Constants.end(), ScaledResult.Constants.begin(), ScaledResult.Constants.end() );
+                Result.Operations.push_back( Expression );
+                Result.Constants.push_back( Scale );
+                Result.NumberOfOperations += 1 + ScaledResult.NumberOfOperations;
+                return;
+            }
+        }
+    }
+    
+    // anything else is just a term
+    Result.Terms.push_back( { Expression, (int32_t)Factor } );
+}
+
+
+// =============================================================================
+//      EXPRESSION OPTIMIZER: INSTANCE HANDLING
+// =============================================================================
+
+
+ExpressionOptimizer::ExpressionOptimizer()
+{
+    RemovedOperations = 0;
+    ReplacedVariables = 0;
+    RemovedStores = 0;
+}
+
+
+// =============================================================================
+//      EXPRESSION OPTIMIZER: KNOWN VALUES
+// =============================================================================
+
+
+void ExpressionOptimizer::ForgetVariable( VariableNode* Variable )
+{
+    KnownValues.erase( Variable );
+    KnownCopies.erase( Variable );
+    
+    // copies of this variable are no longer valid
+    for( auto CopyPair = KnownCopies.begin(); CopyPair != KnownCopies.end(); )
+    {
+        if( CopyPair->second == Variable )
+          CopyPair = KnownCopies.erase( CopyPair );
+        else
+          CopyPair++;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpressionOptimizer::ForgetVariables( const set< VariableNode* >& Variables )
+{
+    for( VariableNode* Variable: Variables )
+      ForgetVariable( Variable );
+}
+
+// -----------------------------------------------------------------------------
+
+// variables that go out of scope are not valid values
+void ExpressionOptimizer::ForgetScope( ScopeNode* Scope )
+{
+    set< VariableNode* > ScopeVariables;
+    
+    for( auto& ValuePair: KnownValues )
+      if( ValuePair.first->OwnerScope == Scope )
+        ScopeVariables.insert( ValuePair.first );
+    
+    for( auto& CopyPair: KnownCopies )
+    {
+        if( CopyPair.first->OwnerScope == Scope )
+          ScopeVariables.insert( CopyPair.first );
+        
+        if( CopyPair.second->OwnerScope == Scope )
+          ScopeVariables.insert( CopyPair.second );
+    }
+    
+    ForgetVariables( ScopeVariables );
+}
+
+// -----------------------------------------------------------------------------
+
+// where two paths of code join, only what
+// is known in both of them is still known
+void ExpressionOptimizer::KeepCommonKnowledge( const map< VariableNode*, StaticValue >& OtherValues, const map< VariableNode*, VariableNode* >& OtherCopies )
+{
+    for( auto ValuePair = KnownValues.begin(); ValuePair != KnownValues.end(); )
+    {
+        auto OtherPair = OtherValues.find( ValuePair->first );
+        
+        bool IsCommon = (OtherPair != OtherValues.end()
+                      && OtherPair->second.Type == ValuePair->second.Type
+                      && OtherPair->second.Word.AsInteger == ValuePair->second.Word.AsInteger);
+        
+        if( IsCommon )
+          ValuePair++;
+        else
+          ValuePair = KnownValues.erase( ValuePair );
+    }
+    
+    for( auto CopyPair = KnownCopies.begin(); CopyPair != KnownCopies.end(); )
+    {
+        auto OtherPair = OtherCopies.find( CopyPair->first );
+        
+        if( OtherPair != OtherCopies.end() && OtherPair->second == CopyPair->second )
+          CopyPair++;
+        else
+          CopyPair = KnownCopies.erase( CopyPair );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// after a variable is assigned a constant or the value
+// of another variable, later reads can just use that
+void ExpressionOptimizer::LearnAssignment( VariableNode* Variable, ExpressionNode* Value )
+{
+    if( !OptimizedVariables.count( Variable ) )
+      return;
+    
+    PrimitiveTypes VariableType = ((PrimitiveType*)Variable->DeclaredType)->Which;
+    Value = Unenclosed( Value );
+    
+    // types are checked from the expression, since
+    // static values don't always have the right one
+    if( Value->IsStatic() )
+    {
+        bool IsSameType = TypeIsThisPrimitive( Value->ReturnedType, VariableType );
+        bool IsIntToFloat = IsIntExpression( Value ) && VariableType == PrimitiveTypes::Float;
+        
+        if( !IsSameType && !IsIntToFloat )
+          return;
+        
+        StaticValue Known = Value->GetStaticValue();
+        
+        if( IsSameType )
+          Known.Type = VariableType;
+        else
+          Known.ConvertToType( PrimitiveTypes::Float );
+        
+        KnownValues.insert( make_pair( Variable, Known ) );
+        return;
+    }
+    
+    VariableNode* Source = NamedVariable( Value );
+    
+    if( Source && Source != Variable && OptimizedVariables.count( Source )
+    &&  AreEqual( Source->DeclaredType, Variable->DeclaredType ) )
+      KnownCopies[ Variable ] = Source;
+}
+
+
+// =============================================================================
+//      EXPRESSION OPTIMIZER: REPLACING VARIABLES
+// =============================================================================
+
+
+// replaces variables read by an expression with their
+// known values, except the ones that it assigns itself
+void ExpressionOptimizer::ReplaceVariables( ExpressionNode*& Expression, const set< VariableNode* >& Assigned, vector< AtomReplacement >& Replacements )
+{
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::ExpressionAtom:
+        {
+            VariableNode* Variable = NamedVariable( Expression );
+            
+            if( !Variable || Assigned.count( Variable ) )
+              return;
+            
+            ExpressionNode* Replacement = nullptr;
+            auto ValuePair = KnownValues.find( Variable );
+            auto CopyPair = KnownCopies.find( Variable );
+            
+            if( ValuePair != KnownValues.end() )
+              Replacement = NewLiteral( ValuePair->second, Expression->Parent, Expression->Location );
+            
+            else if( CopyPair != KnownCopies.end() && !Assigned.count( CopyPair->second ) )
+              Replacement = NewVariableAtom( CopyPair->second, Expression->Parent, Expression->Location );
+            
+            if( !Replacement )
+              return;
+            
+            Replacements.push_back( { &Expression, Expression } );
+            Expression = Replacement;
+            return;
+        }
+        
+        case CNodeTypes::FunctionCall:
+        {
+            for( ExpressionNode*& Parameter: ((FunctionCallNode*)Expression)->Parameters )
+              ReplaceVariables( Parameter, Assigned, Replacements );
+            
+            return;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+            ReplaceVariablesInPlacement( ((ArrayAccessNode*)Expression)->ArrayOperand, Assigned, Replacements );
+            ReplaceVariables( ((ArrayAccessNode*)Expression)->IndexOperand, Assigned, Replacements );
+            return;
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* Operation = (UnaryOperationNode*)Expression;
+            
+            if( Operation->Operator == UnaryOperators::Reference || IsIncrementOrDecrement( Operation->Operator ) )
+              ReplaceVariablesInPlacement( Operation->Operand, Assigned, Replacements );
+            else
+              ReplaceVariables( Operation->Operand, Assigned, Replacements );
+            
+            return;
+        }
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* Operation = (BinaryOperationNode*)Expression;
+            
+            if( IsAssignment( Operation->Operator ) )
+              ReplaceVariablesInPlacement( Operation->LeftOperand, Assigned, Replacements );
+            else
+              ReplaceVariables( Operation->LeftOperand, Assigned, Replacements );
+            
+            ReplaceVariables( Operation->RightOperand, Assigned, Replacements );
+            return;
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+            ReplaceVariables( ((EnclosedExpressionNode*)Expression)->InternalExpression, Assigned, Replacements );
+            return;
+        
+        case CNodeTypes::MemberAccess:
+            ReplaceVariablesInPlacement( ((MemberAccessNode*)Expression)->GroupOperand, Assigned, Replacements );
+            return;
+        
+        case CNodeTypes::PointedMemberAccess:
+            ReplaceVariables( ((PointedMemberAccessNode*)Expression)->GroupOperand, Assigned, Replacements );
+            return;
+        
+        case CNodeTypes::TypeConversion:
+            ReplaceVariables( ((TypeConversionNode*)Expression)->ConvertedExpression, Assigned, Replacements );
+            return;
+        
+        default:
+            return;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// for expressions used by their memory address,
+// only the values used to find that address
+void ExpressionOptimizer::ReplaceVariablesInPlacement( ExpressionNode*& Expression, const set< VariableNode* >& Assigned, vector< AtomReplacement >& Replacements )
+{
+    if( Expression->Type() == CNodeTypes::ExpressionAtom )
+      return;
+    
+    if( Expression->Type() == CNodeTypes::EnclosedExpression )
+      ReplaceVariablesInPlacement( ((EnclosedExpressionNode*)Expression)->InternalExpression, Assigned, Replacements );
+    
+    else
+      ReplaceVariables( Expression, Assigned, Replacements );
+}
+
+
+// =============================================================================
+//      EXPRESSION OPTIMIZER: SIMPLIFYING OPERATIONS
+// =============================================================================
+
+
+// simplifies all operations in an expression, from
+// its innermost ones; the result replaces the expression
+ExpressionNode* ExpressionOptimizer::SimplifyExpression( ExpressionNode* Expression )
+{
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::FunctionCall:
+        {
+            for( ExpressionNode*& Parameter: ((FunctionCallNode*)Expression)->Parameters )
+              Parameter = SimplifyExpression( Parameter );
+            
+            return Expression;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+        {
+            ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Expression;
+            ArrayAccess->ArrayOperand = SimplifyExpression( ArrayAccess->ArrayOperand );
+            ArrayAccess->IndexOperand = SimplifyExpression( ArrayAccess->IndexOperand );
+            return Expression;
+        }
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* Operation = (UnaryOperationNode*)Expression;
+            Operation->Operand = SimplifyExpression( Operation->Operand );
+            return SimplifyUnaryOperation( Operation );
+        }
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* Operation = (BinaryOperationNode*)Expression;
+            Operation->LeftOperand = SimplifyExpression( Operation->LeftOperand );
+            Operation->RightOperand = SimplifyExpression( Operation->RightOperand );
+            return SimplifyBinaryOperation( Operation );
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+        {
+            EnclosedExpressionNode* Enclosed = (EnclosedExpressionNode*)Expression;
+            Enclosed->InternalExpression = SimplifyExpression( Enclosed->InternalExpression );
+            return Expression;
+        }
+        
+        case CNodeTypes::MemberAccess:
+        {
+            MemberAccessNode* MemberAccess = (MemberAccessNode*)Expression;
+            MemberAccess->GroupOperand = SimplifyExpression( MemberAccess->GroupOperand );
+            return Expression;
+        }
+        
+        case CNodeTypes::PointedMemberAccess:
+        {
+            PointedMemberAccessNode* MemberAccess = (PointedMemberAccessNode*)Expression;
+            MemberAccess->GroupOperand = SimplifyExpression( MemberAccess->GroupOperand );
+            return Expression;
+        }
+        
+        case CNodeTypes::TypeConversion:
+        {
+            TypeConversionNode* Conversion = (TypeConversionNode*)Expression;
+            Conversion->ConvertedExpression = SimplifyExpression( Conversion->ConvertedExpression );
+            return Expression;
+        }
+        
+        default:
+            return Expression;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ExpressionNode* ExpressionOptimizer::SimplifyUnaryOperation( UnaryOperationNode* Operation )
+{
+    // static values are already computed by the emitter
+    if( Operation->IsStatic() )
+      return Operation;
+    
+    if( Operation->Operator == UnaryOperators::MinusSign
+    &&  IsIntExpression( Operation ) && IsIntExpression( Operation->Operand ) )
+      return CombineConstants( Operation );
+    
+    // unary plus does nothing
+    if( Operation->Operator == UnaryOperators::PlusSign
+    &&  AreEqual( Operation->ReturnedType, Operation->Operand->ReturnedType ) )
+    {
+        RemovedOperations++;
+        return ReplaceWithPart( Operation, Operation->Operand );
+    }
+    
+    // double negations cancel out
+    if( Operation->Operator == UnaryOperators::MinusSign
+    ||  Operation->Operator == UnaryOperators::BitwiseNot )
+    {
+        ExpressionNode* Operand = Unenclosed( Operation->Operand );
+        
+        if( Operand->Type() != CNodeTypes::UnaryOperation )
+          return Operation;
+        
+        UnaryOperationNode* Negated = (UnaryOperationNode*)Operand;
+        
+        if( Negated->Operator == Operation->Operator
+        &&  AreEqual( Operation->ReturnedType, Negated->Operand->ReturnedType ) )
+        {
+            RemovedOperations += 2;
+            return ReplaceWithPart( Operation, Negated->Operand );
+        }
+    }
+    
+    return Operation;
+}
+
+// -----------------------------------------------------------------------------
+
+ExpressionNode* ExpressionOptimizer::SimplifyBinaryOperation( BinaryOperationNode* Operation )
+{
+    // static values are already computed by the emitter
+    if( Operation->IsStatic() )
+      return Operation;
+    
+    ExpressionNode* Left = Operation->LeftOperand;
+    ExpressionNode* Right = Operation->RightOperand;
+    
+    if( IsIntExpression( Operation ) && IsIntExpression( Left ) && IsIntExpression( Right )
+    && (Operation->Operator == BinaryOperators::Addition
+    ||  Operation->Operator == BinaryOperators::Subtraction
+    ||  Operation->Operator == BinaryOperators::Product) )
+      return CombineConstants( Operation );
+    
+    // other operations can be removed when they leave
+    // their other operand unchanged, as long as its type
+    // is the same as the result (for floats, x + 0.0 is
+    // not removed since it turns -0.0 into +0.0)
+    bool LeftIsResult = AreEqual( Left->ReturnedType, Operation->ReturnedType );
+    bool RightIsResult = AreEqual( Right->ReturnedType, Operation->ReturnedType );
+    bool KeepLeft = false, KeepRight = false;
+    
+    switch( Operation->Operator )
+    {
+        case BinaryOperators::Product:
+            KeepLeft  = LeftIsResult  && HasStaticValue( Right, 1 );
+            KeepRight = RightIsResult && HasStaticValue( Left, 1 );
+            break;
+        
+        case BinaryOperators::Division:
+            KeepLeft = LeftIsResult && HasStaticValue( Right, 1 );
+            break;
+        
+        case BinaryOperators::BitwiseOr:
+        case BinaryOperators::BitwiseXor:
+            KeepLeft  = LeftIsResult  && HasStaticValue( Right, 0 );
+            KeepRight = RightIsResult && HasStaticValue( Left, 0 );
+            break;
+        
+        case BinaryOperators::BitwiseAnd:
+            KeepLeft  = LeftIsResult  && HasStaticValue( Right, -1 );
+            KeepRight = RightIsResult && HasStaticValue( Left, -1 );
+            break;
+        
+        case BinaryOperators::ShiftLeft:
+        case BinaryOperators::ShiftRight:
+            KeepLeft = LeftIsResult && HasStaticValue( Right, 0 );
+            break;
+        
+        default:
+            break;
+    }
+    
+    if( KeepLeft )
+    {
+        RemovedOperations++;
+        return ReplaceWithPart( Operation, Operation->LeftOperand );
+    }
+    
+    if( KeepRight )
+    {
+        RemovedOperations++;
+        return ReplaceWithPart( Operation, Operation->RightOperand );
+    }
+    
+    return Operation;
+}
+
+// -----------------------------------------------------------------------------
+
+// rewrites an int expression as a sum of its terms and a
+// single constant at the end, when that needs fewer operations
+ExpressionNode* ExpressionOptimizer::CombineConstants( ExpressionNode* Expression )
+{
+    TermDecomposition Decomposition;
+    Decomposition.Constant = 0;
+    Decomposition.NumberOfOperations = 0;
+    DecomposeTerms( Expression, 1, Decomposition );
+    
+    vector< ScaledTerm >& Terms = Decomposition.Terms;
+    int32_t Constant = (int32_t)Decomposition.Constant;
+    
+    // terms multiplied by 0 can have side effects, and
+    // the factor of INT_MIN has no positive equivalent
+    if( Terms.empty() )
+      return Expression;
+    
+    for( ScaledTerm& Term: Terms )
+      if( Term.Factor == 0 || Term.Factor == INT32_MIN )
+        return Expression;
+    
+    // count the operations needed for the new form
+    int NumberOfOperations = Terms.size() - 1;
+    
+    for( ScaledTerm& Term: Terms )
+      if( Term.Factor != 1 && Term.Factor != -1 )
+        NumberOfOperations++;
+    
+    // (a negative first term is either subtracted
+    // from the constant or needs to be negated)
+    if( Constant != 0 || Terms[ 0 ].Factor < 0 )
+      NumberOfOperations++;
+    
+    if( NumberOfOperations >= Decomposition.NumberOfOperations )
+      return Expression;
+    
+    // build the new expression from left to right
+    CNode* Parent = Expression->Parent;
+    SourceLocation Location = Expression->Location;
+    ExpressionNode* Result = nullptr;
+    
+    for( ScaledTerm& Term: Terms )
+    {
+        ExpressionNode* Scaled = Term.Term;
+        int32_t Magnitude = abs( Term.Factor );
+        
+        if( Magnitude != 1 )
+          Scaled = NewBinaryOperation( BinaryOperators::Product, Scaled, NewLiteral( StaticValue( Magnitude ), Parent, Location ), Parent, Location );
+        
+        if( Result )
+          Result = NewBinaryOperation( (Term.Factor < 0? BinaryOperators::Subtraction : BinaryOperators::Addition), Result, Scaled, Parent, Location );
+        
+        else if( Term.Factor > 0 )
+          Result = Scaled;
+        
+        else if( Constant != 0 )
+        {
+            Result = NewBinaryOperation( BinaryOperators::Subtraction, NewLiteral( StaticValue( Constant ), Parent, Location ), Scaled, Parent, Location );
+            Constant = 0;
+        }
+        
+        else
+          Result = NewNegation( Scaled, Parent, Location );
+    }
+    
+    if( Constant < 0 && Constant != INT32_MIN )
+      Result = NewBinaryOperation( BinaryOperators::Subtraction, Result, NewLiteral( StaticValue( -Constant ), Parent, Location ), Parent, Location );
+    
+    else if( Constant != 0 )
+      Result = NewBinaryOperation( BinaryOperators::Addition, Result, NewLiteral( StaticValue( Constant ), Parent, Location ), Parent, Location );
+    
+    Result->Parent = Parent;
+    
+    // delete what was replaced, except for the terms
+    for( ExpressionNode* Operation: Decomposition.Operations )
+      DeleteWithoutOperands( Operation );
+    
+    for( ExpressionNode* Combined: Decomposition.Constants )
+      delete Combined;
+    
+    RemovedOperations += Decomposition.NumberOfOperations - NumberOfOperations;
+    return Result;
+}
+
+
+// =============================================================================
+//      EXPRESSION OPTIMIZER: OPTIMIZING FUNCTIONS
+// =============================================================================
+
+
+// when the value of an expression is discarded,
+// updates of a variable with a known value
+// can become simple assignments of a constant
+ExpressionNode* ExpressionOptimizer::AssignKnownResults( ExpressionNode* Expression, bool ValueIsUsed )
+{
+    if( Expression->Type() == CNodeTypes::UnaryOperation )
+    {
+        UnaryOperationNode* Operation = (UnaryOperationNode*)Expression;
+        
+        if( !IsIncrementOrDecrement( Operation->Operator ) )
+          return Expression;
+        
+        // post-increments give the previous value
+        bool IsPost = (Operation->Operator == UnaryOperators::PostIncrement
+                    || Operation->Operator == UnaryOperators::PostDecrement);
+        
+        if( IsPost && ValueIsUsed )
+          return Expression;
+        
+        VariableNode* Target = NamedVariable( Operation->Operand );
+        auto ValuePair = KnownValues.find( Target );
+        
+        if( !Target || ValuePair == KnownValues.end() || ValuePair->second.Type == PrimitiveTypes::Bool )
+          return Expression;
+        
+        bool IsIncrement = (Operation->Operator == UnaryOperators::PreIncrement
+                         || Operation->Operator == UnaryOperators::PostIncrement);
+        
+        StaticValue Result = ValuePair->second;
+        
+        if( Result.Type == PrimitiveTypes::Float )
+          Result.Word.AsFloat += (IsIncrement? 1 : -1);
+        else
+          Result.Word.AsInteger = (uint32_t)Result.Word.AsInteger + (IsIncrement? 1 : -1);
+        
+        CNode* Parent = Expression->Parent;
+        SourceLocation Location = Expression->Location;
+        
+        ExpressionNode* Assignment = NewBinaryOperation
+        (
+            BinaryOperators::Assignment,
+            NewVariableAtom( Target, Parent, Location ),
+            NewLiteral( Result, Parent, Location ),
+            Parent, Location
+        );
+        
+        delete Expression;
+        ReplacedVariables++;
+        return Assignment;
+    }
+    
+    if( Expression->Type() == CNodeTypes::BinaryOperation )
+    {
+        BinaryOperationNode* Operation = (BinaryOperationNode*)Expression;
+        BinaryOperators Operator;
+        
+        if( !GetCompoundOperation( Operation->Operator, Operator ) )
+          return Expression;
+        
+        VariableNode* Target = NamedVariable( Operation->LeftOperand );
+        auto ValuePair = KnownValues.find( Target );
+        
+        if( !Target || ValuePair == KnownValues.end() || ValuePair->second.Type == PrimitiveTypes::Bool )
+          return Expression;
+        
+        // the operated value must not need conversions
+        // and must not change the variable itself
+        if( !AreEqual( Operation->RightOperand->ReturnedType, Target->DeclaredType ) )
+          return Expression;
+        
+        VariableUses RightUses;
+        FindVariableUses( Operation->RightOperand, RightUses );
+        
+        if( RightUses.Assigned.count( Target ) )
+          return Expression;
+        
+        Operation->Operator = BinaryOperators::Assignment;
+        Operation->RightOperand = NewBinaryOperation
+        (
+            Operator,
+            NewLiteral( ValuePair->second, Operation, Operation->Location ),
+            Operation->RightOperand,
+            Operation, Operation->Location
+        );
+        
+        ReplacedVariables++;
+        return Expression;
+    }
+    
+    return Expression;
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpressionOptimizer::OptimizeExpression( ExpressionNode*& Expression, bool ValueIsUsed )
+{
+    // some contructs have optional parts!
+    if( !Expression ) return;
+    
+    Expression = AssignKnownResults( Expression, ValueIsUsed );
+    
+    // reads made before an assignment at the root can
+    // use the previous value of the assigned variable
+    VariableUses Uses;
+    FindVariableUses( Expression, Uses );
+    
+    ExpressionNode* Root = Unenclosed( Expression );
+    BinaryOperationNode* RootAssignment = nullptr;
+    VariableNode* RootTarget = nullptr;
+    
+    if( Root->Type() == CNodeTypes::BinaryOperation
+    &&  ((BinaryOperationNode*)Root)->Operator == BinaryOperators::Assignment )
+    {
+        RootAssignment = (BinaryOperationNode*)Root;
+        RootTarget = NamedVariable( RootAssignment->LeftOperand );
+    }
+    
+    vector< AtomReplacement > Replacements;
+    
+    if( RootTarget )
+    {
+        VariableUses RightUses;
+        FindVariableUses( RootAssignment->RightOperand, RightUses );
+        ReplaceVariables( RootAssignment->RightOperand, RightUses.Assigned, Replacements );
+    }
+    
+    else
+      ReplaceVariables( Expression, Uses.Assigned, Replacements );
+    
+    // undo the replacements if they make
+    // the emitter find a division by zero
+    if( DividesByStaticZero( Expression ) )
+    {
+        for( auto Replacement = Replacements.rbegin(); Replacement != Replacements.rend(); Replacement++ )
+        {
+            delete *Replacement->Position;
+            *Replacement->Position = Replacement->OriginalAtom;
+        }
+    }
+    
+    else
+    {
+        for( AtomReplacement& Replacement: Replacements )
+          delete Replacement.OriginalAtom;
+        
+        ReplacedVariables += Replacements.size();
+    }
+    
+    Expression = SimplifyExpression( Expression );
+    
+    // update what is known after the expression
+    ForgetVariables( Uses.Assigned );
+    
+    if( RootTarget )
+      LearnAssignment( RootTarget, RootAssignment->RightOperand );
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpressionOptimizer::OptimizeInitialization( CNode*& InitialValue )
+{
+    if( InitialValue->Type() == CNodeTypes::InitializationList )
+    {
+        for( CNode*& Value: ((InitializationListNode*)InitialValue)->AssignedValues )
+          OptimizeInitialization( Value );
+        
+        return;
+    }
+    
+    ExpressionNode* Expression = (ExpressionNode*)InitialValue;
+    OptimizeExpression( Expression, true );
+    InitialValue = Expression;
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpressionOptimizer::OptimizeStatement( CNode*& Statement )
+{
+    // some contructs have optional parts!
+    if( !Statement ) return;
+    
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+            {
+                if( Variable->InitialValue )
+                  OptimizeInitialization( Variable->InitialValue );
+                
+                ForgetVariable( Variable );
+                
+                if( Variable->InitialValue && Variable->InitialValue->IsExpression() )
+                  LearnAssignment( Variable, (ExpressionNode*)Variable->InitialValue );
+            }
+            
+            return;
+        }
+        
+        case CNodeTypes::Block:
+        {
+            BlockNode* Block = (BlockNode*)Statement;
+            OptimizeStatementList( Block->Statements );
+            ForgetScope( Block );
+            return;
+        }
+        
+        case CNodeTypes::If:
+        {
+            IfNode* If = (IfNode*)Statement;
+            OptimizeExpression( If->Condition, true );
+            
+            map< VariableNode*, StaticValue > EntryValues = KnownValues;
+            map< VariableNode*, VariableNode* > EntryCopies = KnownCopies;
+            OptimizeStatement( If->TrueStatement );
+            
+            map< VariableNode*, StaticValue > TrueValues = KnownValues;
+            map< VariableNode*, VariableNode* > TrueCopies = KnownCopies;
+            KnownValues = EntryValues;
+            KnownCopies = EntryCopies;
+            OptimizeStatement( If->FalseStatement );
+            
+            KeepCommonKnowledge( TrueValues, TrueCopies );
+            return;
+        }
+        
+        // in loops, variables assigned anywhere in the loop
+        // have no known value (also wherever a continue
+        // statement can jump to, or after the loop)
+        case CNodeTypes::While:
+        {
+            WhileNode* While = (WhileNode*)Statement;
+            VariableUses LoopUses;
+            FindVariableUses( While, LoopUses );
+            
+            ForgetVariables( LoopUses.Assigned );
+            OptimizeExpression( While->Condition, true );
+            OptimizeStatement( While->LoopStatement );
+            ForgetVariables( LoopUses.Assigned );
+            return;
+        }
+        
+        case CNodeTypes::Do:
+        {
+            DoNode* Do = (DoNode*)Statement;
+            VariableUses LoopUses;
+            FindVariableUses( Do, LoopUses );
+            
+            ForgetVariables( LoopUses.Assigned );
+            OptimizeStatement( Do->LoopStatement );
+            ForgetVariables( LoopUses.Assigned );
+            OptimizeExpression( Do->Condition, true );
+            ForgetVariables( LoopUses.Assigned );
+            return;
+        }
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Statement;
+            OptimizeStatement( For->InitialAction );
+            
+            VariableUses LoopUses;
+            FindVariableUses( For->Condition, LoopUses );
+            FindVariableUses( For->LoopStatement, LoopUses );
+            FindVariableUses( For->IterationAction, LoopUses );
+            
+            ForgetVariables( LoopUses.Assigned );
+            OptimizeExpression( For->Condition, true );
+            OptimizeStatement( For->LoopStatement );
+            ForgetVariables( LoopUses.Assigned );
+            OptimizeExpression( For->IterationAction, false );
+            ForgetVariables( LoopUses.Assigned );
+            ForgetScope( For );
+            return;
+        }
+        
+        // cases can be reached from the switch or from
+        // the previous case, and so can the switch end
+        case CNodeTypes::Switch:
+        {
+            SwitchNode* Switch = (SwitchNode*)Statement;
+            OptimizeExpression( Switch->Condition, true );
+            
+            VariableUses SwitchUses;
+            FindVariableUses( Switch, SwitchUses );
+            ForgetVariables( SwitchUses.Assigned );
+            
+            map< VariableNode*, StaticValue > EntryValues = KnownValues;
+            map< VariableNode*, VariableNode* > EntryCopies = KnownCopies;
+            
+            for( CNode*& SwitchStatement: Switch->Statements )
+            {
+                if( SwitchStatement->Type() == CNodeTypes::Case
+                ||  SwitchStatement->Type() == CNodeTypes::Default )
+                {
+                    KnownValues = EntryValues;
+                    KnownCopies = EntryCopies;
+                }
+                
+                OptimizeStatement( SwitchStatement );
+            }
+            
+            KnownValues = EntryValues;
+            KnownCopies = EntryCopies;
+            ForgetScope( Switch );
+            return;
+        }
+        
+        case CNodeTypes::Return:
+            OptimizeExpression( ((ReturnNode*)Statement)->ReturnedExpression, true );
+            return;
+        
+        // labels can be reached from any goto
+        case CNodeTypes::Label:
+            KnownValues.clear();
+            KnownCopies.clear();
+            return;
+        
+        default:
+        {
+            if( !Statement->IsExpression() )
+              return;
+            
+            ExpressionNode* Expression = (ExpressionNode*)Statement;
+            OptimizeExpression( Expression, false );
+            Statement = Expression;
+            return;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpressionOptimizer::OptimizeStatementList( list< CNode* >& Statements )
+{
+    for( CNode*& Statement: Statements )
+      OptimizeStatement( Statement );
+}
+
+// -----------------------------------------------------------------------------
+
+// removes assignments to variables that are never read,
+// as long as the assigned values have no side effects
+bool ExpressionOptimizer::RemoveUnreadStores( CNode*& Statement, const set< VariableNode* >& UnreadVariables )
+{
+    // some contructs have optional parts!
+    if( !Statement ) return false;
+    
+    bool StoresWereRemoved = false;
+    
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+            {
+                if( !UnreadVariables.count( Variable ) || !Variable->InitialValue )
+                  continue;
+                
+                if( ((ExpressionNode*)Variable->InitialValue)->HasSideEffects() )
+                  continue;
+                
+                delete Variable->InitialValue;
+                Variable->InitialValue = nullptr;
+                RemovedStores++;
+                StoresWereRemoved = true;
+            }
+            
+            break;
+        }
+        
+        case CNodeTypes::Block:
+        case CNodeTypes::Switch:
+        {
+            for( CNode*& BlockStatement: ((BlockNode*)Statement)->Statements )
+              if( RemoveUnreadStores( BlockStatement, UnreadVariables ) )
+                StoresWereRemoved = true;
+            
+            break;
+        }
+        
+        case CNodeTypes::If:
+        {
+            IfNode* If = (IfNode*)Statement;
+            bool TrueStoresWereRemoved = RemoveUnreadStores( If->TrueStatement, UnreadVariables );
+            bool FalseStoresWereRemoved = RemoveUnreadStores( If->FalseStatement, UnreadVariables );
+            StoresWereRemoved = TrueStoresWereRemoved || FalseStoresWereRemoved;
+            break;
+        }
+        
+        case CNodeTypes::While:
+            StoresWereRemoved = RemoveUnreadStores( ((WhileNode*)Statement)->LoopStatement, UnreadVariables );
+            break;
+        
+        case CNodeTypes::Do:
+            StoresWereRemoved = RemoveUnreadStores( ((DoNode*)Statement)->LoopStatement, UnreadVariables );
+            break;
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Statement;
+            bool InitialStoresWereRemoved = RemoveUnreadStores( For->InitialAction, UnreadVariables );
+            bool LoopStoresWereRemoved = RemoveUnreadStores( For->LoopStatement, UnreadVariables );
+            StoresWereRemoved = InitialStoresWereRemoved || LoopStoresWereRemoved;
+            break;
+        }
+        
+        default:
+        {
+            if( !Statement->IsExpression() )
+              break;
+            
+            ExpressionNode* Expression = Unenclosed( (ExpressionNode*)Statement );
+            
+            if( Expression->Type() != CNodeTypes::BinaryOperation )
+              break;
+            
+            BinaryOperationNode* Assignment = (BinaryOperationNode*)Expression;
+            
+            if( Assignment->Operator != BinaryOperators::Assignment
+            ||  Assignment->RightOperand->HasSideEffects() )
+              break;
+            
+            VariableNode* Target = NamedVariable( Assignment->LeftOperand );
+            
+            if( !Target || !UnreadVariables.count( Target ) )
+              break;
+            
+            EmptyStatementNode* EmptyStatement = new EmptyStatementNode( Statement->Parent );
+            EmptyStatement->Location = Statement->Location;
+            delete Statement;
+            Statement = EmptyStatement;
+            
+            RemovedStores++;
+            StoresWereRemoved = true;
+            break;
+        }
+    }
+    
+    return StoresWereRemoved;
+}
+
+
+// =============================================================================
+//      EXPRESSION OPTIMIZER: MAIN FUNCTIONS
+// =============================================================================
+
+
+void ExpressionOptimizer::OptimizeFunction( FunctionNode* Function )
+{
+    KnownValues.clear();
+    KnownCopies.clear();
+    OptimizedVariables.clear();
+    FindOptimizedVariables( Function, OptimizedVariables );
+    OptimizeStatementList( Function->Statements );
+    
+    // once variables are replaced by their values, some
+    // may no longer be read (and removing their stores
+    // can leave other variables unread as well)
+    bool StoresWereRemoved = true;
+    
+    while( StoresWereRemoved )
+    {
+        VariableUses FinalUses;
+        FindVariableUses( Function, FinalUses );
+        set< VariableNode* > UnreadVariables;
+        
+        for( VariableNode* Variable: OptimizedVariables )
+          if( !FinalUses.Reads.count( Variable ) )
+            UnreadVariables.insert( Variable );
+        
+        StoresWereRemoved = false;
+        
+        for( CNode*& Statement: Function->Statements )
+          if( RemoveUnreadStores( Statement, UnreadVariables ) )
+            StoresWereRemoved = true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// globals are initialized in order, so only
+// their own expressions can be simplified
+void ExpressionOptimizer::OptimizeGlobals( TopLevelNode* ProgramAST )
+{
+    for( CNode* Statement: ProgramAST->Statements )
+      if( Statement->Type() == CNodeTypes::VariableList )
+        for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+          if( Variable->InitialValue && Variable->InitialValue->IsExpression() )
+            Variable->InitialValue = SimplifyExpression( (ExpressionNode*)Variable->InitialValue );
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned ExpressionOptimizer::TotalChanges()
+{
+    return RemovedOperations + ReplacedVariables + RemovedStores;
+}
+
+// -----------------------------------------------------------------------------
+
+void ExpressionOptimizer::PrintStatistics( ostream& Output )
+{
+    Output << "expression optimizer: " << RemovedOperations << " operations removed, ";
+    Output << ReplacedVariables << " variables replaced, " << RemovedStores << " stores removed" << endl;
+}
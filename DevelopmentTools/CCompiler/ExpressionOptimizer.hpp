@@ -0,0 +1,153 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef EXPRESSIONOPTIMIZER_HPP
+    #define EXPRESSIONOPTIMIZER_HPP
+    
+    // include project headers
+    #include "CNodes.hpp"
+    
+    // include C/C++ headers
+    #include <list>             // [ C++ STL ] Lists
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+    #include <ostream>          // [ C++ STL ] Output streams
+// *****************************************************************************
+
+
+// =============================================================================
+//      DATA USED BY THE EXPRESSION OPTIMIZER
+// =============================================================================
+
+
+// how a variable is accessed by some part of the code
+enum class VariableAccesses
+{
+    Read,
+    Write,
+    ReadWrite,
+    Address
+};
+
+// -----------------------------------------------------------------------------
+
+// what a part of the code does with variables
+typedef struct
+{
+    std::set< VariableNode* > Declared;
+    std::set< VariableNode* > Assigned;
+    std::set< VariableNode* > AccessedByAddress;    // (with & or from asm)
+    std::map< VariableNode*, int > Reads;
+}
+VariableUses;
+
+// -----------------------------------------------------------------------------
+
+// an atom that was replaced by a known value, and can
+// still be restored if the replacement is not valid
+typedef struct
+{
+    ExpressionNode** Position;
+    ExpressionNode* OriginalAtom;
+}
+AtomReplacement;
+
+
+// =============================================================================
+//      CLASS TO OPTIMIZE EXPRESSIONS IN THE AST
+// =============================================================================
+
+
+// Before emission, this rewrites the expressions of each
+// function so that they need fewer operations. Values that
+// are known for local variables are used in place of the
+// variables (constants and copies of other variables), int
+// sums and products are reordered so their constants can be
+// combined, and operations that do nothing like "* 1", "+ 0"
+// or double negations are removed. Stores to variables that
+// are never read afterwards are then removed too. This only
+// considers local variables of primitive types that are not
+// accessed through pointers or asm blocks.
+class ExpressionOptimizer
+{
+    protected:
+        
+        // variables that the current function can optimize,
+        // and what is known about them at each point
+        std::set< VariableNode* > OptimizedVariables;
+        std::map< VariableNode*, StaticValue > KnownValues;
+        std::map< VariableNode*, VariableNode* > KnownCopies;
+        
+        // statistics
+        unsigned RemovedOperations;
+        unsigned ReplacedVariables;
+        unsigned RemovedStores;
+        
+        // known values at each point of the code
+        void ForgetVariable( VariableNode* Variable );
+        void ForgetVariables( const std::set< VariableNode* >& Variables );
+        void ForgetScope( ScopeNode* Scope );
+        void KeepCommonKnowledge( const std::map< VariableNode*, StaticValue >& OtherValues, const std::map< VariableNode*, VariableNode* >& OtherCopies );
+        void LearnAssignment( VariableNode* Variable, ExpressionNode* Value );
+        
+        // replacement of variables by known values
+        void ReplaceVariables( ExpressionNode*& Expression, const std::set< VariableNode* >& Assigned, std::vector< AtomReplacement >& Replacements );
+        void ReplaceVariablesInPlacement( ExpressionNode*& Expression, const std::set< VariableNode* >& Assigned, std::vector< AtomReplacement >& Replacements );
+        
+        // simplification of operations
+        ExpressionNode* SimplifyExpression( ExpressionNode* Expression );
+        ExpressionNode* SimplifyUnaryOperation( UnaryOperationNode* Operation );
+        ExpressionNode* SimplifyBinaryOperation( BinaryOperationNode* Operation );
+        ExpressionNode* CombineConstants( ExpressionNode* Expression );
+        
+        // optimization of function code
+        ExpressionNode* AssignKnownResults( ExpressionNode* Expression, bool ValueIsUsed );
+        void OptimizeExpression( ExpressionNode*& Expression, bool ValueIsUsed );
+        void OptimizeInitialization( CNode*& InitialValue );
+        void OptimizeStatement( CNode*& Statement );
+        void OptimizeStatementList( std::list< CNode* >& Statements );
+        bool RemoveUnreadStores( CNode*& Statement, const std::set< VariableNode* >& UnreadVariables );
+        
+    public:
+        
+        // instance handling
+        ExpressionOptimizer();
+        
+        // main functions
+        void OptimizeFunction( FunctionNode* Function );
+        void OptimizeGlobals( TopLevelNode* ProgramAST );
+        unsigned TotalChanges();
+        void PrintStatistics( std::ostream& Output );
+};
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS FOR AST OPTIMIZATIONS
+// =============================================================================
+
+
+// queries on expressions
+ExpressionNode* Unenclosed( ExpressionNode* Expression );
+bool IsAssignment( BinaryOperators Operator );
+bool IsIncrementOrDecrement( UnaryOperators Operator );
+bool GetCompoundOperation( BinaryOperators Operator, BinaryOperators& Operation );
+VariableNode* NamedVariable( ExpressionNode* Expression );
+bool DividesByStaticZero( ExpressionNode* Expression );
+
+// uses of variables in a part of the code
+void FindVariableUses( CNode* Node, VariableUses& Uses, VariableAccesses Access = VariableAccesses::Read );
+void FindOptimizedVariables( FunctionNode* Function, std::set< VariableNode* >& OptimizedVariables );
+
+// queries on loops
+bool IsBlockOperationLoop( ForNode* For, BinaryOperationNode*& Assignment, ExpressionNode*& Limit, bool& LimitIsIncluded );
+
+// creation of new nodes
+ExpressionAtomNode* NewLiteral( const StaticValue& Value, CNode* Parent, const SourceLocation& Location );
+ExpressionAtomNode* NewVariableAtom( VariableNode* Variable, CNode* Parent, const SourceLocation& Location );
+BinaryOperationNode* NewBinaryOperation( BinaryOperators Operator, ExpressionNode* Left, ExpressionNode* Right, CNode* Parent, const SourceLocation& Location );
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -0,0 +1,417 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "../DevToolsInfrastructure/StringFunctions.hpp"
+    
+    // include project headers
+    #include "FunctionInlining.hpp"
+    #include "VariableRegisterAllocation.hpp"
+    #include "CompilerInfrastructure.hpp"
+    
+    // include C/C++ headers
+    #include <vector>           // [ C++ STL ] Vectors
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// asm lines with these can't be repeated in several places
+// or moved away from their function's stack frame
+static bool AssemblyWordIsForbidden( const string& Word )
+{
+    static const set< string > ForbiddenWords =
+    {
+        // control flow needs labels and the call stack
+        "jmp", "jt", "jf", "call", "ret",
+        
+        // data definitions
+        "integer", "float", "string", "pointer", "datafile",
+        
+        // stack frame registers
+        "bp", "sp", "r14", "r15"
+    };
+    
+    return ForbiddenWords.count( ToLowerCase( Word ) ) > 0;
+}
+
+// -----------------------------------------------------------------------------
+
+// inlined arguments are kept in a single register
+static bool ArgumentTypeCanBeInlined( DataType* ArgumentType )
+{
+    DataTypes Which = ArgumentType->Type();
+    return (Which == DataTypes::Primitive || Which == DataTypes::Pointer || Which == DataTypes::Enumeration);
+}
+
+
+// =============================================================================
+//      CLASS: FUNCTION INLINING
+// =============================================================================
+
+
+FunctionInlining::FunctionInlining()
+{
+    // (do nothing)
+}
+
+// -----------------------------------------------------------------------------
+
+void FunctionInlining::Clear()
+{
+    InlinedFunctions.clear();
+    RejectedFunctions.clear();
+    Definitions.clear();
+    FunctionsInProgress.clear();
+    DeclaredInline.clear();
+    WrittenArguments.clear();
+    ArgumentsNeedingRegisters.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+// returns the argument that an operand is (if any),
+// so that its uses can be tracked
+VariableNode* FunctionInlining::ArgumentInOperand( InlinedFunction& Function, ExpressionNode* Operand )
+{
+    while( Operand->Type() == CNodeTypes::EnclosedExpression )
+      Operand = ((EnclosedExpressionNode*)Operand)->InternalExpression;
+    
+    if( Operand->Type() != CNodeTypes::ExpressionAtom )
+      return nullptr;
+    
+    VariableNode* Variable = ((ExpressionAtomNode*)Operand)->ResolvedVariable;
+    
+    for( VariableNode* Argument: Function.Definition->Arguments )
+      if( Argument == Variable )
+        return Argument;
+    
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+bool FunctionInlining::CheckAssemblyLine( InlinedFunction& Function, const AssemblyBlockNode::AssemblyLine& Line, int& PushedWords )
+{
+    vector< string > Words = SplitAssemblyLine( Line.Text );
+    
+    // comments and empty lines have no effect
+    if( Words.empty() )
+      return true;
+    
+    // directives and labels are not allowed
+    string Instruction = ToLowerCase( Words[ 0 ] );
+    string Code = Line.Text.substr( 0, Line.Text.find( ';' ) );
+    
+    if( Code[ Code.find_first_not_of( " \t" ) ] == '%' || Code.find( ':' ) != string::npos )
+      return false;
+    
+    for( string& Word: Words )
+      if( AssemblyWordIsForbidden( Word ) )
+        return false;
+    
+    // the stack can be used, as long as it is left as it was
+    if( Instruction == "push" ) PushedWords++;
+    if( Instruction == "pop"  ) PushedWords--;
+    
+    if( PushedWords < 0 )
+      return false;
+    
+    AddRegistersInLine( Line.Text, map< string, set< int > >(), Function.AssemblyRegisters );
+    Function.Cost++;
+    
+    // find out how arguments are used
+    if( Line.EmbeddedAtom )
+    {
+        VariableNode* Argument = ArgumentInOperand( Function, Line.EmbeddedAtom );
+        
+        if( !Argument )
+          return true;
+        
+        // registers have no address
+        if( Instruction == "lea" )
+          return false;
+        
+        // a constant can only be a source operand
+        // (and never in a memory address)
+        size_t CommaPosition = Code.find( ',' );
+        size_t AtomPosition = Code.find( '{' );
+        bool IsSourceOperand = (CommaPosition != string::npos && CommaPosition < AtomPosition);
+        
+        if( !IsSourceOperand )
+          WrittenArguments.insert( Argument );
+        
+        if( !IsSourceOperand || Code.find( '[' ) != string::npos || Instruction == "in" )
+          ArgumentsNeedingRegisters.insert( Argument );
+    }
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool FunctionInlining::CheckExpression( InlinedFunction& Function, ExpressionNode* Expression )
+{
+    // some contructs have optional parts!
+    if( !Expression ) return true;
+    
+    // static values are just placed in a register
+    if( Expression->IsStatic() )
+      return true;
+    
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::ExpressionAtom:
+        {
+            VariableNode* Argument = ArgumentInOperand( Function, Expression );
+            
+            if( Argument )
+              ArgumentsNeedingRegisters.insert( Argument );
+            
+            return true;
+        }
+        
+        // calls are only allowed if they are also inlined
+        case CNodeTypes::FunctionCall:
+        {
+            FunctionCallNode* FunctionCall = (FunctionCallNode*)Expression;
+            string CalleeName = FunctionCall->ResolvedFunction->Name;
+            
+            if( !CheckFunction( CalleeName ) )
+              return false;
+            
+            InlinedFunction& Callee = InlinedFunctions[ CalleeName ];
+            Function.Cost += Callee.Cost;
+            Function.ModifiedRegisters.insert( Callee.ModifiedRegisters.begin(), Callee.ModifiedRegisters.end() );
+            
+            for( ExpressionNode* Parameter: FunctionCall->Parameters )
+              if( !CheckExpression( Function, Parameter ) )
+                return false;
+            
+            return true;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+        {
+            ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Expression;
+            Function.Cost++;
+            
+            return CheckExpression( Function, ArrayAccess->ArrayOperand )
+                && CheckExpression( Function, ArrayAccess->IndexOperand );
+        }
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* UnaryOperation = (UnaryOperationNode*)Expression;
+            UnaryOperators Operator = UnaryOperation->Operator;
+            VariableNode* Argument = ArgumentInOperand( Function, UnaryOperation->Operand );
+            Function.Cost++;
+            
+            // registers have no address
+            if( Argument && Operator == UnaryOperators::Reference )
+              return false;
+            
+            if( Argument )
+              if( Operator == UnaryOperators::PreIncrement  || Operator == UnaryOperators::PreDecrement
+              ||  Operator == UnaryOperators::PostIncrement || Operator == UnaryOperators::PostDecrement )
+                WrittenArguments.insert( Argument );
+            
+            return CheckExpression( Function, UnaryOperation->Operand );
+        }
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* BinaryOperation = (BinaryOperationNode*)Expression;
+            Function.Cost++;
+            
+            // short-circuits need labels
+            if( BinaryOperation->Operator == BinaryOperators::LogicalOr
+            ||  BinaryOperation->Operator == BinaryOperators::LogicalAnd )
+              return false;
+            
+            // the result of assignments is their left operand
+            if( BinaryOperation->HasMemoryPlacement() )
+            {
+                VariableNode* Argument = ArgumentInOperand( Function, BinaryOperation->LeftOperand );
+                
+                if( Argument )
+                  WrittenArguments.insert( Argument );
+            }
+            
+            return CheckExpression( Function, BinaryOperation->LeftOperand )
+                && CheckExpression( Function, BinaryOperation->RightOperand );
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+            return CheckExpression( Function, ((EnclosedExpressionNode*)Expression)->InternalExpression );
+        
+        case CNodeTypes::MemberAccess:
+            Function.Cost++;
+            return CheckExpression( Function, ((MemberAccessNode*)Expression)->GroupOperand );
+        
+        case CNodeTypes::PointedMemberAccess:
+            Function.Cost++;
+            return CheckExpression( Function, ((PointedMemberAccessNode*)Expression)->GroupOperand );
+        
+        case CNodeTypes::TypeConversion:
+            Function.Cost++;
+            return CheckExpression( Function, ((TypeConversionNode*)Expression)->ConvertedExpression );
+        
+        // literal strings are emitted with a label,
+        // and any other expression is not supported
+        default:
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool FunctionInlining::CheckStatement( InlinedFunction& Function, CNode* Statement, bool IsLastStatement )
+{
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::EmptyStatement:
+            return true;
+        
+        case CNodeTypes::AssemblyBlock:
+        {
+            AssemblyBlockNode* AssemblyBlock = (AssemblyBlockNode*)Statement;
+            int PushedWords = 0;
+            
+            for( auto& AssemblyLine: AssemblyBlock->AssemblyLines )
+              if( !CheckAssemblyLine( Function, AssemblyLine, PushedWords ) )
+                return false;
+            
+            return (PushedWords == 0);
+        }
+        
+        // the value is just left in the result register,
+        // so it can only be returned at the end
+        case CNodeTypes::Return:
+            return IsLastStatement && CheckExpression( Function, ((ReturnNode*)Statement)->ReturnedExpression );
+        
+        // expressions are the only other statements allowed
+        // (with no local variables, blocks or labels)
+        default:
+            return Statement->IsExpression() && CheckExpression( Function, (ExpressionNode*)Statement );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool FunctionInlining::CheckFunction( const string& Name )
+{
+    // reuse any previous results
+    if( InlinedFunctions.count( Name ) )
+      return true;
+    
+    if( RejectedFunctions.count( Name ) )
+      return false;
+    
+    // when a function is reached again while it is still being
+    // checked it is recursive, so the last call is not inlined
+    if( FunctionsInProgress.count( Name ) )
+      return false;
+    
+    // only functions with a body can be inlined
+    auto DefinitionPair = Definitions.find( Name );
+    
+    if( DefinitionPair == Definitions.end() )
+    {
+        RejectedFunctions.insert( Name );
+        return false;
+    }
+    
+    InlinedFunction Function;
+    Function.Definition = DefinitionPair->second;
+    Function.Cost = 0;
+    
+    // check all parts of the function
+    FunctionsInProgress.insert( Name );
+    bool CanBeInlined = true;
+    
+    for( VariableNode* Argument: Function.Definition->Arguments )
+      if( !ArgumentTypeCanBeInlined( Argument->DeclaredType ) )
+        CanBeInlined = false;
+    
+    list< CNode* >& Statements = Function.Definition->Statements;
+    
+    for( auto Statement = Statements.begin(); Statement != Statements.end() && CanBeInlined; Statement++ )
+      CanBeInlined = CheckStatement( Function, *Statement, next( Statement ) == Statements.end() );
+    
+    FunctionsInProgress.erase( Name );
+    
+    // small functions are always inlined, and others
+    // only when the program requests it
+    bool IsDeclaredInline = DeclaredInline.count( Name ) > 0;
+    
+    if( !IsDeclaredInline && Function.Cost > MaximumInlinedCost )
+      CanBeInlined = false;
+    
+    if( !CanBeInlined )
+    {
+        if( IsDeclaredInline )
+          RaiseWarning( Function.Definition->Location, "function \"" + Name + "\" cannot be inlined, so it will be called instead" );
+        
+        RejectedFunctions.insert( Name );
+        return false;
+    }
+    
+    // save the results
+    Function.ModifiedRegisters.insert( Function.AssemblyRegisters.begin(), Function.AssemblyRegisters.end() );
+    
+    for( VariableNode* Argument: Function.Definition->Arguments )
+      if( !WrittenArguments.count( Argument ) )
+      {
+          Function.ReadOnlyArguments.insert( Argument );
+          
+          if( !ArgumentsNeedingRegisters.count( Argument ) )
+            Function.ImmediateArguments.insert( Argument );
+      }
+    
+    InlinedFunctions[ Name ] = Function;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void FunctionInlining::Analyze( TopLevelNode* ProgramAST )
+{
+    Clear();
+    
+    // calls can appear before their functions are defined,
+    // and they can also be declared inline in a prototype
+    for( CNode* Statement: ProgramAST->Statements )
+    {
+        if( Statement->Type() != CNodeTypes::Function )
+          continue;
+        
+        FunctionNode* Function = (FunctionNode*)Statement;
+        
+        if( Function->HasBody )
+          Definitions[ Function->Name ] = Function;
+        
+        if( Function->IsInline )
+          DeclaredInline.insert( Function->Name );
+    }
+    
+    for( auto& DefinitionPair: Definitions )
+      CheckFunction( DefinitionPair.first );
+}
+
+// -----------------------------------------------------------------------------
+
+// gives nullptr when calls to the function are not inlined
+const InlinedFunction* FunctionInlining::Find( FunctionNode* Function ) const
+{
+    auto FunctionPair = InlinedFunctions.find( Function->Name );
+    
+    if( FunctionPair == InlinedFunctions.end() )
+      return nullptr;
+    
+    return &FunctionPair->second;
+}
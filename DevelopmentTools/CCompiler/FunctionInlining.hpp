@@ -0,0 +1,97 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef FUNCTIONINLINING_HPP
+    #define FUNCTIONINLINING_HPP
+    
+    // include project headers
+    #include "CNodes.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+// *****************************************************************************
+
+
+// =============================================================================
+//      DATA FOR INLINED FUNCTIONS
+// =============================================================================
+
+
+// Functions are inlined automatically when their cost is at most
+// this; it counts their asm instructions and the operations in
+// their expressions, including those of other inlined functions.
+// Functions declared with the inline keyword have no limit
+const int MaximumInlinedCost = 12;
+
+// -----------------------------------------------------------------------------
+
+// what the emitter needs to know to place the code of a
+// function where it is called, instead of calling it
+typedef struct
+{
+    FunctionNode* Definition;
+    int Cost;
+    
+    // registers modified by the function's asm blocks, and
+    // those that can be modified by any of its inlined code
+    // (its own asm blocks and the inlined calls within it)
+    std::set< int > AssemblyRegisters;
+    std::set< int > ModifiedRegisters;
+    
+    // arguments that the function never modifies, and the
+    // ones only read from asm lines where a constant fits
+    std::set< VariableNode* > ReadOnlyArguments;
+    std::set< VariableNode* > ImmediateArguments;
+}
+InlinedFunction;
+
+
+// =============================================================================
+//      CLASS TO DECIDE WHICH FUNCTIONS ARE INLINED
+// =============================================================================
+
+
+// A function can be inlined when its body only has expressions,
+// asm blocks and a final return. This way its arguments can just
+// be kept in registers, and its code needs no labels or stack
+// space. It cannot call other functions, unless they are also
+// inlined (so inlined functions are never recursive).
+class FunctionInlining
+{
+    protected:
+        
+        // results of the analysis, by function name
+        std::map< std::string, InlinedFunction > InlinedFunctions;
+        std::set< std::string > RejectedFunctions;
+        
+        // state while the program is analyzed
+        std::map< std::string, FunctionNode* > Definitions;
+        std::set< std::string > FunctionsInProgress;
+        std::set< std::string > DeclaredInline;
+        std::set< VariableNode* > WrittenArguments;
+        std::set< VariableNode* > ArgumentsNeedingRegisters;
+        
+        // analysis of the AST
+        bool CheckFunction( const std::string& Name );
+        bool CheckStatement( InlinedFunction& Function, CNode* Statement, bool IsLastStatement );
+        bool CheckExpression( InlinedFunction& Function, ExpressionNode* Expression );
+        bool CheckAssemblyLine( InlinedFunction& Function, const AssemblyBlockNode::AssemblyLine& Line, int& PushedWords );
+        VariableNode* ArgumentInOperand( InlinedFunction& Function, ExpressionNode* Operand );
+        
+    public:
+        
+        // instance handling
+        FunctionInlining();
+        void Clear();
+        
+        // main functions
+        void Analyze( TopLevelNode* ProgramAST );
+        const InlinedFunction* Find( FunctionNode* Function ) const;
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -16,6 +16,8 @@ string CompilerFolder;
 bool CompileOnly = false;
 bool DisableWarnings = false;
 bool EnableAllWarnings = false;
+bool RegisterCallingConvention = false;
+int OptimizationLevel = 2;
 
 
 // =============================================================================
@@ -18,6 +18,14 @@ extern bool CompileOnly;
 extern bool DisableWarnings;
 extern bool EnableAllWarnings;
 
+// when enabled, functions take their first arguments
+// in registers instead of the stack (see RegisterAllocation.hpp)
+extern bool RegisterCallingConvention;
+
+// from 0 to 2, selects which optimizations are done
+// (see the pass table in PassManager.cpp)
+extern int OptimizationLevel;
+
 
 // =============================================================================
 //      DEBUG
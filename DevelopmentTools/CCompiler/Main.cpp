@@ -12,6 +12,8 @@
     #include "VirconCParser.hpp"
     #include "VirconCAnalyzer.hpp"
     #include "VirconCEmitter.hpp"
+    #include "PassManager.hpp"
+    #include "PeepholeOptimizer.hpp"
     #include "CompilerInfrastructure.hpp"
     #include "Globals.hpp"
     #include "DebugInfo.hpp"
@@ -49,8 +51,10 @@ void PrintUsage()
     cout << "  -g           Outputs an additional file with debug info" << endl;
     cout << "  -w           Inhibit all warnings" << endl;
     cout << "  -Wall        Enable all warnings" << endl;
+    cout << "  -mregcall    Pass the first function arguments in registers" << endl;
+    cout << "  -O0,-O1,-O2  Optimization level, default is -O2 (-O3 is the same)" << endl;
     cout << "Also, the following options are accepted for compatibility" << endl;
-    cout << "but have no effect: -c,-s,-O1,-O2,-O3" << endl;
+    cout << "but have no effect: -c,-s" << endl;
 }
 
 // -----------------------------------------------------------------------------
@@ -148,6 +152,24 @@ int main( int NumberOfArguments, char* Arguments[] )
                 continue;
             }
             
+            if( Arguments[i] == string("-mregcall") )
+            {
+                RegisterCallingConvention = true;
+                continue;
+            }
+            
+            if( Arguments[i] == string("-O0") || Arguments[i] == string("-O1")
+            ||  Arguments[i] == string("-O2") || Arguments[i] == string("-O3") )
+            {
+                OptimizationLevel = Arguments[i][2] - '0';
+                
+                // -O3 has no additional optimizations
+                if( OptimizationLevel > 2 )
+                  OptimizationLevel = 2;
+                
+                continue;
+            }
+            
             if( Arguments[i] == string("-g") )
             {
                 CreateDebugVersion = true;
@@ -174,10 +196,7 @@ int main( int NumberOfArguments, char* Arguments[] )
             }
             
             // these options are accepted but have no effect
-            if( Arguments[i] == string("-s")  )  continue;
-            if( Arguments[i] == string("-O1") )  continue;
-            if( Arguments[i] == string("-O2") )  continue;
-            if( Arguments[i] == string("-O3") )  continue;
+            if( Arguments[i] == string("-s") )  continue;
             
             // discard any other parameters starting with '-'
             if( Arguments[i][0] == '-' )
@@ -274,10 +293,26 @@ int main( int NumberOfArguments, char* Arguments[] )
           throw runtime_error( "analyzer finished with errors" );
         
         // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-        // STAGE 5: Run emitter
+        // STAGE 5: Run optimization passes
+        // (AST nodes --> AST nodes)
+        if( VerboseMode )
+          cout << "stage 5: running optimization passes" << endl;
+        
+        PassManager Passes;
+        Passes.Optimize( Parser.ProgramAST );
+        
+        if( VerboseMode )
+          Passes.PrintStatistics( cout );
+        
+        // when requested, log the IR of all functions
+        if( DebugMode )
+          SaveIRLog( OutputPath + ".ir.log", Passes );
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STAGE 6: Run emitter
         // (AST nodes --> binary ROM)
         if( VerboseMode )
-          cout << "stage 5: running emitter" << endl;
+          cout << "stage 6: running emitter" << endl;
           
         VirconCEmitter Emitter;
         Emitter.Emit( *Parser.ProgramAST, ProgramIsBios );
@@ -286,6 +321,21 @@ int main( int NumberOfArguments, char* Arguments[] )
         if( CompilationErrors != 0 )
           throw runtime_error( "emitter finished with errors" );
         
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // STAGE 7: Run peephole optimizer
+        // (ASM lines --> ASM lines)
+        if( OptimizationLevel >= 1 )
+        {
+            if( VerboseMode )
+              cout << "stage 7: running peephole optimizer" << endl;
+            
+            PeepholeOptimizer Optimizer;
+            Optimizer.Optimize( Emitter );
+            
+            if( VerboseMode )
+              Optimizer.PrintStatistics( cout );
+        }
+        
         // no need for debug output here (result is final)
         if( VerboseMode )
           cout << "saving output file" << endl;
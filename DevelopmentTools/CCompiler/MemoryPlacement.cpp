@@ -24,6 +24,9 @@ MemoryPlacement::MemoryPlacement()
     
     // embedded info
     IsEmbedded = false;
+    
+    // register info
+    Register = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -100,3 +103,20 @@ string MemoryPlacement::PassingAddressString()
     
     return PassingAddress;
 }
+
+// -----------------------------------------------------------------------------
+
+// the variable still has an address, but while this is
+// true any accesses to it must use the register instead
+bool MemoryPlacement::IsInRegister()
+{
+    return (Register > 0);
+}
+
+// -----------------------------------------------------------------------------
+
+// only valid for variables in a register!
+string MemoryPlacement::RegisterName()
+{
+    return "R" + to_string( Register );
+}
@@ -31,6 +31,10 @@ class MemoryPlacement
         bool IsEmbedded;
         std::string EmbeddedName;
         
+        // locals can be kept in a register while their
+        // function runs (0 when they only use memory)
+        int Register;
+        
     public:
         
         // instance handling
@@ -40,6 +44,8 @@ class MemoryPlacement
         void AddOffset( int Offset );
         std::string AccessAddressString();
         std::string PassingAddressString();
+        bool IsInRegister();
+        std::string RegisterName();
 };
 
 
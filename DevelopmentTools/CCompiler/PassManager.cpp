@@ -0,0 +1,1675 @@
+// *****************************************************************************
+    // include project headers
+    #include "PassManager.hpp"
+    #include "Globals.hpp"
+    
+    // include C/C++ headers
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// passes that repeat until nothing changes
+// stop after this, to limit compilation time
+const int MaximumPassIterations = 32;
+
+// -----------------------------------------------------------------------------
+
+static ExpressionSlot NodeSlot( CNode*& Node )
+{
+    ExpressionSlot Slot;
+    Slot.Node = &Node;
+    Slot.Operand = nullptr;
+    return Slot;
+}
+
+// -----------------------------------------------------------------------------
+
+static ExpressionSlot OperandSlot( ExpressionNode*& Operand )
+{
+    ExpressionSlot Slot;
+    Slot.Node = nullptr;
+    Slot.Operand = &Operand;
+    return Slot;
+}
+
+// -----------------------------------------------------------------------------
+
+static ExpressionNode* GetExpression( const ExpressionSlot& Slot )
+{
+    if( Slot.Node )
+      return (ExpressionNode*)*Slot.Node;
+    
+    return *Slot.Operand;
+}
+
+// -----------------------------------------------------------------------------
+
+static void SetExpression( const ExpressionSlot& Slot, ExpressionNode* Expression )
+{
+    if( Slot.Node )
+      *Slot.Node = Expression;
+    else
+      *Slot.Operand = Expression;
+}
+
+// -----------------------------------------------------------------------------
+
+static void ReplaceWithEmptyStatement( CNode*& Statement )
+{
+    EmptyStatementNode* EmptyStatement = new EmptyStatementNode( Statement->Parent );
+    EmptyStatement->Location = Statement->Location;
+    delete Statement;
+    Statement = EmptyStatement;
+}
+
+// -----------------------------------------------------------------------------
+
+// finds an expression and all of its parts that get evaluated
+// (the operand of sizeof is not); parentheses are skipped, so
+// that the same value is not found twice
+static void FindSubexpressions( const ExpressionSlot& Slot, vector< ExpressionSlot >& Slots )
+{
+    ExpressionNode* Expression = GetExpression( Slot );
+    
+    if( Expression->Type() != CNodeTypes::EnclosedExpression )
+      Slots.push_back( Slot );
+    
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::FunctionCall:
+        {
+            for( ExpressionNode*& Parameter: ((FunctionCallNode*)Expression)->Parameters )
+              FindSubexpressions( OperandSlot( Parameter ), Slots );
+            
+            break;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+            FindSubexpressions( OperandSlot( ((ArrayAccessNode*)Expression)->ArrayOperand ), Slots );
+            FindSubexpressions( OperandSlot( ((ArrayAccessNode*)Expression)->IndexOperand ), Slots );
+            break;
+        
+        case CNodeTypes::MemberAccess:
+            FindSubexpressions( OperandSlot( ((MemberAccessNode*)Expression)->GroupOperand ), Slots );
+            break;
+        
+        case CNodeTypes::PointedMemberAccess:
+            FindSubexpressions( OperandSlot( ((PointedMemberAccessNode*)Expression)->GroupOperand ), Slots );
+            break;
+        
+        case CNodeTypes::EnclosedExpression:
+            FindSubexpressions( OperandSlot( ((EnclosedExpressionNode*)Expression)->InternalExpression ), Slots );
+            break;
+        
+        case CNodeTypes::UnaryOperation:
+            FindSubexpressions( OperandSlot( ((UnaryOperationNode*)Expression)->Operand ), Slots );
+            break;
+        
+        case CNodeTypes::BinaryOperation:
+            FindSubexpressions( OperandSlot( ((BinaryOperationNode*)Expression)->LeftOperand ), Slots );
+            FindSubexpressions( OperandSlot( ((BinaryOperationNode*)Expression)->RightOperand ), Slots );
+            break;
+        
+        case CNodeTypes::TypeConversion:
+            FindSubexpressions( OperandSlot( ((TypeConversionNode*)Expression)->ConvertedExpression ), Slots );
+            break;
+        
+        default:
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+static void FindInitializationExpressions( CNode*& InitialValue, vector< ExpressionSlot >& Slots )
+{
+    if( InitialValue->Type() == CNodeTypes::InitializationList )
+    {
+        for( CNode*& Value: ((InitializationListNode*)InitialValue)->AssignedValues )
+          FindInitializationExpressions( Value, Slots );
+    }
+    
+    else if( InitialValue->IsExpression() )
+      FindSubexpressions( NodeSlot( InitialValue ), Slots );
+}
+
+// -----------------------------------------------------------------------------
+
+// finds all expressions in a part of the code
+static void FindStatementExpressions( CNode*& Statement, vector< ExpressionSlot >& Slots )
+{
+    // some contructs have optional parts!
+    if( !Statement ) return;
+    
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+              if( Variable->InitialValue )
+                FindInitializationExpressions( Variable->InitialValue, Slots );
+            
+            break;
+        }
+        
+        // a switch is also a block, with its condition before it
+        case CNodeTypes::Switch:
+        {
+            FindSubexpressions( OperandSlot( ((SwitchNode*)Statement)->Condition ), Slots );
+            
+            for( CNode*& BlockStatement: ((BlockNode*)Statement)->Statements )
+              FindStatementExpressions( BlockStatement, Slots );
+            
+            break;
+        }
+        
+        case CNodeTypes::Block:
+        {
+            for( CNode*& BlockStatement: ((BlockNode*)Statement)->Statements )
+              FindStatementExpressions( BlockStatement, Slots );
+            
+            break;
+        }
+        
+        case CNodeTypes::If:
+        {
+            IfNode* If = (IfNode*)Statement;
+            FindSubexpressions( OperandSlot( If->Condition ), Slots );
+            FindStatementExpressions( If->TrueStatement, Slots );
+            FindStatementExpressions( If->FalseStatement, Slots );
+            break;
+        }
+        
+        case CNodeTypes::While:
+        {
+            WhileNode* While = (WhileNode*)Statement;
+            FindSubexpressions( OperandSlot( While->Condition ), Slots );
+            FindStatementExpressions( While->LoopStatement, Slots );
+            break;
+        }
+        
+        case CNodeTypes::Do:
+        {
+            DoNode* Do = (DoNode*)Statement;
+            FindStatementExpressions( Do->LoopStatement, Slots );
+            FindSubexpressions( OperandSlot( Do->Condition ), Slots );
+            break;
+        }
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Statement;
+            FindStatementExpressions( For->InitialAction, Slots );
+            
+            if( For->Condition )
+              FindSubexpressions( OperandSlot( For->Condition ), Slots );
+            
+            FindStatementExpressions( For->LoopStatement, Slots );
+            
+            if( For->IterationAction )
+              FindSubexpressions( OperandSlot( For->IterationAction ), Slots );
+            
+            break;
+        }
+        
+        case CNodeTypes::Return:
+        {
+            ReturnNode* Return = (ReturnNode*)Statement;
+            
+            if( Return->ReturnedExpression )
+              FindSubexpressions( OperandSlot( Return->ReturnedExpression ), Slots );
+            
+            break;
+        }
+        
+        default:
+        {
+            if( Statement->IsExpression() )
+              FindSubexpressions( NodeSlot( Statement ), Slots );
+            
+            break;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// Describes a pure expression as text, that is the same for all
+// expressions that always compute the same value. Leaves can only
+// be constants or variables (no memory is read), and divisions
+// must be by a non zero constant so that they never fail.
+static bool DescribeExpression( ExpressionNode* Expression, string& Text, int& Operations, set< VariableNode* >& Leaves )
+{
+    if( Expression->IsStatic() )
+    {
+        if( DividesByStaticZero( Expression ) )
+          return false;
+        
+        Text = "#" + Expression->ReturnedType->ToString() + ":" + to_string( Expression->GetStaticValue().Word.AsInteger );
+        return true;
+    }
+    
+    switch( Expression->Type() )
+    {
+        case CNodeTypes::ExpressionAtom:
+        {
+            VariableNode* Variable = NamedVariable( Expression );
+            
+            if( !Variable )
+              return false;
+            
+            DataTypes VariableType = Variable->DeclaredType->Type();
+            
+            if( VariableType != DataTypes::Primitive && VariableType != DataTypes::Pointer )
+              return false;
+            
+            Leaves.insert( Variable );
+            Text = Variable->Name + "@" + to_string( Variable->LabelNumber );
+            return true;
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+            return DescribeExpression( ((EnclosedExpressionNode*)Expression)->InternalExpression, Text, Operations, Leaves );
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* Operation = (UnaryOperationNode*)Expression;
+            
+            if( Operation->Operator == UnaryOperators::PlusSign )
+              return DescribeExpression( Operation->Operand, Text, Operations, Leaves );
+            
+            if( Operation->Operator != UnaryOperators::MinusSign
+            &&  Operation->Operator != UnaryOperators::LogicalNot
+            &&  Operation->Operator != UnaryOperators::BitwiseNot )
+              return false;
+            
+            string OperandText;
+            
+            if( !DescribeExpression( Operation->Operand, OperandText, Operations, Leaves ) )
+              return false;
+            
+            Text = "u" + to_string( (int)Operation->Operator ) + ":" + Expression->ReturnedType->ToString();
+            Text += "(" + OperandText + ")";
+            Operations++;
+            return true;
+        }
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* Operation = (BinaryOperationNode*)Expression;
+            BinaryOperators Operator = Operation->Operator;
+            
+            if( IsAssignment( Operator ) )
+              return false;
+            
+            if( Operator == BinaryOperators::Division || Operator == BinaryOperators::Modulus )
+              if( !Operation->RightOperand->IsStatic() || DividesByStaticZero( Operation ) )
+                return false;
+            
+            string LeftText, RightText;
+            
+            if( !DescribeExpression( Operation->LeftOperand, LeftText, Operations, Leaves )
+            ||  !DescribeExpression( Operation->RightOperand, RightText, Operations, Leaves ) )
+              return false;
+            
+            // the order of operands does not matter here
+            bool IsCommutative = (Operator == BinaryOperators::Addition
+                              ||  Operator == BinaryOperators::Product
+                              ||  Operator == BinaryOperators::BitwiseAnd
+                              ||  Operator == BinaryOperators::BitwiseOr
+                              ||  Operator == BinaryOperators::BitwiseXor
+                              ||  Operator == BinaryOperators::Equal
+                              ||  Operator == BinaryOperators::NotEqual);
+            
+            if( IsCommutative && RightText < LeftText )
+              swap( LeftText, RightText );
+            
+            Text = "b" + to_string( (int)Operator ) + ":" + Expression->ReturnedType->ToString();
+            Text += "(" + LeftText + "," + RightText + ")";
+            Operations++;
+            return true;
+        }
+        
+        case CNodeTypes::TypeConversion:
+        {
+            string OperandText;
+            
+            if( !DescribeExpression( ((TypeConversionNode*)Expression)->ConvertedExpression, OperandText, Operations, Leaves ) )
+              return false;
+            
+            Text = "c:" + Expression->ReturnedType->ToString() + "(" + OperandText + ")";
+            Operations++;
+            return true;
+        }
+        
+        default:
+            return false;
+    }
+}
+
+
+// =============================================================================
+//      OPTIMIZATION PASSES
+// =============================================================================
+
+
+// Each pass optimizes the current function of the manager,
+// and returns how many changes it made. Passes are run in
+// the order of this table, when the optimization level is
+// at least their minimum level.
+typedef unsigned (*OptimizationPassFunction)( PassManager& Manager );
+
+typedef struct
+{
+    const char* Name;
+    int MinimumLevel;
+    OptimizationPassFunction Run;
+}
+OptimizationPass;
+
+// -----------------------------------------------------------------------------
+
+static unsigned PropagateValues( PassManager& Manager )
+{
+    unsigned PreviousChanges = Manager.Simplifier.TotalChanges();
+    Manager.Simplifier.OptimizeFunction( Manager.Function );
+    return Manager.Simplifier.TotalChanges() - PreviousChanges;
+}
+
+// -----------------------------------------------------------------------------
+
+// conditions that are known only keep the branch that
+// is taken, unless the other one can be entered from
+// labels or cases (then the graph still removes its
+// unreachable statements)
+static unsigned FoldStaticConditions( CNode*& Statement )
+{
+    // some contructs have optional parts!
+    if( !Statement ) return 0;
+    
+    unsigned Changes = 0;
+    
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::Block:
+        case CNodeTypes::Switch:
+        {
+            for( CNode*& BlockStatement: ((BlockNode*)Statement)->Statements )
+              Changes += FoldStaticConditions( BlockStatement );
+            
+            return Changes;
+        }
+        
+        case CNodeTypes::If:
+        {
+            IfNode* If = (IfNode*)Statement;
+            Changes += FoldStaticConditions( If->TrueStatement );
+            Changes += FoldStaticConditions( If->FalseStatement );
+            
+            bool IsTrue;
+            
+            if( !GetStaticCondition( If->Condition, IsTrue ) )
+              return Changes;
+            
+            CNode*& TakenBranch = (IsTrue? If->TrueStatement : If->FalseStatement);
+            CNode* DroppedBranch = (IsTrue? If->FalseStatement : If->TrueStatement);
+            
+            if( DroppedBranch && HasEntryPoints( DroppedBranch ) )
+              return Changes;
+            
+            // detach the taken branch before deleting the rest
+            CNode* Replacement = TakenBranch;
+            TakenBranch = nullptr;
+            
+            if( Replacement )
+              Replacement->Parent = If->Parent;
+            
+            else
+            {
+                Replacement = new EmptyStatementNode( If->Parent );
+                Replacement->Location = If->Location;
+            }
+            
+            delete If;
+            Statement = Replacement;
+            return Changes + 1;
+        }
+        
+        case CNodeTypes::While:
+        {
+            WhileNode* While = (WhileNode*)Statement;
+            Changes += FoldStaticConditions( While->LoopStatement );
+            
+            bool IsTrue;
+            
+            if( GetStaticCondition( While->Condition, IsTrue ) && !IsTrue && !HasEntryPoints( While ) )
+            {
+                ReplaceWithEmptyStatement( Statement );
+                Changes++;
+            }
+            
+            return Changes;
+        }
+        
+        case CNodeTypes::Do:
+            return FoldStaticConditions( ((DoNode*)Statement)->LoopStatement );
+        
+        case CNodeTypes::For:
+            return FoldStaticConditions( ((ForNode*)Statement)->LoopStatement );
+        
+        default:
+            return 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// removes statements in blocks that cannot be reached;
+// labels, cases and asm blocks are always kept, and so
+// are statements that contain any of them
+static unsigned RemoveUnreachableStatements( PassManager& Manager )
+{
+    vector< StatementPosition > Removals;
+    set< CNode* > RemovedStatements;
+    
+    for( BasicBlock* Block: Manager.Graph.Blocks )
+    {
+        if( Block->IsReachable )
+          continue;
+        
+        for( StatementPosition& Position: Block->Statements )
+        {
+            CNode* Statement = *Position.Slot;
+            
+            switch( Statement->Type() )
+            {
+                case CNodeTypes::EmptyStatement:
+                case CNodeTypes::Label:
+                case CNodeTypes::Case:
+                case CNodeTypes::Default:
+                case CNodeTypes::AssemblyBlock:
+                    continue;
+                
+                // declarations only lose their initial values
+                case CNodeTypes::VariableList:
+                    break;
+                
+                default:
+                {
+                    if( HasEntryPoints( Statement ) || !Position.List )
+                      continue;
+                    
+                    break;
+                }
+            }
+            
+            Removals.push_back( Position );
+            RemovedStatements.insert( Statement );
+        }
+    }
+    
+    // statements within others that are removed are
+    // deleted with them, so they need no changes
+    vector< StatementPosition > OuterRemovals;
+    
+    for( StatementPosition& Position: Removals )
+    {
+        bool IsNested = false;
+        
+        for( CNode* Container = (*Position.Slot)->Parent; Container; Container = Container->Parent )
+          if( RemovedStatements.count( Container ) )
+            IsNested = true;
+        
+        if( !IsNested )
+          OuterRemovals.push_back( Position );
+    }
+    
+    unsigned Changes = 0;
+    
+    for( StatementPosition& Position: OuterRemovals )
+    {
+        CNode*& Statement = *Position.Slot;
+        
+        if( Statement->Type() != CNodeTypes::VariableList )
+        {
+            ReplaceWithEmptyStatement( Statement );
+            Changes++;
+            continue;
+        }
+        
+        for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+        {
+            if( !Variable->InitialValue )
+              continue;
+            
+            delete Variable->InitialValue;
+            Variable->InitialValue = nullptr;
+            Changes++;
+        }
+    }
+    
+    return Changes;
+}
+
+// -----------------------------------------------------------------------------
+
+// removes stores to variables whose value is
+// never read again before the next store
+static unsigned RemoveDeadStores( PassManager& Manager )
+{
+    ControlFlowGraph& Graph = Manager.Graph;
+    set< CNode* > DeadStores;
+    
+    for( BasicBlock* Block: Graph.Blocks )
+    {
+        set< VariableNode* > LiveVariables = Block->LiveOut;
+        
+        for( auto Instruction = Block->Instructions.rbegin(); Instruction != Block->Instructions.rend(); Instruction++ )
+        {
+            VariableNode* AssignedVariable = Instruction->AssignedVariable();
+            
+            if( AssignedVariable && Graph.TrackedVariables.count( AssignedVariable ) )
+            {
+                if( !LiveVariables.count( AssignedVariable ) )
+                  DeadStores.insert( Instruction->Source );
+                
+                LiveVariables.erase( AssignedVariable );
+            }
+            
+            set< VariableNode* > ReadVariables;
+            Instruction->AddReadVariables( ReadVariables );
+            
+            for( VariableNode* Variable: ReadVariables )
+              if( Graph.TrackedVariables.count( Variable ) )
+                LiveVariables.insert( Variable );
+        }
+    }
+    
+    unsigned Changes = 0;
+    
+    for( BasicBlock* Block: Graph.Blocks )
+    {
+        for( StatementPosition& Position: Block->Statements )
+        {
+            CNode*& Statement = *Position.Slot;
+            
+            if( Statement->Type() == CNodeTypes::VariableList )
+            {
+                for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+                {
+                    if( !DeadStores.count( Variable ) || !Variable->InitialValue || !Variable->InitialValue->IsExpression() )
+                      continue;
+                    
+                    if( ((ExpressionNode*)Variable->InitialValue)->HasSideEffects() )
+                      continue;
+                    
+                    delete Variable->InitialValue;
+                    Variable->InitialValue = nullptr;
+                    Changes++;
+                }
+                
+                continue;
+            }
+            
+            // only complete statements are removed
+            if( !Statement->IsExpression() || !Position.List )
+              continue;
+            
+            ExpressionNode* Expression = Unenclosed( (ExpressionNode*)Statement );
+            
+            if( !DeadStores.count( Expression ) )
+              continue;
+            
+            if( Expression->Type() == CNodeTypes::BinaryOperation )
+              if( ((BinaryOperationNode*)Expression)->RightOperand->HasSideEffects() )
+                continue;
+            
+            ReplaceWithEmptyStatement( Statement );
+            Changes++;
+        }
+    }
+    
+    return Changes;
+}
+
+// -----------------------------------------------------------------------------
+
+static unsigned EliminateDeadCode( PassManager& Manager )
+{
+    unsigned Changes = 0;
+    
+    for( CNode*& Statement: Manager.Function->Statements )
+      Changes += FoldStaticConditions( Statement );
+    
+    Manager.Graph.Build( Manager.Function );
+    Changes += RemoveUnreachableStatements( Manager );
+    
+    // removing a store can leave others dead
+    for( int Iteration = 0; Iteration < MaximumPassIterations; Iteration++ )
+    {
+        Manager.Graph.Build( Manager.Function );
+        unsigned RemovedStores = RemoveDeadStores( Manager );
+        
+        if( !RemovedStores )
+          break;
+        
+        Changes += RemovedStores;
+    }
+    
+    return Changes;
+}
+
+// -----------------------------------------------------------------------------
+
+// expressions that compute the same value, and the
+// code where they are evaluated
+typedef struct
+{
+    vector< ExpressionSlot > Occurrences;
+    set< VariableNode* > Leaves;
+    int Operations;
+    StatementPosition Position;
+}
+ExpressionGroup;
+
+// -----------------------------------------------------------------------------
+
+// finds the variables that a loop can change, including the
+// initial action of for loops (it runs after code placed just
+// before the loop). Stores are attributed to a variable when
+// their address is calculated from it; other stores, calls and
+// asm blocks could write anywhere in memory
+static void FindLoopWrites( ControlFlowGraph& Graph, NaturalLoop& Loop, CNode* InitialAction, set< VariableNode* >& WrittenVariables, bool& WritesAnyMemory )
+{
+    CNode* LoopStatement = Loop.Header->LoopStatement;
+    WritesAnyMemory = false;
+    
+    for( BasicBlock* Block: Graph.Blocks )
+    {
+        bool IsInLoop = Loop.Blocks.count( Block );
+        
+        for( IRInstruction& Instruction: Block->Instructions )
+        {
+            if( !IsInLoop && !(InitialAction && IsWithin( Instruction.Source, InitialAction )) )
+              continue;
+            
+            if( Instruction.AssignedVariable() )
+              WrittenVariables.insert( Instruction.AssignedVariable() );
+            
+            if( Instruction.Operation == IROperations::Store )
+            {
+                VariableNode* StoredVariable = Graph.FindAccessedVariable( Instruction.Left );
+                
+                if( StoredVariable )
+                  WrittenVariables.insert( StoredVariable );
+                else
+                  WritesAnyMemory = true;
+            }
+            
+            if( Instruction.Operation == IROperations::Call
+            ||  Instruction.Operation == IROperations::Assembly )
+              WritesAnyMemory = true;
+        }
+    }
+    
+    // variables declared in the loop get new values
+    VariableUses LoopUses;
+    FindVariableUses( LoopStatement, LoopUses );
+    WrittenVariables.insert( LoopUses.Declared.begin(), LoopUses.Declared.end() );
+}
+
+// -----------------------------------------------------------------------------
+
+// finds the expressions in a loop that compute the same
+// value in all iterations, and moves the one that saves
+// the most operations before the loop
+static bool HoistFromLoop( PassManager& Manager, NaturalLoop& Loop, map< CNode*, StatementPosition >& Positions )
+{
+    ControlFlowGraph& Graph = Manager.Graph;
+    CNode* LoopStatement = Loop.Header->LoopStatement;
+    
+    // loops made with goto are not changed, and neither
+    // are loops that can be entered from the middle
+    if( !LoopStatement || !Positions.count( LoopStatement ) )
+      return false;
+    
+    StatementPosition& LoopPosition = Positions[ LoopStatement ];
+    
+    if( HasEntryPoints( LoopStatement ) )
+      return false;
+    
+    // the initial action of a for loop runs
+    // after the values are calculated
+    CNode* InitialAction = nullptr;
+    
+    if( LoopStatement->Type() == CNodeTypes::For )
+      InitialAction = ((ForNode*)LoopStatement)->InitialAction;
+    
+    set< VariableNode* > WrittenVariables;
+    bool WritesAnyMemory = false;
+    FindLoopWrites( Graph, Loop, InitialAction, WrittenVariables, WritesAnyMemory );
+    
+    // group the invariant expressions
+    vector< ExpressionSlot > Slots;
+    FindStatementExpressions( *LoopPosition.Slot, Slots );
+    map< string, ExpressionGroup > Groups;
+    
+    for( ExpressionSlot& Slot: Slots )
+    {
+        ExpressionNode* Expression = GetExpression( Slot );
+        
+        if( Expression->IsStatic() )
+          continue;
+        
+        string Text;
+        int Operations = 0;
+        set< VariableNode* > Leaves;
+        
+        if( !DescribeExpression( Expression, Text, Operations, Leaves ) || Operations == 0 )
+          continue;
+        
+        bool IsInvariant = true;
+        
+        for( VariableNode* Leaf: Leaves )
+          if( WrittenVariables.count( Leaf ) || (WritesAnyMemory && !Graph.TrackedVariables.count( Leaf )) )
+            IsInvariant = false;
+        
+        if( !IsInvariant )
+          continue;
+        
+        ExpressionGroup& Group = Groups[ Text ];
+        Group.Occurrences.push_back( Slot );
+        Group.Operations = Operations;
+    }
+    
+    ExpressionGroup* BestGroup = nullptr;
+    
+    for( auto& GroupPair: Groups )
+    {
+        ExpressionGroup& Group = GroupPair.second;
+        
+        if( !BestGroup || Group.Operations * Group.Occurrences.size() > BestGroup->Operations * BestGroup->Occurrences.size() )
+          BestGroup = &Group;
+    }
+    
+    if( !BestGroup )
+      return false;
+    
+    Manager.ReplaceWithTemporary( BestGroup->Occurrences, LoopPosition );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static unsigned HoistLoopInvariants( PassManager& Manager )
+{
+    // inlined functions cannot have variables
+    if( Manager.Inlining.Find( Manager.Function ) )
+      return 0;
+    
+    unsigned Changes = 0;
+    
+    for( int Iteration = 0; Iteration < MaximumPassIterations; Iteration++ )
+    {
+        ControlFlowGraph& Graph = Manager.Graph;
+        Graph.Build( Manager.Function );
+        
+        map< CNode*, StatementPosition > Positions;
+        
+        for( BasicBlock* Block: Graph.Blocks )
+          for( StatementPosition& Position: Block->Statements )
+            Positions[ *Position.Slot ] = Position;
+        
+        // loops are sorted with outer loops first
+        bool ExpressionWasHoisted = false;
+        
+        for( NaturalLoop& Loop: Graph.Loops )
+          if( HoistFromLoop( Manager, Loop, Positions ) )
+          {
+              ExpressionWasHoisted = true;
+              break;
+          }
+        
+        if( !ExpressionWasHoisted )
+          break;
+        
+        Changes++;
+    }
+    
+    return Changes;
+}
+
+// -----------------------------------------------------------------------------
+
+// finds the variable that the iteration action of a for loop
+// changes by a constant step, and the value it starts from
+// (a constant or a variable, that can be read again before
+// the initial action with the same result)
+static bool FindInductionVariable( ForNode* For, VariableNode*& Variable, ExpressionNode*& StartValue, int& Step )
+{
+    if( !For->InitialAction || !For->IterationAction )
+      return false;
+    
+    ExpressionNode* Iteration = Unenclosed( For->IterationAction );
+    
+    if( Iteration->Type() == CNodeTypes::UnaryOperation )
+    {
+        UnaryOperationNode* Operation = (UnaryOperationNode*)Iteration;
+        
+        if( !IsIncrementOrDecrement( Operation->Operator ) )
+          return false;
+        
+        bool IsIncrement = (Operation->Operator == UnaryOperators::PreIncrement
+                         || Operation->Operator == UnaryOperators::PostIncrement);
+        
+        Variable = NamedVariable( Operation->Operand );
+        Step = (IsIncrement? 1 : -1);
+    }
+    
+    else if( Iteration->Type() == CNodeTypes::BinaryOperation )
+    {
+        BinaryOperationNode* Operation = (BinaryOperationNode*)Iteration;
+        
+        if( Operation->Operator != BinaryOperators::AdditionAssignment
+        &&  Operation->Operator != BinaryOperators::SubtractionAssignment )
+          return false;
+        
+        if( !Operation->RightOperand->IsStatic() || !TypeIsThisPrimitive( Operation->RightOperand->ReturnedType, PrimitiveTypes::Int ) )
+          return false;
+        
+        Variable = NamedVariable( Operation->LeftOperand );
+        Step = Operation->RightOperand->GetStaticValue().Word.AsInteger;
+        
+        if( Operation->Operator == BinaryOperators::SubtractionAssignment )
+          Step = -Step;
+    }
+    
+    else return false;
+    
+    if( !Variable || !TypeIsThisPrimitive( Variable->DeclaredType, PrimitiveTypes::Int ) )
+      return false;
+    
+    // find the start value in the initial action
+    StartValue = nullptr;
+    
+    if( For->InitialAction->Type() == CNodeTypes::VariableList )
+    {
+        for( VariableNode* DeclaredVariable: ((VariableListNode*)For->InitialAction)->Variables )
+          if( DeclaredVariable == Variable && Variable->InitialValue && Variable->InitialValue->IsExpression() )
+            StartValue = (ExpressionNode*)Variable->InitialValue;
+    }
+    
+    else if( For->InitialAction->IsExpression() )
+    {
+        ExpressionNode* Initialization = Unenclosed( (ExpressionNode*)For->InitialAction );
+        
+        if( Initialization->Type() == CNodeTypes::BinaryOperation )
+        {
+            BinaryOperationNode* Assignment = (BinaryOperationNode*)Initialization;
+            
+            if( Assignment->Operator == BinaryOperators::Assignment && NamedVariable( Assignment->LeftOperand ) == Variable )
+              StartValue = Assignment->RightOperand;
+        }
+    }
+    
+    if( !StartValue || !TypeIsThisPrimitive( StartValue->ReturnedType, PrimitiveTypes::Int ) )
+      return false;
+    
+    if( StartValue->IsStatic() )
+      return true;
+    
+    VariableNode* StartVariable = NamedVariable( StartValue );
+    return (StartVariable && StartVariable != Variable);
+}
+
+// -----------------------------------------------------------------------------
+
+// describes as text an address that does not change in a
+// loop: an array declared outside of it, a pointer that the
+// loop does not change, or elements of those that are arrays
+static bool DescribeInvariantAddress( ExpressionNode* Expression, CNode* Loop, ControlFlowGraph& Graph, const set< VariableNode* >& WrittenVariables, string& Text )
+{
+    Expression = Unenclosed( Expression );
+    VariableNode* Variable = NamedVariable( Expression );
+    
+    if( Variable )
+    {
+        DataTypes VariableType = Variable->DeclaredType->Type();
+        
+        if( IsWithin( Variable->OwnerScope, Loop ) )
+          return false;
+        
+        if( VariableType == DataTypes::Pointer )
+          if( !Graph.TrackedVariables.count( Variable ) || WrittenVariables.count( Variable ) )
+            return false;
+        
+        if( VariableType != DataTypes::Array && VariableType != DataTypes::Pointer )
+          return false;
+        
+        Text = Variable->Name + "@" + to_string( Variable->LabelNumber );
+        return true;
+    }
+    
+    if( Expression->Type() != CNodeTypes::ArrayAccess || Expression->ReturnedType->Type() != DataTypes::Array )
+      return false;
+    
+    ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Expression;
+    string ArrayText, IndexText;
+    
+    if( !DescribeInvariantAddress( ArrayAccess->ArrayOperand, Loop, Graph, WrittenVariables, ArrayText ) )
+      return false;
+    
+    if( ArrayAccess->IndexOperand->IsStatic() )
+      IndexText = to_string( ArrayAccess->IndexOperand->GetStaticValue().Word.AsInteger );
+    
+    else
+    {
+        VariableNode* IndexVariable = NamedVariable( ArrayAccess->IndexOperand );
+        
+        if( !IndexVariable || !Graph.TrackedVariables.count( IndexVariable ) || WrittenVariables.count( IndexVariable ) )
+          return false;
+        
+        IndexText = IndexVariable->Name + "@" + to_string( IndexVariable->LabelNumber );
+    }
+    
+    Text = ArrayText + "[" + IndexText + "]";
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// tells if a continue statement jumps to the end of a loop
+static bool ContinuesLoop( CNode* Node, CNode* Loop )
+{
+    if( !Node )
+      return false;
+    
+    switch( Node->Type() )
+    {
+        case CNodeTypes::Continue:
+            return (((ContinueNode*)Node)->LoopContext == Loop);
+        
+        case CNodeTypes::Block:
+        case CNodeTypes::Switch:
+        {
+            for( CNode* Statement: ((BlockNode*)Node)->Statements )
+              if( ContinuesLoop( Statement, Loop ) )
+                return true;
+            
+            return false;
+        }
+        
+        case CNodeTypes::If:
+            return ContinuesLoop( ((IfNode*)Node)->TrueStatement, Loop )
+                || ContinuesLoop( ((IfNode*)Node)->FalseStatement, Loop );
+        
+        case CNodeTypes::While:
+            return ContinuesLoop( ((WhileNode*)Node)->LoopStatement, Loop );
+        
+        case CNodeTypes::Do:
+            return ContinuesLoop( ((DoNode*)Node)->LoopStatement, Loop );
+        
+        case CNodeTypes::For:
+            return ContinuesLoop( ((ForNode*)Node)->LoopStatement, Loop );
+        
+        default:
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// In a for loop with an induction variable i, accesses like a[i]
+// are replaced with p[0], where p is a new pointer that starts
+// at the first element and is advanced at the end of the body.
+// This saves the calculation of the address (with a product,
+// for large elements) every time. The group of accesses with
+// the largest savings is replaced, if they pay for the pointer
+static bool ReduceInductionVariable( PassManager& Manager, NaturalLoop& Loop, map< CNode*, StatementPosition >& Positions )
+{
+    ControlFlowGraph& Graph = Manager.Graph;
+    CNode* LoopStatement = Loop.Header->LoopStatement;
+    
+    if( !LoopStatement || LoopStatement->Type() != CNodeTypes::For || !Positions.count( LoopStatement ) )
+      return false;
+    
+    ForNode* For = (ForNode*)LoopStatement;
+    
+    if( !For->LoopStatement || For->LoopStatement->Type() == CNodeTypes::VariableList || HasEntryPoints( For ) )
+      return false;
+    
+    VariableNode* Induction;
+    ExpressionNode* StartValue;
+    int Step;
+    
+    if( !FindInductionVariable( For, Induction, StartValue, Step ) || !Graph.TrackedVariables.count( Induction ) )
+      return false;
+    
+    // the pointer is advanced at the end of
+    // the body, which continue would skip
+    if( ContinuesLoop( For->LoopStatement, For ) )
+      return false;
+    
+    // loops that the emitter does as a single
+    // block operation are already faster
+    BinaryOperationNode* BlockAssignment;
+    ExpressionNode* BlockLimit;
+    bool BlockLimitIsIncluded;
+    
+    if( IsBlockOperationLoop( For, BlockAssignment, BlockLimit, BlockLimitIsIncluded ) )
+      return false;
+    
+    // the variable can only change in the iteration action
+    for( BasicBlock* Block: Loop.Blocks )
+      for( IRInstruction& Instruction: Block->Instructions )
+        if( Instruction.AssignedVariable() == Induction && !IsWithin( Instruction.Source, For->IterationAction ) )
+          return false;
+    
+    set< VariableNode* > WrittenVariables;
+    bool WritesAnyMemory;
+    FindLoopWrites( Graph, Loop, For->InitialAction, WrittenVariables, WritesAnyMemory );
+    
+    // group the accesses by array
+    vector< ExpressionSlot > Slots;
+    FindStatementExpressions( For->LoopStatement, Slots );
+    map< string, vector< ArrayAccessNode* > > Groups;
+    
+    for( ExpressionSlot& Slot: Slots )
+    {
+        ExpressionNode* Expression = GetExpression( Slot );
+        
+        if( Expression->Type() != CNodeTypes::ArrayAccess )
+          continue;
+        
+        ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Expression;
+        string Text;
+        
+        if( NamedVariable( ArrayAccess->IndexOperand ) != Induction )
+          continue;
+        
+        if( DescribeInvariantAddress( ArrayAccess->ArrayOperand, For, Graph, WrittenVariables, Text ) )
+          Groups[ Text ].push_back( ArrayAccess );
+    }
+    
+    // each access saves adding the index and finding the
+    // array address; advancing the pointer costs one addition
+    vector< ArrayAccessNode* >* BestGroup = nullptr;
+    int BestSavings = 1;
+    
+    for( auto& GroupPair: Groups )
+    {
+        ArrayAccessNode* First = GroupPair.second[ 0 ];
+        int SavingsPerAccess = 1;
+        
+        if( First->ReturnedType->SizeInWords() != 1 )
+          SavingsPerAccess++;
+        
+        if( Unenclosed( First->ArrayOperand )->Type() == CNodeTypes::ArrayAccess )
+          SavingsPerAccess++;
+        
+        int Savings = SavingsPerAccess * GroupPair.second.size();
+        
+        if( Savings > BestSavings )
+        {
+            BestGroup = &GroupPair.second;
+            BestSavings = Savings;
+        }
+    }
+    
+    if( !BestGroup )
+      return false;
+    
+    // the pointer starts at the address of the first
+    // element, taken from the first of the accesses
+    ArrayAccessNode* First = (*BestGroup)[ 0 ];
+    SourceLocation Location = For->Location;
+    
+    ArrayAccessNode* FirstElement = new ArrayAccessNode( nullptr );
+    FirstElement->Location = Location;
+    FirstElement->ArrayOperand = First->ArrayOperand;
+    FirstElement->ArrayOperand->Parent = FirstElement;
+    
+    if( StartValue->IsStatic() )
+      FirstElement->IndexOperand = NewLiteral( StartValue->GetStaticValue(), FirstElement, Location );
+    else
+      FirstElement->IndexOperand = NewVariableAtom( NamedVariable( StartValue ), FirstElement, Location );
+    
+    FirstElement->DetermineReturnedType();
+    
+    UnaryOperationNode* FirstAddress = new UnaryOperationNode( nullptr );
+    FirstAddress->Location = Location;
+    FirstAddress->Operator = UnaryOperators::Reference;
+    FirstAddress->Operand = FirstElement;
+    FirstElement->Parent = FirstAddress;
+    FirstAddress->DetermineReturnedType();
+    
+    VariableNode* Pointer = Manager.DeclareTemporary( FirstAddress->ReturnedType, Positions[ For ] );
+    Pointer->InitialValue = FirstAddress;
+    FirstAddress->Parent = Pointer;
+    FirstAddress->AllocateTemporaries();
+    
+    for( ArrayAccessNode* ArrayAccess: *BestGroup )
+    {
+        if( ArrayAccess != First )
+          delete ArrayAccess->ArrayOperand;
+        
+        delete ArrayAccess->IndexOperand;
+        ArrayAccess->ArrayOperand = NewVariableAtom( Pointer, ArrayAccess, ArrayAccess->Location );
+        ArrayAccess->IndexOperand = NewLiteral( StaticValue( 0 ), ArrayAccess, ArrayAccess->Location );
+    }
+    
+    // advance the pointer at the end of the body
+    StatementPosition BodyPosition;
+    BodyPosition.Slot = &For->LoopStatement;
+    BodyPosition.List = nullptr;
+    
+    if( For->LoopStatement->Type() != CNodeTypes::Block )
+      Manager.PlaceInBlock( BodyPosition );
+    
+    BlockNode* Body = (BlockNode*)For->LoopStatement;
+    ExpressionNode* Advance;
+    
+    if( Step == 1 || Step == -1 )
+    {
+        UnaryOperationNode* Increment = new UnaryOperationNode( Body );
+        Increment->Location = Location;
+        Increment->Operator = (Step == 1? UnaryOperators::PreIncrement : UnaryOperators::PreDecrement);
+        Increment->Operand = NewVariableAtom( Pointer, Increment, Location );
+        Increment->DetermineReturnedType();
+        Advance = Increment;
+    }
+    
+    else
+    {
+        Advance = NewBinaryOperation
+        (
+            BinaryOperators::AdditionAssignment,
+            NewVariableAtom( Pointer, Body, Location ),
+            NewLiteral( StaticValue( Step ), Body, Location ),
+            Body, Location
+        );
+    }
+    
+    Body->Statements.push_back( Advance );
+    Advance->AllocateTemporaries();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static unsigned ReduceInductionVariables( PassManager& Manager )
+{
+    // inlined functions cannot have variables
+    if( Manager.Inlining.Find( Manager.Function ) )
+      return 0;
+    
+    unsigned Changes = 0;
+    
+    for( int Iteration = 0; Iteration < MaximumPassIterations; Iteration++ )
+    {
+        ControlFlowGraph& Graph = Manager.Graph;
+        Graph.Build( Manager.Function );
+        
+        map< CNode*, StatementPosition > Positions;
+        
+        for( BasicBlock* Block: Graph.Blocks )
+          for( StatementPosition& Position: Block->Statements )
+            Positions[ *Position.Slot ] = Position;
+        
+        bool AccessesWereReduced = false;
+        
+        for( NaturalLoop& Loop: Graph.Loops )
+          if( ReduceInductionVariable( Manager, Loop, Positions ) )
+          {
+              AccessesWereReduced = true;
+              break;
+          }
+        
+        if( !AccessesWereReduced )
+          break;
+        
+        Changes++;
+    }
+    
+    return Changes;
+}
+
+// -----------------------------------------------------------------------------
+
+// finds the expressions that a statement evaluates in its
+// own block, and the variables that it assigns last (so they
+// are read before, in the expressions of the statement)
+static void FindEvaluatedExpressions( CNode*& Statement, vector< ExpressionSlot >& Roots, set< VariableNode* >& Targets )
+{
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+            {
+                Targets.insert( Variable );
+                
+                if( Variable->InitialValue && Variable->InitialValue->IsExpression() )
+                  Roots.push_back( NodeSlot( Variable->InitialValue ) );
+            }
+            
+            return;
+        }
+        
+        case CNodeTypes::If:
+            Roots.push_back( OperandSlot( ((IfNode*)Statement)->Condition ) );
+            return;
+        
+        case CNodeTypes::Switch:
+            Roots.push_back( OperandSlot( ((SwitchNode*)Statement)->Condition ) );
+            return;
+        
+        case CNodeTypes::Return:
+        {
+            ReturnNode* Return = (ReturnNode*)Statement;
+            
+            if( Return->ReturnedExpression )
+              Roots.push_back( OperandSlot( Return->ReturnedExpression ) );
+            
+            return;
+        }
+        
+        default:
+        {
+            if( !Statement->IsExpression() )
+              return;
+            
+            Roots.push_back( NodeSlot( Statement ) );
+            ExpressionNode* Expression = Unenclosed( (ExpressionNode*)Statement );
+            
+            if( Expression->Type() != CNodeTypes::BinaryOperation )
+              return;
+            
+            BinaryOperationNode* Assignment = (BinaryOperationNode*)Expression;
+            
+            if( IsAssignment( Assignment->Operator ) && NamedVariable( Assignment->LeftOperand ) )
+              Targets.insert( NamedVariable( Assignment->LeftOperand ) );
+            
+            return;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// finds groups of expressions that compute the same value in
+// consecutive statements of a block, and replaces the group
+// that saves the most operations with a variable
+static bool ReplaceCommonSubexpressions( PassManager& Manager )
+{
+    ControlFlowGraph& Graph = Manager.Graph;
+    vector< ExpressionGroup > FinishedGroups;
+    
+    for( BasicBlock* Block: Graph.Blocks )
+    {
+        if( !Block->IsReachable )
+          continue;
+        
+        map< string, ExpressionGroup > Groups;
+        list< CNode* >* CurrentList = nullptr;
+        
+        for( StatementPosition& Position: Block->Statements )
+        {
+            // the variable must be declared in the
+            // same list as all of the statements
+            if( !Position.List || Position.List != CurrentList )
+            {
+                for( auto& GroupPair: Groups )
+                  FinishedGroups.push_back( GroupPair.second );
+                
+                Groups.clear();
+                CurrentList = Position.List;
+                
+                if( !CurrentList )
+                  continue;
+            }
+            
+            vector< ExpressionSlot > Roots;
+            set< VariableNode* > Targets;
+            FindEvaluatedExpressions( *Position.Slot, Roots, Targets );
+            
+            VariableUses StatementUses;
+            vector< ExpressionSlot > Slots;
+            
+            for( ExpressionSlot& Root: Roots )
+            {
+                FindVariableUses( GetExpression( Root ), StatementUses );
+                FindSubexpressions( Root, Slots );
+            }
+            
+            if( (*Position.Slot)->Type() == CNodeTypes::VariableList )
+              FindVariableUses( *Position.Slot, StatementUses );
+            
+            for( ExpressionSlot& Slot: Slots )
+            {
+                ExpressionNode* Expression = GetExpression( Slot );
+                
+                if( Expression->IsStatic() )
+                  continue;
+                
+                string Text;
+                int Operations = 0;
+                set< VariableNode* > Leaves;
+                
+                if( !DescribeExpression( Expression, Text, Operations, Leaves ) || Operations == 0 )
+                  continue;
+                
+                // values can only be kept for variables that
+                // the statement does not change before using them
+                bool IsValid = true;
+                
+                for( VariableNode* Leaf: Leaves )
+                  if( !Graph.TrackedVariables.count( Leaf ) || (StatementUses.Assigned.count( Leaf ) && !Targets.count( Leaf )) )
+                    IsValid = false;
+                
+                if( !IsValid )
+                  continue;
+                
+                ExpressionGroup& Group = Groups[ Text ];
+                
+                if( Group.Occurrences.empty() )
+                {
+                    Group.Leaves = Leaves;
+                    Group.Operations = Operations;
+                    Group.Position = Position;
+                }
+                
+                Group.Occurrences.push_back( Slot );
+            }
+            
+            // groups end when their variables change
+            for( auto GroupPair = Groups.begin(); GroupPair != Groups.end(); )
+            {
+                bool LeafIsAssigned = false;
+                
+                for( VariableNode* Leaf: GroupPair->second.Leaves )
+                  if( StatementUses.Assigned.count( Leaf ) )
+                    LeafIsAssigned = true;
+                
+                if( !LeafIsAssigned )
+                {
+                    GroupPair++;
+                    continue;
+                }
+                
+                FinishedGroups.push_back( GroupPair->second );
+                GroupPair = Groups.erase( GroupPair );
+            }
+        }
+        
+        for( auto& GroupPair: Groups )
+          FinishedGroups.push_back( GroupPair.second );
+    }
+    
+    // a variable is only worth it when it saves
+    // more than the operations needed to use it
+    ExpressionGroup* BestGroup = nullptr;
+    int BestSavings = 2;
+    
+    for( ExpressionGroup& Group: FinishedGroups )
+    {
+        int Savings = (Group.Occurrences.size() - 1) * Group.Operations;
+        
+        if( Savings > BestSavings )
+        {
+            BestGroup = &Group;
+            BestSavings = Savings;
+        }
+    }
+    
+    if( !BestGroup )
+      return false;
+    
+    Manager.ReplaceWithTemporary( BestGroup->Occurrences, BestGroup->Position );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+static unsigned EliminateCommonSubexpressions( PassManager& Manager )
+{
+    // inlined functions cannot have variables
+    if( Manager.Inlining.Find( Manager.Function ) )
+      return 0;
+    
+    unsigned Changes = 0;
+    
+    for( int Iteration = 0; Iteration < MaximumPassIterations; Iteration++ )
+    {
+        Manager.Graph.Build( Manager.Function );
+        
+        if( !ReplaceCommonSubexpressions( Manager ) )
+          break;
+        
+        Changes++;
+    }
+    
+    return Changes;
+}
+
+// -----------------------------------------------------------------------------
+
+const OptimizationPass OptimizationPasses[] =
+{
+    { "constant and copy propagation", 1, PropagateValues               },
+    { "dead code elimination",         1, EliminateDeadCode             },
+    { "loop invariant code motion",    2, HoistLoopInvariants           },
+    { "induction variables",           2, ReduceInductionVariables      },
+    { "common subexpressions",         2, EliminateCommonSubexpressions }
+};
+
+const unsigned NumberOfOptimizationPasses = sizeof( OptimizationPasses ) / sizeof( OptimizationPass );
+
+
+// =============================================================================
+//      PASS MANAGER: INSTANCE HANDLING
+// =============================================================================
+
+
+PassManager::PassManager()
+{
+    ProgramAST = nullptr;
+    Function = nullptr;
+    PassChanges.assign( NumberOfOptimizationPasses, 0 );
+    CreatedTemporaries = 0;
+}
+
+
+// =============================================================================
+//      PASS MANAGER: CHANGES TO THE AST
+// =============================================================================
+
+
+// stack frames need space for the largest set of
+// variables in all of the scopes that are nested
+void PassManager::AllocateScopes( CNode* Statement )
+{
+    // some contructs have optional parts!
+    if( !Statement ) return;
+    
+    switch( Statement->Type() )
+    {
+        case CNodeTypes::Block:
+        case CNodeTypes::Switch:
+        {
+            ((ScopeNode*)Statement)->AllocateVariablesInStack();
+            
+            for( CNode* BlockStatement: ((BlockNode*)Statement)->Statements )
+              AllocateScopes( BlockStatement );
+            
+            break;
+        }
+        
+        case CNodeTypes::If:
+            AllocateScopes( ((IfNode*)Statement)->TrueStatement );
+            AllocateScopes( ((IfNode*)Statement)->FalseStatement );
+            break;
+        
+        case CNodeTypes::While:
+            AllocateScopes( ((WhileNode*)Statement)->LoopStatement );
+            break;
+        
+        case CNodeTypes::Do:
+            AllocateScopes( ((DoNode*)Statement)->LoopStatement );
+            break;
+        
+        case CNodeTypes::For:
+            ((ScopeNode*)Statement)->AllocateVariablesInStack();
+            AllocateScopes( ((ForNode*)Statement)->LoopStatement );
+            break;
+        
+        default:
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// a statement that is not part of a list is placed in a new
+// block, so that other statements can be added next to it
+StatementPosition PassManager::PlaceInBlock( const StatementPosition& Position )
+{
+    if( Position.List )
+      return Position;
+    
+    CNode* Statement = *Position.Slot;
+    BlockNode* Block = new BlockNode( Statement->Parent );
+    Block->Location = Statement->Location;
+    Block->Statements.push_back( Statement );
+    Statement->Parent = Block;
+    *Position.Slot = Block;
+    
+    StatementPosition NewPosition;
+    NewPosition.List = &Block->Statements;
+    NewPosition.Position = Block->Statements.begin();
+    NewPosition.Slot = &Block->Statements.front();
+    return NewPosition;
+}
+
+// -----------------------------------------------------------------------------
+
+// creates a variable declared just before the given
+// statement; its initial value is set by the caller
+VariableNode* PassManager::DeclareTemporary( DataType* Type, const StatementPosition& Position )
+{
+    StatementPosition ListPosition = PlaceInBlock( Position );
+    CNode* Statement = *ListPosition.Slot;
+    
+    VariableListNode* Declaration = new VariableListNode( Statement->Parent );
+    Declaration->Location = Statement->Location;
+    Declaration->DeclaredType = Type->Clone();
+    
+    VariableNode* Temporary = new VariableNode( Declaration );
+    Temporary->Location = Statement->Location;
+    Temporary->Name = "__temporary_" + to_string( ++CreatedTemporaries );
+    Temporary->DeclaredType = Type->Clone();
+    Temporary->OwnerScope = Temporary->FindClosestScope( false );
+    Temporary->AllocatePlacement();
+    
+    Declaration->Variables.push_back( Temporary );
+    ListPosition.List->insert( ListPosition.Position, Declaration );
+    
+    // the scope of the variable is now larger
+    if( Function->StackSizeForVariables < Function->LocalVariablesSize )
+      Function->StackSizeForVariables = Function->LocalVariablesSize;
+    
+    for( CNode* FunctionStatement: Function->Statements )
+      AllocateScopes( FunctionStatement );
+    
+    return Temporary;
+}
+
+// -----------------------------------------------------------------------------
+
+// the first occurrence becomes the initial value of a new
+// variable, declared just before the given statement
+VariableNode* PassManager::ReplaceWithTemporary( const vector< ExpressionSlot >& Occurrences, const StatementPosition& Position )
+{
+    ExpressionNode* Value = GetExpression( Occurrences[ 0 ] );
+    VariableNode* Temporary = DeclareTemporary( Value->ReturnedType, Position );
+    
+    for( const ExpressionSlot& Occurrence: Occurrences )
+    {
+        ExpressionNode* Replaced = GetExpression( Occurrence );
+        SetExpression( Occurrence, NewVariableAtom( Temporary, Replaced->Parent, Replaced->Location ) );
+        
+        if( Replaced != Value )
+          delete Replaced;
+    }
+    
+    Value->Parent = Temporary;
+    Temporary->InitialValue = Value;
+    return Temporary;
+}
+
+
+// =============================================================================
+//      PASS MANAGER: MAIN FUNCTIONS
+// =============================================================================
+
+
+void PassManager::Optimize( TopLevelNode* ProgramAST_ )
+{
+    ProgramAST = ProgramAST_;
+    
+    if( OptimizationLevel >= 1 )
+      Simplifier.OptimizeGlobals( ProgramAST );
+    
+    // passes must know which functions the
+    // emitter will be able to inline
+    if( OptimizationLevel >= 2 )
+      Inlining.Analyze( ProgramAST );
+    
+    for( CNode* Statement: ProgramAST->Statements )
+    {
+        if( Statement->Type() != CNodeTypes::Function )
+          continue;
+        
+        Function = (FunctionNode*)Statement;
+        
+        if( !Function->HasBody )
+          continue;
+        
+        for( unsigned Pass = 0; Pass < NumberOfOptimizationPasses; Pass++ )
+          if( OptimizationLevel >= OptimizationPasses[ Pass ].MinimumLevel )
+            PassChanges[ Pass ] += OptimizationPasses[ Pass ].Run( *this );
+        
+        // log the final code of the function
+        if( DebugMode )
+        {
+            Graph.Build( Function );
+            Graph.Dump( IRLog );
+        }
+    }
+    
+    Graph.Clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void PassManager::PrintStatistics( ostream& Output )
+{
+    Output << "optimization passes (level " << OptimizationLevel << "): ";
+    Output << CreatedTemporaries << " temporary variables created" << endl;
+    
+    for( unsigned Pass = 0; Pass < NumberOfOptimizationPasses; Pass++ )
+      if( OptimizationLevel >= OptimizationPasses[ Pass ].MinimumLevel )
+        Output << "  " << OptimizationPasses[ Pass ].Name << ": " << PassChanges[ Pass ] << endl;
+    
+    if( OptimizationLevel >= 1 )
+      Simplifier.PrintStatistics( Output );
+}
@@ -0,0 +1,92 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef PASSMANAGER_HPP
+    #define PASSMANAGER_HPP
+    
+    // include project headers
+    #include "CNodes.hpp"
+    #include "ControlFlowGraph.hpp"
+    #include "ExpressionOptimizer.hpp"
+    #include "FunctionInlining.hpp"
+    
+    // include C/C++ headers
+    #include <list>             // [ C++ STL ] Lists
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <sstream>          // [ C++ STL ] String streams
+    #include <ostream>          // [ C++ STL ] Output streams
+// *****************************************************************************
+
+
+// =============================================================================
+//      DATA USED BY THE PASS MANAGER
+// =============================================================================
+
+
+// the place where an expression is referenced from:
+// a statement or initial value, or an operand of
+// some other expression
+typedef struct
+{
+    CNode** Node;
+    ExpressionNode** Operand;
+}
+ExpressionSlot;
+
+
+// =============================================================================
+//      PASS MANAGER
+// =============================================================================
+
+
+// Runs the optimization passes on each function, between the
+// analyzer and the emitter. The passes that are run depend on
+// the optimization level (-O0 to -O2). Except for the expression
+// optimizer, passes make their decisions on the control flow
+// graph of the function, and then apply them to the AST. The
+// graph is built again after every change, so it always
+// matches the code that will be emitted.
+class PassManager
+{
+    public:
+        
+        // program being optimized
+        TopLevelNode* ProgramAST;
+        FunctionNode* Function;
+        ControlFlowGraph Graph;
+        
+        // other optimizers used by passes
+        ExpressionOptimizer Simplifier;
+        FunctionInlining Inlining;
+        
+        // statistics
+        std::vector< unsigned > PassChanges;
+        unsigned CreatedTemporaries;
+        
+        // final IR of all functions (debug mode only)
+        std::ostringstream IRLog;
+        
+    protected:
+        
+        // recalculation of stack space
+        void AllocateScopes( CNode* Statement );
+        
+    public:
+        
+        // instance handling
+        PassManager();
+        
+        // changes to the AST, used by passes
+        StatementPosition PlaceInBlock( const StatementPosition& Position );
+        VariableNode* DeclareTemporary( DataType* Type, const StatementPosition& Position );
+        VariableNode* ReplaceWithTemporary( const std::vector< ExpressionSlot >& Occurrences, const StatementPosition& Position );
+        
+        // main functions
+        void Optimize( TopLevelNode* ProgramAST_ );
+        void PrintStatistics( std::ostream& Output );
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -0,0 +1,991 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "../DevToolsInfrastructure/EnumStringConversions.hpp"
+    #include "../DevToolsInfrastructure/StringFunctions.hpp"
+    
+    // include project headers
+    #include "PeepholeOptimizer.hpp"
+    
+    // include C/C++ headers
+    #include <cstdlib>          // [ ANSI C ] Standard library
+    #include <cstdint>          // [ ANSI C ] Standard integer types
+    #include <cctype>           // [ ANSI C ] Character types
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+static string TrimSpaces( const string& Text )
+{
+    size_t First = Text.find_first_not_of( " \t\r\n" );
+    
+    if( First == string::npos )
+      return "";
+    
+    size_t Last = Text.find_last_not_of( " \t\r\n" );
+    return Text.substr( First, Last - First + 1 );
+}
+
+// -----------------------------------------------------------------------------
+
+// only decimal and hexadecimal forms are recognized;
+// others are left as text, so no rule will use them
+static bool ParseInteger( const string& Text, int32_t& Value )
+{
+    if( Text.empty() )
+      return false;
+    
+    const char* Start = Text.c_str();
+    bool IsHex = (Text.size() > 2 && Text[ 0 ] == '0' && (Text[ 1 ] == 'x' || Text[ 1 ] == 'X'));
+    char* End = nullptr;
+    long long Parsed = strtoll( Start, &End, IsHex? 16 : 10 );
+    
+    if( End == Start || *End != 0 )
+      return false;
+    
+    if( Parsed < INT32_MIN || Parsed > (long long)UINT32_MAX )
+      return false;
+    
+    Value = (int32_t)Parsed;
+    return true;
+}
+
+
+// -----------------------------------------------------------------------------
+
+static void AddIdentifiers( const string& Text, set< string >& Identifiers )
+{
+    size_t Position = 0;
+    
+    while( Position < Text.size() )
+    {
+        char c = Text[ Position ];
+        
+        // skip comments
+        if( c == ';' )
+          return;
+        
+        // skip literal strings
+        if( c == '"' )
+        {
+            Position = Text.find( '"', Position + 1 );
+            if( Position == string::npos ) return;
+            
+            Position++;
+            continue;
+        }
+        
+        // skip numbers (even with letters, as in 0xFF)
+        if( isdigit( c ) )
+        {
+            while( Position < Text.size() && (isalnum( Text[ Position ] ) || Text[ Position ] == '_') )
+              Position++;
+            
+            continue;
+        }
+        
+        // skip any other separators
+        if( !isalpha( c ) && c != '_' )
+        {
+            Position++;
+            continue;
+        }
+        
+        size_t End = Position;
+        
+        while( End < Text.size() && (isalnum( Text[ End ] ) || Text[ End ] == '_') )
+          End++;
+        
+        Identifiers.insert( Text.substr( Position, End - Position ) );
+        Position = End;
+    }
+}
+
+
+// =============================================================================
+//      CLASS: ASSEMBLY OPERAND
+// =============================================================================
+
+
+AssemblyOperand::AssemblyOperand()
+{
+    IsRegister = false;
+    Register = CPURegisters::Register00;
+    IsInteger = false;
+    IntegerValue = 0;
+    IsMemory = false;
+    HasBaseRegister = false;
+    BaseRegister = CPURegisters::Register00;
+}
+
+// -----------------------------------------------------------------------------
+
+void AssemblyOperand::Parse( const string& OperandText )
+{
+    *this = AssemblyOperand();
+    Text = TrimSpaces( OperandText );
+    
+    // registers
+    if( IsRegisterName( Text ) )
+    {
+        IsRegister = true;
+        Register = StringToRegister( Text );
+        return;
+    }
+    
+    // immediate integers
+    if( ParseInteger( Text, IntegerValue ) )
+    {
+        IsInteger = true;
+        return;
+    }
+    
+    // memory addresses
+    if( Text.size() >= 2 && Text.front() == '[' && Text.back() == ']' )
+    {
+        IsMemory = true;
+        
+        // the base register, if any, is always first
+        string Address = TrimSpaces( Text.substr( 1, Text.size() - 2 ) );
+        string Base = TrimSpaces( Address.substr( 0, Address.find_first_of( "+-" ) ) );
+        
+        if( IsRegisterName( Base ) )
+        {
+            HasBaseRegister = true;
+            BaseRegister = StringToRegister( Base );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool AssemblyOperand::IsLabel() const
+{
+    return !IsRegister && !IsInteger && !IsMemory && !Text.empty();
+}
+
+// -----------------------------------------------------------------------------
+
+bool AssemblyOperand::IsSameAs( const AssemblyOperand& Other ) const
+{
+    // registers can be named with aliases
+    if( IsRegister || Other.IsRegister )
+      return (IsRegister && Other.IsRegister && Register == Other.Register);
+    
+    return (Text == Other.Text);
+}
+
+// -----------------------------------------------------------------------------
+
+bool AssemblyOperand::UsesRegister( CPURegisters Checked ) const
+{
+    if( IsRegister )
+      return (Register == Checked);
+    
+    return (IsMemory && HasBaseRegister && BaseRegister == Checked);
+}
+
+
+// =============================================================================
+//      CLASS: ASSEMBLY LINE
+// =============================================================================
+
+
+AssemblyLine::AssemblyLine()
+{
+    Type = AssemblyLineTypes::Other;
+    OpCode = InstructionOpCodes::HLT;
+    DebugNode = nullptr;
+    Removed = false;
+    Modified = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void AssemblyLine::Parse( const string& LineText )
+{
+    Text = LineText;
+    Type = AssemblyLineTypes::Other;
+    string Trimmed = TrimSpaces( LineText );
+    
+    if( Trimmed.empty() || Trimmed[ 0 ] == ';' || Trimmed[ 0 ] == '%' )
+      return;
+    
+    // labels
+    if( Trimmed.back() == ':' && Trimmed.find_first_of( " \t" ) == string::npos )
+    {
+        Type = AssemblyLineTypes::Label;
+        LabelName = Trimmed.substr( 0, Trimmed.size() - 1 );
+        return;
+    }
+    
+    // instructions (anything else, like data
+    // directives, is not understood)
+    size_t OpCodeEnd = Trimmed.find_first_of( " \t" );
+    string OpCodeName = Trimmed.substr( 0, OpCodeEnd );
+    
+    if( !IsOpCodeName( OpCodeName ) )
+      return;
+    
+    Type = AssemblyLineTypes::Instruction;
+    OpCode = StringToOpCode( OpCodeName );
+    Operands.clear();
+    
+    if( OpCodeEnd == string::npos )
+      return;
+    
+    for( const string& OperandText: SplitString( Trimmed.substr( OpCodeEnd ), ',' ) )
+    {
+        Operands.push_back( AssemblyOperand() );
+        Operands.back().Parse( OperandText );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void AssemblyLine::ReplaceInstruction( InstructionOpCodes NewOpCode, const vector< string >& NewOperands )
+{
+    Type = AssemblyLineTypes::Instruction;
+    OpCode = NewOpCode;
+    Operands.clear();
+    
+    for( const string& OperandText: NewOperands )
+    {
+        Operands.push_back( AssemblyOperand() );
+        Operands.back().Parse( OperandText );
+    }
+    
+    Modified = true;
+}
+
+// -----------------------------------------------------------------------------
+
+string AssemblyLine::ToText() const
+{
+    // unchanged lines keep their original form
+    if( !Modified )
+      return Text;
+    
+    string Result = ToLowerCase( OpCodeToString( OpCode ) );
+    
+    for( unsigned i = 0; i < Operands.size(); i++ )
+      Result += (i? ", " : " ") + Operands[ i ].Text;
+    
+    return Result;
+}
+
+
+// =============================================================================
+//      PEEPHOLE RULES
+// =============================================================================
+
+
+// Each rule is tried at the position of every instruction,
+// and it returns true when it changed the program. A rule
+// must never reverse the effect of another one, so that
+// passes can be repeated until no rule applies.
+typedef bool (*PeepholeRuleFunction)( PeepholeOptimizer& Optimizer, int Position );
+
+typedef struct
+{
+    const char* Name;
+    PeepholeRuleFunction Apply;
+}
+PeepholeRule;
+
+// -----------------------------------------------------------------------------
+
+// the target of a jump is its last operand
+static AssemblyOperand* GetJumpTarget( AssemblyLine& Line )
+{
+    if( Line.OpCode != InstructionOpCodes::JMP
+    &&  Line.OpCode != InstructionOpCodes::JT
+    &&  Line.OpCode != InstructionOpCodes::JF )
+      return nullptr;
+    
+    if( Line.Operands.empty() || !Line.Operands.back().IsLabel() )
+      return nullptr;
+    
+    return &Line.Operands.back();
+}
+
+// -----------------------------------------------------------------------------
+
+// mov R1, R1  -->  (nothing)
+static bool RemoveSelfMove( PeepholeOptimizer& Optimizer, int Position )
+{
+    AssemblyLine& Line = Optimizer.Lines[ Position ];
+    
+    if( Line.OpCode != InstructionOpCodes::MOV || Line.Operands.size() != 2 )
+      return false;
+    
+    if( !Line.Operands[ 0 ].IsRegister || !Line.Operands[ 0 ].IsSameAs( Line.Operands[ 1 ] ) )
+      return false;
+    
+    Optimizer.RemoveLine( Position );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// mov [BP-1], R1  -->  mov [BP-1], R1
+// mov R1, [BP-1]       (nothing)
+// (and the same for any pair of moves in opposite directions)
+static bool RemoveReversedMove( PeepholeOptimizer& Optimizer, int Position )
+{
+    int NextPosition = Optimizer.NextInstruction( Position );
+    if( NextPosition < 0 ) return false;
+    
+    AssemblyLine& First = Optimizer.Lines[ Position ];
+    AssemblyLine& Second = Optimizer.Lines[ NextPosition ];
+    
+    if( First.OpCode != InstructionOpCodes::MOV || First.Operands.size() != 2 )
+      return false;
+    
+    if( Second.OpCode != InstructionOpCodes::MOV || Second.Operands.size() != 2 )
+      return false;
+    
+    AssemblyOperand& Destination = First.Operands[ 0 ];
+    AssemblyOperand& Source = First.Operands[ 1 ];
+    
+    if( !Second.Operands[ 0 ].IsSameAs( Source ) || !Second.Operands[ 1 ].IsSameAs( Destination ) )
+      return false;
+    
+    // only registers and memory can be written
+    if( !Source.IsRegister && !Source.IsMemory )
+      return false;
+    
+    // a loaded register could be part of the address
+    if( Destination.IsRegister && Source.UsesRegister( Destination.Register ) )
+      return false;
+    
+    Optimizer.RemoveLine( NextPosition );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// mov [BP-1], R1  -->  mov [BP-1], R1
+// mov R2, [BP-1]       mov R2, R1
+static bool ForwardStoredValue( PeepholeOptimizer& Optimizer, int Position )
+{
+    int NextPosition = Optimizer.NextInstruction( Position );
+    if( NextPosition < 0 ) return false;
+    
+    AssemblyLine& First = Optimizer.Lines[ Position ];
+    AssemblyLine& Second = Optimizer.Lines[ NextPosition ];
+    
+    if( First.OpCode != InstructionOpCodes::MOV || First.Operands.size() != 2 )
+      return false;
+    
+    if( Second.OpCode != InstructionOpCodes::MOV || Second.Operands.size() != 2 )
+      return false;
+    
+    AssemblyOperand& Address = First.Operands[ 0 ];
+    AssemblyOperand& StoredRegister = First.Operands[ 1 ];
+    
+    if( !Address.IsMemory || !StoredRegister.IsRegister )
+      return false;
+    
+    if( !Second.Operands[ 0 ].IsRegister || !Second.Operands[ 1 ].IsSameAs( Address ) )
+      return false;
+    
+    // reloading the same register is for another rule
+    if( Second.Operands[ 0 ].IsSameAs( StoredRegister ) )
+      return false;
+    
+    Second.ReplaceInstruction( InstructionOpCodes::MOV, { Second.Operands[ 0 ].Text, StoredRegister.Text } );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// push R1  -->  (nothing)    push R1  -->  mov R2, R1
+// pop R1                     pop R2
+static bool RemovePushPopPair( PeepholeOptimizer& Optimizer, int Position )
+{
+    int NextPosition = Optimizer.NextInstruction( Position );
+    if( NextPosition < 0 ) return false;
+    
+    AssemblyLine& First = Optimizer.Lines[ Position ];
+    AssemblyLine& Second = Optimizer.Lines[ NextPosition ];
+    
+    if( First.OpCode != InstructionOpCodes::PUSH || First.Operands.size() != 1 )
+      return false;
+    
+    if( Second.OpCode != InstructionOpCodes::POP || Second.Operands.size() != 1 )
+      return false;
+    
+    if( !First.Operands[ 0 ].IsRegister || !Second.Operands[ 0 ].IsRegister )
+      return false;
+    
+    if( !Second.Operands[ 0 ].IsSameAs( First.Operands[ 0 ] ) )
+      Second.ReplaceInstruction( InstructionOpCodes::MOV, { Second.Operands[ 0 ].Text, First.Operands[ 0 ].Text } );
+    else
+      Optimizer.RemoveLine( NextPosition );
+    
+    Optimizer.RemoveLine( Position );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// iadd R1, 0  -->  (nothing)
+// (also for other integer operations with a neutral element)
+static bool RemoveNeutralOperation( PeepholeOptimizer& Optimizer, int Position )
+{
+    AssemblyLine& Line = Optimizer.Lines[ Position ];
+    
+    if( Line.Operands.size() != 2 || !Line.Operands[ 0 ].IsRegister || !Line.Operands[ 1 ].IsInteger )
+      return false;
+    
+    int32_t Value = Line.Operands[ 1 ].IntegerValue;
+    bool IsNeutral = false;
+    
+    switch( Line.OpCode )
+    {
+        case InstructionOpCodes::IADD:
+        case InstructionOpCodes::ISUB:
+        case InstructionOpCodes::OR:
+        case InstructionOpCodes::XOR:
+        case InstructionOpCodes::SHL:
+            IsNeutral = (Value == 0);
+            break;
+        
+        case InstructionOpCodes::IMUL:
+        case InstructionOpCodes::IDIV:
+            IsNeutral = (Value == 1);
+            break;
+        
+        case InstructionOpCodes::AND:
+            IsNeutral = (Value == -1);
+            break;
+        
+        default:
+            break;
+    }
+    
+    if( !IsNeutral )
+      return false;
+    
+    Optimizer.RemoveLine( Position );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// iadd R1, 4  -->  iadd R1, 5    mov R1, 4  -->  mov R1, 12
+// iadd R1, 1                     imul R1, 3
+// (additions and subtractions can be mixed, and so
+// can products; int operations just wrap around)
+static bool CombineImmediateOperations( PeepholeOptimizer& Optimizer, int Position )
+{
+    int NextPosition = Optimizer.NextInstruction( Position );
+    if( NextPosition < 0 ) return false;
+    
+    AssemblyLine& First = Optimizer.Lines[ Position ];
+    AssemblyLine& Second = Optimizer.Lines[ NextPosition ];
+    
+    if( First.Operands.size() != 2 || Second.Operands.size() != 2 )
+      return false;
+    
+    if( !First.Operands[ 0 ].IsRegister || !First.Operands[ 1 ].IsInteger || !Second.Operands[ 1 ].IsInteger )
+      return false;
+    
+    if( !Second.Operands[ 0 ].IsSameAs( First.Operands[ 0 ] ) )
+      return false;
+    
+    uint32_t FirstValue = First.Operands[ 1 ].IntegerValue;
+    uint32_t SecondValue = Second.Operands[ 1 ].IntegerValue;
+    bool FirstIsAddition = (First.OpCode == InstructionOpCodes::IADD || First.OpCode == InstructionOpCodes::ISUB);
+    bool SecondIsAddition = (Second.OpCode == InstructionOpCodes::IADD || Second.OpCode == InstructionOpCodes::ISUB);
+    
+    if( First.OpCode == InstructionOpCodes::ISUB )
+      FirstValue = -FirstValue;
+    
+    if( Second.OpCode == InstructionOpCodes::ISUB )
+      SecondValue = -SecondValue;
+    
+    InstructionOpCodes OpCode = First.OpCode;
+    int32_t Result;
+    
+    if( First.OpCode == InstructionOpCodes::MOV && SecondIsAddition )
+      Result = FirstValue + SecondValue;
+    
+    else if( First.OpCode == InstructionOpCodes::MOV && Second.OpCode == InstructionOpCodes::IMUL )
+      Result = FirstValue * SecondValue;
+    
+    else if( FirstIsAddition && SecondIsAddition )
+    {
+        OpCode = InstructionOpCodes::IADD;
+        Result = FirstValue + SecondValue;
+    }
+    
+    else if( First.OpCode == InstructionOpCodes::IMUL && Second.OpCode == InstructionOpCodes::IMUL )
+      Result = FirstValue * SecondValue;
+    
+    else return false;
+    
+    // the assembler needs INT_MIN in hex notation
+    string ResultText = (Result == INT32_MIN? "0x80000000" : to_string( Result ));
+    First.ReplaceInstruction( OpCode, { First.Operands[ 0 ].Text, ResultText } );
+    Optimizer.RemoveLine( NextPosition );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// mov R0, 1        -->  mov R0, 1
+// jf R0, label          (nothing)
+// (a condition that always jumps becomes a jmp)
+static bool FoldConstantCondition( PeepholeOptimizer& Optimizer, int Position )
+{
+    int NextPosition = Optimizer.NextInstruction( Position );
+    if( NextPosition < 0 ) return false;
+    
+    AssemblyLine& First = Optimizer.Lines[ Position ];
+    AssemblyLine& Second = Optimizer.Lines[ NextPosition ];
+    
+    if( First.OpCode != InstructionOpCodes::MOV || First.Operands.size() != 2 )
+      return false;
+    
+    if( !First.Operands[ 0 ].IsRegister || !First.Operands[ 1 ].IsInteger )
+      return false;
+    
+    if( Second.OpCode != InstructionOpCodes::JT && Second.OpCode != InstructionOpCodes::JF )
+      return false;
+    
+    if( Second.Operands.size() != 2 || !Second.Operands[ 0 ].IsSameAs( First.Operands[ 0 ] ) )
+      return false;
+    
+    bool JumpIfTrue = (Second.OpCode == InstructionOpCodes::JT);
+    bool ConditionIsTrue = (First.Operands[ 1 ].IntegerValue != 0);
+    
+    if( JumpIfTrue == ConditionIsTrue )
+      Second.ReplaceInstruction( InstructionOpCodes::JMP, { Second.Operands[ 1 ].Text } );
+    else
+      Optimizer.RemoveLine( NextPosition );
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// jf R0, label1  -->  jt R0, label2
+// jmp label2          label1:
+// label1:
+static bool InvertConditionalJump( PeepholeOptimizer& Optimizer, int Position )
+{
+    int NextPosition = Optimizer.NextInstruction( Position );
+    if( NextPosition < 0 ) return false;
+    
+    AssemblyLine& First = Optimizer.Lines[ Position ];
+    AssemblyLine& Second = Optimizer.Lines[ NextPosition ];
+    
+    if( First.OpCode != InstructionOpCodes::JT && First.OpCode != InstructionOpCodes::JF )
+      return false;
+    
+    if( Second.OpCode != InstructionOpCodes::JMP )
+      return false;
+    
+    AssemblyOperand* SkippedTarget = GetJumpTarget( First );
+    AssemblyOperand* Target = GetJumpTarget( Second );
+    
+    if( !SkippedTarget || !Target || First.Operands.size() != 2 )
+      return false;
+    
+    if( !Optimizer.IsFollowedByLabel( NextPosition, SkippedTarget->Text ) )
+      return false;
+    
+    InstructionOpCodes InvertedOpCode = InstructionOpCodes::JT;
+    
+    if( First.OpCode == InstructionOpCodes::JT )
+      InvertedOpCode = InstructionOpCodes::JF;
+    
+    First.ReplaceInstruction( InvertedOpCode, { First.Operands[ 0 ].Text, Target->Text } );
+    Optimizer.RemoveLine( NextPosition );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// jmp label1  -->  jmp label2
+// (...)
+// label1:
+// jmp label2
+static bool ThreadJumpChain( PeepholeOptimizer& Optimizer, int Position )
+{
+    AssemblyLine& Line = Optimizer.Lines[ Position ];
+    AssemblyOperand* Target = GetJumpTarget( Line );
+    
+    if( !Target )
+      return false;
+    
+    string FinalTarget = Optimizer.FinalJumpTarget( Target->Text );
+    
+    if( FinalTarget == Target->Text )
+      return false;
+    
+    Target->Text = FinalTarget;
+    Line.Modified = true;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// jmp label  -->  label:
+// label:
+static bool RemoveJumpToNextLine( PeepholeOptimizer& Optimizer, int Position )
+{
+    AssemblyOperand* Target = GetJumpTarget( Optimizer.Lines[ Position ] );
+    
+    if( !Target || !Optimizer.IsFollowedByLabel( Position, Target->Text ) )
+      return false;
+    
+    Optimizer.RemoveLine( Position );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// jmp label  -->  jmp label
+// mov R0, 1       label2:
+// label2:
+static bool RemoveUnreachableCode( PeepholeOptimizer& Optimizer, int Position )
+{
+    AssemblyLine& Line = Optimizer.Lines[ Position ];
+    
+    if( Line.OpCode != InstructionOpCodes::JMP && Line.OpCode != InstructionOpCodes::RET )
+      return false;
+    
+    bool Removed = false;
+    
+    for( int NextPosition = Optimizer.NextInstruction( Position );
+         NextPosition >= 0;
+         NextPosition = Optimizer.NextInstruction( NextPosition ) )
+    {
+        Optimizer.RemoveLine( NextPosition );
+        Removed = true;
+    }
+    
+    return Removed;
+}
+
+// -----------------------------------------------------------------------------
+
+const PeepholeRule PeepholeRules[] =
+{
+    { "self move",              RemoveSelfMove             },
+    { "reversed move",          RemoveReversedMove         },
+    { "forwarded stored value", ForwardStoredValue         },
+    { "push/pop pair",          RemovePushPopPair          },
+    { "neutral operation",      RemoveNeutralOperation     },
+    { "combined immediates",    CombineImmediateOperations },
+    { "constant condition",     FoldConstantCondition      },
+    { "inverted condition",     InvertConditionalJump      },
+    { "jump chain",             ThreadJumpChain            },
+    { "jump to next line",      RemoveJumpToNextLine       },
+    { "unreachable code",       RemoveUnreachableCode      }
+};
+
+const unsigned NumberOfPeepholeRules = sizeof( PeepholeRules ) / sizeof( PeepholeRule );
+
+
+// =============================================================================
+//      PEEPHOLE OPTIMIZER: INSTANCE HANDLING
+// =============================================================================
+
+
+PeepholeOptimizer::PeepholeOptimizer()
+{
+    EndDebugNode = nullptr;
+    RuleHits.assign( NumberOfPeepholeRules, 0 );
+    InitialInstructions = 0;
+    FinalInstructions = 0;
+    Passes = 0;
+}
+
+
+// =============================================================================
+//      PEEPHOLE OPTIMIZER: CONVERSION FROM/TO EMITTER RESULTS
+// =============================================================================
+
+
+void PeepholeOptimizer::LoadLines( VirconCEmitter& Emitter )
+{
+    Lines.clear();
+    LabelPositions.clear();
+    EndDebugNode = nullptr;
+    InitialInstructions = 0;
+    
+    for( unsigned i = 0; i < Emitter.ProgramLines.size(); i++ )
+    {
+        Lines.push_back( AssemblyLine() );
+        AssemblyLine& Line = Lines.back();
+        
+        // lines from asm blocks are kept as they are
+        if( Emitter.AssemblyBlockLines.count( i ) )
+          Line.Text = Emitter.ProgramLines[ i ];
+        else
+          Line.Parse( Emitter.ProgramLines[ i ] );
+        
+        if( Line.Type == AssemblyLineTypes::Instruction )
+          InitialInstructions++;
+        
+        if( Line.Type == AssemblyLineTypes::Label )
+          LabelPositions[ Line.LabelName ] = i;
+    }
+    
+    DataReferences.clear();
+    
+    for( const string& DataLine: Emitter.DataLines )
+      AddIdentifiers( DataLine, DataReferences );
+    
+    // attach debug info to lines (see AddDebugInfo
+    // in the emitter for the meaning of the offset)
+    for( auto& MapPair: Emitter.LineMapping )
+    {
+        unsigned Position = MapPair.first - 2;
+        
+        if( Position < Lines.size() )
+          Lines[ Position ].DebugNode = MapPair.second;
+        else
+          EndDebugNode = MapPair.second;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void PeepholeOptimizer::StoreLines( VirconCEmitter& Emitter )
+{
+    Emitter.ProgramLines.clear();
+    Emitter.LineMapping.clear();
+    set< int > AssemblyBlockLines;
+    FinalInstructions = 0;
+    
+    for( unsigned i = 0; i < Lines.size(); i++ )
+    {
+        AssemblyLine& Line = Lines[ i ];
+        if( Line.Removed ) continue;
+        
+        if( Line.DebugNode )
+          Emitter.LineMapping[ Emitter.ProgramLines.size() + 2 ] = Line.DebugNode;
+        
+        if( Emitter.AssemblyBlockLines.count( i ) )
+          AssemblyBlockLines.insert( Emitter.ProgramLines.size() );
+        
+        if( Line.Type == AssemblyLineTypes::Instruction )
+          FinalInstructions++;
+        
+        Emitter.ProgramLines.push_back( Line.ToText() );
+    }
+    
+    if( EndDebugNode )
+      Emitter.LineMapping[ Emitter.ProgramLines.size() + 2 ] = EndDebugNode;
+    
+    Emitter.AssemblyBlockLines = AssemblyBlockLines;
+}
+
+
+// -----------------------------------------------------------------------------
+
+// any identifier in a line other than a label definition
+// is taken as a reference (even if it is not a label)
+void PeepholeOptimizer::FindReferencedLabels()
+{
+    ReferencedLabels = DataReferences;
+    
+    for( AssemblyLine& Line: Lines )
+      if( !Line.Removed && Line.Type != AssemblyLineTypes::Label )
+        AddIdentifiers( Line.ToText(), ReferencedLabels );
+}
+
+
+// =============================================================================
+//      PEEPHOLE OPTIMIZER: NAVIGATION AND CHANGES
+// =============================================================================
+
+
+// rules only match consecutive instructions, so
+// this returns -1 if anything else is found first
+int PeepholeOptimizer::NextInstruction( int Position )
+{
+    for( unsigned i = Position + 1; i < Lines.size(); i++ )
+    {
+        if( Lines[ i ].Removed )
+          continue;
+        
+        if( Lines[ i ].Type == AssemblyLineTypes::Instruction )
+          return i;
+        
+        // no jump can arrive at an unused label
+        if( Lines[ i ].Type == AssemblyLineTypes::Label )
+          if( !ReferencedLabels.count( Lines[ i ].LabelName ) )
+            continue;
+        
+        return -1;
+    }
+    
+    return -1;
+}
+
+// -----------------------------------------------------------------------------
+
+// checks if the label is among the ones that
+// immediately follow the given position
+bool PeepholeOptimizer::IsFollowedByLabel( int Position, const string& LabelName )
+{
+    for( unsigned i = Position + 1; i < Lines.size(); i++ )
+    {
+        if( Lines[ i ].Removed )
+          continue;
+        
+        if( Lines[ i ].Type != AssemblyLineTypes::Label )
+          return false;
+        
+        if( Lines[ i ].LabelName == LabelName )
+          return true;
+    }
+    
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+// follows unconditional jumps placed right after the
+// label; a cycle of jumps leaves the label unchanged
+string PeepholeOptimizer::FinalJumpTarget( const string& LabelName )
+{
+    set< string > VisitedLabels;
+    string Target = LabelName;
+    
+    while( true )
+    {
+        auto LabelPair = LabelPositions.find( Target );
+        
+        if( LabelPair == LabelPositions.end() )
+          return Target;
+        
+        VisitedLabels.insert( Target );
+        
+        // skip any other labels at the same place
+        int Position = LabelPair->second;
+        
+        while( ++Position < (int)Lines.size() )
+          if( !Lines[ Position ].Removed && Lines[ Position ].Type != AssemblyLineTypes::Label )
+            break;
+        
+        if( Position >= (int)Lines.size() )
+          return Target;
+        
+        AssemblyLine& Line = Lines[ Position ];
+        
+        if( Line.Type != AssemblyLineTypes::Instruction || Line.OpCode != InstructionOpCodes::JMP )
+          return Target;
+        
+        AssemblyOperand* NextTarget = GetJumpTarget( Line );
+        
+        if( !NextTarget )
+          return Target;
+        
+        if( VisitedLabels.count( NextTarget->Text ) )
+          return LabelName;
+        
+        Target = NextTarget->Text;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// debug info from a removed line is passed to the next one,
+// unless it already has its own (then it is just discarded)
+void PeepholeOptimizer::RemoveLine( int Position )
+{
+    AssemblyLine& Line = Lines[ Position ];
+    Line.Removed = true;
+    
+    if( !Line.DebugNode )
+      return;
+    
+    for( unsigned i = Position + 1; i < Lines.size(); i++ )
+    {
+        if( Lines[ i ].Removed )
+          continue;
+        
+        if( !Lines[ i ].DebugNode )
+          Lines[ i ].DebugNode = Line.DebugNode;
+        
+        Line.DebugNode = nullptr;
+        return;
+    }
+    
+    if( !EndDebugNode )
+      EndDebugNode = Line.DebugNode;
+    
+    Line.DebugNode = nullptr;
+}
+
+
+// =============================================================================
+//      PEEPHOLE OPTIMIZER: MAIN FUNCTIONS
+// =============================================================================
+
+
+bool PeepholeOptimizer::RunPass()
+{
+    bool ProgramChanged = false;
+    FindReferencedLabels();
+    
+    for( unsigned Position = 0; Position < Lines.size(); Position++ )
+    {
+        for( unsigned Rule = 0; Rule < NumberOfPeepholeRules; Rule++ )
+        {
+            AssemblyLine& Line = Lines[ Position ];
+            
+            if( Line.Removed || Line.Type != AssemblyLineTypes::Instruction )
+              break;
+            
+            if( PeepholeRules[ Rule ].Apply( *this, Position ) )
+            {
+                RuleHits[ Rule ]++;
+                ProgramChanged = true;
+            }
+        }
+    }
+    
+    return ProgramChanged;
+}
+
+// -----------------------------------------------------------------------------
+
+void PeepholeOptimizer::Optimize( VirconCEmitter& Emitter )
+{
+    LoadLines( Emitter );
+    
+    // a rule can enable others, so repeat
+    // until the program no longer changes
+    Passes = 0;
+    
+    do Passes++;
+    while( RunPass() );
+    
+    StoreLines( Emitter );
+}
+
+// -----------------------------------------------------------------------------
+
+void PeepholeOptimizer::PrintStatistics( ostream& Output )
+{
+    Output << "peephole optimizer: " << InitialInstructions << " -> " << FinalInstructions;
+    Output << " instructions in " << Passes << " passes" << endl;
+    
+    for( unsigned Rule = 0; Rule < NumberOfPeepholeRules; Rule++ )
+      Output << "  " << PeepholeRules[ Rule ].Name << ": " << RuleHits[ Rule ] << endl;
+}
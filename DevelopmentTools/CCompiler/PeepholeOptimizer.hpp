@@ -0,0 +1,165 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef PEEPHOLEOPTIMIZER_HPP
+    #define PEEPHOLEOPTIMIZER_HPP
+    
+    // include common Vircon headers
+    #include "../../VirconDefinitions/Enumerations.hpp"
+    
+    // include project headers
+    #include "VirconCEmitter.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+    #include <ostream>          // [ C++ STL ] Output streams
+// *****************************************************************************
+
+
+// =============================================================================
+//      REPRESENTATION OF EMITTED ASSEMBLY
+// =============================================================================
+
+
+// operands are classified only as far as the optimizer
+// needs; anything else (labels, ports, floats...) is
+// only identified by its text
+class AssemblyOperand
+{
+    public:
+        
+        std::string Text;
+        
+        // for registers
+        bool IsRegister;
+        V32::CPURegisters Register;
+        
+        // for immediate integers
+        bool IsInteger;
+        int32_t IntegerValue;
+        
+        // for memory addresses: [address],
+        // [register] or [register +/- offset]
+        bool IsMemory;
+        bool HasBaseRegister;
+        V32::CPURegisters BaseRegister;
+        
+    public:
+        
+        // instance handling
+        AssemblyOperand();
+        void Parse( const std::string& OperandText );
+        
+        // queries
+        bool IsLabel() const;
+        bool IsSameAs( const AssemblyOperand& Other ) const;
+        bool UsesRegister( V32::CPURegisters Checked ) const;
+};
+
+// -----------------------------------------------------------------------------
+
+enum class AssemblyLineTypes
+{
+    Instruction,
+    Label,
+    Other           // comments, directives, asm blocks...
+};
+
+// -----------------------------------------------------------------------------
+
+class AssemblyLine
+{
+    public:
+        
+        AssemblyLineTypes Type;
+        std::string Text;
+        
+        // for instructions
+        V32::InstructionOpCodes OpCode;
+        std::vector< AssemblyOperand > Operands;
+        
+        // for labels
+        std::string LabelName;
+        
+        // C line mapped to this line (for debug info)
+        CNode* DebugNode;
+        
+        // state within the optimizer
+        bool Removed;
+        bool Modified;
+        
+    public:
+        
+        // instance handling
+        AssemblyLine();
+        void Parse( const std::string& LineText );
+        
+        // transformations
+        void ReplaceInstruction( V32::InstructionOpCodes NewOpCode, const std::vector< std::string >& NewOperands );
+        std::string ToText() const;
+};
+
+
+// =============================================================================
+//      PEEPHOLE OPTIMIZER
+// =============================================================================
+
+
+// Rewrites the emitted program to remove redundancies that
+// are only visible in short instruction sequences. Lines from
+// asm blocks are never modified, and they also act as barriers
+// so that no rule ever matches a sequence that includes them.
+// Labels are barriers too, unless no line refers to them.
+class PeepholeOptimizer
+{
+    public:
+        
+        // program being optimized
+        std::vector< AssemblyLine > Lines;
+        std::map< std::string, int > LabelPositions;
+        CNode* EndDebugNode;
+        
+        // identifiers used anywhere outside of label
+        // definitions (the data section is not modified)
+        std::set< std::string > DataReferences;
+        std::set< std::string > ReferencedLabels;
+        
+        // statistics
+        std::vector< unsigned > RuleHits;
+        unsigned InitialInstructions;
+        unsigned FinalInstructions;
+        unsigned Passes;
+        
+    protected:
+        
+        // conversion from/to emitter results
+        void LoadLines( VirconCEmitter& Emitter );
+        void StoreLines( VirconCEmitter& Emitter );
+        void FindReferencedLabels();
+        
+        // applies all rules once to the whole program
+        bool RunPass();
+        
+    public:
+        
+        // instance handling
+        PeepholeOptimizer();
+        
+        // navigation and changes, used by rules
+        int NextInstruction( int Position );
+        bool IsFollowedByLabel( int Position, const std::string& LabelName );
+        std::string FinalJumpTarget( const std::string& LabelName );
+        void RemoveLine( int Position );
+        
+        // main functions
+        void Optimize( VirconCEmitter& Emitter );
+        void PrintStatistics( std::ostream& Output );
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
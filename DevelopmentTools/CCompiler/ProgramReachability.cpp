@@ -0,0 +1,381 @@
+// *****************************************************************************
+    // include project headers
+    #include "ProgramReachability.hpp"
+    #include "VariableRegisterAllocation.hpp"
+    
+    // include C/C++ headers
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// initializations of globals are always run, so
+// the ones that call functions must be kept
+static bool InitializationUsesFunctionCalls( CNode* InitialValue )
+{
+    if( !InitialValue )
+      return false;
+    
+    if( InitialValue->Type() == CNodeTypes::InitializationList )
+    {
+        for( CNode* Value: ((InitializationListNode*)InitialValue)->AssignedValues )
+          if( InitializationUsesFunctionCalls( Value ) )
+            return true;
+        
+        return false;
+    }
+    
+    return ((ExpressionNode*)InitialValue)->UsesFunctionCalls();
+}
+
+
+// =============================================================================
+//      PROGRAM REACHABILITY: INSTANCE HANDLING
+// =============================================================================
+
+
+ProgramReachability::ProgramReachability()
+{
+    Inlining = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+void ProgramReachability::Clear()
+{
+    Definitions.clear();
+    GlobalDeclarations.clear();
+    AssemblyNames.clear();
+    Inlining = nullptr;
+    CalledFunctions.clear();
+    ReachedFunctions.clear();
+    UsedGlobals.clear();
+    PendingNodes.clear();
+}
+
+
+// =============================================================================
+//      PROGRAM REACHABILITY: AST ANALYSIS
+// =============================================================================
+
+
+// functions are analyzed once, but their own code
+// is only needed when some call is not inlined
+void ProgramReachability::AddFunction( const string& Name, bool IsCalled )
+{
+    if( IsCalled )
+      CalledFunctions.insert( Name );
+    
+    auto DefinitionPair = Definitions.find( Name );
+    
+    if( DefinitionPair == Definitions.end() )
+      return;
+    
+    if( ReachedFunctions.insert( Name ).second )
+      PendingNodes.push_back( DefinitionPair->second );
+}
+
+// -----------------------------------------------------------------------------
+
+void ProgramReachability::AddVariable( VariableNode* Variable )
+{
+    // locals are emitted with their function
+    auto DeclarationsPair = GlobalDeclarations.find( Variable->Name );
+    
+    if( DeclarationsPair == GlobalDeclarations.end() )
+      return;
+    
+    vector< VariableNode* >& Declarations = DeclarationsPair->second;
+    
+    if( find( Declarations.begin(), Declarations.end(), Variable ) == Declarations.end() )
+      return;
+    
+    // the initial values of a used global are
+    // emitted, so what they use is needed too
+    if( UsedGlobals.insert( Variable->Name ).second )
+      for( VariableNode* Declaration: Declarations )
+        if( Declaration->InitialValue )
+          PendingNodes.push_back( Declaration->InitialValue );
+}
+
+// -----------------------------------------------------------------------------
+
+void ProgramReachability::AnalyzeNode( CNode* Node )
+{
+    // some contructs have optional parts!
+    if( !Node ) return;
+    
+    switch( Node->Type() )
+    {
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // expressions
+        case CNodeTypes::ExpressionAtom:
+        {
+            ExpressionAtomNode* Atom = (ExpressionAtomNode*)Node;
+            
+            if( Atom->AtomType == AtomTypes::Variable && Atom->ResolvedVariable )
+              AddVariable( Atom->ResolvedVariable );
+            
+            break;
+        }
+        
+        case CNodeTypes::FunctionCall:
+        {
+            FunctionCallNode* FunctionCall = (FunctionCallNode*)Node;
+            
+            for( ExpressionNode* Parameter: FunctionCall->Parameters )
+              AnalyzeNode( Parameter );
+            
+            bool IsInlined = (Inlining->Find( FunctionCall->ResolvedFunction ) != nullptr);
+            AddFunction( FunctionCall->ResolvedFunction->Name, !IsInlined );
+            break;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+            AnalyzeNode( ((ArrayAccessNode*)Node)->ArrayOperand );
+            AnalyzeNode( ((ArrayAccessNode*)Node)->IndexOperand );
+            break;
+        
+        case CNodeTypes::UnaryOperation:
+            AnalyzeNode( ((UnaryOperationNode*)Node)->Operand );
+            break;
+        
+        case CNodeTypes::BinaryOperation:
+            AnalyzeNode( ((BinaryOperationNode*)Node)->LeftOperand );
+            AnalyzeNode( ((BinaryOperationNode*)Node)->RightOperand );
+            break;
+        
+        case CNodeTypes::EnclosedExpression:
+            AnalyzeNode( ((EnclosedExpressionNode*)Node)->InternalExpression );
+            break;
+        
+        case CNodeTypes::MemberAccess:
+            AnalyzeNode( ((MemberAccessNode*)Node)->GroupOperand );
+            break;
+        
+        case CNodeTypes::PointedMemberAccess:
+            AnalyzeNode( ((PointedMemberAccessNode*)Node)->GroupOperand );
+            break;
+        
+        case CNodeTypes::TypeConversion:
+            AnalyzeNode( ((TypeConversionNode*)Node)->ConvertedExpression );
+            break;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // declarations
+        case CNodeTypes::Function:
+        {
+            for( CNode* Statement: ((FunctionNode*)Node)->Statements )
+              AnalyzeNode( Statement );
+            
+            break;
+        }
+        
+        case CNodeTypes::VariableList:
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Node)->Variables )
+              AnalyzeNode( Variable->InitialValue );
+            
+            break;
+        }
+        
+        case CNodeTypes::InitializationList:
+        {
+            for( CNode* Value: ((InitializationListNode*)Node)->AssignedValues )
+              AnalyzeNode( Value );
+            
+            break;
+        }
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // statements
+        case CNodeTypes::Block:
+        {
+            for( CNode* Statement: ((BlockNode*)Node)->Statements )
+              AnalyzeNode( Statement );
+            
+            break;
+        }
+        
+        case CNodeTypes::Switch:
+        {
+            SwitchNode* Switch = (SwitchNode*)Node;
+            AnalyzeNode( Switch->Condition );
+            
+            for( CNode* Statement: Switch->Statements )
+              AnalyzeNode( Statement );
+            
+            break;
+        }
+        
+        case CNodeTypes::If:
+            AnalyzeNode( ((IfNode*)Node)->Condition );
+            AnalyzeNode( ((IfNode*)Node)->TrueStatement );
+            AnalyzeNode( ((IfNode*)Node)->FalseStatement );
+            break;
+        
+        case CNodeTypes::While:
+            AnalyzeNode( ((WhileNode*)Node)->Condition );
+            AnalyzeNode( ((WhileNode*)Node)->LoopStatement );
+            break;
+        
+        case CNodeTypes::Do:
+            AnalyzeNode( ((DoNode*)Node)->LoopStatement );
+            AnalyzeNode( ((DoNode*)Node)->Condition );
+            break;
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Node;
+            AnalyzeNode( For->InitialAction );
+            AnalyzeNode( For->Condition );
+            AnalyzeNode( For->LoopStatement );
+            AnalyzeNode( For->IterationAction );
+            break;
+        }
+        
+        case CNodeTypes::Return:
+            AnalyzeNode( ((ReturnNode*)Node)->ReturnedExpression );
+            break;
+        
+        // asm code can name any function or global
+        case CNodeTypes::AssemblyBlock:
+        {
+            for( auto& AssemblyLine: ((AssemblyBlockNode*)Node)->AssemblyLines )
+            {
+                if( AssemblyLine.EmbeddedAtom )
+                  AnalyzeNode( AssemblyLine.EmbeddedAtom );
+                
+                for( string& Word: SplitAssemblyLine( AssemblyLine.Text ) )
+                {
+                    if( Word.compare( 0, 11, "__function_" ) == 0 )
+                      AddFunction( Word.substr( 11 ), true );
+                    
+                    auto NamePair = AssemblyNames.find( Word );
+                    
+                    if( NamePair != AssemblyNames.end() )
+                      for( VariableNode* Declaration: GlobalDeclarations[ NamePair->second ] )
+                        AddVariable( Declaration );
+                }
+            }
+            
+            break;
+        }
+        
+        // other nodes don't use functions or variables
+        // (sizeof does not evaluate its operand)
+        default:
+            break;
+    }
+}
+
+
+// =============================================================================
+//      PROGRAM REACHABILITY: MAIN FUNCTIONS
+// =============================================================================
+
+
+void ProgramReachability::Analyze( TopLevelNode* ProgramAST, const FunctionInlining& Inlining_, bool IsBios )
+{
+    Clear();
+    Inlining = &Inlining_;
+    
+    // find all functions and globals in the program
+    for( CNode* Statement: ProgramAST->Statements )
+    {
+        if( Statement->Type() == CNodeTypes::Function )
+        {
+            FunctionNode* Function = (FunctionNode*)Statement;
+            
+            if( Function->HasBody )
+              Definitions[ Function->Name ] = Function;
+        }
+        
+        else if( Statement->Type() == CNodeTypes::VariableList )
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+            {
+                GlobalDeclarations[ Variable->Name ].push_back( Variable );
+                AssemblyNames[ "global_" + Variable->Name ] = Variable->Name;
+            }
+        }
+        
+        else if( Statement->Type() == CNodeTypes::EmbeddedFile )
+        {
+            VariableNode* Variable = ((EmbeddedFileNode*)Statement)->Variable;
+            GlobalDeclarations[ Variable->Name ].push_back( Variable );
+            AssemblyNames[ Variable->Placement.AccessAddressString() ] = Variable->Name;
+        }
+    }
+    
+    // the program starts from main (and the BIOS
+    // can also be entered from its error handler)
+    AddFunction( "main", true );
+    
+    if( IsBios )
+      AddFunction( "error_handler", true );
+    
+    for( auto& DeclarationsPair: GlobalDeclarations )
+      for( VariableNode* Declaration: DeclarationsPair.second )
+        if( InitializationUsesFunctionCalls( Declaration->InitialValue ) )
+          AddVariable( Declaration );
+    
+    // follow everything used by the reached code
+    while( !PendingNodes.empty() )
+    {
+        CNode* Node = PendingNodes.back();
+        PendingNodes.pop_back();
+        AnalyzeNode( Node );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// without optimizations the whole program is emitted
+void ProgramReachability::MarkAllAsUsed( TopLevelNode* ProgramAST )
+{
+    Clear();
+    
+    for( CNode* Statement: ProgramAST->Statements )
+    {
+        if( Statement->Type() == CNodeTypes::Function )
+          CalledFunctions.insert( ((FunctionNode*)Statement)->Name );
+        
+        else if( Statement->Type() == CNodeTypes::VariableList )
+        {
+            for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+              UsedGlobals.insert( Variable->Name );
+        }
+        
+        else if( Statement->Type() == CNodeTypes::EmbeddedFile )
+          UsedGlobals.insert( ((EmbeddedFileNode*)Statement)->Variable->Name );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// tells if a top level declaration needs to be emitted
+bool ProgramReachability::IsUsed( CNode* Declaration ) const
+{
+    if( Declaration->Type() == CNodeTypes::Function )
+      return CalledFunctions.count( ((FunctionNode*)Declaration)->Name ) > 0;
+    
+    if( Declaration->Type() == CNodeTypes::EmbeddedFile )
+      return VariableIsUsed( ((EmbeddedFileNode*)Declaration)->Variable );
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool ProgramReachability::VariableIsUsed( VariableNode* Variable ) const
+{
+    return UsedGlobals.count( Variable->Name ) > 0;
+}
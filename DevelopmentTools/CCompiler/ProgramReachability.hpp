@@ -0,0 +1,73 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef PROGRAMREACHABILITY_HPP
+    #define PROGRAMREACHABILITY_HPP
+    
+    // include project headers
+    #include "CNodes.hpp"
+    #include "FunctionInlining.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+// *****************************************************************************
+
+
+// =============================================================================
+//      CLASS TO FIND THE PARTS OF A PROGRAM THAT ARE USED
+// =============================================================================
+
+
+// Headers define all of their functions, so most programs
+// include many that they never call. Starting from main,
+// this follows function calls, global variables and the
+// names used in asm blocks to find out which functions
+// and globals the program can actually reach. The rest
+// don't need to be emitted (along with their strings).
+// Functions that are always inlined are followed too,
+// but their own code is only needed if they are called.
+class ProgramReachability
+{
+    protected:
+        
+        // program data, by name (globals can have
+        // several declarations, and asm code refers
+        // to them by the names given in emission)
+        std::map< std::string, FunctionNode* > Definitions;
+        std::map< std::string, std::vector< VariableNode* > > GlobalDeclarations;
+        std::map< std::string, std::string > AssemblyNames;
+        const FunctionInlining* Inlining;
+        
+        // results of the analysis
+        std::set< std::string > CalledFunctions;
+        std::set< std::string > ReachedFunctions;
+        std::set< std::string > UsedGlobals;
+        
+        // code still to be analyzed
+        std::vector< CNode* > PendingNodes;
+        
+        // analysis of the AST
+        void AddFunction( const std::string& Name, bool IsCalled );
+        void AddVariable( VariableNode* Variable );
+        void AnalyzeNode( CNode* Node );
+        
+    public:
+        
+        // instance handling
+        ProgramReachability();
+        void Clear();
+        
+        // main functions
+        void Analyze( TopLevelNode* ProgramAST, const FunctionInlining& Inlining_, bool IsBios );
+        void MarkAllAsUsed( TopLevelNode* ProgramAST );
+        bool IsUsed( CNode* Declaration ) const;
+        bool VariableIsUsed( VariableNode* Variable ) const;
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
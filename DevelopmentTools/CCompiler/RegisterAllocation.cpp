@@ -4,6 +4,9 @@
     #include "CompilerInfrastructure.hpp"
     #include "Globals.hpp"
     
+    // include C/C++ headers
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
     // declare used namespaces
     using namespace std;
 // *****************************************************************************
@@ -22,6 +25,9 @@ RegisterAllocation::RegisterAllocation( SourceLocation Location_ )
     for( bool& R: RegisterUsed )
       R = false;
     
+    for( bool& R: RegisterReserved )
+      R = false;
+    
     TemporariesStackSize = 0;
     HighestUsedRegister = 0;
 }
@@ -35,7 +41,7 @@ int RegisterAllocation::FirstFreeRegister()
     // Registers BP and SP (indices 14 and 15) are used
     // to control the stack so they are not used either
     for( int i = 1; i < 14; i++ )
-    if( !RegisterUsed[ i ] )
+    if( !RegisterUsed[ i ] && !RegisterReserved[ i ] )
     {
         // track the highest used register
         if( i > HighestUsedRegister )
@@ -49,3 +55,30 @@ int RegisterAllocation::FirstFreeRegister()
     // no free register was found
     RaiseFatalError( Location, "expression is too complex, try splitting it into simpler expressions" );
 }
+
+
+// =============================================================================
+//      REGISTER CALLING CONVENTION
+// =============================================================================
+
+
+int RegisterArgumentsCount( FunctionNode* Function )
+{
+    if( !Function->PassesArgumentsInRegisters )
+      return 0;
+    
+    return min( (int)Function->Arguments.size(), MaximumRegisterArguments );
+}
+
+// -----------------------------------------------------------------------------
+
+set< int > CallerSavedRegisters()
+{
+    set< int > Registers;
+    
+    for( int i = 0; i < 14; i++ )
+      if( i < FirstCalleeSavedRegister || i > LastCalleeSavedRegister )
+        Registers.insert( i );
+    
+    return Registers;
+}
@@ -5,6 +5,9 @@
     
     // include project headers
     #include "CNodes.hpp"
+    
+    // include C/C++ headers
+    #include <set>              // [ C++ STL ] Sets
 // *****************************************************************************
 
 
@@ -27,6 +30,10 @@ class RegisterAllocation
         // preserved since the CPU stack uses them
         bool RegisterUsed[ 14 ];
         
+        // registers holding local variables for the
+        // whole function are never used as temporaries
+        bool RegisterReserved[ 14 ];
+        
         // when using space from the allocated
         // temporaries, use a LIFO stack pattern
         int TemporariesStackSize;
@@ -43,6 +50,30 @@ class RegisterAllocation
 };
 
 
+// =============================================================================
+//      REGISTER CALLING CONVENTION
+// =============================================================================
+
+
+// With the register convention, the first arguments of a
+// function are passed in R1 to R4. Functions can freely
+// modify those registers, as well as R0 (their result) and
+// R11 to R13, so callers need to save them if they are in
+// use. Functions must preserve R5 to R10 when they use them.
+const int FirstArgumentRegister = 1;
+const int MaximumRegisterArguments = 4;
+const int FirstCalleeSavedRegister = 5;
+const int LastCalleeSavedRegister = 10;
+
+// number of arguments that the function receives in
+// registers (the rest are passed in the stack)
+int RegisterArgumentsCount( FunctionNode* Function );
+
+// registers that a function using the register
+// convention can be expected to modify
+std::set< int > CallerSavedRegisters();
+
+
 // *****************************************************************************
     // end include guard
     #endif
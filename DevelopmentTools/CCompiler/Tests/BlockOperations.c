@@ -0,0 +1,135 @@
+// For loops that only copy array elements or set all of
+// them to the same value are done with the block operations
+// of the CPU (MOVS and SETS). Results cover the index value
+// after the loop (also when it never runs), fills that need
+// a conversion, structures, rows of 2D arrays, overlapping
+// ranges through pointers, and loops that must still run
+// one step at a time.
+
+#include "CheckResults.h"
+
+struct Point
+{
+    int x, y;
+};
+
+int[ 30 ] Results;
+
+// expected values, in the same order
+int[ 13 ] Expected = { 90, 48, 506, 864, 499, 40, 23, 502, 36, 6, 1, 6, 3 };
+
+int[ 10 ] Source;
+int[ 10 ] Destination;
+float[ 6 ] Factors;
+Point[ 4 ] Points;
+Point[ 4 ] PointsCopy;
+int[ 3 ][ 5 ] Rows;
+
+void main( void )
+{
+    for( int i = 0; i < 10; i++ )
+      Source[ i ] = i * i;
+    
+    // copies and fills
+    for( int i = 0; i < 10; i++ )
+      Destination[ i ] = Source[ i ];
+    
+    Results[ 0 ] = Destination[ 3 ] + Destination[ 9 ];
+    
+    for( int i = 2; i < 7; i++ )
+      Destination[ i ] = -1;
+    
+    Results[ 1 ] = Destination[ 1 ] + Destination[ 2 ] + Destination[ 6 ] + Destination[ 7 ];
+    
+    // the index is still used after the loop
+    int i;
+    int Last = 4;
+    
+    for( i = 1; i <= Last; ++i )
+      Destination[ i ] = 7;
+    
+    Results[ 2 ] = i * 100 + Destination[ 0 ] + Destination[ 4 ] + Destination[ 5 ];
+    
+    // loops that do not run keep the start index
+    for( i = 8; i < Last; i += 1 )
+      Destination[ i ] = 1000;
+    
+    Results[ 3 ] = i * 100 + Destination[ 8 ];
+    
+    for( i = 5; 5 > i; i++ )
+      Destination[ i ] = 1000;
+    
+    Results[ 4 ] = i * 100 + Destination[ 5 ];
+    
+    // fills converted to the element type
+    for( int j = 0; j < 6; j++ )
+      Factors[ j ] = 2;
+    
+    Results[ 5 ] = (int)(Factors[ 0 ] * Factors[ 5 ] * 10.0);
+    
+    // structures are copied word by word
+    for( int j = 0; j < 4; j++ )
+    {
+        Points[ j ].x = j;
+        Points[ j ].y = 10 * j;
+    }
+    
+    for( int j = 1; j < 4; j++ )
+    {
+        PointsCopy[ j ] = Points[ j ];
+    }
+    
+    Results[ 6 ] = PointsCopy[ 0 ].y + PointsCopy[ 2 ].y + PointsCopy[ 3 ].x;
+    
+    // rows of 2D arrays
+    int Row = 2;
+    
+    for( int j = 0; j < 5; j++ )
+      Rows[ Row ][ j ] = j + 1;
+    
+    for( int j = 0; j < 5; j++ )
+      Rows[ 0 ][ j ] = Rows[ Row ][ j ];
+    
+    for( int j = 1; j < 4; j++ )
+      Rows[ 1 ][ j ] = Row;
+    
+    Results[ 7 ] = Rows[ 0 ][ 4 ] * 100 + Rows[ 1 ][ 0 ] * 10 + Rows[ 1 ][ 3 ];
+    
+    // pointers, with overlapping ranges
+    int* p = &Source[ 1 ];
+    int* q = &Source[ 0 ];
+    
+    for( int j = 0; j < 5; j++ )
+      p[ j ] = q[ j ];
+    
+    Results[ 8 ] = Source[ 0 ] + Source[ 3 ] + Source[ 5 ] + Source[ 6 ];
+    
+    int Fill = 3;
+    
+    for( int j = 0; j < 4; j++ )
+      p[ j ] = Fill;
+    
+    Results[ 9 ] = Source[ 0 ] + Source[ 1 ] + Source[ 4 ] + Source[ 5 ];
+    
+    // a pointer that writes over its own limit
+    int n = 3;
+    int* pn = &n;
+    
+    for( int j = 0; j < n; j++ )
+      pn[ j ] = 1;
+    
+    Results[ 10 ] = n;
+    
+    // loops that cannot use block operations
+    for( int j = 0; j < 4; j++ )
+      Destination[ j ] = Source[ j + 1 ];
+    
+    Results[ 11 ] = Destination[ 0 ] + Destination[ 3 ];
+    
+    for( int j = 0; j < 4; j++ )
+      Destination[ j ] = j;
+    
+    Results[ 12 ] = Destination[ 0 ] + Destination[ 3 ];
+    
+    CheckResults( Results, Expected, 13 );
+}
@@ -0,0 +1,33 @@
+// Shared by the tests that run their code and keep
+// the results in a global array: call it at the end
+// of main with the values each result must have. The
+// screen shows PASS, or FAIL followed by the position
+// of every result that is wrong.
+
+#ifndef CHECKRESULTS_H
+#define CHECKRESULTS_H
+
+#include "video.h"
+#include "string.h"
+
+void CheckResults( int* Results, int* Expected, int NumberOfResults )
+{
+    int[ 20 ] Text;
+    int Failures = 0;
+    
+    clear_screen( color_black );
+    
+    for( int i = 0; i < NumberOfResults; i++ )
+      if( Results[ i ] != Expected[ i ] )
+      {
+          itoa( i, Text, 10 );
+          print_at( 10, 40 + 20 * Failures, "Wrong result:" );
+          print_at( 150, 40 + 20 * Failures, Text );
+          Failures++;
+      }
+    
+    if( Failures ) print_at( 10, 10, "FAIL" );
+    else print_at( 10, 10, "PASS" );
+}
+
+#endif
@@ -0,0 +1,140 @@
+// Expressions are simplified before emission: constants
+// are combined, operations that do nothing are removed and
+// known values of local variables are used in their place.
+// Each result covers one of those simplifications, or a
+// place where a value must not be assumed: after loops,
+// branches and labels, for variables used by address or
+// written from asm, and for unread stores that still call
+// functions.
+
+#include "CheckResults.h"
+
+int[ 40 ] Results;
+
+// expected values, in the same order
+int[ 26 ] Expected = { 10, 14, 7, 7, -3, -5, -4, 25, 25, 7, 40, 16, 3, 4, 0, 103, 6, 4, 12, 20, 8, 9, 6, 3, 15, 1 };
+
+int Calls = 0;
+
+int Identity( int x )
+{
+    Calls++;
+    return x;
+}
+
+void main( void )
+{
+    int a = Identity( 7 );
+    int b = Identity( -3 );
+    float f = 2.5;
+    
+    // combining constants and removing identities
+    Results[ 0 ] = a + 1 + 2;
+    Results[ 1 ] = (a + 4) * 2 - 8;
+    Results[ 2 ] = a * 1 + 0;
+    Results[ 3 ] = -(-a);
+    Results[ 4 ] = ~~b;
+    Results[ 5 ] = 10 - (a - b) - 5;
+    Results[ 6 ] = -a + 3;
+    Results[ 7 ] = (a | 0) + (b ^ 0) + (a << 0) + (a & -1) + a / 1;
+    Results[ 8 ] = (int)(f * 1.0 / 1.0 * 10.0);
+    Results[ 9 ] = 2147483647 + a - 2147483647;
+    
+    // constants and copies across statements
+    int k = 5;
+    int c = k;
+    int d = c;
+    Results[ 10 ] = d * a + k;
+    k += 10;
+    k++;
+    Results[ 11 ] = k;
+    
+    // a post-increment gives the previous value
+    int p = 3;
+    Results[ 12 ] = p++;
+    Results[ 13 ] = p;
+    
+    // divisions by a known zero are left to run
+    int z = 0;
+    if( a < 0 ) Results[ 14 ] = a / z;
+    else Results[ 14 ] = z;
+    
+    // branches keep only what both agree on
+    int e = 1, g = 2;
+    if( a > b ) { e = 1; g = 3; }
+    else        { e = 1; g = 4; }
+    Results[ 15 ] = e * 100 + g;
+    
+    // loops change their variables in every iteration
+    int s = 0;
+    int i = 0;
+    while( i < 4 )
+    {
+        s += i;
+        i++;
+    }
+    Results[ 16 ] = s;
+    Results[ 17 ] = i;
+    
+    int t = 10;
+    for( int j = 0; j < 3; j++ )
+    {
+        if( j == 1 ) continue;
+        t = t + j;
+    }
+    Results[ 18 ] = t;
+    
+    // cases can be entered from the switch or the case before
+    int w = 1;
+    switch( a )
+    {
+        case 7:
+            w = 2;
+        case 8:
+            w = w * 10;
+            break;
+        default:
+            w = 0;
+    }
+    Results[ 19 ] = w;
+    
+    // labels can be reached from elsewhere
+    int n = 0;
+    int m = 1;
+    again:
+    m *= 2;
+    n++;
+    if( n < 3 ) goto again;
+    Results[ 20 ] = m;
+    
+    // variables used by address are never replaced
+    int r = 4;
+    int* pr = &r;
+    *pr = 9;
+    Results[ 21 ] = r;
+    
+    // values stored from asm are never replaced
+    int v = 1;
+    asm
+    {
+        "mov R0, 6"
+        "mov {v}, R0"
+    }
+    Results[ 22 ] = v;
+    
+    // stores to variables that are never read are
+    // removed, but not the function calls in them
+    int Unread = 12;
+    Unread = Identity( 13 );
+    Unread = 14;
+    Results[ 23 ] = Calls;
+    
+    // conversions of known values
+    float h = 3;
+    h = h / 2;
+    Results[ 24 ] = (int)(h * 10.0);
+    bool yes = a > 0;
+    Results[ 25 ] = yes;
+    
+    CheckResults( Results, Expected, 26 );
+}
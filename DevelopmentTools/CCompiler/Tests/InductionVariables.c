@@ -0,0 +1,147 @@
+// In for loops that step a variable by a constant, accesses
+// to arrays indexed by that variable become pointers that
+// advance with it, and values that do not change in the loop
+// are calculated before it. Results cover struct arrays,
+// nested loops over a 2D array, negative and larger steps,
+// start values taken from variables and loops with continue.
+// They also cover loops that must be left as they are: the
+// variable changes in the body, or arrays are reached through
+// a pointer.
+
+#include "CheckResults.h"
+
+struct Particle
+{
+    int x, y;
+    int vx, vy;
+};
+
+int[ 20 ] Results;
+
+// expected values, in the same order
+int[ 10 ] Expected = { 869, 420, 7938, 542, 10, 110, 5664, 3821, 14, -7 };
+
+Particle[ 8 ] Particles;
+int[ 4 ][ 6 ] Map;
+int Width = 6;
+int Height = 4;
+
+void main( void )
+{
+    // arrays of structures
+    for( int i = 0; i < 8; i++ )
+    {
+        Particles[ i ].x = i;
+        Particles[ i ].y = 10 * i;
+        Particles[ i ].vx = i % 3;
+        Particles[ i ].vy = -1;
+    }
+    
+    for( int i = 0; i < 8; i++ )
+    {
+        Particles[ i ].x += Particles[ i ].vx;
+        Particles[ i ].y += Particles[ i ].vy;
+    }
+    
+    Results[ 0 ] = Particles[ 7 ].x * 100 + Particles[ 7 ].y;
+    
+    // nested loops over a 2D array, with invariant bounds
+    for( int y = 0; y < Height; y++ )
+      for( int x = 0; x < Width; x++ )
+        Map[ y ][ x ] = x + y * 10 + Map[ y ][ x ];
+    
+    int Sum = 0;
+    
+    for( int i = 0; i < Width * Height; i++ )
+      Sum += Map[ i / 6 ][ i % 6 ];
+    
+    Results[ 1 ] = Sum;
+    
+    // negative and larger steps
+    int[ 10 ] a;
+    
+    for( int i = 9; i >= 0; i-- )
+      a[ i ] = i * i - a[ i ] * 0;
+    
+    Sum = 0;
+    
+    for( int i = 0; i < 10; i += 3 )
+      Sum += a[ i ] * a[ i ];
+    
+    Results[ 2 ] = Sum;
+    
+    // the start value comes from a variable
+    int First = 4;
+    int i;
+    Sum = 0;
+    
+    for( i = First; i < 10; i++ )
+      Sum += a[ i ] + a[ i ];
+    
+    Results[ 3 ] = Sum;
+    Results[ 4 ] = i;
+    
+    // continue skips the end of the body
+    Sum = 0;
+    
+    for( int j = 0; j < 10; j++ )
+    {
+        if( a[ j ] > 30 )
+          continue;
+        
+        Sum += a[ j ] + a[ j ];
+    }
+    
+    Results[ 5 ] = Sum;
+    
+    // the variable also changes in the body
+    Sum = 0;
+    
+    for( int j = 0; j < 10; j++ )
+    {
+        Sum += a[ j ] * a[ j ];
+        j++;
+    }
+    
+    Results[ 6 ] = Sum;
+    
+    // accesses through a pointer, that can change
+    int* p = &a[ 2 ];
+    Sum = 0;
+    
+    for( int j = 0; j < 4; j++ )
+      Sum += p[ j ] + p[ j ];
+    
+    for( int j = 0; j < 3; j++ )
+    {
+        Sum += p[ j ] * p[ j ];
+        p = &a[ 5 ];
+    }
+    
+    Results[ 7 ] = Sum;
+    
+    // arrays declared inside of the loop
+    Sum = 0;
+    
+    for( int j = 0; j < 3; j++ )
+    {
+        int[ 3 ] b;
+        b[ j ] = j + 1;
+        Sum += b[ j ] * b[ j ];
+    }
+    
+    Results[ 8 ] = Sum;
+    
+    // loops that end early
+    for( int j = 0; j < 8; j++ )
+    {
+        if( Particles[ j ].vx == 0 && j > 0 )
+          break;
+        
+        Particles[ j ].vy = Particles[ j ].vy * 2;
+    }
+    
+    Results[ 9 ] = Particles[ 0 ].vy + Particles[ 1 ].vy + Particles[ 2 ].vy + Particles[ 3 ].vy;
+    
+    CheckResults( Results, Expected, 10 );
+}
@@ -0,0 +1,111 @@
+// Small functions are emitted in place of their calls.
+// Results cover asm wrappers that preserve or modify
+// registers, one-line functions with constant and variable
+// arguments, inlined calls inside other expressions and
+// inside other inlined functions, arguments modified in
+// the body, and functions that must stay as calls (long
+// or recursive ones).
+
+#include "CheckResults.h"
+
+int[ 30 ] Results;
+
+// expected values, in the same order
+int[ 18 ] Expected = { 3, 42, 81, 25, 25, 9, 89, 120, 665, 32, 21, 0, 1, 4, 9, 16, 5, 10 };
+
+// asm wrapper that preserves what it uses
+int Minimum( int a, int b )
+{
+    asm
+    {
+        "push R1"
+        "mov R0, {a}"
+        "mov R1, {b}"
+        "imin R0, R1"
+        "pop R1"
+    }
+}
+
+// asm wrapper that modifies registers
+int Twice( int a )
+{
+    asm
+    {
+        "mov R2, {a}"
+        "iadd R2, R2"
+        "mov R0, R2"
+    }
+}
+
+// function with only a return
+int Square( int x )
+{
+    return x * x;
+}
+
+float Half( float x )
+{
+    return x / 2.0;
+}
+
+// inlined functions can use other inlined functions
+int Distance( int x, int y )
+{
+    return Square( x ) + Square( y );
+}
+
+// a void function with an expression
+void Store( int Index, int Value )
+{
+    Results[ Index ] = Value;
+}
+
+// an argument that is modified
+int Decrement( int x )
+{
+    x -= 1;
+    return x;
+}
+
+// long functions are only inlined when requested
+inline int Polynomial( int x )
+{
+    return x*x*x*x + 2*x*x*x + 3*x*x + 4*x + 5 + x*x*x*x*x;
+}
+
+// recursive functions are always called
+int Factorial( int n )
+{
+    if( n <= 1 ) return 1;
+    return n * Factorial( n - 1 );
+}
+
+void main( void )
+{
+    Results[ 0 ] = Minimum( 7, 3 );
+    Results[ 1 ] = Twice( 21 );
+    Results[ 2 ] = Square( 9 );
+    Results[ 3 ] = (int)(Half( 5.0 ) * 10.0);
+    Results[ 4 ] = Distance( 3, 4 );
+    Results[ 5 ] = Decrement( 10 );
+    Results[ 6 ] = Polynomial( 2 );
+    Results[ 7 ] = Factorial( 5 );
+    
+    // temporaries alive around inlined code
+    int a = 5, b = 8;
+    Results[ 8 ] = a * 100 + Twice( b ) * 10 + Minimum( a, b );
+    Results[ 9 ] = Square( a + 1 ) - Square( Twice( a ) - b );
+    Results[ 10 ] = Minimum( Square( a ), Twice( b ) + a );
+    
+    // arguments from variables
+    for( int i = 0; i < 5; i++ )
+    {
+        Store( 11 + i, Square( i ) );
+        b = Decrement( b ) + Minimum( i, 2 );
+    }
+    
+    Results[ 16 ] = a;
+    Results[ 17 ] = b;
+    
+    CheckResults( Results, Expected, 18 );
+}
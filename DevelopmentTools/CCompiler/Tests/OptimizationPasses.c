@@ -0,0 +1,152 @@
+// Functions go through optimization passes that depend on
+// the level chosen with -O0, -O1 or -O2: dead code is removed,
+// values computed more than once are kept in variables and
+// loops stop computing values that do not change. Results
+// cover each pass, including labels reached inside dead code,
+// and also expressions that only look the same: a variable,
+// a pointed value or a global changed by a call in between
+// must be read again. Results must not change between levels.
+
+#include "CheckResults.h"
+
+int[ 30 ] Results;
+
+// expected values, in the same order
+int[ 15 ] Expected = { 0, 11, 19, 75, 45, 28, 32, 1026, 1395, 6, 35, 28, 138, 23, 6 };
+
+int Calls = 0;
+
+int Identity( int x )
+{
+    Calls++;
+    return x;
+}
+
+int EarlyReturn( int x )
+{
+    if( x > 0 )
+      return 1;
+    else
+      return -1;
+    
+    // unreachable, since both branches return
+    Calls += 1000;
+    return 0;
+}
+
+void main( void )
+{
+    int a = Identity( 6 );
+    int b = Identity( 4 );
+    
+    // static conditions and unreachable code
+    if( 0 )
+      Calls += 1000;
+    
+    while( 0 )
+      Calls += 1000;
+    
+    Results[ 0 ] = EarlyReturn( a ) + EarlyReturn( -b );
+    
+    // a label inside dead code can still be reached
+    goto inside;
+    
+    if( 0 )
+    {
+        Calls += 1000;
+        inside:
+        Results[ 1 ] = 11;
+    }
+    
+    // stores that are never read
+    int unused = a * b;
+    unused = a + b;
+    int kept = a * 3;
+    kept = kept + 1;
+    Results[ 2 ] = kept;
+    
+    // common subexpressions
+    Results[ 3 ] = (a * b + 1) + (a * b + 1) * 2;
+    int s1 = (a - b) * (a + b);
+    int s2 = (a - b) * (a + b) + 5;
+    Results[ 4 ] = s1 + s2;
+    
+    // the same text, but a variable changes in between
+    int c = (a << 2) + b;
+    a++;
+    int d = (a << 2) + b;
+    Results[ 5 ] = c;
+    Results[ 6 ] = d;
+    a--;
+    
+    // values read through pointers can change
+    int m = 3;
+    int* pm = &m;
+    int e = (m * m) + 1;
+    *pm = 5;
+    int f = (m * m) + 1;
+    Results[ 7 ] = e * 100 + f;
+    
+    // loop invariants, and values that only look invariant
+    int Sum = 0;
+    
+    for( int i = 0; i < 10; i++ )
+      Sum += (a * b + 7) * i;
+    
+    Results[ 8 ] = Sum;
+    
+    int Matches = 0;
+    
+    for( int i = 0; i < 20; i++ )
+      if( i > 3 && (i % 3 == 0 || i == 7) )
+        Matches++;
+    
+    Results[ 9 ] = Matches;
+    
+    // a variable that changes inside of the loop body
+    int g = 1;
+    Sum = 0;
+    
+    for( int i = 0; i < 5; i++ )
+    {
+        Sum += (g * 3) + (b - a);
+        g++;
+    }
+    
+    Results[ 10 ] = Sum;
+    
+    // calls in the loop body may change globals
+    Sum = 0;
+    
+    for( int i = 0; i < 4; i++ )
+    {
+        Sum += Calls * 2;
+        Identity( i );
+    }
+    
+    Results[ 11 ] = Sum;
+    
+    // nested loops
+    Sum = 0;
+    
+    for( int i = 0; i < 3; i++ )
+      for( int j = 0; j < 4; j++ )
+        Sum += (a + b) * i + j;
+    
+    Results[ 12 ] = Sum;
+    
+    // loops that are never entered or only run once
+    int n = 0;
+    
+    while( n > 100 )
+      n += (a * b);
+    
+    do
+      n += (a * b) - 1;
+    while( 0 );
+    
+    Results[ 13 ] = n;
+    Results[ 14 ] = Calls;
+    
+    CheckResults( Results, Expected, 15 );
+}
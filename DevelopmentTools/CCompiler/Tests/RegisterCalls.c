@@ -0,0 +1,130 @@
+// Calls that pass arguments in registers (option -mregcall)
+// must give the same results as the ones using the stack.
+// Results cover functions with more arguments than
+// registers, calls nested inside other arguments, calls
+// made from asm blocks and calls through prototypes.
+
+#include "CheckResults.h"
+
+int[ 30 ] Results;
+
+// expected values, in the same order
+int[ 18 ] Expected = { 7, 91, 231, 12, 7, 42, 720, 30, 10, 1184, 10, 0, 1, 4, 9, 16, 26, 17 };
+
+// declared before its body is known
+int Later( int a, int b );
+
+int Add( int a, int b )
+{
+    return a + b;
+}
+
+// more arguments than registers
+int Weighted( int a, int b, int c, int d, int e, int f )
+{
+    return a + 2*b + 3*c + 4*d + 5*e + 6*f;
+}
+
+// arguments that are swapped on entry
+int Rotate( int a, int b, int c )
+{
+    int t = a;
+    a = b;
+    b = c;
+    c = t;
+    return a * 100 + b * 10 + c;
+}
+
+// address of an argument
+int Indirect( int a, int b )
+{
+    int* p = &a;
+    *p += b;
+    return a;
+}
+
+// a void function that modifies registers
+void Store( int Index, int Value )
+{
+    Results[ Index ] = Value;
+}
+
+// arguments read from an asm block
+int AsmSum( int a, int b )
+{
+    int Sum = 0;
+    
+    asm
+    {
+        "mov R0, {a}"
+        "mov R1, {b}"
+        "iadd R0, R1"
+        "mov {Sum}, R0"
+    }
+    
+    return Sum;
+}
+
+int Factorial( int n )
+{
+    if( n <= 1 ) return 1;
+    return n * Factorial( n - 1 );
+}
+
+float Average( float x, float y )
+{
+    return (x + y) / 2.0;
+}
+
+void main( void )
+{
+    Results[ 0 ] = Add( 3, 4 );
+    Results[ 1 ] = Weighted( 1, 2, 3, 4, 5, 6 );
+    Results[ 2 ] = Rotate( 1, 2, 3 );
+    Results[ 3 ] = Indirect( 5, 7 );
+    Results[ 4 ] = Later( 9, 2 );
+    Results[ 5 ] = AsmSum( 20, 22 );
+    Results[ 6 ] = Factorial( 6 );
+    Results[ 7 ] = (int)(Average( 1.5, 4.5 ) * 10.0);
+    
+    // nested calls and temporaries alive across calls
+    Results[ 8 ] = Add( Add( 1, 2 ), Add( 3, 4 ) );
+    Results[ 9 ] = 1000 + Weighted( Add( 1, 1 ), 2, Add( 2, 1 ), 4, Add( 2, 3 ), 6 ) * 2;
+    Results[ 10 ] = Add( 1, 2 ) * Add( 3, 4 ) - Add( 5, 6 );
+    
+    // locals that are alive across calls
+    int Total = 0;
+    
+    for( int i = 0; i < 5; i++ )
+    {
+        Store( 11 + i, i * i );
+        Total += Add( i, Total );
+    }
+    
+    Results[ 16 ] = Total;
+    
+    // functions called from asm blocks keep passing
+    // their arguments in the stack
+    int FromAsm = 0;
+    
+    asm
+    {
+        "isub SP, 2"
+        "mov R1, 8"
+        "mov [SP], R1"
+        "mov R1, 9"
+        "mov [SP+1], R1"
+        "call __function_Add"
+        "iadd SP, 2"
+        "mov {FromAsm}, R0"
+    }
+    
+    Results[ 17 ] = FromAsm;
+    
+    CheckResults( Results, Expected, 18 );
+}
+
+int Later( int a, int b )
+{
+    return a - b;
+}
@@ -0,0 +1,193 @@
+// Local variables and arguments can be kept in registers
+// for a whole function. Results check values that must
+// survive calls (also in nested loops), pointers walking
+// arrays, variables with their address taken (which stay
+// in memory), asm blocks that modify registers, loops made
+// with goto, increments inside arguments, switches, floats
+// and shadowed names.
+
+#include "CheckResults.h"
+
+int[ 40 ] Results;
+
+// expected values, in the same order
+int[ 19 ] Expected = { 15, 55, 55, 418, 570, 162, 10, 24, 44, 119, 42, 14, 12, 34, 51, 184, 28, 20, 1 };
+int Counter = 0;
+
+struct Point
+{
+    int x, y;
+};
+
+// a void function does not preserve registers
+void Increment()
+{
+    int Temporary = Counter;
+    Temporary += 3;
+    Counter = Temporary;
+}
+
+// arguments are modified in place
+int SumDown( int n )
+{
+    int Sum = 0;
+    
+    while( n > 0 )
+    {
+        Sum += n;
+        n--;
+    }
+    
+    return Sum;
+}
+
+// locals must survive recursive calls
+int Fibonacci( int n )
+{
+    if( n < 2 ) return n;
+    int a = Fibonacci( n - 1 );
+    int b = Fibonacci( n - 2 );
+    return a + b;
+}
+
+int Compound( int Value )
+{
+    int x = Value;
+    x += 5;  x -= 2;  x *= 7;  x /= 3;  x %= 50;
+    x <<= 3; x >>= 1; x &= 0xFE; x |= 0x101; x ^= 0x33;
+    return x;
+}
+
+void main( void )
+{
+    int[ 10 ] Values;
+    
+    // loop counter alive across calls to a void function
+    for( int i = 0; i < 5; i++ )
+      Increment();
+    
+    Results[ 0 ] = Counter;
+    Results[ 1 ] = SumDown( 10 );
+    Results[ 2 ] = Fibonacci( 10 );
+    Results[ 3 ] = Compound( 1234 );
+    
+    // pointer walking an array
+    for( int i = 0; i < 10; i++ )
+      Values[ i ] = i * i;
+    
+    int* p = &Values[ 0 ];
+    int* End = &Values[ 10 ];
+    int Total = 0;
+    
+    while( p < End )
+    {
+        *p = *p * 2;
+        Total += *p++;
+    }
+    
+    Results[ 4 ] = Total;
+    Results[ 5 ] = Values[ 9 ];
+    
+    // a variable with its address taken stays in memory
+    int InMemory = 4;
+    int* q = &InMemory;
+    *q += 6;
+    Results[ 6 ] = InMemory;
+    
+    // asm blocks modify registers and read variables
+    int Local = 21;
+    int Doubled = 0;
+    
+    for( int j = 0; j < 3; j++ )
+    {
+        asm
+        {
+            "mov R5, {Local}"
+            "iadd R5, R5"
+            "mov R6, 1000"
+            "mov R7, R6"
+            "mov R8, R6"
+            "mov R9, R6"
+            "mov R10, R6"
+            "mov {Doubled}, R5"
+        }
+        
+        Local += j;
+    }
+    
+    Results[ 7 ] = Local;
+    Results[ 8 ] = Doubled;
+    
+    // nested loops with calls in the inner one
+    int Accumulated = 0;
+    
+    for( int a = 1; a <= 4; a++ )
+      for( int b = 1; b <= a; b++ )
+        Accumulated += SumDown( b ) * a;
+    
+    Results[ 9 ] = Accumulated;
+    
+    // loops built with goto
+    int k = 0;
+    int Steps = 0;
+    
+    loop:
+    k += 3;
+    Steps++;
+    if( k < 40 ) goto loop;
+    
+    Results[ 10 ] = k;
+    Results[ 11 ] = Steps;
+    
+    // increments within expressions and arguments
+    int m = 5;
+    int n = m++ + ++m;
+    Results[ 12 ] = n;
+    Results[ 13 ] = SumDown( m-- ) + m;
+    
+    // conditions and switches on register variables
+    int Matches = 0;
+    
+    for( int c = 0; c < 20; c++ )
+    {
+        if( c > 3 && (c % 3 == 0 || c == 7) )
+          Matches++;
+        
+        switch( c & 3 )
+        {
+            case 0: Matches += 10; break;
+            case 2: Matches -= 1;  break;
+            default: break;
+        }
+    }
+    
+    Results[ 14 ] = Matches;
+    
+    // floats and conversions
+    float f = 0.5;
+    
+    for( int d = 0; d < 7; d++ )
+      f = f * 2.0 + d;
+    
+    Results[ 15 ] = (int)f;
+    
+    // pointers to structures
+    Point Position;
+    Point* Pointer = &Position;
+    Pointer->x = 7;
+    Pointer->y = Pointer->x * 3;
+    Results[ 16 ] = Position.x + Position.y;
+    
+    // shadowed names in nested blocks
+    int s = 1;
+    
+    {
+        int s = 2;
+        s *= 10;
+        Results[ 17 ] = s;
+    }
+    
+    Results[ 18 ] = s;
+    
+    CheckResults( Results, Expected, 19 );
+}
@@ -0,0 +1,102 @@
+// Measures the CPU cycles taken by switch dispatch. The
+// cycle counter is read before and after running each
+// loop, and both counts are shown on screen. The values
+// returned are added into checksums, which must match the
+// ones expected from the case table, so that a wrong jump
+// or search is reported even if it is fast.
+// Dense cases should use a jump table, so their time is
+// the same for any value; sparse cases should use a
+// binary search. Each loop fits within a single frame.
+
+#include "time.h"
+#include "CheckResults.h"
+
+// dense values, as in a bytecode interpreter
+int RunOpcode( int opcode, int accumulator )
+{
+    switch( opcode )
+    {
+        case 0:  return accumulator;
+        case 1:  return accumulator + 1;
+        case 2:  return accumulator - 1;
+        case 3:  return accumulator * 2;
+        case 4:  return accumulator / 2;
+        case 5:  return accumulator + 7;
+        case 6:  return accumulator - 7;
+        case 7:  return accumulator ^ 5;
+        case 8:  return accumulator | 16;
+        case 9:  return accumulator & 255;
+        case 10: return -accumulator;
+        case 11: return accumulator + 100;
+        case 13: return accumulator - 100;
+        case 14: return accumulator * 3;
+        case 15: return 0;
+        default: return accumulator + 1000;
+    }
+}
+
+// sparse values, as in a message dispatcher
+int HandleMessage( int message )
+{
+    switch( message )
+    {
+        case -500:  return 1;
+        case 1:     return 2;
+        case 10:    return 3;
+        case 100:   return 4;
+        case 1000:  return 5;
+        case 2000:  return 6;
+        case 5000:  return 7;
+        case 10000: return 8;
+        case 20000: return 9;
+        case 50000: return 10;
+        case 99999: return 11;
+        default:    return 0;
+    }
+}
+
+// results are also kept in globals
+int DenseCycles;
+int SparseCycles;
+
+// checksums for dense and sparse switches
+int[ 2 ] Results;
+int[ 2 ] Expected = { 747, 5516 };
+
+void main( void )
+{
+    int[ 20 ] Text;
+    int[ 12 ] Messages = { 99999, 50000, 20000, 10000, 5000, 3, 2000, 1000, 100, 10, 1, -500 };
+    
+    // dense switch
+    int StartCycles = get_cycle_counter();
+    int Accumulator = 1;
+    
+    for( int i = 0; i < 1000; i++ )
+      Accumulator = RunOpcode( i % 17, Accumulator );
+    
+    DenseCycles = get_cycle_counter() - StartCycles;
+    Results[ 0 ] = Accumulator;
+    
+    // sparse switch (each loop starts on a new frame)
+    end_frame();
+    StartCycles = get_cycle_counter();
+    int Sum = 0;
+    
+    for( int i = 0; i < 1000; i++ )
+      Sum += HandleMessage( Messages[ i % 12 ] );
+    
+    SparseCycles = get_cycle_counter() - StartCycles;
+    Results[ 1 ] = Sum;
+    
+    // check results, and then show cycles below them
+    CheckResults( Results, Expected, 2 );
+    
+    itoa( DenseCycles, Text, 10 );
+    print_at( 10, 100, "Dense switch cycles:" );
+    print_at( 250, 100, Text );
+    
+    itoa( SparseCycles, Text, 10 );
+    print_at( 10, 120, "Sparse switch cycles:" );
+    print_at( 250, 120, Text );
+}
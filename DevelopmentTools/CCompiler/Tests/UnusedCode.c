@@ -0,0 +1,89 @@
+// Only the functions and globals that the program can
+// reach from main are emitted. Functions called only from
+// asm blocks and globals that asm code names must still be
+// kept, and so must globals initialized by function calls.
+// Results only check the code that is kept: that unused
+// ones and their literal strings do not appear must be
+// checked in the assembly output.
+
+#include "CheckResults.h"
+
+int[ 10 ] Results;
+
+// expected values, in the same order
+int[ 5 ] Expected = { 42, 23, 13, 1, 301 };
+
+// unused: neither these nor their string are emitted
+int* UnusedText = "this string is never used";
+int UnusedGlobal = 5;
+
+void UnusedFunction( int* Text )
+{
+    UnusedText = Text;
+}
+
+void CallsUnused( void )
+{
+    UnusedFunction( "this one is not used either" );
+}
+
+// only named in an asm block
+int CalledFromAsm( void )
+{
+    return 42;
+}
+
+// only named in asm blocks, by name and as a variable
+int AsmGlobal = 11;
+int AsmVariable = 12;
+
+// used through another global
+int Pointed = 13;
+int* Pointer = &Pointed;
+
+// never used, but its initialization calls a function
+int Counter = 0;
+
+int Count( void )
+{
+    Counter++;
+    return Counter;
+}
+
+int CountedGlobal = Count();
+
+// a prototype followed later by the definition
+int Later( int a );
+
+void main( void )
+{
+    int FromAsm = 0;
+    
+    asm
+    {
+        "call __function_CalledFromAsm"
+        "mov {FromAsm}, R0"
+    }
+    
+    Results[ 0 ] = FromAsm;
+    
+    asm
+    {
+        "mov R0, [global_AsmGlobal]"
+        "mov R1, {AsmVariable}"
+        "iadd R0, R1"
+        "mov {FromAsm}, R0"
+    }
+    
+    Results[ 1 ] = FromAsm;
+    Results[ 2 ] = *Pointer;
+    Results[ 3 ] = Counter;
+    Results[ 4 ] = Later( 3 );
+    
+    CheckResults( Results, Expected, 5 );
+}
+
+int Later( int a )
+{
+    return a * 100 + Counter;
+}
@@ -0,0 +1,762 @@
+// *****************************************************************************
+    // include infrastructure headers
+    #include "../DevToolsInfrastructure/EnumStringConversions.hpp"
+    #include "../DevToolsInfrastructure/StringFunctions.hpp"
+    
+    // include project headers
+    #include "VariableRegisterAllocation.hpp"
+    
+    // include C/C++ headers
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    #include <cctype>           // [ ANSI C ] Character types
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// uses of variables within loops will most likely run many
+// more times than the rest, so they are given higher weights
+// (deep nesting is capped so that weights cannot overflow)
+static const int LoopNestingWeights[] = { 1, 10, 100, 1000, 10000 };
+static const int MaximumLoopNesting = 4;
+
+// -----------------------------------------------------------------------------
+
+static bool IsIdentifierCharacter( char c )
+{
+    return isalnum( (unsigned char)c ) || c == '_';
+}
+
+// -----------------------------------------------------------------------------
+
+// only scalars can fit in a register; other variables
+// (and any non local ones) always stay in memory
+static bool CanBeInRegister( VariableNode* Variable )
+{
+    if( Variable->Placement.IsGlobal || Variable->Placement.IsEmbedded || Variable->IsExtern )
+      return false;
+    
+    DataType* Type = Variable->DeclaredType;
+    
+    if( Type->Type() != DataTypes::Primitive
+    &&  Type->Type() != DataTypes::Pointer
+    &&  Type->Type() != DataTypes::Enumeration )
+      return false;
+    
+    return (Type->SizeInWords() == 1);
+}
+
+
+// =============================================================================
+//      DETECTION OF USED REGISTERS
+// =============================================================================
+
+
+vector< string > SplitAssemblyLine( const string& Line )
+{
+    // separate all words in the line, until a comment
+    // (text in strings cannot contain registers)
+    vector< string > Words;
+    string CurrentWord;
+    bool IsInString = false;
+    
+    for( char c: Line )
+    {
+        if( IsInString )
+        {
+            if( c == '"' ) IsInString = false;
+            continue;
+        }
+        
+        if( IsIdentifierCharacter( c ) )
+        {
+            CurrentWord += c;
+            continue;
+        }
+        
+        if( !CurrentWord.empty() )
+          Words.push_back( CurrentWord );
+        
+        CurrentWord.clear();
+        
+        if( c == ';' ) break;
+        if( c == '"' ) IsInString = true;
+    }
+    
+    if( !CurrentWord.empty() )
+      Words.push_back( CurrentWord );
+    
+    return Words;
+}
+
+// -----------------------------------------------------------------------------
+
+void AddRegistersInLine( const string& Line, const map< string, set< int > >& FunctionClobbers, set< int >& Registers )
+{
+    vector< string > Words = SplitAssemblyLine( Line );
+    
+    // directives and empty lines have no registers
+    if( Words.empty() || Line[ Line.find_first_not_of( " \t" ) ] == '%' )
+      return;
+    
+    string Instruction = ToLowerCase( Words[ 0 ] );
+    
+    // string operations use CR, SR and DR implicitly
+    if( Instruction == "movs" || Instruction == "sets" || Instruction == "cmps" )
+    {
+        Registers.insert( (int)CPURegisters::CountRegister );
+        Registers.insert( (int)CPURegisters::SourceRegister );
+        Registers.insert( (int)CPURegisters::DestinationRegister );
+    }
+    
+    // a call can modify anything, unless we know the function
+    if( Instruction == "call" )
+    {
+        auto Clobbers = FunctionClobbers.end();
+        
+        if( Words.size() > 1 )
+          Clobbers = FunctionClobbers.find( Words[ 1 ] );
+        
+        if( Clobbers != FunctionClobbers.end() )
+          Registers.insert( Clobbers->second.begin(), Clobbers->second.end() );
+        
+        else for( int i = 0; i < 14; i++ )
+          Registers.insert( i );
+    }
+    
+    // add all explicit registers, except BP and SP
+    // (they are always restored by their users)
+    for( string& Word: Words )
+      if( IsRegisterName( Word ) )
+      {
+          int Register = (int)StringToRegister( Word );
+          
+          if( Register < (int)CPURegisters::BasePointer )
+            Registers.insert( Register );
+      }
+}
+
+
+// =============================================================================
+//      CLASS: VARIABLE REGISTER ALLOCATION
+// =============================================================================
+
+
+VariableRegisterAllocation::VariableRegisterAllocation()
+{
+    Function = nullptr;
+    FunctionClobbers = nullptr;
+    Inlining = nullptr;
+    FunctionUsesGoto = false;
+    NextPosition = 0;
+    LoopDepth = 0;
+    ReferenceDepth = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+// variables are given back their memory placement
+void VariableRegisterAllocation::Clear()
+{
+    for( VariableLiveRange& Range: LiveRanges )
+      Range.Variable->Placement.Register = 0;
+    
+    Function = nullptr;
+    LiveRanges.clear();
+    ClobberPoints.clear();
+    LoopRanges.clear();
+    ScopeEnds.clear();
+    RangeIndices.clear();
+    FunctionUsesGoto = false;
+    NextPosition = 0;
+    LoopDepth = 0;
+    ReferenceDepth = 0;
+}
+
+
+// =============================================================================
+//      VARIABLE REGISTER ALLOCATION: AST ANALYSIS
+// =============================================================================
+
+
+int VariableRegisterAllocation::CurrentWeight()
+{
+    return LoopNestingWeights[ min( LoopDepth, MaximumLoopNesting ) ];
+}
+
+// -----------------------------------------------------------------------------
+
+void VariableRegisterAllocation::AddVariable( VariableNode* Variable, int Position, bool IsArgument )
+{
+    if( !CanBeInRegister( Variable ) )
+      return;
+    
+    VariableLiveRange NewRange;
+    NewRange.Variable = Variable;
+    NewRange.IsArgument = IsArgument;
+    NewRange.PassingRegister = 0;
+    NewRange.DeclarationPosition = Position;
+    NewRange.FirstPosition = Position;
+    NewRange.LastPosition = Position;
+    NewRange.Weight = 0;
+    NewRange.MustBeInMemory = false;
+    NewRange.Register = 0;
+    
+    RangeIndices[ Variable ] = LiveRanges.size();
+    LiveRanges.push_back( NewRange );
+}
+
+// -----------------------------------------------------------------------------
+
+void VariableRegisterAllocation::AddVariableUse( VariableNode* Variable, int Position )
+{
+    auto RangePair = RangeIndices.find( Variable );
+    
+    if( RangePair == RangeIndices.end() )
+      return;
+    
+    VariableLiveRange& Range = LiveRanges[ RangePair->second ];
+    Range.FirstPosition = min( Range.FirstPosition, Position );
+    Range.LastPosition = max( Range.LastPosition, Position );
+    Range.Weight += CurrentWeight();
+    
+    // registers have no address
+    if( ReferenceDepth > 0 )
+      Range.MustBeInMemory = true;
+}
+
+// -----------------------------------------------------------------------------
+
+// call after analyzing all of the node's children
+void VariableRegisterAllocation::AddClobberPoint( CNode* Node, int FirstPosition, const set< int >& ModifiedRegisters, const set< int >& ArgumentRegisters )
+{
+    RegisterClobberPoint NewPoint;
+    NewPoint.Node = Node;
+    NewPoint.FirstPosition = FirstPosition;
+    NewPoint.Position = NextPosition - 1;
+    NewPoint.Weight = CurrentWeight();
+    NewPoint.ModifiedRegisters = ModifiedRegisters;
+    NewPoint.ArgumentRegisters = ArgumentRegisters;
+    
+    ClobberPoints.push_back( NewPoint );
+}
+
+// -----------------------------------------------------------------------------
+
+// nodes are visited in the same order as they are emitted,
+// and each one takes the next position in the function
+void VariableRegisterAllocation::AnalyzeNode( CNode* Node )
+{
+    // some contructs have optional parts!
+    if( !Node ) return;
+    
+    int Position = NextPosition++;
+    
+    switch( Node->Type() )
+    {
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // expressions
+        case CNodeTypes::ExpressionAtom:
+        {
+            ExpressionAtomNode* Atom = (ExpressionAtomNode*)Node;
+            
+            if( Atom->AtomType == AtomTypes::Variable && Atom->ResolvedVariable )
+              AddVariableUse( Atom->ResolvedVariable, Position );
+            
+            break;
+        }
+        
+        case CNodeTypes::FunctionCall:
+        {
+            FunctionCallNode* FunctionCall = (FunctionCallNode*)Node;
+            
+            for( ExpressionNode* Parameter: FunctionCall->Parameters )
+              AnalyzeNode( Parameter );
+            
+            // inlined calls only modify the registers of their code
+            const InlinedFunction* Inlined = Inlining->Find( FunctionCall->ResolvedFunction );
+            
+            if( Inlined )
+            {
+                AddClobberPoint( Node, Position, Inlined->ModifiedRegisters, set< int >() );
+                break;
+            }
+            
+            // registers are modified after evaluating parameters
+            set< int > ModifiedRegisters;
+            string CallLine = "call __function_" + FunctionCall->ResolvedFunction->Name;
+            AddRegistersInLine( CallLine, *FunctionClobbers, ModifiedRegisters );
+            
+            // (except for the ones that pass arguments)
+            set< int > ArgumentRegisters;
+            
+            for( int i = 0; i < RegisterArgumentsCount( FunctionCall->ResolvedFunction ); i++ )
+              ArgumentRegisters.insert( FirstArgumentRegister + i );
+            
+            ModifiedRegisters.insert( ArgumentRegisters.begin(), ArgumentRegisters.end() );
+            AddClobberPoint( Node, Position, ModifiedRegisters, ArgumentRegisters );
+            break;
+        }
+        
+        case CNodeTypes::ArrayAccess:
+        {
+            ArrayAccessNode* ArrayAccess = (ArrayAccessNode*)Node;
+            AnalyzeNode( ArrayAccess->ArrayOperand );
+            AnalyzeNode( ArrayAccess->IndexOperand );
+            break;
+        }
+        
+        case CNodeTypes::UnaryOperation:
+        {
+            UnaryOperationNode* UnaryOperation = (UnaryOperationNode*)Node;
+            bool IsReference = (UnaryOperation->Operator == UnaryOperators::Reference);
+            
+            if( IsReference ) ReferenceDepth++;
+            AnalyzeNode( UnaryOperation->Operand );
+            if( IsReference ) ReferenceDepth--;
+            break;
+        }
+        
+        case CNodeTypes::BinaryOperation:
+        {
+            BinaryOperationNode* BinaryOperation = (BinaryOperationNode*)Node;
+            
+            // simple assignments evaluate the assigned value first;
+            // other operations (compound assignments too) start
+            // with the left operand
+            if( BinaryOperation->Operator == BinaryOperators::Assignment )
+            {
+                AnalyzeNode( BinaryOperation->RightOperand );
+                AnalyzeNode( BinaryOperation->LeftOperand );
+            }
+            
+            else
+            {
+                AnalyzeNode( BinaryOperation->LeftOperand );
+                AnalyzeNode( BinaryOperation->RightOperand );
+            }
+            
+            break;
+        }
+        
+        case CNodeTypes::EnclosedExpression:
+            AnalyzeNode( ((EnclosedExpressionNode*)Node)->InternalExpression );
+            break;
+        
+        case CNodeTypes::MemberAccess:
+            AnalyzeNode( ((MemberAccessNode*)Node)->GroupOperand );
+            break;
+        
+        case CNodeTypes::PointedMemberAccess:
+            AnalyzeNode( ((PointedMemberAccessNode*)Node)->GroupOperand );
+            break;
+        
+        case CNodeTypes::TypeConversion:
+            AnalyzeNode( ((TypeConversionNode*)Node)->ConvertedExpression );
+            break;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // declarations
+        case CNodeTypes::VariableList:
+        {
+            VariableListNode* VariableList = (VariableListNode*)Node;
+            
+            // the initial value is evaluated before
+            // the variable gets it, so analyze it first
+            for( VariableNode* Variable: VariableList->Variables )
+            {
+                AnalyzeNode( Variable->InitialValue );
+                AddVariable( Variable, NextPosition++, false );
+            }
+            
+            break;
+        }
+        
+        case CNodeTypes::InitializationList:
+        {
+            for( CNode* Value: ((InitializationListNode*)Node)->AssignedValues )
+              AnalyzeNode( Value );
+            
+            break;
+        }
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // statements
+        case CNodeTypes::Block:
+        {
+            for( CNode* Statement: ((BlockNode*)Node)->Statements )
+              AnalyzeNode( Statement );
+            
+            ScopeEnds[ (BlockNode*)Node ] = NextPosition - 1;
+            break;
+        }
+        
+        case CNodeTypes::Switch:
+        {
+            SwitchNode* Switch = (SwitchNode*)Node;
+            AnalyzeNode( Switch->Condition );
+            
+            for( CNode* Statement: Switch->Statements )
+              AnalyzeNode( Statement );
+            
+            ScopeEnds[ Switch ] = NextPosition - 1;
+            break;
+        }
+        
+        case CNodeTypes::If:
+        {
+            IfNode* If = (IfNode*)Node;
+            AnalyzeNode( If->Condition );
+            AnalyzeNode( If->TrueStatement );
+            AnalyzeNode( If->FalseStatement );
+            break;
+        }
+        
+        case CNodeTypes::While:
+        {
+            WhileNode* While = (WhileNode*)Node;
+            
+            LoopDepth++;
+            AnalyzeNode( While->Condition );
+            AnalyzeNode( While->LoopStatement );
+            LoopDepth--;
+            
+            LoopRanges.push_back( make_pair( Position, NextPosition - 1 ) );
+            break;
+        }
+        
+        case CNodeTypes::Do:
+        {
+            DoNode* Do = (DoNode*)Node;
+            
+            LoopDepth++;
+            AnalyzeNode( Do->LoopStatement );
+            AnalyzeNode( Do->Condition );
+            LoopDepth--;
+            
+            LoopRanges.push_back( make_pair( Position, NextPosition - 1 ) );
+            break;
+        }
+        
+        case CNodeTypes::For:
+        {
+            ForNode* For = (ForNode*)Node;
+            
+            // the initial action is not repeated
+            AnalyzeNode( For->InitialAction );
+            int RepeatedPosition = NextPosition;
+            
+            LoopDepth++;
+            AnalyzeNode( For->Condition );
+            AnalyzeNode( For->LoopStatement );
+            AnalyzeNode( For->IterationAction );
+            LoopDepth--;
+            
+            LoopRanges.push_back( make_pair( RepeatedPosition, NextPosition - 1 ) );
+            ScopeEnds[ For ] = NextPosition - 1;
+            break;
+        }
+        
+        case CNodeTypes::Return:
+            AnalyzeNode( ((ReturnNode*)Node)->ReturnedExpression );
+            break;
+        
+        case CNodeTypes::Goto:
+            FunctionUsesGoto = true;
+            break;
+        
+        case CNodeTypes::AssemblyBlock:
+        {
+            AssemblyBlockNode* AssemblyBlock = (AssemblyBlockNode*)Node;
+            set< int > ModifiedRegisters;
+            
+            for( auto& AssemblyLine: AssemblyBlock->AssemblyLines )
+              AddRegistersInLine( AssemblyLine.Text, *FunctionClobbers, ModifiedRegisters );
+            
+            // variables used in asm can be replaced by their
+            // register, as long as the block does not use it
+            // (but lea needs them to have an address)
+            for( auto& AssemblyLine: AssemblyBlock->AssemblyLines )
+            {
+                if( !AssemblyLine.EmbeddedAtom || !AssemblyLine.EmbeddedAtom->ResolvedVariable )
+                  continue;
+                
+                VariableNode* Variable = AssemblyLine.EmbeddedAtom->ResolvedVariable;
+                vector< string > Words = SplitAssemblyLine( AssemblyLine.Text );
+                bool NeedsAddress = (!Words.empty() && ToLowerCase( Words[ 0 ] ) == "lea");
+                
+                if( NeedsAddress ) ReferenceDepth++;
+                AddVariableUse( Variable, Position );
+                if( NeedsAddress ) ReferenceDepth--;
+                
+                if( RangeIndices.count( Variable ) )
+                {
+                    set< int >& Forbidden = LiveRanges[ RangeIndices[ Variable ] ].ForbiddenRegisters;
+                    Forbidden.insert( ModifiedRegisters.begin(), ModifiedRegisters.end() );
+                }
+            }
+            
+            AddClobberPoint( Node, Position, ModifiedRegisters, set< int >() );
+            break;
+        }
+        
+        // other nodes have no variable uses
+        // (sizeof does not evaluate its operand)
+        default:
+            break;
+    }
+}
+
+
+// =============================================================================
+//      VARIABLE REGISTER ALLOCATION: PROCESSING OF RESULTS
+// =============================================================================
+
+
+void VariableRegisterAllocation::ExtendLiveRanges()
+{
+    int LastPosition = NextPosition - 1;
+    
+    for( VariableLiveRange& Range: LiveRanges )
+    {
+        // with goto, the program order no longer tells which
+        // uses come first, so use all of the variable's scope
+        // (variables in sibling scopes share their memory, so
+        // their ranges must still not overlap)
+        if( FunctionUsesGoto )
+        {
+            auto ScopePair = ScopeEnds.find( Range.Variable->OwnerScope );
+            Range.FirstPosition = Range.DeclarationPosition;
+            Range.LastPosition = (ScopePair != ScopeEnds.end()? ScopePair->second : LastPosition);
+            continue;
+        }
+        
+        // values of variables declared outside a loop and
+        // used in it can be needed on any later iteration
+        // (inner loops come first, so extensions propagate)
+        for( auto& Loop: LoopRanges )
+        {
+            bool IsDeclaredInLoop = (Range.DeclarationPosition >= Loop.first && Range.DeclarationPosition <= Loop.second);
+            bool IsUsedInLoop = (Range.FirstPosition <= Loop.second && Range.LastPosition >= Loop.first);
+            
+            if( IsUsedInLoop && !IsDeclaredInLoop )
+            {
+                Range.FirstPosition = min( Range.FirstPosition, Loop.first );
+                Range.LastPosition = max( Range.LastPosition, Loop.second );
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool VariableRegisterAllocation::RangesOverlap( const VariableLiveRange& Range1, const VariableLiveRange& Range2 )
+{
+    return (Range1.FirstPosition <= Range2.LastPosition)
+        && (Range2.FirstPosition <= Range1.LastPosition);
+}
+
+// -----------------------------------------------------------------------------
+
+bool VariableRegisterAllocation::RegisterIsAvailable( const VariableLiveRange& Range, int Register )
+{
+    if( Range.ForbiddenRegisters.count( Register ) )
+      return false;
+    
+    for( VariableLiveRange& OtherRange: LiveRanges )
+      if( OtherRange.Register == Register && RangesOverlap( Range, OtherRange ) )
+        return false;
+    
+    // calls write their arguments while the parameters
+    // are evaluated, so variables still needed there
+    // cannot use those registers
+    for( RegisterClobberPoint& Point: ClobberPoints )
+      if( Point.ArgumentRegisters.count( Register ) )
+        if( Range.FirstPosition <= Point.Position && Range.LastPosition >= Point.FirstPosition )
+          return false;
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// a save and a restore for every point where this
+// register is modified while the variable is needed
+int VariableRegisterAllocation::SavingCost( const VariableLiveRange& Range, int Register )
+{
+    int Cost = 0;
+    
+    for( RegisterClobberPoint& Point: ClobberPoints )
+      if( Range.FirstPosition <= Point.Position && Range.LastPosition > Point.Position )
+        if( Point.ModifiedRegisters.count( Register ) )
+          Cost += 2 * Point.Weight;
+    
+    return Cost;
+}
+
+
+// =============================================================================
+//      VARIABLE REGISTER ALLOCATION: MAIN FUNCTIONS
+// =============================================================================
+
+
+// function clobbers are the registers that each of the
+// already emitted functions may modify (by label name)
+void VariableRegisterAllocation::Analyze( FunctionNode* Function_, const map< string, set< int > >& FunctionClobbers_, const FunctionInlining& Inlining_ )
+{
+    Clear();
+    Function = Function_;
+    FunctionClobbers = &FunctionClobbers_;
+    Inlining = &Inlining_;
+    
+    // arguments are already set when the function starts
+    int ArgumentNumber = 0;
+    
+    for( VariableNode* Argument: Function->Arguments )
+    {
+        AddVariable( Argument, NextPosition, true );
+        
+        if( ArgumentNumber < RegisterArgumentsCount( Function ) && RangeIndices.count( Argument ) )
+          LiveRanges[ RangeIndices[ Argument ] ].PassingRegister = FirstArgumentRegister + ArgumentNumber;
+        
+        ArgumentNumber++;
+    }
+    
+    NextPosition++;
+    
+    for( CNode* Statement: Function->Statements )
+      AnalyzeNode( Statement );
+    
+    ExtendLiveRanges();
+}
+
+// -----------------------------------------------------------------------------
+
+// Variables are taken from most to least used, and each is
+// given the register where it costs the least to keep it.
+// When registers are preserved they need a push and a pop.
+void VariableRegisterAllocation::AssignRegisters( int FirstRegister, int LastRegister, const set< int >& PreservedRegisters )
+{
+    vector< int > RangeOrder;
+    
+    for( unsigned i = 0; i < LiveRanges.size(); i++ )
+      RangeOrder.push_back( i );
+    
+    stable_sort
+    (
+        RangeOrder.begin(), RangeOrder.end(),
+        [ this ]( int i1, int i2 ){ return LiveRanges[ i1 ].Weight > LiveRanges[ i2 ].Weight; }
+    );
+    
+    set< int > UsedRegisters;
+    
+    for( int i: RangeOrder )
+    {
+        VariableLiveRange& Range = LiveRanges[ i ];
+        
+        if( Range.MustBeInMemory )
+          continue;
+        
+        int BestRegister = 0;
+        int BestCost = 0;
+        
+        for( int Register = FirstRegister; Register <= LastRegister; Register++ )
+        {
+            if( !RegisterIsAvailable( Range, Register ) )
+              continue;
+            
+            int Cost = SavingCost( Range, Register );
+            
+            // arguments in the stack need to be loaded first;
+            // the ones passed in registers would otherwise be
+            // stored in memory, so moving them costs the same
+            if( Range.IsArgument && !Range.PassingRegister )
+              Cost += 1;
+            
+            if( Range.PassingRegister == Register )
+              Cost -= 1;
+            
+            if( PreservedRegisters.count( Register ) && !UsedRegisters.count( Register ) )
+              Cost += 2;
+            
+            if( !BestRegister || Cost < BestCost )
+            {
+                BestRegister = Register;
+                BestCost = Cost;
+            }
+        }
+        
+        // only use registers when they save more than they cost
+        if( BestRegister && BestCost < Range.Weight )
+        {
+            Range.Register = BestRegister;
+            UsedRegisters.insert( BestRegister );
+        }
+    }
+    
+    // now determine what must be saved at each point
+    for( RegisterClobberPoint& Point: ClobberPoints )
+      for( VariableLiveRange& Range: LiveRanges )
+        if( Range.Register && Point.ModifiedRegisters.count( Range.Register ) )
+          if( Range.FirstPosition <= Point.Position && Range.LastPosition > Point.Position )
+            Point.SavedVariables.push_back( Range.Variable );
+    
+    // variables are placed in their registers
+    // until the allocation is cleared
+    for( VariableLiveRange& Range: LiveRanges )
+      Range.Variable->Placement.Register = Range.Register;
+}
+
+// -----------------------------------------------------------------------------
+
+int VariableRegisterAllocation::HighestRegister()
+{
+    int Highest = 0;
+    
+    for( VariableLiveRange& Range: LiveRanges )
+      Highest = max( Highest, Range.Register );
+    
+    return Highest;
+}
+
+// -----------------------------------------------------------------------------
+
+vector< VariableNode* > VariableRegisterAllocation::VariablesToSave( CNode* Node )
+{
+    for( RegisterClobberPoint& Point: ClobberPoints )
+      if( Point.Node == Node )
+        return Point.SavedVariables;
+    
+    return vector< VariableNode* >();
+}
+
+// -----------------------------------------------------------------------------
+
+// arguments passed in registers are not included
+vector< VariableNode* > VariableRegisterAllocation::StackArgumentsInRegisters()
+{
+    vector< VariableNode* > Arguments;
+    
+    for( VariableLiveRange& Range: LiveRanges )
+      if( Range.Register && Range.IsArgument && !Range.PassingRegister )
+        Arguments.push_back( Range.Variable );
+    
+    return Arguments;
+}
+
+// -----------------------------------------------------------------------------
+
+// expressions in the function cannot use these as temporaries
+void VariableRegisterAllocation::ReserveRegisters( RegisterAllocation& Registers )
+{
+    for( VariableLiveRange& Range: LiveRanges )
+      if( Range.Register )
+        Registers.RegisterReserved[ Range.Register ] = true;
+}
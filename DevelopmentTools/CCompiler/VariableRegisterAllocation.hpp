@@ -0,0 +1,155 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef VARIABLEREGISTERALLOCATION_HPP
+    #define VARIABLEREGISTERALLOCATION_HPP
+    
+    // include project headers
+    #include "CNodes.hpp"
+    #include "RegisterAllocation.hpp"
+    #include "FunctionInlining.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
+// *****************************************************************************
+
+
+// =============================================================================
+//      DATA USED BY THE ALLOCATION
+// =============================================================================
+
+
+// Positions are given to AST nodes in the order they are
+// emitted. Within a function the range between the first
+// and last use of a variable is the part where its value
+// needs to be kept (ranges are extended to whole loops
+// when its value is used across iterations)
+typedef struct
+{
+    VariableNode* Variable;
+    bool IsArgument;
+    int PassingRegister;        // 0 for arguments passed in the stack
+    int DeclarationPosition;
+    int FirstPosition;
+    int LastPosition;
+    
+    // uses, weighted by their loop nesting
+    int Weight;
+    
+    // variables with their address taken must stay in memory;
+    // the ones used in asm blocks cannot use the registers
+    // that those blocks modify
+    bool MustBeInMemory;
+    std::set< int > ForbiddenRegisters;
+    
+    // 0 for variables that were not assigned one
+    int Register;
+}
+VariableLiveRange;
+
+// -----------------------------------------------------------------------------
+
+// function calls and asm blocks can modify registers,
+// so variables that are kept in them and are needed
+// afterwards have to be saved in memory around them;
+// calls that pass arguments in registers also write
+// them while their parameters are still evaluated
+typedef struct
+{
+    CNode* Node;
+    int FirstPosition;
+    int Position;
+    int Weight;
+    std::set< int > ModifiedRegisters;
+    std::set< int > ArgumentRegisters;
+    std::vector< VariableNode* > SavedVariables;
+}
+RegisterClobberPoint;
+
+
+// =============================================================================
+//      CLASS TO REPRESENT REGISTER ALLOCATION FOR LOCAL VARIABLES
+// =============================================================================
+
+
+// Selects scalar local variables (and arguments) to keep in
+// registers for the whole duration of a function. Registers
+// are shared by variables whose live ranges don't overlap.
+// The emitter uses registers above the ones it needs for
+// temporaries, so that expressions never need to spill them.
+class VariableRegisterAllocation
+{
+    public:
+        
+        // analyzed function
+        FunctionNode* Function;
+        
+        // results of the analysis
+        std::vector< VariableLiveRange > LiveRanges;
+        std::vector< RegisterClobberPoint > ClobberPoints;
+        std::vector< std::pair< int, int > > LoopRanges;
+        std::map< ScopeNode*, int > ScopeEnds;
+        bool FunctionUsesGoto;
+        
+    protected:
+        
+        // state while the function is analyzed
+        std::map< VariableNode*, int > RangeIndices;
+        const std::map< std::string, std::set< int > >* FunctionClobbers;
+        const FunctionInlining* Inlining;
+        int NextPosition;
+        int LoopDepth;
+        int ReferenceDepth;
+        
+        // analysis of the AST
+        void AnalyzeNode( CNode* Node );
+        void AddVariable( VariableNode* Variable, int Position, bool IsArgument );
+        void AddVariableUse( VariableNode* Variable, int Position );
+        void AddClobberPoint( CNode* Node, int FirstPosition, const std::set< int >& ModifiedRegisters, const std::set< int >& ArgumentRegisters );
+        int CurrentWeight();
+        
+        // processing of the results
+        void ExtendLiveRanges();
+        int SavingCost( const VariableLiveRange& Range, int Register );
+        bool RegisterIsAvailable( const VariableLiveRange& Range, int Register );
+        bool RangesOverlap( const VariableLiveRange& Range1, const VariableLiveRange& Range2 );
+        
+    public:
+        
+        // instance handling
+        VariableRegisterAllocation();
+        void Clear();
+        
+        // main functions
+        void Analyze( FunctionNode* Function_, const std::map< std::string, std::set< int > >& FunctionClobbers_, const FunctionInlining& Inlining_ );
+        void AssignRegisters( int FirstRegister, int LastRegister, const std::set< int >& PreservedRegisters );
+        
+        // queries for the emitter
+        int HighestRegister();
+        std::vector< VariableNode* > VariablesToSave( CNode* Node );
+        std::vector< VariableNode* > StackArgumentsInRegisters();
+        void ReserveRegisters( RegisterAllocation& Registers );
+};
+
+
+// =============================================================================
+//      DETECTION OF USED REGISTERS
+// =============================================================================
+
+
+// separates the words in an assembly line that can name
+// registers or labels (comments and strings are skipped)
+std::vector< std::string > SplitAssemblyLine( const std::string& Line );
+
+// adds to the set the registers that an assembly line can
+// modify or read; calls add every register, except for
+// those to functions with a known set of modified registers
+void AddRegistersInLine( const std::string& Line, const std::map< std::string, std::set< int > >& FunctionClobbers, std::set< int >& Registers );
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
@@ -2,6 +2,7 @@
     // include project headers
     #include "VirconCEmitter.hpp"
     #include "CompilerInfrastructure.hpp"
+    #include "Globals.hpp"
     
     // include C/C++ headers
     #include <iostream>         // [ C++ STL ] I/O Streams
@@ -149,6 +150,7 @@ int VirconCEmitter::EmitRootExpression( ExpressionNode* Expression )
     
     // now begin evaluation of a new expression tree
     RegisterAllocation Registers( Expression->Location );
+    LocalVariableRegisters.ReserveRegisters( Registers );
     
     // if functions are internally called, R0 may be implicitely used
     // so instead just emit to R1 and move the result to R0 afterwards
@@ -350,9 +352,12 @@ void VirconCEmitter::EmitGlobalScopeFunction()
       ProgramLines.push_back( "isub SP, " + to_string( NeededStackSize ) );
     
     // (4) as body, emit the initialization of all global variables in order
+    // (except for the ones that the program never uses)
     for( CNode* Statement: ProgramAST->Statements )
       if( Statement->Type() == CNodeTypes::VariableList )
-        EmitVariableList( (VariableListNode*)Statement );
+        for( VariableNode* Variable: ((VariableListNode*)Statement)->Variables )
+          if( Reachability.VariableIsUsed( Variable ) )
+            EmitVariable( Variable );
     
     // (5) restore the parent's stack frame
     ProgramLines.push_back( "mov SP, BP" );
@@ -387,7 +392,8 @@ void VirconCEmitter::EmitProgramStartSection()
         for( VariableNode* Variable: VariableList->Variables )
         {
             // do not emit externs, they are partial definitions
-            if( Variable->IsExtern )
+            // (nor globals that the program never uses)
+            if( Variable->IsExtern || !Reachability.VariableIsUsed( Variable ) )
               continue;
             
             // emit variable name for easier reading
@@ -411,6 +417,209 @@ void VirconCEmitter::EmitHardwareErrorVector()
 }
 
 
+// =============================================================================
+//      VIRCON C EMITTER: VARIABLES KEPT IN REGISTERS
+// =============================================================================
+
+
+// returns 0 when the expression does not refer to a variable in a register
+int VirconCEmitter::VariableRegister( ExpressionNode* Expression )
+{
+    if( !Expression->HasStaticPlacement() )
+      return 0;
+    
+    return Expression->GetStaticPlacement().Register;
+}
+
+// -----------------------------------------------------------------------------
+
+// OPTIMIZATION: operands that are just a variable kept in
+// a register can be read from it, instead of copying them.
+// That register must not be modified, and it can be released
+// like any temporary (variable registers are never allocated)
+int VirconCEmitter::EmitOperandRegister( ExpressionNode* Operand, RegisterAllocation& Registers, bool WillBeModified )
+{
+    ExpressionNode* Variable = Operand;
+    
+    while( Variable->Type() == CNodeTypes::EnclosedExpression )
+      Variable = ((EnclosedExpressionNode*)Variable)->InternalExpression;
+    
+    if( !WillBeModified && Variable->Type() == CNodeTypes::ExpressionAtom )
+      if( VariableRegister( Variable ) )
+        return VariableRegister( Variable );
+    
+    // otherwise place the operand in a new register
+    int OperandRegister = Registers.FirstFreeRegister();
+    EmitDependentExpression( Operand, Registers, OperandRegister );
+    return OperandRegister;
+}
+
+// -----------------------------------------------------------------------------
+
+// variables in registers that the node can modify are saved
+// to their memory before it, and then loaded back after it
+void VirconCEmitter::EmitVariableSaves( CNode* ClobberingNode, bool AfterNode )
+{
+    for( VariableNode* Variable: LocalVariableRegisters.VariablesToSave( ClobberingNode ) )
+    {
+        string RegisterName = Variable->Placement.RegisterName();
+        string VariableAddress = "[" + Variable->Placement.AccessAddressString() + "]";
+        
+        if( AfterNode )
+          ProgramLines.push_back( "mov " + RegisterName + ", " + VariableAddress );
+        else
+          ProgramLines.push_back( "mov " + VariableAddress + ", " + RegisterName );
+    }
+}
+
+
+// =============================================================================
+//      VIRCON C EMITTER: REGISTER CALLING CONVENTION
+// =============================================================================
+
+
+// collects all words in the asm blocks of a statement
+// (any of them could be a function label: calls, jumps...)
+static void FindAssemblyWords( CNode* Node, set< string >& Words )
+{
+    // some contructs have optional parts!
+    if( !Node ) return;
+    
+    switch( Node->Type() )
+    {
+        case CNodeTypes::Function:
+            for( CNode* Statement: ((FunctionNode*)Node)->Statements )
+              FindAssemblyWords( Statement, Words );
+            break;
+        
+        case CNodeTypes::Block:
+        case CNodeTypes::Switch:
+            for( CNode* Statement: ((BlockNode*)Node)->Statements )
+              FindAssemblyWords( Statement, Words );
+            break;
+        
+        case CNodeTypes::If:
+            FindAssemblyWords( ((IfNode*)Node)->TrueStatement, Words );
+            FindAssemblyWords( ((IfNode*)Node)->FalseStatement, Words );
+            break;
+        
+        case CNodeTypes::While:
+            FindAssemblyWords( ((WhileNode*)Node)->LoopStatement, Words );
+            break;
+        
+        case CNodeTypes::Do:
+            FindAssemblyWords( ((DoNode*)Node)->LoopStatement, Words );
+            break;
+        
+        case CNodeTypes::For:
+            FindAssemblyWords( ((ForNode*)Node)->LoopStatement, Words );
+            break;
+        
+        case CNodeTypes::AssemblyBlock:
+            for( auto& AssemblyLine: ((AssemblyBlockNode*)Node)->AssemblyLines )
+              for( string& Word: SplitAssemblyLine( AssemblyLine.Text ) )
+                Words.insert( Word );
+            break;
+        
+        default:
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// decides the convention for every function before emitting
+// any of them, since calls may appear before their definitions
+void VirconCEmitter::AssignCallingConventions()
+{
+    // functions named in asm blocks keep passing all their
+    // arguments in the stack, since asm code may call them
+    set< string > AssemblyWords;
+    
+    for( CNode* Statement: ProgramAST->Statements )
+      FindAssemblyWords( Statement, AssemblyWords );
+    
+    for( CNode* Statement: ProgramAST->Statements )
+    {
+        if( Statement->Type() != CNodeTypes::Function )
+          continue;
+        
+        FunctionNode* Function = (FunctionNode*)Statement;
+        string FunctionLabel = "__function_" + Function->Name;
+        Function->PassesArgumentsInRegisters = RegisterCallingConvention && !AssemblyWords.count( FunctionLabel );
+        
+        // until they are emitted, assume these functions modify
+        // every register that the convention allows them to
+        if( Function->PassesArgumentsInRegisters )
+          FunctionClobbers[ FunctionLabel ] = CallerSavedRegisters();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// Arguments are placed in the registers where the function keeps
+// them. Those passed in registers that stay in memory are stored
+// in their stack position (callers always leave space for them)
+void VirconCEmitter::EmitArgumentsEntry( FunctionNode* Function )
+{
+    vector< pair< int, int > > RegisterMoves;   // (destination, source)
+    int ArgumentNumber = 0;
+    
+    for( VariableNode* Argument: Function->Arguments )
+    {
+        if( ArgumentNumber >= RegisterArgumentsCount( Function ) )
+          break;
+        
+        int PassingRegister = FirstArgumentRegister + ArgumentNumber;
+        ArgumentNumber++;
+        
+        if( Argument->Placement.IsInRegister() )
+        {
+            if( Argument->Placement.Register != PassingRegister )
+              RegisterMoves.push_back( make_pair( Argument->Placement.Register, PassingRegister ) );
+        }
+        
+        else if( Argument->IsReferenced )
+          ProgramLines.push_back( "mov [" + Argument->Placement.AccessAddressString() + "], R" + to_string( PassingRegister ) );
+    }
+    
+    // registers are moved in an order that never overwrites
+    // one that still has to be read; cycles are broken by
+    // saving one of their values in R0
+    while( !RegisterMoves.empty() )
+    {
+        bool MoveWasDone = false;
+        
+        for( unsigned i = 0; i < RegisterMoves.size() && !MoveWasDone; i++ )
+        {
+            bool DestinationIsRead = false;
+            
+            for( auto& OtherMove: RegisterMoves )
+              if( OtherMove.second == RegisterMoves[ i ].first )
+                DestinationIsRead = true;
+            
+            if( DestinationIsRead )
+              continue;
+            
+            ProgramLines.push_back( "mov R" + to_string( RegisterMoves[ i ].first ) + ", R" + to_string( RegisterMoves[ i ].second ) );
+            RegisterMoves.erase( RegisterMoves.begin() + i );
+            MoveWasDone = true;
+        }
+        
+        if( !MoveWasDone )
+        {
+            ProgramLines.push_back( "mov R0, R" + to_string( RegisterMoves[ 0 ].second ) );
+            RegisterMoves[ 0 ].second = 0;
+        }
+    }
+    
+    // arguments from the stack are loaded at the end, since
+    // their registers may be the ones where others are passed
+    for( VariableNode* Argument: LocalVariableRegisters.StackArgumentsInRegisters() )
+      ProgramLines.push_back( "mov " + Argument->Placement.RegisterName() + ", [" + Argument->Placement.AccessAddressString() + "]" );
+}
+
+
 // =============================================================================
 //      VIRCON C EMITTER: EMISSION FUNCTIONS FOR MEMORY ADDRESSES
 // =============================================================================
@@ -418,6 +627,11 @@ void VirconCEmitter::EmitHardwareErrorVector()
 
 void VirconCEmitter::EmitStaticPlacement( MemoryPlacement Placement, int ResultRegister )
 {
+    // variables whose address is taken are never kept in
+    // registers, so this can only happen by compiler error
+    if( Placement.IsInRegister() )
+      throw runtime_error( "cannot emit the address of a variable kept in a register" );
+    
     string ResultRegisterName = "R" + to_string(ResultRegister);
     
     // LEA instruction needs to use a register as a base, so
@@ -496,12 +710,10 @@ void VirconCEmitter::EmitExpressionPlacement( ExpressionNode* Expression, Regist
         else
         {
             // here we need to use an additional register
-            int IndexRegister = Registers.FirstFreeRegister();
+            // (unless the index can be used in place)
+            int IndexRegister = EmitOperandRegister( ArrayAccess->IndexOperand, Registers, ElementSize != 1 );
             string IndexRegisterName = "R" + to_string(IndexRegister);
             
-            // emit index of this element in the array
-            EmitDependentExpression( ArrayAccess->IndexOperand, Registers, IndexRegister );
-            
             // only if element size is not 1, we need to scale the offset
             if( ElementSize != 1 )
               ProgramLines.push_back( "imul " + IndexRegisterName + ", " + to_string(ElementSize) );
@@ -521,8 +733,9 @@ void VirconCEmitter::EmitExpressionPlacement( ExpressionNode* Expression, Regist
         // case 1: pointer dereference
         if( UnaryOperation->Operator == UnaryOperators::Dereference )
         {
-            // for pointer arithmetic values obtained on the fly:
-            if( !UnaryOperation->Operand->HasMemoryPlacement() )
+            // for pointer arithmetic values obtained on the fly,
+            // or pointers kept in registers:
+            if( !UnaryOperation->Operand->HasMemoryPlacement() || VariableRegister( UnaryOperation->Operand ) )
             {
                 EmitDependentExpression( UnaryOperation->Operand, Registers, ResultRegister );
             }
@@ -605,6 +818,26 @@ void VirconCEmitter::Emit( TopLevelNode& ProgramAST_, bool IsBios )
     
     // delete any previous results
     ProgramLines.clear();
+    AssemblyBlockLines.clear();
+    FunctionClobbers.clear();
+    
+    // functions must agree with their callers
+    // on where their arguments are passed
+    AssignCallingConventions();
+    
+    // find the functions whose calls can
+    // be replaced by their code
+    if( OptimizationLevel >= 2 )
+      Inlining.Analyze( ProgramAST );
+    else
+      Inlining.Clear();
+    
+    // OPTIMIZATION: only emit the functions and
+    // globals that can be reached from main
+    if( OptimizationLevel >= 1 )
+      Reachability.Analyze( ProgramAST, Inlining, IsBios );
+    else
+      Reachability.MarkAllAsUsed( ProgramAST );
     
     // if this is a BIOS program, we need to emit a very
     // specific initial structure for handling hardware errors
@@ -622,7 +855,8 @@ void VirconCEmitter::Emit( TopLevelNode& ProgramAST_, bool IsBios )
     // global variables (already in the start section)
     for( CNode* Statement: ProgramAST->Statements )
       if( Statement->Type() != CNodeTypes::VariableList )
-        EmitCNode( Statement );
+        if( Reachability.IsUsed( Statement ) )
+          EmitCNode( Statement );
 }
 
 // -----------------------------------------------------------------------------
@@ -6,6 +6,14 @@
     // include project headers
     #include "CNodes.hpp"
     #include "RegisterAllocation.hpp"
+    #include "VariableRegisterAllocation.hpp"
+    #include "FunctionInlining.hpp"
+    #include "ProgramReachability.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <map>              // [ C++ STL ] Maps
+    #include <set>              // [ C++ STL ] Sets
 // *****************************************************************************
 
 
@@ -21,12 +29,31 @@ class VirconCEmitter
         // link to source data
         TopLevelNode* ProgramAST;
         
+        // local variables kept in registers for the
+        // function being emitted, and registers that
+        // each emitted function may modify for callers
+        VariableRegisterAllocation LocalVariableRegisters;
+        std::map< std::string, std::set< int > > FunctionClobbers;
+        
+        // functions emitted in place of their calls; while
+        // their code is emitted, arguments are bound to the
+        // values given (unless they are just in registers)
+        FunctionInlining Inlining;
+        std::map< VariableNode*, std::string > InlinedArgumentValues;
+        
+        // functions and globals that the program uses
+        ProgramReachability Reachability;
+        
     public:
         
         // results
         std::vector< std::string > ProgramLines;
         std::vector< std::string > DataLines;
         
+        // program lines copied from asm blocks,
+        // which must be preserved as they are
+        std::set< int > AssemblyBlockLines;
+        
         // debug info: C->ASM line correspondence
         std::map< int, CNode* > LineMapping;
         
@@ -45,6 +72,7 @@ class VirconCEmitter
         int EmitVariableList       ( VariableListNode* VariableList );
         int EmitVariable           ( VariableNode* Variable );
         int EmitFunction           ( FunctionNode* Function );
+        int EmitFunctionCode       ( FunctionNode* Function );
         int EmitEmbeddedFile       ( EmbeddedFileNode* EmbeddedFile );
         
         // specific emitters for variable initializations
@@ -74,6 +102,7 @@ class VirconCEmitter
         // (sizeof is not needed: it is always static)
         void EmitExpressionAtom     ( ExpressionAtomNode* ExpressionAtom          , RegisterAllocation& Registers, int ResultRegister );
         void EmitFunctionCall       ( FunctionCallNode* FunctionCall              , RegisterAllocation& Registers, int ResultRegister );
+        void EmitInlinedCall        ( FunctionCallNode* FunctionCall              , RegisterAllocation& Registers, int ResultRegister );
         void EmitArrayAccess        ( ArrayAccessNode* ArrayAccess                , RegisterAllocation& Registers, int ResultRegister );
         void EmitUnaryOperation     ( UnaryOperationNode* UnaryOperation          , RegisterAllocation& Registers, int ResultRegister );
         void EmitBinaryOperation    ( BinaryOperationNode* BinaryOperation        , RegisterAllocation& Registers, int ResultRegister );
@@ -129,6 +158,25 @@ class VirconCEmitter
         // helper function for all compound assignments
         void EmitComplementaryAssignment( BinaryOperationNode* BinaryOperation, RegisterAllocation& Registers, int ResultRegister );
         
+        // helper functions for switch statements
+        void EmitSwitchDispatch( SwitchNode* Switch, const std::vector< int >& Values, int First, int Last, const std::string& DefaultLabel );
+        void EmitSwitchJumpTable( SwitchNode* Switch, const std::vector< int >& Values, int First, int Last, const std::string& DefaultLabel );
+        
+        // helper function for loops that copy or fill arrays
+        int EmitBlockOperationLoop( ForNode* For, BinaryOperationNode* Assignment, ExpressionNode* Limit, bool LimitIsIncluded );
+        
+        // helper functions for variables kept in registers
+        int VariableRegister( ExpressionNode* Expression );
+        int EmitOperandRegister( ExpressionNode* Operand, RegisterAllocation& Registers, bool WillBeModified );
+        void EmitVariableSaves( CNode* ClobberingNode, bool AfterNode );
+        
+        // helper functions for the register calling convention
+        void AssignCallingConventions();
+        void EmitArgumentsEntry( FunctionNode* Function );
+        
+        // helper function for asm blocks (also when inlined)
+        void EmitAssemblyLines( AssemblyBlockNode* AssemblyBlock );
+        
         // non-node emission functions
         void EmitLabel( const std::string& LabelName );
         void EmitRegisterTypeConversion( int RegisterNumber, PrimitiveTypes ProducedType, PrimitiveTypes NeededType );
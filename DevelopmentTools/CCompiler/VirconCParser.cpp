@@ -133,6 +133,9 @@ CNode* VirconCParser::ParseStatement( CNode* Parent, CTokenIterator& TokenPositi
     if( TokenIsThisKeyword( NextToken, KeywordTypes::Extern ) )
       RaiseFatalError( NextToken->Location, "extern variables can only be declared at the top level" );
     
+    if( TokenIsThisKeyword( NextToken, KeywordTypes::Inline ) )
+      RaiseFatalError( NextToken->Location, "inline functions can only be declared at the top level" );
+    
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     // now choose from all valid cases
     
@@ -964,6 +967,26 @@ FunctionNode* VirconCParser::ParseFunction( DataType* ReturnType, const string&
 
 // -----------------------------------------------------------------------------
 
+FunctionNode* VirconCParser::ParseInlineFunction( CNode* Parent, CTokenIterator& TokenPosition )
+{
+    // consume "inline" keyword
+    TokenPosition++;
+    
+    // parse the function type and name
+    DataType* ReturnType = ParseType( Parent, TokenPosition );
+    string FunctionName = ExpectIdentifier( TokenPosition );
+    
+    // only functions can be declared inline
+    if( !TokenIsThisDelimiter( *TokenPosition, DelimiterTypes::OpenParenthesis ) )
+      RaiseFatalError( (*TokenPosition)->Location, "only functions can be declared inline" );
+    
+    FunctionNode* NewFunction = ParseFunction( ReturnType, FunctionName, Parent, TokenPosition );
+    NewFunction->IsInline = true;
+    return NewFunction;
+}
+
+// -----------------------------------------------------------------------------
+
 VariableListNode* VirconCParser::ParseVariableList( DataType* DeclaredType, const string& Name, bool UsesExtern, CNode* Parent, CTokenIterator& TokenPosition )
 {
     VariableListNode* VariableList = new VariableListNode( Parent );
@@ -2126,6 +2149,14 @@ void VirconCParser::ParseTopLevel( CTokenList& Tokens_ )
             continue;
         }
         
+        // recognize inline functions
+        if( TokenIsThisKeyword( NextToken, KeywordTypes::Inline ) )
+        {
+            FunctionNode* NewFunction = ParseInlineFunction( ProgramAST, TokenPosition );
+            ProgramAST->Statements.push_back( NewFunction );
+            continue;
+        }
+        
         // give special error messages for non supported features of standard C
         if( NextToken->Type() == CTokenTypes::Identifier )
         {
@@ -329,8 +329,7 @@ void VirconDisassembler::Disassemble( ostream& Output, bool IncludeDescriptions
                 ROMIndex++;
             }
             
-            Output << "  " << OpCodeToString( (InstructionOpCodes)Instruction.OpCode );
-            Output << OperandWriteFunctions[ Instruction.OpCode ]( *this, Instruction, ImmediateValue );
+            Output << "  " << DisassembleInstruction( Instruction, ImmediateValue );
             Output << endl;
         }
         
@@ -368,3 +367,11 @@ void VirconDisassembler::Disassemble( ostream& Output, bool IncludeDescriptions
         PreviousIndexWasCode = CurrentIndexIsCode;
     }
 }
+
+// -----------------------------------------------------------------------------
+
+string VirconDisassembler::DisassembleInstruction( CPUInstruction Instruction, V32Word ImmediateValue )
+{
+    string OpCodeName = OpCodeToString( (InstructionOpCodes)Instruction.OpCode );
+    return OpCodeName + OperandWriteFunctions[ Instruction.OpCode ]( *this, Instruction, ImmediateValue );
+}
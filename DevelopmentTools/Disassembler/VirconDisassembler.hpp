@@ -48,6 +48,10 @@ class VirconDisassembler
         // main disassembly functions
         void LoadROM( const std::string& InputPath );
         void Disassemble( std::ostream& Output, bool IncludeDescriptions = false );
+        
+        // disassembly of a single instruction (it can be
+        // used with no ROM, and then jumps show addresses)
+        std::string DisassembleInstruction( V32::CPUInstruction Instruction, V32::V32Word ImmediateValue );
 };
 
 
@@ -0,0 +1,173 @@
+// *****************************************************************************
+    // include libretro headers
+    #include <libretro.h>       // [ libretro ] Core API
+    
+    // include C/C++ headers
+    #include <iostream>         // [ C++ STL ] I/O Streams
+    #include <string>           // [ C++ STL ] Strings
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <chrono>           // [ C++ STL ] Time measurement
+    #include <cstdlib>          // [ ANSI C ] Standard library
+    
+    // declare used namespaces
+    using namespace std;
+// *****************************************************************************
+
+
+// =============================================================================
+//      STAND-IN FRONTEND
+// =============================================================================
+
+
+// This program drives the core through its libretro API
+// with no video, audio or input, so that the core can be
+// measured in isolation: it only counts what the core
+// outputs and reports the time taken by each operation.
+
+// folder given to the core for BIOS and memory cards
+static string SystemDirectory = ".";
+
+// counts of core output
+static unsigned long VideoFrames = 0;
+static unsigned long AudioSamples = 0;
+
+// -----------------------------------------------------------------------------
+
+static bool EnvironmentCallback( unsigned Command, void* Data )
+{
+    switch( Command )
+    {
+        case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+        case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+            *(const char**)Data = SystemDirectory.c_str();
+            return true;
+        
+        case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+        case RETRO_ENVIRONMENT_SET_INPUT_DESCRIPTORS:
+        case RETRO_ENVIRONMENT_SET_SUPPORT_NO_GAME:
+            return true;
+        
+        // the core will log to standard error
+        default:
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+static void VideoRefreshCallback( const void* Pixels, unsigned Width, unsigned Height, size_t Pitch )
+{
+    VideoFrames++;
+}
+
+// -----------------------------------------------------------------------------
+
+static void AudioSampleCallback( int16_t Left, int16_t Right )
+{
+    AudioSamples++;
+}
+
+// -----------------------------------------------------------------------------
+
+static size_t AudioBatchCallback( const int16_t* Samples, size_t NumberOfSamples )
+{
+    AudioSamples += NumberOfSamples;
+    return NumberOfSamples;
+}
+
+// -----------------------------------------------------------------------------
+
+static void InputPollCallback()
+{
+    // (no input)
+}
+
+// -----------------------------------------------------------------------------
+
+static int16_t InputStateCallback( unsigned Port, unsigned Device, unsigned Index, unsigned ID )
+{
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+static double SecondsSince( chrono::steady_clock::time_point Start )
+{
+    chrono::duration< double > Elapsed = chrono::steady_clock::now() - Start;
+    return Elapsed.count();
+}
+
+
+// =============================================================================
+//      MAIN FUNCTION
+// =============================================================================
+
+
+int main( int NumberOfArguments, char* Arguments[] )
+{
+    if( NumberOfArguments < 2 )
+    {
+        cout << "USAGE: Vircon32CoreRunner <system folder> [cartridge file] [frames]" << endl;
+        cout << "The system folder must contain Vircon32Bios.v32" << endl;
+        return 1;
+    }
+    
+    SystemDirectory = Arguments[ 1 ];
+    // an empty cartridge argument runs just the BIOS
+    const char* CartridgePath = (NumberOfArguments > 2? Arguments[ 2 ] : nullptr);
+    
+    if( CartridgePath && !CartridgePath[ 0 ] )
+      CartridgePath = nullptr;
+    
+    int NumberOfFrames = (NumberOfArguments > 3? atoi( Arguments[ 3 ] ) : 3600);
+    
+    // connect the core to this program
+    retro_set_environment( EnvironmentCallback );
+    retro_set_video_refresh( VideoRefreshCallback );
+    retro_set_audio_sample( AudioSampleCallback );
+    retro_set_audio_sample_batch( AudioBatchCallback );
+    retro_set_input_poll( InputPollCallback );
+    retro_set_input_state( InputStateCallback );
+    retro_init();
+    
+    // load the game (or just the BIOS)
+    struct retro_game_info Game = { CartridgePath, nullptr, 0, nullptr };
+    auto LoadStart = chrono::steady_clock::now();
+    
+    if( !retro_load_game( CartridgePath? &Game : nullptr ) )
+    {
+        cout << "Cannot load game" << endl;
+        retro_deinit();
+        return 1;
+    }
+    
+    cout << "Load time: " << SecondsSince( LoadStart ) * 1000 << " ms" << endl;
+    
+    // run the requested number of frames
+    auto RunStart = chrono::steady_clock::now();
+    
+    for( int i = 0; i < NumberOfFrames; i++ )
+      retro_run();
+    
+    double RunTime = SecondsSince( RunStart );
+    cout << "Ran " << VideoFrames << " frames in " << RunTime << " s ("
+         << VideoFrames / RunTime << " fps, " << AudioSamples << " audio samples)" << endl;
+    
+    // measure a savestate round trip
+    vector< uint8_t > State( retro_serialize_size() );
+    auto StateStart = chrono::steady_clock::now();
+    bool Saved = retro_serialize( &State[ 0 ], State.size() );
+    double SaveTime = SecondsSince( StateStart );
+    
+    StateStart = chrono::steady_clock::now();
+    bool Loaded = retro_unserialize( &State[ 0 ], State.size() );
+    double LoadTime = SecondsSince( StateStart );
+    
+    cout << "State size: " << State.size() << " bytes" << endl;
+    cout << "Save state: " << (Saved? "OK" : "FAILED") << " in " << SaveTime * 1000 << " ms" << endl;
+    cout << "Load state: " << (Loaded? "OK" : "FAILED") << " in " << LoadTime * 1000 << " ms" << endl;
+    
+    retro_unload_game();
+    retro_deinit();
+    return (Saved && Loaded)? 0 : 1;
+}
@@ -0,0 +1,634 @@
+// *****************************************************************************
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include project headers
+    #include "SoftwareRenderer.hpp"
+    
+    // include libretro headers
+    #include <libretro.h>       // [ libretro ] Core API
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    #include <fstream>          // [ C++ STL ] File streams
+    #include <memory>           // [ C++ STL ] Dynamic memory
+    #include <stdexcept>        // [ C++ STL ] Exceptions
+    #include <cstdarg>          // [ ANSI C ] Variable arguments
+    #include <cstdio>           // [ ANSI C ] Standard I/O
+    #include <cstring>          // [ ANSI C ] Strings
+    #include <cstdint>          // [ ANSI C ] Standard integers
+    #include <ctime>            // [ ANSI C ] Date and time
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+/* -------------------------------------------------------------------------- //
+    NOTES ON THIS CORE:
+    -------------------------------
+    (1) Libretro runs a single core instance per program, so all core state
+        is kept as static objects in this file. The console itself still has
+        its own set of callbacks, which are all set here at retro_init, and
+        video callbacks only use the renderer they receive as user data.
+    (2) Exceptions are never allowed to cross the libretro API, since the
+        frontend is C code. Every API function that may fail catches them.
+    (3) Video is rendered in software and audio is given as one full frame
+        (735 stereo samples) per retro_run, so this core is deterministic
+        and can run without any display, as frontends need for run-ahead.
+// -------------------------------------------------------------------------- */
+
+
+// =============================================================================
+//      CORE STATE
+// =============================================================================
+
+
+// normally given by the build system
+#if !defined(VIRCON32_CORE_VERSION)
+  #define VIRCON32_CORE_VERSION "unknown"
+#endif
+
+// emulated console and its video
+static V32Console* Console = nullptr;
+static SoftwareRenderer* Renderer = nullptr;
+
+// buffers for output and states
+static SPUOutputBuffer SoundBuffer;
+static unique_ptr< ConsoleState > StateBuffer;
+
+// frontend callbacks
+static retro_environment_t EnvironmentCallback = nullptr;
+static retro_video_refresh_t VideoRefreshCallback = nullptr;
+static retro_audio_sample_t AudioSampleCallback = nullptr;
+static retro_audio_sample_batch_t AudioBatchCallback = nullptr;
+static retro_input_poll_t InputPollCallback = nullptr;
+static retro_input_state_t InputStateCallback = nullptr;
+static retro_log_printf_t LogCallback = nullptr;
+
+// -----------------------------------------------------------------------------
+
+// mapping from libretro joypads to console gamepads
+typedef struct
+{
+    unsigned RetroID;
+    GamepadControls Control;
+    const char* Description;
+}
+GamepadMapping;
+
+static const GamepadMapping GamepadMappings[] =
+{
+    { RETRO_DEVICE_ID_JOYPAD_LEFT,  GamepadControls::Left,        "Left"   },
+    { RETRO_DEVICE_ID_JOYPAD_RIGHT, GamepadControls::Right,       "Right"  },
+    { RETRO_DEVICE_ID_JOYPAD_UP,    GamepadControls::Up,          "Up"     },
+    { RETRO_DEVICE_ID_JOYPAD_DOWN,  GamepadControls::Down,        "Down"   },
+    { RETRO_DEVICE_ID_JOYPAD_A,     GamepadControls::ButtonA,     "A"      },
+    { RETRO_DEVICE_ID_JOYPAD_B,     GamepadControls::ButtonB,     "B"      },
+    { RETRO_DEVICE_ID_JOYPAD_X,     GamepadControls::ButtonX,     "X"      },
+    { RETRO_DEVICE_ID_JOYPAD_Y,     GamepadControls::ButtonY,     "Y"      },
+    { RETRO_DEVICE_ID_JOYPAD_L,     GamepadControls::ButtonL,     "L"      },
+    { RETRO_DEVICE_ID_JOYPAD_R,     GamepadControls::ButtonR,     "R"      },
+    { RETRO_DEVICE_ID_JOYPAD_START, GamepadControls::ButtonStart, "Start"  }
+};
+
+static const int NumberOfMappings = sizeof(GamepadMappings) / sizeof(GamepadMapping);
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+static void CoreLog( retro_log_level Level, const char* Format, ... )
+{
+    char Message[ 1024 ];
+    
+    va_list Arguments;
+    va_start( Arguments, Format );
+    vsnprintf( Message, sizeof(Message), Format, Arguments );
+    va_end( Arguments );
+    
+    // without a log interface, use standard error
+    if( LogCallback )
+      LogCallback( Level, "%s\n", Message );
+    else
+      fprintf( stderr, "[Vircon32] %s\n", Message );
+}
+
+// -----------------------------------------------------------------------------
+
+static string GetFrontendDirectory( unsigned Command )
+{
+    const char* Directory = nullptr;
+    
+    if( !EnvironmentCallback( Command, &Directory ) || !Directory )
+      return ".";
+    
+    return Directory;
+}
+
+// -----------------------------------------------------------------------------
+
+static string GetFileNameWithoutExtension( const string& FilePath )
+{
+    size_t LastSeparator = FilePath.find_last_of( "/\\" );
+    string FileName = FilePath.substr( LastSeparator == string::npos? 0 : LastSeparator + 1 );
+    
+    size_t LastDot = FileName.find_last_of( '.' );
+    return FileName.substr( 0, LastDot );
+}
+
+// -----------------------------------------------------------------------------
+
+static bool FileExists( const string& FilePath )
+{
+    ifstream TestedFile( FilePath, ios_base::binary );
+    return TestedFile.good();
+}
+
+
+// =============================================================================
+//      CALLBACK FUNCTIONS FOR CONSOLE LOGIC
+// =============================================================================
+
+
+// user data is the renderer for the calling console
+namespace CallbackFunctions
+{
+    void ClearScreen( void* UserData, GPUColor ClearColor )
+    {
+        ((SoftwareRenderer*)UserData)->ClearScreen( ClearColor );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void DrawQuad( void* UserData, GPUQuad& DrawnQuad )
+    {
+        ((SoftwareRenderer*)UserData)->DrawQuad( DrawnQuad );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SetMultiplyColor( void* UserData, GPUColor NewMultiplyColor )
+    {
+        ((SoftwareRenderer*)UserData)->SetMultiplyColor( NewMultiplyColor );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SetBlendingMode( void* UserData, int NewBlendingMode )
+    {
+        ((SoftwareRenderer*)UserData)->SetBlendingMode( NewBlendingMode );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SelectTexture( void* UserData, int GPUTextureID )
+    {
+        ((SoftwareRenderer*)UserData)->SelectTexture( GPUTextureID );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void LoadTexture( void* UserData, int GPUTextureID, void* Pixels )
+    {
+        ((SoftwareRenderer*)UserData)->LoadTexture( GPUTextureID, Pixels );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void UnloadCartridgeTextures( void* UserData )
+    {
+        for( int i = 0; i < Constants::GPUMaximumCartridgeTextures; i++ )
+          ((SoftwareRenderer*)UserData)->UnloadTexture( i );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void UnloadBiosTexture( void* UserData )
+    {
+        ((SoftwareRenderer*)UserData)->UnloadTexture( -1 );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void LogLine( void* UserData, const string& Message )
+    {
+        CoreLog( RETRO_LOG_INFO, "%s", Message.c_str() );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void ThrowException( void* UserData, const string& Message )
+    {
+        throw runtime_error( Message );
+    }
+}
+
+
+// =============================================================================
+//      LIBRETRO API: CORE INFORMATION
+// =============================================================================
+
+
+RETRO_API unsigned retro_api_version( void )
+{
+    return RETRO_API_VERSION;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_get_system_info( struct retro_system_info* Info )
+{
+    memset( Info, 0, sizeof(*Info) );
+    Info->library_name = "Vircon32";
+    Info->library_version = VIRCON32_CORE_VERSION;
+    Info->valid_extensions = "v32|V32";
+    
+    // cartridges can be hundreds of MB and the console
+    // reads them from file, so never load them in memory
+    Info->need_fullpath = true;
+    Info->block_extract = false;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_get_system_av_info( struct retro_system_av_info* Info )
+{
+    memset( Info, 0, sizeof(*Info) );
+    Info->geometry.base_width = Constants::ScreenWidth;
+    Info->geometry.base_height = Constants::ScreenHeight;
+    Info->geometry.max_width = Constants::ScreenWidth;
+    Info->geometry.max_height = Constants::ScreenHeight;
+    Info->geometry.aspect_ratio = (float)Constants::ScreenWidth / Constants::ScreenHeight;
+    Info->timing.fps = Constants::FramesPerSecond;
+    Info->timing.sample_rate = Constants::SPUSamplingRate;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API unsigned retro_get_region( void )
+{
+    return RETRO_REGION_NTSC;
+}
+
+
+// =============================================================================
+//      LIBRETRO API: FRONTEND CALLBACKS
+// =============================================================================
+
+
+RETRO_API void retro_set_environment( retro_environment_t Callback )
+{
+    EnvironmentCallback = Callback;
+    
+    // the console can run its BIOS with no cartridge
+    bool SupportsNoGame = true;
+    EnvironmentCallback( RETRO_ENVIRONMENT_SET_SUPPORT_NO_GAME, &SupportsNoGame );
+    
+    // use the frontend log when available
+    struct retro_log_callback LogInterface;
+    
+    if( EnvironmentCallback( RETRO_ENVIRONMENT_GET_LOG_INTERFACE, &LogInterface ) )
+      LogCallback = LogInterface.log;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_set_video_refresh( retro_video_refresh_t Callback )
+{
+    VideoRefreshCallback = Callback;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_set_audio_sample( retro_audio_sample_t Callback )
+{
+    AudioSampleCallback = Callback;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_set_audio_sample_batch( retro_audio_sample_batch_t Callback )
+{
+    AudioBatchCallback = Callback;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_set_input_poll( retro_input_poll_t Callback )
+{
+    InputPollCallback = Callback;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_set_input_state( retro_input_state_t Callback )
+{
+    InputStateCallback = Callback;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_set_controller_port_device( unsigned Port, unsigned Device )
+{
+    if( !Console || Port >= (unsigned)Constants::GamepadPorts )
+      return;
+    
+    Console->SetGamepadConnection( Port, Device != RETRO_DEVICE_NONE );
+}
+
+
+// =============================================================================
+//      LIBRETRO API: CORE LIFETIME
+// =============================================================================
+
+
+RETRO_API void retro_init( void )
+{
+    Renderer = new SoftwareRenderer;
+    Console = new V32Console;
+    
+    // connect the console to this core
+    Console->Callbacks.UserData = Renderer;
+    Console->Callbacks.ClearScreen = CallbackFunctions::ClearScreen;
+    Console->Callbacks.DrawQuad = CallbackFunctions::DrawQuad;
+    Console->Callbacks.SetMultiplyColor = CallbackFunctions::SetMultiplyColor;
+    Console->Callbacks.SetBlendingMode = CallbackFunctions::SetBlendingMode;
+    Console->Callbacks.SelectTexture = CallbackFunctions::SelectTexture;
+    Console->Callbacks.LoadTexture = CallbackFunctions::LoadTexture;
+    Console->Callbacks.UnloadCartridgeTextures = CallbackFunctions::UnloadCartridgeTextures;
+    Console->Callbacks.UnloadBiosTexture = CallbackFunctions::UnloadBiosTexture;
+    Console->Callbacks.LogLine = CallbackFunctions::LogLine;
+    Console->Callbacks.ThrowException = CallbackFunctions::ThrowException;
+    
+    // connect both gamepads until told otherwise
+    for( int Port = 0; Port < Constants::GamepadPorts; Port++ )
+      Console->SetGamepadConnection( Port, true );
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_deinit( void )
+{
+    delete Console;
+    delete Renderer;
+    Console = nullptr;
+    Renderer = nullptr;
+    StateBuffer.reset();
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API bool retro_load_game( const struct retro_game_info* Game )
+{
+    enum retro_pixel_format PixelFormat = RETRO_PIXEL_FORMAT_XRGB8888;
+    
+    if( !EnvironmentCallback( RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &PixelFormat ) )
+    {
+        CoreLog( RETRO_LOG_ERROR, "Frontend does not support XRGB8888 pixels" );
+        return false;
+    }
+    
+    // describe the gamepad controls to the frontend
+    struct retro_input_descriptor Descriptors[ 2 * NumberOfMappings + 1 ];
+    memset( Descriptors, 0, sizeof(Descriptors) );
+    
+    for( int Port = 0; Port < 2; Port++ )
+      for( int i = 0; i < NumberOfMappings; i++ )
+      {
+          struct retro_input_descriptor& Descriptor = Descriptors[ Port * NumberOfMappings + i ];
+          Descriptor.port = Port;
+          Descriptor.device = RETRO_DEVICE_JOYPAD;
+          Descriptor.id = GamepadMappings[ i ].RetroID;
+          Descriptor.description = GamepadMappings[ i ].Description;
+      }
+    
+    EnvironmentCallback( RETRO_ENVIRONMENT_SET_INPUT_DESCRIPTORS, Descriptors );
+    
+    try
+    {
+        // the BIOS is taken from the frontend's system folder
+        string BiosPath = GetFrontendDirectory( RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY ) + "/Vircon32Bios.v32";
+        Console->LoadBios( BiosPath );
+        
+        if( Game && Game->path )
+        {
+            Console->LoadCartridge( Game->path );
+            
+            // each game gets its own memory card in the save folder
+            string SaveDirectory = GetFrontendDirectory( RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY );
+            string CardPath = SaveDirectory + "/" + GetFileNameWithoutExtension( Game->path ) + ".memc";
+            
+            if( !FileExists( CardPath ) )
+              Console->CreateMemoryCard( CardPath );
+            
+            Console->LoadMemoryCard( CardPath );
+        }
+        
+        // set console date and time from the system
+        // (Careful! C gives year counting from 1900)
+        time_t CurrentTime;
+        time( &CurrentTime );
+        struct tm* CurrentTimeInfo = localtime( &CurrentTime );
+        
+        Console->SetCurrentDate( CurrentTimeInfo->tm_year + 1900, CurrentTimeInfo->tm_yday );
+        Console->SetCurrentTime( CurrentTimeInfo->tm_hour, CurrentTimeInfo->tm_min, CurrentTimeInfo->tm_sec );
+        
+        Console->SetPower( true );
+    }
+    catch( const exception& e )
+    {
+        CoreLog( RETRO_LOG_ERROR, "Cannot load game: %s", e.what() );
+        return false;
+    }
+    
+    // allocate states only once, since
+    // frontends may save them every frame
+    StateBuffer.reset( new ConsoleState );
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API bool retro_load_game_special( unsigned GameType, const struct retro_game_info* Info, size_t NumberOfInfos )
+{
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_unload_game( void )
+{
+    try
+    {
+        // powering off saves any pending memory card changes
+        Console->SetPower( false );
+        Console->UnloadMemoryCard();
+        Console->UnloadCartridge();
+        Console->UnloadBios();
+    }
+    catch( const exception& e )
+    {
+        CoreLog( RETRO_LOG_ERROR, "Cannot unload game: %s", e.what() );
+    }
+}
+
+
+// =============================================================================
+//      LIBRETRO API: EMULATION
+// =============================================================================
+
+
+RETRO_API void retro_reset( void )
+{
+    // the frontend may have written anywhere in RAM
+    // through the exposed memory, so clear it all
+    Console->RAM.MarkAllPagesModified();
+    Console->Reset();
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_run( void )
+{
+    // read gamepads
+    InputPollCallback();
+    
+    for( int Port = 0; Port < Constants::GamepadPorts; Port++ )
+      for( int i = 0; i < NumberOfMappings; i++ )
+      {
+          bool Pressed = InputStateCallback( Port, RETRO_DEVICE_JOYPAD, 0, GamepadMappings[ i ].RetroID );
+          Console->SetGamepadControl( Port, GamepadMappings[ i ].Control, Pressed );
+      }
+    
+    // run the console
+    try
+    {
+        Console->RunNextFrame();
+    }
+    catch( const exception& e )
+    {
+        CoreLog( RETRO_LOG_ERROR, "Error running frame: %s", e.what() );
+    }
+    
+    // give the frontend all output for this frame
+    VideoRefreshCallback
+    (
+        Renderer->GetFramePixels(),
+        Constants::ScreenWidth,
+        Constants::ScreenHeight,
+        Constants::ScreenWidth * sizeof(uint32_t)
+    );
+    
+    Console->GetFrameSoundOutput( SoundBuffer );
+    AudioBatchCallback( (const int16_t*)SoundBuffer.Samples, Constants::SPUSamplesPerFrame );
+}
+
+
+// =============================================================================
+//      LIBRETRO API: SAVESTATES
+// =============================================================================
+
+
+RETRO_API size_t retro_serialize_size( void )
+{
+    return Console->GetStateSize();
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API bool retro_serialize( void* Data, size_t Size )
+{
+    if( !Console->IsPowerOn() || Size < Console->GetStateSize() )
+      return false;
+    
+    try
+    {
+        // frontend buffers are normally well aligned, and
+        // then states are written there with no extra copy
+        if( ((uintptr_t)Data % alignof(ConsoleState)) == 0 )
+          Console->SaveState( (ConsoleState*)Data );
+        
+        else
+        {
+            Console->SaveState( StateBuffer.get() );
+            memcpy( Data, StateBuffer.get(), Console->GetStateSize() );
+        }
+    }
+    catch( const exception& e )
+    {
+        CoreLog( RETRO_LOG_ERROR, "Cannot save state: %s", e.what() );
+        return false;
+    }
+    
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API bool retro_unserialize( const void* Data, size_t Size )
+{
+    if( !Console->IsPowerOn() || Size < Console->GetStateSize() )
+      return false;
+    
+    try
+    {
+        if( ((uintptr_t)Data % alignof(ConsoleState)) == 0 )
+          Console->LoadState( (const ConsoleState*)Data );
+        
+        else
+        {
+            memcpy( StateBuffer.get(), Data, Console->GetStateSize() );
+            Console->LoadState( StateBuffer.get() );
+        }
+    }
+    catch( const exception& e )
+    {
+        CoreLog( RETRO_LOG_ERROR, "Cannot load state: %s", e.what() );
+        return false;
+    }
+    
+    return true;
+}
+
+
+// =============================================================================
+//      LIBRETRO API: MEMORY ACCESS AND CHEATS
+// =============================================================================
+
+
+RETRO_API void* retro_get_memory_data( unsigned MemoryID )
+{
+    if( MemoryID == RETRO_MEMORY_SYSTEM_RAM && Console )
+      return &Console->RAM.Memory[ 0 ];
+    
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API size_t retro_get_memory_size( unsigned MemoryID )
+{
+    if( MemoryID == RETRO_MEMORY_SYSTEM_RAM )
+      return Constants::RAMSize * sizeof(V32Word);
+    
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+// memory cards are kept as files, and cheats are not supported
+RETRO_API void retro_cheat_reset( void )
+{
+    // (nothing to do)
+}
+
+// -----------------------------------------------------------------------------
+
+RETRO_API void retro_cheat_set( unsigned Index, bool Enabled, const char* Code )
+{
+    // (nothing to do)
+}
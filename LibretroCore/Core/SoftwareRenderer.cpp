@@ -0,0 +1,254 @@
+// *****************************************************************************
+    // include common Vircon headers
+    #include "../VirconDefinitions/Enumerations.hpp"
+    
+    // include project headers
+    #include "SoftwareRenderer.hpp"
+    
+    // include C/C++ headers
+    #include <cstring>          // [ ANSI C ] Strings
+    #include <cmath>            // [ ANSI C ] Mathematics
+    #include <algorithm>        // [ C++ STL ] Algorithms
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      SOFTWARE RENDERER: INSTANCE HANDLING
+// =============================================================================
+
+
+SoftwareRenderer::SoftwareRenderer()
+{
+    // start with a black screen
+    FramePixels.resize( Constants::ScreenPixels, 0 );
+    
+    // set default render configuration
+    SelectedTexture = &BiosTexture;
+    MultiplyColor = GPUColor{ 255, 255, 255, 255 };
+    BlendingMode = (int)IOPortValues::GPUBlendingMode_Alpha;
+}
+
+
+// =============================================================================
+//      SOFTWARE RENDERER: INTERNAL AUXILIARY METHODS
+// =============================================================================
+
+
+vector< GPUColor >& SoftwareRenderer::GetTexture( int GPUTextureID )
+{
+    if( GPUTextureID < 0 )
+      return BiosTexture;
+    
+    return CartridgeTextures[ GPUTextureID ];
+}
+
+// -----------------------------------------------------------------------------
+
+// these are the same equations set for OpenGL
+// blending in the emulators (with source alpha)
+void SoftwareRenderer::BlendPixel( uint32_t& Destination, GPUColor Source )
+{
+    int Alpha = Source.A;
+    int SourceRGB[ 3 ] = { Source.R, Source.G, Source.B };
+    int DestinationRGB[ 3 ] =
+    {
+        (int)((Destination >> 16) & 255),
+        (int)((Destination >>  8) & 255),
+        (int)( Destination        & 255)
+    };
+    
+    for( int c = 0; c < 3; c++ )
+    {
+        int WeightedSource = SourceRGB[ c ] * Alpha;
+        
+        if( BlendingMode == (int)IOPortValues::GPUBlendingMode_Add )
+          DestinationRGB[ c ] = min( 255, DestinationRGB[ c ] + WeightedSource / 255 );
+        
+        else if( BlendingMode == (int)IOPortValues::GPUBlendingMode_Subtract )
+          DestinationRGB[ c ] = max( 0, DestinationRGB[ c ] - WeightedSource / 255 );
+        
+        else
+          DestinationRGB[ c ] = (WeightedSource + DestinationRGB[ c ] * (255 - Alpha)) / 255;
+    }
+    
+    Destination = (DestinationRGB[ 0 ] << 16) | (DestinationRGB[ 1 ] << 8) | DestinationRGB[ 2 ];
+}
+
+
+// =============================================================================
+//      SOFTWARE RENDERER: TEXTURE HANDLING
+// =============================================================================
+
+
+void SoftwareRenderer::LoadTexture( int GPUTextureID, void* Pixels )
+{
+    // console always gives textures at full size
+    vector< GPUColor >& Texture = GetTexture( GPUTextureID );
+    Texture.resize( Constants::GPUTextureSize * Constants::GPUTextureSize );
+    memcpy( &Texture[ 0 ], Pixels, Texture.size() * sizeof(GPUColor) );
+}
+
+// -----------------------------------------------------------------------------
+
+void SoftwareRenderer::UnloadTexture( int GPUTextureID )
+{
+    // release memory, not just the contents
+    vector< GPUColor >().swap( GetTexture( GPUTextureID ) );
+}
+
+// -----------------------------------------------------------------------------
+
+void SoftwareRenderer::SelectTexture( int GPUTextureID )
+{
+    SelectedTexture = &GetTexture( GPUTextureID );
+}
+
+
+// =============================================================================
+//      SOFTWARE RENDERER: RENDER CONFIGURATION
+// =============================================================================
+
+
+void SoftwareRenderer::SetMultiplyColor( GPUColor NewMultiplyColor )
+{
+    MultiplyColor = NewMultiplyColor;
+}
+
+// -----------------------------------------------------------------------------
+
+void SoftwareRenderer::SetBlendingMode( int NewBlendingMode )
+{
+    // ignore invalid values, like OpenGL video does
+    if( NewBlendingMode != (int)IOPortValues::GPUBlendingMode_Alpha
+    &&  NewBlendingMode != (int)IOPortValues::GPUBlendingMode_Add
+    &&  NewBlendingMode != (int)IOPortValues::GPUBlendingMode_Subtract )
+      return;
+    
+    BlendingMode = NewBlendingMode;
+}
+
+
+// =============================================================================
+//      SOFTWARE RENDERER: RENDER FUNCTIONS
+// =============================================================================
+
+
+void SoftwareRenderer::ClearScreen( GPUColor ClearColor )
+{
+    uint32_t ClearPixel = (ClearColor.R << 16) | (ClearColor.G << 8) | ClearColor.B;
+    fill( FramePixels.begin(), FramePixels.end(), ClearPixel );
+}
+
+// -----------------------------------------------------------------------------
+
+// quads from the console are parallelograms in screen
+// coordinates, with vertices in the order top-left,
+// top-right, bottom-left, bottom-right; every pixel
+// whose center is inside is mapped back to quad
+// coordinates (U,V) to find its texture coordinates
+void SoftwareRenderer::DrawQuad( GPUQuad& Quad )
+{
+    vector< GPUColor >& Texture = *SelectedTexture;
+    
+    // a texture that was never loaded draws nothing
+    if( Texture.empty() )
+      return;
+    
+    GPUPoint& Origin = Quad.Vertices[ 0 ];
+    GPUPoint& EndU = Quad.Vertices[ 1 ];
+    GPUPoint& EndV = Quad.Vertices[ 2 ];
+    
+    // edges of the quad along U and V
+    float UX = EndU.x - Origin.x, UY = EndU.y - Origin.y;
+    float VX = EndV.x - Origin.x, VY = EndV.y - Origin.y;
+    
+    // a quad with no area draws nothing
+    float Determinant = UX * VY - UY * VX;
+    
+    if( fabs( Determinant ) < 1e-6 )
+      return;
+    
+    // screen bounding box for the quad
+    float MinX = Quad.Vertices[ 0 ].x, MaxX = MinX;
+    float MinY = Quad.Vertices[ 0 ].y, MaxY = MinY;
+    
+    for( int i = 1; i < 4; i++ )
+    {
+        MinX = min( MinX, Quad.Vertices[ i ].x );
+        MaxX = max( MaxX, Quad.Vertices[ i ].x );
+        MinY = min( MinY, Quad.Vertices[ i ].y );
+        MaxY = max( MaxY, Quad.Vertices[ i ].y );
+    }
+    
+    int FirstX = max( 0, (int)floor( MinX ) );
+    int LastX  = min( Constants::ScreenWidth - 1, (int)ceil( MaxX ) );
+    int FirstY = max( 0, (int)floor( MinY ) );
+    int LastY  = min( Constants::ScreenHeight - 1, (int)ceil( MaxY ) );
+    
+    // U and V change linearly along each axis
+    float DeltaUPerX =  VY / Determinant;
+    float DeltaVPerX = -UY / Determinant;
+    
+    // texture coordinates change linearly with U and V
+    float TextureSize = Constants::GPUTextureSize;
+    float TextureXPerU = (EndU.texture_x - Origin.texture_x) * TextureSize;
+    float TextureYPerU = (EndU.texture_y - Origin.texture_y) * TextureSize;
+    float TextureXPerV = (EndV.texture_x - Origin.texture_x) * TextureSize;
+    float TextureYPerV = (EndV.texture_y - Origin.texture_y) * TextureSize;
+    
+    for( int y = FirstY; y <= LastY; y++ )
+    {
+        // quad coordinates at the first pixel center in this row
+        float RelativeX = FirstX + 0.5f - Origin.x;
+        float RelativeY = y + 0.5f - Origin.y;
+        float U = (RelativeX * VY - RelativeY * VX) / Determinant;
+        float V = (UX * RelativeY - UY * RelativeX) / Determinant;
+        
+        uint32_t* Pixel = &FramePixels[ y * Constants::ScreenWidth + FirstX ];
+        
+        for( int x = FirstX; x <= LastX; x++ )
+        {
+            // use half-open ranges so that adjacent
+            // quads never draw the same pixel twice
+            if( U >= 0 && U < 1 && V >= 0 && V < 1 )
+            {
+                int TextureX = (int)(Origin.texture_x * TextureSize + U * TextureXPerU + V * TextureXPerV);
+                int TextureY = (int)(Origin.texture_y * TextureSize + U * TextureYPerU + V * TextureYPerV);
+                
+                // clamp to edge, same as video textures
+                TextureX = max( 0, min( Constants::GPUTextureSize - 1, TextureX ) );
+                TextureY = max( 0, min( Constants::GPUTextureSize - 1, TextureY ) );
+                
+                GPUColor Texel = Texture[ TextureY * Constants::GPUTextureSize + TextureX ];
+                
+                // apply multiply color
+                Texel.R = Texel.R * MultiplyColor.R / 255;
+                Texel.G = Texel.G * MultiplyColor.G / 255;
+                Texel.B = Texel.B * MultiplyColor.B / 255;
+                Texel.A = Texel.A * MultiplyColor.A / 255;
+                
+                if( Texel.A > 0 )
+                  BlendPixel( *Pixel, Texel );
+            }
+            
+            U += DeltaUPerX;
+            V += DeltaVPerX;
+            Pixel++;
+        }
+    }
+}
+
+
+// =============================================================================
+//      SOFTWARE RENDERER: ACCESS TO SCREEN CONTENTS
+// =============================================================================
+
+
+const uint32_t* SoftwareRenderer::GetFramePixels()
+{
+    return &FramePixels[ 0 ];
+}
@@ -0,0 +1,79 @@
+// *****************************************************************************
+    // start include guard
+    #ifndef SOFTWARERENDERER_HPP
+    #define SOFTWARERENDERER_HPP
+    
+    // include console logic headers
+    #include "ConsoleLogic/ExternalInterfaces.hpp"
+    
+    // include common Vircon headers
+    #include "../VirconDefinitions/Constants.hpp"
+    #include "../VirconDefinitions/DataStructures.hpp"
+    
+    // include C/C++ headers
+    #include <vector>           // [ C++ STL ] Vectors
+    #include <cstdint>          // [ ANSI C ] Standard integers
+// *****************************************************************************
+
+
+// =============================================================================
+//      SOFTWARE RENDERER CLASS
+// =============================================================================
+
+
+// Draws console quads into a framebuffer in main memory,
+// so that the core does not need any graphics API. Pixels
+// are stored as XRGB8888, the format libretro expects.
+// Results are meant to match the OpenGL video output of
+// the emulators: nearest texture sampling, and the same
+// equations for multiply color and blending modes.
+class SoftwareRenderer
+{
+    private:
+        
+        // screen contents
+        std::vector< uint32_t > FramePixels;
+        
+        // textures are only allocated when loaded
+        std::vector< V32::GPUColor > BiosTexture;
+        std::vector< V32::GPUColor > CartridgeTextures[ V32::Constants::GPUMaximumCartridgeTextures ];
+        
+        // current render configuration
+        std::vector< V32::GPUColor >* SelectedTexture;
+        V32::GPUColor MultiplyColor;
+        int BlendingMode;
+        
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        // Internal auxiliary methods
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+        
+        std::vector< V32::GPUColor >& GetTexture( int GPUTextureID );
+        void BlendPixel( uint32_t& Destination, V32::GPUColor Source );
+        
+    public:
+        
+        // instance handling
+        SoftwareRenderer();
+        
+        // texture handling (ID -1 is the BIOS texture)
+        void LoadTexture( int GPUTextureID, void* Pixels );
+        void UnloadTexture( int GPUTextureID );
+        void SelectTexture( int GPUTextureID );
+        
+        // render configuration
+        void SetMultiplyColor( V32::GPUColor NewMultiplyColor );
+        void SetBlendingMode( int NewBlendingMode );
+        
+        // render functions
+        void ClearScreen( V32::GPUColor ClearColor );
+        void DrawQuad( V32::GPUQuad& Quad );
+        
+        // access to screen contents
+        const uint32_t* GetFramePixels();
+};
+
+
+// *****************************************************************************
+    // end include guard
+    #endif
+// *****************************************************************************
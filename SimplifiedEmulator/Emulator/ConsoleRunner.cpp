@@ -0,0 +1,116 @@
+// *****************************************************************************
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include C/C++ headers
+    #include <iostream>         // [ C++ STL ] I/O Streams
+    #include <string>           // [ C++ STL ] Strings
+    #include <memory>           // [ C++ STL ] Smart pointers
+    #include <chrono>           // [ C++ STL ] Time measurement
+    #include <stdexcept>        // [ C++ STL ] Exceptions
+    #include <cstdlib>          // [ ANSI C ] Standard library
+    
+    // declare used namespaces
+    using namespace std;
+    using namespace V32;
+// *****************************************************************************
+
+
+// =============================================================================
+//      AUXILIARY FUNCTIONS
+// =============================================================================
+
+
+// This program runs the same console as the emulator, from
+// the shared console logic library, but with no video, audio
+// or input. It keeps the default callbacks (that do nothing)
+// so only the console itself is timed, and the results can
+// be compared with the ones from the libretro core runner.
+
+static void LogLine( void* UserData, const string& Message )
+{
+    cout << Message << endl;
+}
+
+// -----------------------------------------------------------------------------
+
+static double SecondsSince( chrono::steady_clock::time_point Start )
+{
+    chrono::duration< double > Elapsed = chrono::steady_clock::now() - Start;
+    return Elapsed.count();
+}
+
+
+// =============================================================================
+//      MAIN FUNCTION
+// =============================================================================
+
+
+int main( int NumberOfArguments, char* Arguments[] )
+{
+    if( NumberOfArguments < 2 )
+    {
+        cout << "USAGE: Vircon32SimpleRunner <bios file> [cartridge file] [frames]" << endl;
+        cout << "By default it runs 3600 frames; an empty cartridge runs just the BIOS" << endl;
+        return 1;
+    }
+    
+    string BiosPath = Arguments[ 1 ];
+    string CartridgePath = (NumberOfArguments > 2? Arguments[ 2 ] : "");
+    int NumberOfFrames = (NumberOfArguments > 3? atoi( Arguments[ 3 ] ) : 3600);
+    
+    // the console holds all of its memory and chip state,
+    // so it is better kept out of the stack
+    unique_ptr< V32Console > Console( new V32Console );
+    Console->Callbacks.LogLine = LogLine;
+    
+    try
+    {
+        // load the BIOS and the game, if any
+        auto LoadStart = chrono::steady_clock::now();
+        Console->LoadBios( BiosPath );
+        
+        if( !CartridgePath.empty() )
+          Console->LoadCartridge( CartridgePath );
+        
+        cout << "Load time: " << SecondsSince( LoadStart ) * 1000 << " ms" << endl;
+        
+        // run the requested number of frames, adding
+        // the activity counters of every frame
+        Console->SetPower( true );
+        
+        ConsoleFrameCounters Counters;
+        double TotalCPUCycles = 0;
+        double TotalDrawCommands = 0;
+        auto RunStart = chrono::steady_clock::now();
+        
+        for( int i = 0; i < NumberOfFrames; i++ )
+        {
+            Console->RunNextFrame();
+            
+            Console->GetFrameCounters( Counters );
+            TotalCPUCycles += Counters.CPUCycles;
+            TotalDrawCommands += Counters.DrawCommands;
+        }
+        
+        double RunTime = SecondsSince( RunStart );
+        cout << "Ran " << NumberOfFrames << " frames in " << RunTime << " s ("
+             << NumberOfFrames / RunTime << " fps)" << endl;
+        
+        if( NumberOfFrames > 0 )
+        {
+            cout << "CPU cycles per frame: " << TotalCPUCycles / NumberOfFrames << endl;
+            cout << "GPU draw commands per frame: " << TotalDrawCommands / NumberOfFrames << endl;
+        }
+        
+        Console->SetPower( false );
+    }
+    
+    catch( const exception& e )
+    {
+        cout << "ERROR: " << e.what() << endl;
+        return 1;
+    }
+    
+    return 0;
+}
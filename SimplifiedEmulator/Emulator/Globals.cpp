@@ -1,12 +1,12 @@
 // *****************************************************************************
-    // include common Vircon headers
-    #include "../VirconDefinitions/VirconDefinitions.hpp"
-    #include "../VirconDefinitions/VirconDataStructures.hpp"
-    
     // include project headers
     #include "Globals.hpp"
     #include "VirconEmulator.hpp"
     
+    // include C/C++ headers
+    #include <iostream>         // [ C++ STL ] I/O Streams
+    #include <stdexcept>        // [ C++ STL ] Exceptions
+    
     // declare used namespaces
     using namespace std;
 // *****************************************************************************
@@ -25,3 +25,82 @@ OpenGL2DContext OpenGL2D;
 
 // instance of the Vircon virtual machine
 VirconEmulator Vircon;
+
+
+// =============================================================================
+//      CALLBACK FUNCTIONS FOR CONSOLE LOGIC
+// =============================================================================
+
+
+namespace CallbackFunctions
+{
+    void ClearScreen( void* UserData, V32::GPUColor ClearColor )
+    {
+        OpenGL2D.SetClearColor( ClearColor );
+        OpenGL2D.ClearScreen();
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void DrawQuad( void* UserData, V32::GPUQuad& DrawnQuad )
+    {
+        OpenGL2D.DrawQuad( DrawnQuad );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SetMultiplyColor( void* UserData, V32::GPUColor NewMultiplyColor )
+    {
+        OpenGL2D.SetMultiplyColor( NewMultiplyColor );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SetBlendingMode( void* UserData, int NewBlendingMode )
+    {
+        OpenGL2D.SetBlendingMode( (V32::IOPortValues)NewBlendingMode );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void SelectTexture( void* UserData, int GPUTextureID )
+    {
+        OpenGL2D.SelectTexture( GPUTextureID );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void LoadTexture( void* UserData, int GPUTextureID, void* Pixels )
+    {
+        OpenGL2D.LoadTexture( GPUTextureID, Pixels );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void UnloadCartridgeTextures( void* UserData )
+    {
+        for( int i = 0; i < V32::Constants::GPUMaximumCartridgeTextures; i++ )
+          OpenGL2D.UnloadTexture( i );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void UnloadBiosTexture( void* UserData )
+    {
+        OpenGL2D.UnloadTexture( -1 );
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void LogLine( void* UserData, const string& Message )
+    {
+        cout << Message << endl;
+    }
+    
+    // -----------------------------------------------------------------------------
+    
+    void ThrowException( void* UserData, const string& Message )
+    {
+        throw runtime_error( Message );
+    }
+}
@@ -3,8 +3,14 @@
     #ifndef GLOBALS_HPP
     #define GLOBALS_HPP
     
+    // include console logic headers
+    #include "ConsoleLogic/ExternalInterfaces.hpp"
+    
     // include project headers
     #include "OpenGL2DContext.hpp"
+    
+    // include C/C++ headers
+    #include <string>       // [ C++ STL ] Strings
 // *****************************************************************************
 
 
@@ -24,6 +30,31 @@ class VirconEmulator;
 extern VirconEmulator Vircon;
 
 
+// =============================================================================
+//      CALLBACK FUNCTIONS FOR CONSOLE LOGIC
+// =============================================================================
+
+
+// this program has a single console, whose
+// frontend is global, so user data is not used
+namespace CallbackFunctions
+{
+    // video functions callable by the console
+    void ClearScreen( void* UserData, V32::GPUColor ClearColor );
+    void DrawQuad( void* UserData, V32::GPUQuad& DrawnQuad );
+    void SetMultiplyColor( void* UserData, V32::GPUColor NewMultiplyColor );
+    void SetBlendingMode( void* UserData, int NewBlendingMode );
+    void SelectTexture( void* UserData, int GPUTextureID );
+    void LoadTexture( void* UserData, int GPUTextureID, void* Pixels );
+    void UnloadCartridgeTextures( void* UserData );
+    void UnloadBiosTexture( void* UserData );
+    
+    // log functions callable by the console
+    void LogLine( void* UserData, const std::string& Message );
+    void ThrowException( void* UserData, const std::string& Message );
+}
+
+
 // *****************************************************************************
     // end include guard
     #endif
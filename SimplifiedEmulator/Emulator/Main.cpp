@@ -12,15 +12,6 @@
     // include SDL2 headers
     #include <SDL2/SDL.h>         // [ SDL2 ] Main header
     
-    // include OpenAL headers
-    #if defined(__APPLE__)
-      #include <OpenAL/al.h>      // [ OpenAL ] Main header
-      #include <AL/alut.h>        // [ OpenAL ] Utility Toolkit
-    #else
-      #include <AL/al.h>          // [ OpenAL ] Main header
-      #include <AL/alut.h>        // [ OpenAL ] Utility Toolkit
-    #endif
-    
     // on Linux, include GTK headers
     #if defined(__linux__)
       #include <gtk/gtk.h>        // [ GTK ] Main header
@@ -62,15 +53,7 @@ int main( int NumberOfArguments, char* Arguments[] )
         // set alpha blending
         cout << "Enabling alpha blending" << endl;
         glEnable( GL_BLEND );
-        OpenGL2D.SetBlendingMode( IOPortValues::GPUBlendingMode_Alpha );
-        
-        //initialize audio
-        cout << "Initializing audio" << endl;
-        alutInit( NULL, NULL );
-        
-        // locating listener
-        alListener3f( AL_POSITION, 0, 0, 0 );
-        alListenerf( AL_GAIN, 1.0 );
+        OpenGL2D.SetBlendingMode( V32::IOPortValues::GPUBlendingMode_Alpha );
         
         // on linux, initialize GTK
         #if defined(__linux__)
@@ -80,12 +63,13 @@ int main( int NumberOfArguments, char* Arguments[] )
         
         // -----------------------------------------------------------------------------
         
+        // connect Vircon VM to video, audio and input
+        // (the bios texture is sent to video when loaded)
+        Vircon.Initialize();
+        
         // load the standard bios from the emulator's local bios folder
         Vircon.LoadBios( "./Bios/StandardBios.v32" );
         
-        // turn on Vircon VM
-        Vircon.Initialize();
-        
         // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
         
         // program state control
@@ -177,7 +161,7 @@ int main( int NumberOfArguments, char* Arguments[] )
                         // CTRL+P = Power toggle
                         if( Key == SDLK_p )
                         {
-                            if( Vircon.PowerIsOn )
+                            if( Vircon.IsPowerOn() )
                               Vircon.PowerOff();
                             else
                               Vircon.PowerOn();
@@ -259,10 +243,6 @@ int main( int NumberOfArguments, char* Arguments[] )
         // turn off Vircon VM
         Vircon.Terminate();
         
-        // shut down ALUT
-        cout << "Terminating audio" << endl;
-        alutExit();
-        
         // clean-up in reverse order
         cout << "Exiting" << endl;
         OpenGL2D.DestroyOpenGLWindow();
@@ -1,6 +1,6 @@
 // *****************************************************************************
     // include common Vircon headers
-    #include "../VirconDefinitions/VirconDefinitions.hpp"
+    #include "../VirconDefinitions/Constants.hpp"
     
     // include project headers
     #include "OpenGL2DContext.hpp"
@@ -11,6 +11,7 @@
     
     // declare used namespaces
     using namespace std;
+    using namespace V32;
 // *****************************************************************************
 
 
@@ -29,6 +30,12 @@ OpenGL2DContext::OpenGL2DContext()
     // SDL & OpenGL contexts not created yet
     Window = nullptr;
     OpenGLContext = nullptr;
+    
+    // no textures loaded yet
+    BiosTextureID = 0;
+    
+    for( int i = 0; i < Constants::GPUMaximumCartridgeTextures; i++ )
+      CartridgeTextureIDs[ i ] = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -135,6 +142,9 @@ void OpenGL2DContext::DestroyOpenGLWindow()
     
     if( Window )
       SDL_DestroyWindow( Window );
+    
+    OpenGLContext = nullptr;
+    Window = nullptr;
 }
 
 
@@ -235,6 +245,79 @@ void OpenGL2DContext::SetBlendingMode( IOPortValues BlendingMode )
 }
 
 
+// =============================================================================
+//      OPENGL 2D CONTEXT: TEXTURE FUNCTIONS
+// =============================================================================
+
+
+void OpenGL2DContext::LoadTexture( int GPUTextureID, void* Pixels )
+{
+    GLuint* OpenGLTextureID = &BiosTextureID;
+    
+    if( GPUTextureID >= 0 )
+      OpenGLTextureID = &CartridgeTextureIDs[ GPUTextureID ];
+    
+    // create a new OpenGL texture and select it
+    glGenTextures( 1, OpenGLTextureID );
+    glBindTexture( GL_TEXTURE_2D, *OpenGLTextureID );
+    
+    // clear OpenGL errors
+    glGetError();
+    
+    // console always gives textures at full size
+    glTexImage2D
+    (
+        GL_TEXTURE_2D,
+        0,
+        GL_RGBA,
+        Constants::GPUTextureSize,
+        Constants::GPUTextureSize,
+        0,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        Pixels
+    );
+    
+    if( glGetError() != GL_NO_ERROR )
+      throw runtime_error( "OpenGL error while loading a texture" );
+    
+    // set texture filters for pixel-perfect rendering
+    glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+    glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+    
+    // prevent edge bleeding at region borders
+    glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+    glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+}
+
+// -----------------------------------------------------------------------------
+
+void OpenGL2DContext::UnloadTexture( int GPUTextureID )
+{
+    GLuint* OpenGLTextureID = &BiosTextureID;
+    
+    if( GPUTextureID >= 0 )
+      OpenGLTextureID = &CartridgeTextureIDs[ GPUTextureID ];
+    
+    // unloading an empty texture is not an error
+    if( !*OpenGLTextureID )
+      return;
+    
+    glDeleteTextures( 1, OpenGLTextureID );
+    *OpenGLTextureID = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void OpenGL2DContext::SelectTexture( int GPUTextureID )
+{
+    if( GPUTextureID < 0 )
+      glBindTexture( GL_TEXTURE_2D, BiosTextureID );
+    else
+      glBindTexture( GL_TEXTURE_2D, CartridgeTextureIDs[ GPUTextureID ] );
+}
+
+
 // =============================================================================
 //      OPENGL 2D CONTEXT: RENDER FUNCTIONS
 // =============================================================================
@@ -247,6 +330,27 @@ void OpenGL2DContext::ClearScreen()
 
 // -----------------------------------------------------------------------------
 
+// quads from the console are already placed in screen
+// coordinates; their vertices are given in the order
+// top-left, top-right, bottom-left, bottom-right
+void OpenGL2DContext::DrawQuad( GPUQuad& Quad )
+{
+    const int VertexOrder[ 4 ] = { 0, 1, 3, 2 };
+    
+    glBegin( GL_QUADS );
+    
+    for( int i: VertexOrder )
+    {
+        GPUPoint& Vertex = Quad.Vertices[ i ];
+        glTexCoord2f( Vertex.texture_x, Vertex.texture_y );
+        glVertex2f( Vertex.x, Vertex.y );
+    }
+    
+    glEnd();
+}
+
+// -----------------------------------------------------------------------------
+
 void OpenGL2DContext::RenderFrame()
 {
     SDL_GL_SwapWindow( Window );
@@ -3,9 +3,12 @@
     #ifndef OPENGL2DCONTEXT_HPP
     #define OPENGL2DCONTEXT_HPP
     
+    // include console logic headers
+    #include "ConsoleLogic/ExternalInterfaces.hpp"
+    
     // include common Vircon headers
-    #include "../VirconDefinitions/VirconDataStructures.hpp"
-    #include "../VirconDefinitions/VirconEnumerations.hpp"
+    #include "../VirconDefinitions/DataStructures.hpp"
+    #include "../VirconDefinitions/Enumerations.hpp"
     
     // include SDL2 headers
     #define SDL_MAIN_HANDLED
@@ -39,6 +42,10 @@ class OpenGL2DContext
         SDL_Window* Window;
         SDL_GLContext OpenGLContext;
         
+        // textures for each GPU texture ID
+        GLuint BiosTextureID;
+        GLuint CartridgeTextureIDs[ V32::Constants::GPUMaximumCartridgeTextures ];
+        
     public:
         
         // instance handling
@@ -54,12 +61,18 @@ class OpenGL2DContext
         void ExitFullScreen();
         
         // color treatment functions
-        void SetClearColor( GPUColor ClearColor );
-        void SetMultiplyColor( GPUColor MultiplyColor );
-        void SetBlendingMode( IOPortValues BlendingMode );
+        void SetClearColor( V32::GPUColor ClearColor );
+        void SetMultiplyColor( V32::GPUColor MultiplyColor );
+        void SetBlendingMode( V32::IOPortValues BlendingMode );
+        
+        // texture handling (ID -1 is the BIOS texture)
+        void LoadTexture( int GPUTextureID, void* Pixels );
+        void UnloadTexture( int GPUTextureID );
+        void SelectTexture( int GPUTextureID );
         
         // render functions
         void ClearScreen();
+        void DrawQuad( V32::GPUQuad& Quad );
         void RenderFrame();
 };
 
@@ -17,7 +17,7 @@ namespace UserActions
     void LoadCartridge()
     {
         // console needs to be off
-        if( Vircon.PowerIsOn )
+        if( Vircon.IsPowerOn() )
         {
             cout << "Cannot load a cartridge when the console is on" << endl;
             return;
@@ -47,7 +47,7 @@ namespace UserActions
     void UnloadCartridge()
     {
         // console needs to be off
-        if( Vircon.PowerIsOn )
+        if( Vircon.IsPowerOn() )
         {
             cout << "Cannot unload a cartridge when the console is on" << endl;
             return;
@@ -3,17 +3,15 @@
     #ifndef VIRCONEMULATOR_HPP
     #define VIRCONEMULATOR_HPP
     
-    // include project headers
-    #include "VirconCPU.hpp"
-    #include "VirconGPU.hpp"
-    #include "VirconSPU.hpp"
-    #include "VirconTimer.hpp"
-    #include "VirconRNG.hpp"
-    #include "VirconMemory.hpp"
-    #include "VirconGamepadController.hpp"
-    #include "VirconCartridgeController.hpp"
-    #include "VirconMemoryCardController.hpp"
-    #include "VirconNullController.hpp"
+    // include console logic headers
+    #include "ConsoleLogic/V32Console.hpp"
+    
+    // include C/C++ headers
+    #include <string>           // [ C++ STL ] Strings
+    
+    // include SDL2 headers
+    #define SDL_MAIN_HANDLED
+    #include <SDL2/SDL.h>       // [ SDL2 ] Main header
 // *****************************************************************************
 
 
@@ -22,32 +20,23 @@
 // =============================================================================
 
 
+// the console itself is the same one used by the
+// full emulator: this class just connects it to
+// the video, audio and input of this program
 class VirconEmulator
 {
     public:
         
-        // communication lines
-        VirconMemoryBus  MemoryBus;
-        VirconControlBus ControlBus;
-        
-        // hardwired motherboard components
-        VirconTimer Timer;
-        VirconRNG RNG;
-        VirconGamepadController GamepadController;
-        VirconCartridgeController CartridgeController;
-        VirconMemoryCardController MemoryCardController;
-        VirconNullController NullController;
-        
-        // components on motherboard slots
-        VirconCPU CPU;
-        VirconGPU GPU;
-        VirconSPU SPU;
-        VirconRAM RAM;
-        VirconROM BiosProgramROM;
+        // the emulated console
+        V32::V32Console Console;
         
         // internal state
-        bool PowerIsOn;
         bool Paused;
+        bool Mute;
+        
+        // sound output
+        SDL_AudioDeviceID AudioDevice;
+        V32::SPUOutputBuffer SoundBuffer;
         
     public:
         
@@ -82,15 +71,14 @@ class VirconEmulator
         void Resume();
         
         // external queries
+        bool IsPowerOn();
         bool HasCartridge();
         bool HasMemoryCard();
         bool HasGamepad( int Number );
         
         // external volume control
-        float GetOutputVolume();
-        void SetOutputVolume( float Volume );
         bool IsMuted();
-        void SetMute( bool Mute );
+        void SetMute( bool MuteOn );
         
         // I/O functions
         void ProcessEvent( SDL_Event Event );